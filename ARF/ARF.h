@@ -29,21 +29,40 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "dataStructures/Data.h"
 #include "dataStructures/Value.h"
 #include "dataStructures/Vector.h"
+#include "dataStructures/FixedSensorSample.h"
 #include "dataStructures/Matrix.h"
 #include "dataStructures/RingBuffer.h"
+#include "dataStructures/ColumnRingBuffer.h"
+#include "dataStructures/BlockAggregateIndex.h"
+#include "dataStructures/SlidingStatistics.h"
+#include "dataStructures/SampleQueue.h"
 #include "dataStructures/DataIterator.h"
+#include "dataStructures/DataArena.h"
+#include "dataStructures/MappedDataSet.h"
+#include "dataStructures/DataSetReader.h"
+#include "dataStructures/DataSetWriter.h"
 
 //include the typedefs
 #include "utils/ARFTypedefs.h"
+#include "utils/MathPolicies.h"
+#include "utils/CSVParser.h"
+#include "utils/ColumnCodec.h"
 
 //include the core files
 #include "algorithms/core/Algorithm.h"
+#include "algorithms/core/ExecutionContext.h"
+#include "algorithms/core/PipelinePlan.h"
+#include "algorithms/core/StreamRuntime.h"
+#include "algorithms/core/ColumnProjection.h"
 
 //include the data acquisition files
 #include "algorithms/1-dataAcquisition/RingBufferAlgorithm.h"
 
 //include the preprocessing files
 #include "algorithms/2-preprocessing/Magnitude.h"
+#include "algorithms/2-preprocessing/SlidingDFT.h"
+#include "algorithms/2-preprocessing/BiquadFilter.h"
+#include "algorithms/2-preprocessing/Resampler.h"
 
 //include the event detection files
 #include "algorithms/3-eventDetection/PeakDetector.h"
@@ -53,6 +72,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "algorithms/4-featureExtraction/Mean.h"
 #include "algorithms/4-featureExtraction/STD.h"
 #include "algorithms/4-featureExtraction/ZCR.h"
+#include "algorithms/4-featureExtraction/Statistics.h"
+#include "algorithms/4-featureExtraction/SlidingFeature.h"
+#include "algorithms/4-featureExtraction/FFTPlan.h"
+#include "algorithms/4-featureExtraction/SpectralFeatures.h"
+#include "algorithms/4-featureExtraction/FeatureKernels.h"
 
 //include the utility files
 #include "algorithms/other/DataSelector.h"
@@ -32,6 +32,12 @@
 #include "../../utils/ARFConstants.h"
 #include "../../utils/ARFTypedefs.h"
 #include "../../dataStructures/RingBuffer.h"
+#include "../../dataStructures/FixedSensorSample.h"
+#include "../../dataStructures/SampleQueue.h"
+#include "../../dataStructures/SlidingStatistics.h"
+#include <climits>
+#include <cstddef>
+#include <new>
 
 //remove!
 #include <iostream>
@@ -39,29 +45,191 @@ using namespace std;
 
 namespace ARF {
 
-class RingBufferAlgorithm : public Algorithm {
+/**
+ The algorithms that store the samples they receive in a ring buffer, independently of the type of the samples, so that DataSelectors can select data from any of them
+ */
+class RingBufferSource : public Algorithm {
+	
+public:
+	
+	/**
+	 Retrieves the ring buffer of the stream being executed
+	 
+	 @param context the execution context
+	 @return the ring buffer in the state block of the context, or the ring buffer of the algorithm if the context has no state block
+	 */
+	virtual const IterableValues * getIterable(const ExecutionContext & context) const = 0;
+	
+	/**
+	 Retrieves the ring buffer of the algorithm
+	 
+	 @return the ring buffer used when the algorithm is executed without a state block
+	 */
+	virtual const IterableValues * getIterable() const = 0;
+	
+	/**
+	 Keeps the SlidingStatistics of a column of the ring buffer up to date as samples enter and leave it, so that features of the whole ring buffer can be read in constant time by a SlidingFeature. Columns should be tracked before samples are added and before a StreamRuntime is created for the pipeline
+	 
+	 @param columnIdx the index of the column in the samples
+	 */
+	virtual void trackColumn(UINT columnIdx) = 0;
+	
+	/**
+	 Retrieves the statistics of a tracked column of the ring buffer of the stream being executed
+	 
+	 @param columnIdx the index of the column in the samples
+	 @param context the execution context
+	 @return the statistics of the column, or NULL if the column is not tracked
+	 */
+	virtual const SlidingStatistics * getSlidingStatistics(UINT columnIdx, const ExecutionContext & context) const = 0;
+	
+	/**
+	 Retrieves the statistics of a tracked column of the ring buffer of the algorithm
+	 
+	 @param columnIdx the index of the column in the samples
+	 @return the statistics of the column, or NULL if the column is not tracked
+	 */
+	virtual const SlidingStatistics * getSlidingStatistics(UINT columnIdx) const = 0;
+};
+
+/**
+ A ring buffer algorithm storing samples of type T, either SensorSamples or FixedSensorSamples. The input data passed to execute() should point to a T. The output is always a SensorSample: the stored sample itself when T is a SensorSample, or a copy of it otherwise
+ */
+template <typename T>
+class BasicRingBufferAlgorithm : public RingBufferSource {
 	
 private:
-	RingBuffer<SensorSample> * ringBuffer; ///< The ring buffer containing the data
+	RingBuffer<T> * ringBuffer; ///< The ring buffer containing the data
 	UINT notificationInterval; ///< The number of samples after which the RingBuffer outputs each sample
 	UINT notificationOffset; ///< The amount of samples between the last sample added to the RingBuffer and the sample output
 	UINT notificationCount; ///< The number of samples since the last notification
 	bool notifyWhenFull; ///< Indicates whether the ring buffer should notify samples always or only when it is full
+	SensorSample outputSample; ///< The copy of the notification sample output when the samples are not SensorSamples
+	std::vector<UINT> trackedColumns; ///< The columns whose statistics are updated as samples are added
+	std::vector<SlidingStatistics> slidingStatistics; ///< The statistics of every tracked column of the ring buffer
+	UINT numIndexedColumns; ///< The number of columns of the index of block aggregates of the ring buffers, or 0 if they are not indexed
+	UINT indexBlockSize; ///< The number of samples in a block of the index
+	
+	/**
+	 The state of a stream, followed in the state block by the elements of its ring buffer
+	 */
+	struct State {
+		RingBuffer<T> ringBuffer; ///< The ring buffer of the stream
+		UINT notificationCount; ///< The number of samples since the last notification
+		SensorSample outputSample; ///< The copy of the notification sample of the stream, when the samples are not SensorSamples
+		std::vector<SlidingStatistics> slidingStatistics; ///< The statistics of the tracked columns of the stream
+		
+		State(void * storage, UINT capacity, UINT numTrackedColumns) : ringBuffer(storage, capacity), notificationCount(0), slidingStatistics(numTrackedColumns, SlidingStatistics(capacity)) { }
+	};
+	
+	/**
+	 Retrieves the size of the State struct rounded up so that the elements of the ring buffer that follow it are aligned
+	 
+	 @return the offset of the elements of the ring buffer in the state block
+	 */
+	static UINT getStateHeaderSize(){
+		const UINT alignment = alignof(std::max_align_t);
+		return (sizeof(State) + alignment - 1) / alignment * alignment;
+	}
+	
 	/**
 	 Retrieves the sample the RingBuffer should output, typically the last sample added, but can be an older sample if the notificationOffset > 0
 	 
-	 @return a pointer to the retrieved SensorSample
+	 @param ringBuffer the ring buffer of the stream
+	 @return a reference to the retrieved SensorSample in the ring buffer
 	 */
-	SensorSample * getNotificationSample() const{
+	const T & getNotificationSample(const RingBuffer<T> & ringBuffer) const{
 		
-		int eventIdx = ringBuffer->getEndIdx() - notificationOffset - 1;
-		if (eventIdx < 0) {
-			eventIdx += ringBuffer->getCapacity();
+		UINT eventIdx = ringBuffer.getSize() - notificationOffset - 1;
+		return ringBuffer.getElementAtIdx(eventIdx);
+	}
+	
+	/**
+	 Retrieves the output of the algorithm for a SensorSample stored in the ring buffer, which is the sample itself
+	 
+	 @param sample the notification sample
+	 @param outputSample unused
+	 @return a pointer to the sample
+	 */
+	static Data * GetOutput(const SensorSample & sample, SensorSample & outputSample){
+		return (Data*) &sample;
+	}
+	
+	/**
+	 Retrieves the output of the algorithm for a sample that is not a Data object, like a FixedSensorSample
+	 
+	 @param sample the notification sample
+	 @param outputSample the SensorSample the values of the sample are copied to
+	 @return a pointer to outputSample
+	 */
+	template <typename S>
+	static Data * GetOutput(const S & sample, SensorSample & outputSample){
+		sample.copyTo(outputSample);
+		return &outputSample;
+	}
+	
+	/**
+	 Updates the statistics of the tracked columns with a sample that is about to be added to a ring buffer, and with the oldest sample of the ring buffer if the sample overwrites it
+	 
+	 @param ringBuffer the ring buffer the sample will be added to
+	 @param statistics the statistics of the tracked columns of the ring buffer
+	 @param getValue returns the value of the new sample in a column
+	 */
+	template <typename GetValue>
+	void updateSlidingStatistics(const RingBuffer<T> & ringBuffer, std::vector<SlidingStatistics> & statistics, GetValue getValue) const{
+		if(ringBuffer.isFull()){
+			const T & oldestSample = ringBuffer.getElementAtIdx(0);
+			for(UINT i = 0 ; i < statistics.size() ; i++){
+				statistics[i].slide(IterableElement<T>::GetValue(oldestSample, trackedColumns[i]), getValue(trackedColumns[i]));
+			}
+		} else {
+			for(UINT i = 0 ; i < statistics.size() ; i++){
+				statistics[i].add(getValue(trackedColumns[i]));
+			}
 		}
+	}
+	
+	/**
+	 Adds a sample to a ring buffer, updating the statistics of the tracked columns
+	 
+	 @param sample the sample to append to the ring buffer
+	 @param ringBuffer the ring buffer
+	 @param statistics the statistics of the tracked columns of the ring buffer
+	 */
+	void addSample(const T & sample, RingBuffer<T> & ringBuffer, std::vector<SlidingStatistics> & statistics) const{
+		if(!statistics.empty()){
+			updateSlidingStatistics(ringBuffer, statistics, [&sample](UINT columnIdx){
+				return IterableElement<T>::GetValue(sample, columnIdx);
+			});
+		}
+		ringBuffer.add(sample);
+	}
+	
+	/**
+	 Adds the sample to the ring buffer and checks if the ring buffer should produce an output
+	 
+	 @param sample the sample to append to the ring buffer
+	 @param ringBuffer the ring buffer of the stream
+	 @param notificationCount the number of samples since the last notification of the stream
+	 @param statistics the statistics of the tracked columns of the stream
+	 @return true if the notification sample should be output
+	 */
+	bool addSampleAndNotify(const T * sample, RingBuffer<T> & ringBuffer, UINT & notificationCount, std::vector<SlidingStatistics> & statistics) const{
+		
+		//add the sample to the ring buffer
+		addSample(*sample, ringBuffer, statistics);
 		
-		//cout << eventIdx << endl;
-		SensorSample sample = ringBuffer->getElementAtIdx(eventIdx);
-		return new SensorSample(sample);
+		//check if an output should be produced
+		if(!notifyWhenFull || ringBuffer.isFull()){
+			notificationCount++;
+			if(notificationCount == notificationInterval){
+				notificationCount = 0;
+				
+				//check if there are enough samples in the buffer
+				return notificationOffset < ringBuffer.getSize();
+			}
+		}
+		return false;
 	}
 	
 public:
@@ -72,9 +240,9 @@ public:
 	 @param notificationInterval the number of samples between notifications emitted by the ringBuffer
 	 @param notificationOffset the number of samples after which the ringBuffer emits the first notification
 	 */
-	RingBufferAlgorithm(RingBuffer<SensorSample> * ringBuffer, UINT notificationInterval = 1,
+	BasicRingBufferAlgorithm(RingBuffer<T> * ringBuffer, UINT notificationInterval = 1,
 							  UINT notificationOffset = 0) : ringBuffer(ringBuffer),
-	notificationInterval(notificationInterval), notificationOffset(notificationOffset), notificationCount(0), notifyWhenFull(true) {
+	notificationInterval(notificationInterval), notificationOffset(notificationOffset), notificationCount(0), notifyWhenFull(true), numIndexedColumns(0), indexBlockSize(0) {
 		
 		if (notificationInterval < 1){
 			throw ARFException("RingBuffer::RingBuffer() notificationInterval should be bigger than 1");
@@ -92,9 +260,9 @@ public:
 	 @param notificationInterval the number of samples between notifications emitted by the ringBuffer
 	 @param notificationOffset the number of samples after which the ringBuffer emits the first notification
 	 */
-	RingBufferAlgorithm(UINT numElements, UINT notificationInterval = 1,
+	BasicRingBufferAlgorithm(UINT numElements, UINT notificationInterval = 1,
 							  UINT notificationOffset = 0) :
-	RingBufferAlgorithm(new RingBuffer<SensorSample>(numElements),notificationInterval,notificationOffset){
+	BasicRingBufferAlgorithm(new RingBuffer<T>(numElements),notificationInterval,notificationOffset){
 		
 		if (numElements == 0){
 			throw ARFException("RingBuffer::RingBuffer() numElements should not be zero");
@@ -112,32 +280,211 @@ public:
 	 */
 	Data* execute(Data* sample) override {
 		
-		//add the sample to the ring buffer
-		addSample((SensorSample*) sample);
+		if(addSampleAndNotify((const T*) sample, *ringBuffer, notificationCount, slidingStatistics)){
+			return GetOutput(getNotificationSample(*ringBuffer), outputSample)->clone();
+		}
+		return nullptr;
+	}
+	
+	/**
+	 Adds the input sample to the ring buffer without copying the output when the samples are SensorSamples. The output points to the sample stored in the ring buffer and remains valid until the ring buffer overwrites it. Other samples are copied to a SensorSample that remains valid until the next notification
+	 
+	 @param sample the sample to append to the ring buffer
+	 @param context the execution context. If it has a state block, the sample is added to the ring buffer of the current stream
+	 @return outputs the sample at index 'n - notificationOffset' where n is the
+	 index of the last element in the RingBuffer
+	 */
+	Data* execute(Data* sample, ExecutionContext & context) override {
 		
-		//check if an output should be produced
-		if(!notifyWhenFull || ringBuffer->isFull()){
-			notificationCount++;
-			if(notificationCount == notificationInterval){
-				notificationCount = 0;
-				
-				//check if there are enough samples in the buffer
-				if(notificationOffset < ringBuffer->getSize()) {
-					
-					return (Data*) getNotificationSample();
-				}
+		State * state = (State*) context.getState(this);
+		RingBuffer<T> & streamRingBuffer = (state == nullptr) ? *ringBuffer : state->ringBuffer;
+		UINT & streamNotificationCount = (state == nullptr) ? notificationCount : state->notificationCount;
+		std::vector<SlidingStatistics> & streamStatistics = (state == nullptr) ? slidingStatistics : state->slidingStatistics;
+		
+		if(addSampleAndNotify((const T*) sample, streamRingBuffer, streamNotificationCount, streamStatistics)){
+			return GetOutput(getNotificationSample(streamRingBuffer), (state == nullptr) ? outputSample : state->outputSample);
+		}
+		return nullptr;
+	}
+	
+	/**
+	 Retrieves the size of the state of a stream, which contains a ring buffer with the same capacity as the ring buffer of this algorithm
+	 
+	 @return the size of the state in bytes
+	 */
+	UINT getStateSize() const override {
+		return getStateHeaderSize() + ringBuffer->getCapacity() * sizeof(T);
+	}
+	
+	void initializeState(void * state) const override {
+		State * streamState = new (state) State(((char*) state) + getStateHeaderSize(), ringBuffer->getCapacity(), (UINT) trackedColumns.size());
+		if(numIndexedColumns > 0){
+			streamState->ringBuffer.createIndex(numIndexedColumns, indexBlockSize);
+		}
+	}
+	
+	void destroyState(void * state) const override {
+		((State*) state)->~State();
+	}
+	
+	/**
+	 Retrieves the ring buffer of the stream being executed
+	 
+	 @param context the execution context
+	 @return the ring buffer in the state block of the context, or the ring buffer of this algorithm if the context has no state block
+	 */
+	const RingBuffer<T> * getRingBuffer(const ExecutionContext & context) const{
+		State * state = (State*) context.getState(this);
+		return (state == nullptr) ? ringBuffer : &state->ringBuffer;
+	}
+	
+	const IterableValues * getIterable(const ExecutionContext & context) const override {
+		return getRingBuffer(context);
+	}
+	
+	/**
+	 Retrieves the ring buffer of this algorithm
+	 
+	 @return the ring buffer used when the algorithm is executed without a state block
+	 */
+	const RingBuffer<T> * getRingBuffer() const{
+		return ringBuffer;
+	}
+	
+	const IterableValues * getIterable() const override {
+		return ringBuffer;
+	}
+	
+	/**
+	 Keeps the statistics of a column up to date as samples are added. The samples already in the ring buffer are added to the statistics. The stream states initialized before the column is tracked do not track it, so their statistics of the column are NULL
+	 
+	 @param columnIdx the index of the column in the samples
+	 */
+	void trackColumn(UINT columnIdx) override {
+		if(getSlidingStatistics(columnIdx) != nullptr){
+			return;
+		}
+		SlidingStatistics statistics(ringBuffer->getCapacity());
+		for(UINT i = 0 ; i < ringBuffer->getSize() ; i++){
+			statistics.add(ringBuffer->getValue(i, columnIdx));
+		}
+		trackedColumns.push_back(columnIdx);
+		slidingStatistics.push_back(statistics);
+	}
+	
+	const SlidingStatistics * getSlidingStatistics(UINT columnIdx, const ExecutionContext & context) const override {
+		State * state = (State*) context.getState(this);
+		const std::vector<SlidingStatistics> & statistics = (state == nullptr) ? slidingStatistics : state->slidingStatistics;
+		
+		//the states initialized before the column was tracked have no statistics for it
+		for(UINT i = 0 ; i < statistics.size() ; i++){
+			if(trackedColumns[i] == columnIdx){
+				return &statistics[i];
 			}
 		}
 		return nullptr;
 	}
 	
+	const SlidingStatistics * getSlidingStatistics(UINT columnIdx) const override {
+		for(UINT i = 0 ; i < trackedColumns.size() ; i++){
+			if(trackedColumns[i] == columnIdx){
+				return &slidingStatistics[i];
+			}
+		}
+		return nullptr;
+	}
+	
+	/**
+	 Creates an index of block aggregates in the ring buffer, so that Mean, STD and Minimum compute their features over any DataSelector window of the ring buffer from the aggregates of its blocks (see RingBuffer::createIndex()). The ring buffers of the streams of a StreamRuntime created afterwards are indexed too
+	 
+	 @param numColumns the number of columns indexed, starting from the first column
+	 @param blockSize the number of samples in a block
+	 */
+	void createIndex(UINT numColumns, UINT blockSize = 32){
+		ringBuffer->createIndex(numColumns, blockSize);
+		numIndexedColumns = numColumns;
+		indexBlockSize = blockSize;
+	}
+	
+	/**
+	 Retrieves the columns whose statistics are tracked, followed by the indexed columns
+	 
+	 @param columnIndices set to the tracked and the indexed columns
+	 @return false if no column is tracked or indexed
+	 */
+	bool getColumnIndices(Vector<uint8_t> & columnIndices) const override {
+		columnIndices.resize((UINT) trackedColumns.size() + numIndexedColumns);
+		for(UINT i = 0 ; i < trackedColumns.size() ; i++){
+			columnIndices[i] = (uint8_t) trackedColumns[i];
+		}
+		for(UINT j = 0 ; j < numIndexedColumns ; j++){
+			columnIndices[(UINT) trackedColumns.size() + j] = (uint8_t) j;
+		}
+		return columnIndices.getSize() > 0;
+	}
+	
+	/**
+	 Replaces the tracked columns after the samples were projected. The indexed columns are the first columns of the samples, which remain the first columns of the projected samples since they are all kept, so the index is not modified. The ring buffer should not contain samples
+	 
+	 @param columnIndices the new tracked columns, followed by the indexed columns
+	 */
+	void setColumnIndices(const Vector<uint8_t> & columnIndices) override {
+		for(UINT i = 0 ; i < trackedColumns.size() ; i++){
+			trackedColumns[i] = columnIndices[i];
+		}
+	}
+	
+	/**
+	 Retrieves the ring buffer the samples are stored in, whose notification samples are output to the next algorithms
+	 
+	 @return the ring buffer of this algorithm
+	 */
+	const IterableValues * getSamplesIterable() const override {
+		return ringBuffer;
+	}
+	
 	/**
 	 Adds a sample to the ringBuffer
 	 
 	 @param sample the sample to append to the ring buffer
 	 */
-	void addSample(SensorSample *sample){
-		ringBuffer->add(*sample);
+	void addSample(const T *sample){
+		addSample(*sample, *ringBuffer, slidingStatistics);
+	}
+	
+	/**
+	 Moves the samples in a queue to the ringBuffer, without producing notifications like addSample(). The values are copied directly into the samples stored in the ring buffer. Should be called from the consumer thread of the queue
+	 
+	 @param queue the queue filled by the producer thread
+	 @param maxSamples the maximum number of samples to move
+	 @return the number of samples moved
+	 */
+	UINT addSamples(SampleQueue & queue, UINT maxSamples = UINT_MAX){
+		
+		UINT numChannels = queue.getNumChannels();
+		UINT numAdded = 0;
+		
+		//the samples are acquired in up to two parts when they wrap around the end of the queue
+		const Float * values;
+		UINT numSamples;
+		while(numAdded < maxSamples && (numSamples = queue.acquire(values, maxSamples - numAdded)) > 0){
+			for(UINT i = 0 ; i < numSamples ; i++){
+				const Float * sampleValues = values + (size_t) i * numChannels;
+				if(!slidingStatistics.empty()){
+					updateSlidingStatistics(*ringBuffer, slidingStatistics, [sampleValues](UINT columnIdx){
+						return sampleValues[columnIdx];
+					});
+				}
+				T & element = ringBuffer->addInPlace();
+				if(element.getSize() != numChannels && !element.resize(numChannels)){
+					throw ARFException("RingBufferAlgorithm::addSamples() the samples in the queue do not fit in the samples of the ring buffer");
+				}
+				std::copy(sampleValues, sampleValues + numChannels, element.begin());
+			}
+			queue.release(numSamples);
+			numAdded += numSamples;
+		}
+		return numAdded;
 	}
 	
 	/**
@@ -182,11 +529,13 @@ public:
 	 @param sampleIdx the index of the sensor sample you want
 	 @return the SensorSample
 	 */
-	SensorSample getElementAtIdx(UINT sampleIdx) const{
+	T getElementAtIdx(UINT sampleIdx) const{
 		return ringBuffer->getElementAtIdx(sampleIdx);
 	}
 };
 
+typedef BasicRingBufferAlgorithm<SensorSample> RingBufferAlgorithm;
+
 }
 
 #endif //ARF_RINGBUFFER_H
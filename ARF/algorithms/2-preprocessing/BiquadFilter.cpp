@@ -0,0 +1,273 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "BiquadFilter.h"
+#include "../4-featureExtraction/FeatureKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <math.h>
+#include <new>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARF_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace ARF {
+
+//the number of lanes of the widest SIMD register, the lanes are padded to a multiple of it
+static const UINT kLaneWidth = 8;
+
+typedef void (*FilterKernel)(const BiquadFilter::Section * sections, UINT numSections, Float * delays, Float * values, UINT numLanes);
+
+//the delays of a section are the first delay of every lane followed by the second delay of every lane, in transposed direct form II
+
+static void FilterScalar(const BiquadFilter::Section * sections, UINT numSections, Float * delays, Float * values, UINT numLanes){
+	for(UINT s = 0 ; s < numSections ; s++){
+		const BiquadFilter::Section & section = sections[s];
+		Float * z1 = delays + 2 * s * numLanes;
+		Float * z2 = z1 + numLanes;
+		for(UINT i = 0 ; i < numLanes ; i++){
+			Float x = values[i];
+			Float y = section.b0 * x + z1[i];
+			z1[i] = section.b1 * x - section.a1 * y + z2[i];
+			z2[i] = section.b2 * x - section.a2 * y;
+			values[i] = y;
+		}
+	}
+}
+
+#ifdef ARF_X86_KERNELS
+
+__attribute__((target("sse2")))
+static void FilterSSE2(const BiquadFilter::Section * sections, UINT numSections, Float * delays, Float * values, UINT numLanes){
+	for(UINT s = 0 ; s < numSections ; s++){
+		const BiquadFilter::Section & section = sections[s];
+		__m128 b0 = _mm_set1_ps(section.b0), b1 = _mm_set1_ps(section.b1), b2 = _mm_set1_ps(section.b2);
+		__m128 a1 = _mm_set1_ps(section.a1), a2 = _mm_set1_ps(section.a2);
+		Float * z1 = delays + 2 * s * numLanes;
+		Float * z2 = z1 + numLanes;
+		for(UINT i = 0 ; i < numLanes ; i += 4){
+			__m128 x = _mm_loadu_ps(values + i);
+			__m128 y = _mm_add_ps(_mm_mul_ps(b0, x), _mm_loadu_ps(z1 + i));
+			__m128 newZ1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), _mm_loadu_ps(z2 + i));
+			__m128 newZ2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+			_mm_storeu_ps(z1 + i, newZ1);
+			_mm_storeu_ps(z2 + i, newZ2);
+			_mm_storeu_ps(values + i, y);
+		}
+	}
+}
+
+__attribute__((target("avx2")))
+static void FilterAVX2(const BiquadFilter::Section * sections, UINT numSections, Float * delays, Float * values, UINT numLanes){
+	for(UINT s = 0 ; s < numSections ; s++){
+		const BiquadFilter::Section & section = sections[s];
+		__m256 b0 = _mm256_set1_ps(section.b0), b1 = _mm256_set1_ps(section.b1), b2 = _mm256_set1_ps(section.b2);
+		__m256 a1 = _mm256_set1_ps(section.a1), a2 = _mm256_set1_ps(section.a2);
+		Float * z1 = delays + 2 * s * numLanes;
+		Float * z2 = z1 + numLanes;
+		for(UINT i = 0 ; i < numLanes ; i += 8){
+			__m256 x = _mm256_loadu_ps(values + i);
+			__m256 y = _mm256_add_ps(_mm256_mul_ps(b0, x), _mm256_loadu_ps(z1 + i));
+			__m256 newZ1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(b1, x), _mm256_mul_ps(a1, y)), _mm256_loadu_ps(z2 + i));
+			__m256 newZ2 = _mm256_sub_ps(_mm256_mul_ps(b2, x), _mm256_mul_ps(a2, y));
+			_mm256_storeu_ps(z1 + i, newZ1);
+			_mm256_storeu_ps(z2 + i, newZ2);
+			_mm256_storeu_ps(values + i, y);
+		}
+	}
+}
+
+#endif
+
+/**
+ Retrieves the kernel of the instruction set selected for the feature kernels
+ */
+static FilterKernel GetFilterKernel(){
+#ifdef ARF_X86_KERNELS
+	UINT instructionSet = FeatureKernels::GetInstructionSet();
+	if(instructionSet == FeatureKernels::kAVX2){
+		return FilterAVX2;
+	} else if(instructionSet == FeatureKernels::kSSE2){
+		return FilterSSE2;
+	}
+#endif
+	return FilterScalar;
+}
+
+BiquadFilter::BiquadFilter(UINT filterType, UINT order, Float sampleRate, Float cutoff, const Vector<uint8_t> &columns, Float highCutoff) : columns(columns), minNumColumns(0) {
+	
+	if(filterType != kLowPass && filterType != kHighPass && filterType != kBandPass){
+		throw ARFException("BiquadFilter::BiquadFilter() invalid filter type");
+	}
+	if(order == 0 || order > kMaxOrder){
+		throw ARFException("BiquadFilter::BiquadFilter() order should be in [1 kMaxOrder]");
+	}
+	if(columns.getSize() == 0){
+		throw ARFException("BiquadFilter::BiquadFilter() at least one column should be filtered");
+	}
+	if(cutoff <= 0 || cutoff * 2 >= sampleRate){
+		throw ARFException("BiquadFilter::BiquadFilter() cutoff should be in (0 sampleRate/2)");
+	}
+	
+	if(filterType == kBandPass){
+		if(highCutoff <= cutoff || highCutoff * 2 >= sampleRate){
+			throw ARFException("BiquadFilter::BiquadFilter() highCutoff should be in (cutoff sampleRate/2)");
+		}
+		addSections(kHighPass, order, sampleRate, cutoff);
+		addSections(kLowPass, order, sampleRate, highCutoff);
+	} else {
+		addSections(filterType, order, sampleRate, cutoff);
+	}
+	
+	for(UINT i = 0 ; i < columns.getSize() ; i++){
+		minNumColumns = std::max(minNumColumns, columns[i] + 1u);
+	}
+	numLanes = (columns.getSize() + kLaneWidth - 1) / kLaneWidth * kLaneWidth;
+	ownedState.resize((getStateSize() + sizeof(double) - 1) / sizeof(double));
+	initializeState(ownedState.data());
+}
+
+BiquadFilter::~BiquadFilter(){
+	destroyState(ownedState.data());
+}
+
+void BiquadFilter::addSections(UINT filterType, UINT order, Float sampleRate, Float cutoff){
+	
+	double w0 = 2.0 * M_PI * cutoff / sampleRate;
+	double cosW0 = cos(w0);
+	
+	//the poles of a Butterworth filter of order n come in conjugate pairs with Q = 1 / (2 sin(pi (2k+1) / (2n)))
+	for(UINT k = 0 ; k < order / 2 ; k++){
+		double q = 1.0 / (2.0 * sin(M_PI * (2 * k + 1) / (2.0 * order)));
+		double alpha = sin(w0) / (2.0 * q);
+		double a0 = 1.0 + alpha;
+		double b1 = (filterType == kLowPass) ? 1.0 - cosW0 : -(1.0 + cosW0);
+		double b0 = fabs(b1) / 2.0;
+		
+		Section section;
+		section.b0 = (Float) (b0 / a0);
+		section.b1 = (Float) (b1 / a0);
+		section.b2 = (Float) (b0 / a0);
+		section.a1 = (Float) (-2.0 * cosW0 / a0);
+		section.a2 = (Float) ((1.0 - alpha) / a0);
+		sections.push_back(section);
+	}
+	
+	//an odd order has a real pole, implemented as a first order section
+	if(order % 2 == 1){
+		double k = tan(w0 / 2.0);
+		double gain = (filterType == kLowPass) ? k / (1.0 + k) : 1.0 / (1.0 + k);
+		
+		Section section;
+		section.b0 = (Float) gain;
+		section.b1 = (Float) ((filterType == kLowPass) ? gain : -gain);
+		section.b2 = 0;
+		section.a1 = (Float) ((k - 1.0) / (k + 1.0));
+		section.a2 = 0;
+		sections.push_back(section);
+	}
+}
+
+UINT BiquadFilter::getStateSize() const{
+	return sizeof(State) + (2 * sections.size() + 1) * numLanes * sizeof(Float);
+}
+
+void BiquadFilter::initializeState(void * state) const{
+	State * filterState = new (state) State();
+	memset(filterState->getValues(), 0, (2 * sections.size() + 1) * numLanes * sizeof(Float));
+}
+
+void BiquadFilter::destroyState(void * state) const{
+	((State*) state)->~State();
+}
+
+void BiquadFilter::reset(){
+	destroyState(ownedState.data());
+	initializeState(ownedState.data());
+}
+
+void BiquadFilter::filterSample(const SensorSample & input, SensorSample & output, State & state) const{
+	
+	if(input.getSize() < minNumColumns){
+		throw ARFException("BiquadFilter::filterSample() the sample does not have the filtered columns");
+	}
+	
+	Float * delays = state.getValues();
+	Float * values = delays + 2 * sections.size() * numLanes;
+	UINT numColumns = columns.getSize();
+	for(UINT i = 0 ; i < numColumns ; i++){
+		values[i] = input[columns[i]];
+	}
+	
+	GetFilterKernel()(sections.data(), (UINT) sections.size(), delays, values, numLanes);
+	
+	if(&output != &input){
+		output = input;
+	}
+	for(UINT i = 0 ; i < numColumns ; i++){
+		output[columns[i]] = values[i];
+	}
+}
+
+BiquadFilter::State & BiquadFilter::getState(ExecutionContext & context){
+	State * streamState = (State*) context.getState(this);
+	return (streamState == nullptr) ? *(State*) ownedState.data() : *streamState;
+}
+
+void BiquadFilter::filter(SensorSample * samples, UINT numSamples){
+	State & state = *(State*) ownedState.data();
+	for(UINT i = 0 ; i < numSamples ; i++){
+		filterSample(samples[i], samples[i], state);
+	}
+}
+
+Data* BiquadFilter::execute(Data * data) {
+	SensorSample * output = new SensorSample();
+	filterSample(*(SensorSample*) data, *output, *(State*) ownedState.data());
+	return output;
+}
+
+Data* BiquadFilter::execute(Data * data, ExecutionContext & context) {
+	State & state = getState(context);
+	filterSample(*(SensorSample*) data, state.output, state);
+	return &state.output;
+}
+
+bool BiquadFilter::supportsBatch() const {
+	return true;
+}
+
+void BiquadFilter::executeBatch(Data** input, Data** output, UINT numInputs, ExecutionContext & context) {
+	State & state = getState(context);
+	SensorSample * outputs = context.getArena().createArray<SensorSample>(numInputs);
+	
+	for(UINT i = 0 ; i < numInputs ; i++){
+		if(input[i] == nullptr){
+			output[i] = nullptr;
+		} else {
+			filterSample(*(SensorSample*) input[i], outputs[i], state);
+			output[i] = &outputs[i];
+		}
+	}
+}
+
+}
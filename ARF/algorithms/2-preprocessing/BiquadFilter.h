@@ -0,0 +1,167 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief This preprocessing algorithm filters selected columns of every SensorSample with a Butterworth low-pass, high-pass or band-pass filter, implemented as a cascade of biquad sections. The selected columns are filtered together, one column per SIMD lane. The state of the filter belongs to the stream being executed, and blocks of samples can be filtered at once in a PipelinePlan or offline
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#ifndef ARF_BIQUAD_FILTER_H
+#define ARF_BIQUAD_FILTER_H
+
+#include "../core/Algorithm.h"
+#include "../../utils/ARFTypedefs.h"
+#include "../../dataStructures/Vector.h"
+#include <vector>
+
+namespace ARF {
+
+class BiquadFilter : public Algorithm {
+	
+public:
+	
+	//the types of filters
+	static const UINT kLowPass = 0;
+	static const UINT kHighPass = 1;
+	static const UINT kBandPass = 2; ///< A high-pass filter followed by a low-pass filter of the same order
+	
+	//the maximum order of the low-pass and high-pass filters
+	static const UINT kMaxOrder = 8;
+	
+	/**
+	 The coefficients of a biquad section, normalized so that a0 = 1
+	 */
+	struct Section {
+		Float b0, b1, b2, a1, a2;
+	};
+	
+private:
+	
+	/**
+	 The header of the state of a stream. It is followed by the two delays of every section for every lane, and by the values of the lanes
+	 */
+	struct State {
+		SensorSample output; ///< The last filtered sample of the stream
+		
+		Float * getValues(){
+			return (Float*) (this + 1);
+		}
+	};
+	
+	Vector<uint8_t> columns; ///< The columns of the samples that are filtered
+	UINT minNumColumns; ///< The number of columns the samples should have at least
+	UINT numLanes; ///< The number of columns filtered, rounded up to the width of the widest SIMD register
+	std::vector<Section> sections; ///< The sections of the filter, applied in order
+	std::vector<double> ownedState; ///< The memory of the state used when the algorithm is executed without a state block
+	
+	/**
+	 Appends the sections of a Butterworth low-pass or high-pass filter
+	 */
+	void addSections(UINT filterType, UINT order, Float sampleRate, Float cutoff);
+	
+	/**
+	 Filters the selected columns of a sample
+	 
+	 @param input the sample
+	 @param output the filtered sample, which can be the input sample
+	 @param state the state of the stream
+	 */
+	void filterSample(const SensorSample & input, SensorSample & output, State & state) const;
+	
+	State & getState(ExecutionContext & context);
+	
+	BiquadFilter(const BiquadFilter &rhs);
+	BiquadFilter& operator=(const BiquadFilter &rhs);
+	
+public:
+	
+	/**
+	 Main constructor. The coefficients of the filter are computed with the bilinear transform, prewarped at the cutoff frequencies
+	 
+	 @param filterType kLowPass, kHighPass or kBandPass
+	 @param order the order of the Butterworth filter in [1 kMaxOrder], for a band-pass filter the order of its high-pass and of its low-pass filters
+	 @param sampleRate the sampling rate of the samples in Hz
+	 @param cutoff the cutoff frequency in Hz of low-pass and high-pass filters, or the lower cutoff frequency of a band-pass filter
+	 @param columns the columns of the samples that are filtered, the other columns are copied
+	 @param highCutoff the upper cutoff frequency of a band-pass filter in Hz
+	 */
+	BiquadFilter(UINT filterType, UINT order, Float sampleRate, Float cutoff, const Vector<uint8_t> &columns, Float highCutoff = 0);
+	
+	~BiquadFilter();
+	
+	const std::vector<Section> & getSections() const{
+		return sections;
+	}
+	
+	/**
+	 Filters an array of samples in place and in order, continuing from the samples filtered before without a state block. It can be used to filter the samples of a DataSet offline
+	 
+	 @param samples the samples
+	 @param numSamples the number of samples
+	 */
+	void filter(SensorSample * samples, UINT numSamples);
+	
+	/**
+	 Clears the state used when the algorithm is executed without a state block
+	 */
+	void reset();
+	
+	/**
+	 Filters a SensorSample
+	 
+	 @param data A SensorSample
+	 @return A SensorSample with the filtered columns
+	 */
+	Data* execute(Data * data) override;
+	
+	/**
+	 Filters a SensorSample with the state of the stream being executed
+	 
+	 @param data A SensorSample
+	 @param context the execution context
+	 @return A SensorSample with the filtered columns, which belongs to the stream and remains valid until the algorithm is executed again for the stream
+	 */
+	Data* execute(Data * data, ExecutionContext & context) override;
+	
+	/**
+	 The samples of a block are filtered in order, so blocks can be processed at once
+	 
+	 @return true
+	 */
+	bool supportsBatch() const override;
+	
+	/**
+	 Filters a block of SensorSamples in order. The outputs are allocated from the execution context, so blocks of different streams and contexts do not share them
+	 
+	 @param input the SensorSamples, which can be NULL pointers
+	 @param output the filtered SensorSamples, or NULL pointers for NULL inputs
+	 @param numInputs the number of SensorSamples
+	 @param context the execution context
+	 */
+	void executeBatch(Data** input, Data** output, UINT numInputs, ExecutionContext & context) override;
+	
+	UINT getStateSize() const override;
+	void initializeState(void * state) const override;
+	void destroyState(void * state) const override;
+};
+
+}
+
+#endif //ARF_BIQUAD_FILTER_H
@@ -23,6 +23,7 @@
 #include "../../dataStructures/Data.h"
 #include "../../dataStructures/Matrix.h"
 #include "../../dataStructures/DataIterator.h"
+#include <algorithm>
 #include <cmath>
 
 namespace ARF {
@@ -30,14 +31,86 @@ namespace ARF {
 /**
  Computes the magnitude of a sample with 3 axes
  
- @param data A vector of floats with exactly three components
+ @param signal A Signal with exactly three components
  @return The magnitude of the input vector
  */
-Data* Magnitude::execute(Data * data) {
-	const DataIterator& signal = *(DataIterator*) data;
-	Float result = std::sqrt(signal[0] * signal[0] + signal[1] * signal[1] + signal[2] * signal[2]);
+template <typename Math>
+Float BasicMagnitude<Math>::Compute(const Signal & signal) {
+	return Math::Sqrt(signal[0] * signal[0] + signal[1] * signal[1] + signal[2] * signal[2]);
+}
+
+template <typename Math>
+void BasicMagnitude<Math>::ComputeBlock(const Signal & signal, Float * magnitudes, UINT squareRoot) {
+	UINT numRows = signal.getNumRows();
+	UINT numColumns = signal.getNumColumns();
+	
+	//the column indices are 8 bits
+	StridedSpan spans[256];
+	bool hasSpans[256];
+	bool contiguous = (numColumns > 0);
+	for(UINT c = 0 ; c < numColumns ; c++){
+		hasSpans[c] = signal.getColumnSpan(c, spans[c]);
+		contiguous = contiguous && hasSpans[c] && spans[c].stride == 1;
+	}
 	
-	return new Value(result);
+	if(!contiguous){
+		//the strided columns, like the ones of row-major samples, are copied into blocks of consecutive values, so that they are processed by the same kernels as the contiguous columns
+		static const UINT kGatherSize = 1024;
+		Float values[kGatherSize];
+		const Float * columns[256];
+		UINT blockSize = std::max(kGatherSize / std::max(numColumns, 1u), 1u);
+		for(UINT c = 0 ; c < numColumns ; c++){
+			columns[c] = values + c * blockSize;
+		}
+		for(UINT rowIdx = 0 ; rowIdx < numRows ; rowIdx += blockSize){
+			UINT numBlockRows = std::min(blockSize, numRows - rowIdx);
+			for(UINT c = 0 ; c < numColumns ; c++){
+				Float * column = values + c * blockSize;
+				if(hasSpans[c]){
+					for(UINT i = 0 ; i < numBlockRows ; i++){
+						column[i] = spans[c][rowIdx + i];
+					}
+				} else {
+					for(UINT i = 0 ; i < numBlockRows ; i++){
+						column[i] = signal(rowIdx + i, c);
+					}
+				}
+			}
+			FeatureKernels::Magnitudes(columns, numColumns, numBlockRows, magnitudes + rowIdx, squareRoot);
+		}
+		return;
+	}
+	
+	//the columns can wrap around the end of their storage at different rows, so the rows are processed in blocks where every column is consecutive
+	const Float * columns[256];
+	UINT rowIdx = 0;
+	while(rowIdx < numRows){
+		UINT endRow = numRows;
+		for(UINT c = 0 ; c < numColumns ; c++){
+			if(rowIdx < spans[c].firstSize){
+				columns[c] = spans[c].first + rowIdx;
+				endRow = std::min(endRow, spans[c].firstSize);
+			} else {
+				columns[c] = spans[c].second + (rowIdx - spans[c].firstSize);
+			}
+		}
+		FeatureKernels::Magnitudes(columns, numColumns, endRow - rowIdx, magnitudes + rowIdx, squareRoot);
+		rowIdx = endRow;
+	}
 }
 
+template <typename Math>
+Data* BasicMagnitude<Math>::execute(Data * data) {
+	return new Value(Compute(*(Signal*) data));
+}
+
+template <typename Math>
+Data* BasicMagnitude<Math>::execute(Data * data, ExecutionContext & context) {
+	return context.create<Value>(Compute(*(Signal*) data));
+}
+
+template class BasicMagnitude<ExactMath>;
+template class BasicMagnitude<FastMath>;
+template class BasicMagnitude<TableMath>;
+
 }
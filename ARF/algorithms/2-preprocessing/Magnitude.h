@@ -28,14 +28,41 @@
 
 #include "../core/Algorithm.h"
 #include "../../utils/ARFTypedefs.h"
+#include "../../utils/MathPolicies.h"
+#include "../4-featureExtraction/FeatureKernels.h"
 
 namespace ARF {
 
-class Magnitude : public Algorithm {
+/**
+ The magnitude with the square roots computed by a math policy: ExactMath, FastMath or TableMath
+ */
+template <typename Math>
+class BasicMagnitude : public Algorithm {
 public:
+	
+	/**
+	 Computes the magnitude of a sample with 3 axes
+	 
+	 @param signal A Signal with exactly three components
+	 @return The magnitude of the input vector
+	 */
+	static Float Compute(const Signal & signal);
+	
+	/**
+	 Computes the magnitude of every row of a Signal with any number of columns into a contiguous array, for example over a whole recording. Every row is computed by FeatureKernels::Magnitudes(), so the magnitudes do not depend on the storage of the Signal. Columns stored contiguously, like the columns of a ColumnRingBuffer or of a Vector of Floats, are read in place, the other columns, like the ones of a RingBuffer of samples, are copied in blocks first. The magnitudes can be read by the feature extractors through a Signal over a Vector of Floats, and by PeakDetector::detectPeaks()
+	 
+	 @param signal the Signal, with one or more columns
+	 @param magnitudes set to the magnitude of every row of the Signal, should have space for signal.getNumRows() values
+	 @param squareRoot FeatureKernels::kExactSquareRoot, kRefinedSquareRoot or kApproximateSquareRoot. By default the exact square root for ExactMath and the refined reciprocal square root otherwise
+	 */
+	static void ComputeBlock(const Signal & signal, Float * magnitudes, UINT squareRoot = Math::kExact ? FeatureKernels::kExactSquareRoot : FeatureKernels::kRefinedSquareRoot);
+	
 	Data* execute(Data * data) override;
+	Data* execute(Data * data, ExecutionContext & context) override;
 };
 
+typedef BasicMagnitude<ExactMath> Magnitude;
+
 }
 
 #endif //ARF_MAGNITUDE_H
@@ -0,0 +1,148 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Resampler.h"
+#include "../4-featureExtraction/FeatureKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <math.h>
+#include <new>
+
+namespace ARF {
+
+Resampler::Resampler(UINT interpolation, UINT decimation, const Vector<uint8_t> &columns, UINT numZeroCrossings) : interpolation(interpolation), decimation(decimation), columns(columns), minNumColumns(0) {
+	
+	if(interpolation == 0 || decimation < interpolation){
+		throw ARFException("Resampler::Resampler() the interpolation should be at least 1 and not greater than the decimation");
+	}
+	if(columns.getSize() == 0){
+		throw ARFException("Resampler::Resampler() at least one column should be resampled");
+	}
+	if(numZeroCrossings == 0){
+		throw ARFException("Resampler::Resampler() numZeroCrossings should be greater than 0");
+	}
+	
+	for(UINT i = 0 ; i < columns.getSize() ; i++){
+		minNumColumns = std::max(minNumColumns, columns[i] + 1u);
+	}
+	
+	//the filter is designed at the upsampled rate, its length is rounded up to a multiple of the number of phases
+	UINT numTaps = 2 * numZeroCrossings * decimation;
+	numTapsPerPhase = (numTaps + interpolation - 1) / interpolation;
+	numTaps = numTapsPerPhase * interpolation;
+	double cutoff = 0.9 * 0.5 / decimation;
+	double center = (numTaps - 1) / 2.0;
+	
+	std::vector<double> coefficients(numTaps);
+	for(UINT n = 0 ; n < numTaps ; n++){
+		double x = 2.0 * cutoff * (n - center);
+		double sinc = (x == 0.0) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+		double window = 0.42 - 0.5 * cos(2.0 * M_PI * (n + 0.5) / numTaps) + 0.08 * cos(4.0 * M_PI * (n + 0.5) / numTaps);
+		coefficients[n] = sinc * window;
+	}
+	
+	//every phase is normalized to a gain of 1 at 0 Hz, so that a constant input produces the same constant. The coefficient k of a phase is applied to the input k samples before the last one, so it is stored at numTapsPerPhase-1-k to be applied to the history from oldest to newest
+	phases.resize(numTaps);
+	for(UINT p = 0 ; p < interpolation ; p++){
+		double sum = 0.0;
+		for(UINT k = 0 ; k < numTapsPerPhase ; k++){
+			sum += coefficients[p + k * interpolation];
+		}
+		for(UINT k = 0 ; k < numTapsPerPhase ; k++){
+			phases[p * numTapsPerPhase + numTapsPerPhase - 1 - k] = (Float) (coefficients[p + k * interpolation] / sum);
+		}
+	}
+	
+	ownedState.resize((getStateSize() + sizeof(double) - 1) / sizeof(double));
+	initializeState(ownedState.data());
+}
+
+Resampler::~Resampler(){
+	destroyState(ownedState.data());
+}
+
+UINT Resampler::getStateSize() const{
+	return sizeof(State) + 2 * numTapsPerPhase * columns.getSize() * sizeof(Float);
+}
+
+void Resampler::initializeState(void * state) const{
+	State * resamplerState = new (state) State();
+	resamplerState->position = 0;
+	resamplerState->outputOffset = 0;
+	memset(resamplerState->getHistory(), 0, 2 * numTapsPerPhase * columns.getSize() * sizeof(Float));
+}
+
+void Resampler::destroyState(void * state) const{
+	((State*) state)->~State();
+}
+
+void Resampler::reset(){
+	destroyState(ownedState.data());
+	initializeState(ownedState.data());
+}
+
+bool Resampler::resample(const SensorSample & input, State & state) const{
+	
+	if(input.getSize() < minNumColumns){
+		throw ARFException("Resampler::resample() the sample does not have the resampled columns");
+	}
+	
+	//the history of every column is written twice, so that its last numTapsPerPhase values are contiguous
+	UINT numColumns = columns.getSize();
+	UINT historySize = 2 * numTapsPerPhase;
+	Float * history = state.getHistory();
+	for(UINT i = 0 ; i < numColumns ; i++){
+		Float value = input[columns[i]];
+		history[i * historySize + state.position] = value;
+		history[i * historySize + state.position + numTapsPerPhase] = value;
+	}
+	state.position = (state.position + 1 == numTapsPerPhase) ? 0 : state.position + 1;
+	
+	//the next output is at the upsampled index of this input plus outputOffset
+	UINT offset = state.outputOffset;
+	bool hasOutput = (offset < interpolation);
+	state.outputOffset = (hasOutput ? offset + decimation : offset) - interpolation;
+	if(!hasOutput){
+		return false;
+	}
+	
+	//the phase of the output is its offset from the input
+	const Float * coefficients = phases.data() + offset * numTapsPerPhase;
+	state.output = input;
+	for(UINT i = 0 ; i < numColumns ; i++){
+		state.output[columns[i]] = FeatureKernels::DotProduct(history + i * historySize + state.position, coefficients, numTapsPerPhase);
+	}
+	return true;
+}
+Data* Resampler::execute(Data * data) {
+	State & state = *(State*) ownedState.data();
+	if(!resample(*(SensorSample*) data, state)){
+		return nullptr;
+	}
+	return new SensorSample(state.output);
+}
+
+Data* Resampler::execute(Data * data, ExecutionContext & context) {
+	State * streamState = (State*) context.getState(this);
+	State & state = (streamState == nullptr) ? *(State*) ownedState.data() : *streamState;
+	return resample(*(SensorSample*) data, state) ? &state.output : nullptr;
+}
+
+}
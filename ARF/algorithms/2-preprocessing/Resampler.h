@@ -0,0 +1,120 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief This preprocessing algorithm reduces the sampling rate of a stream of SensorSamples by a rational factor L/M with a polyphase FIR filter, which removes the frequencies above the new Nyquist frequency before the samples are dropped. It outputs a SensorSample only for the inputs that complete an output sample and NULL otherwise, so the algorithms after it are executed at the lower rate
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#ifndef ARF_RESAMPLER_H
+#define ARF_RESAMPLER_H
+
+#include "../core/Algorithm.h"
+#include "../../utils/ARFTypedefs.h"
+#include "../../dataStructures/Vector.h"
+#include <vector>
+
+namespace ARF {
+
+class Resampler : public Algorithm {
+	
+private:
+	
+	/**
+	 The header of the state of a stream. It is followed by the last numTapsPerPhase values of every resampled column, stored twice so that they can be read contiguously from oldest to newest
+	 */
+	struct State {
+		SensorSample output; ///< The last output sample of the stream
+		UINT position; ///< The row of the oldest value in the history
+		UINT outputOffset; ///< The distance from the last input to the next output, at the upsampled rate
+		
+		Float * getHistory(){
+			return (Float*) (this + 1);
+		}
+	};
+	
+	UINT interpolation; ///< L, the factor the samples are upsampled by
+	UINT decimation; ///< M, the factor the upsampled samples are downsampled by
+	Vector<uint8_t> columns; ///< The columns of the samples that are resampled
+	UINT minNumColumns; ///< The number of columns the samples should have at least
+	UINT numTapsPerPhase; ///< The number of coefficients of the filter applied to the input samples for every output
+	std::vector<Float> phases; ///< The coefficients of the filter of every phase, in the order they are applied to the inputs from oldest to newest
+	std::vector<double> ownedState; ///< The memory of the state used when the algorithm is executed without a state block
+	
+	Resampler(const Resampler &rhs);
+	Resampler& operator=(const Resampler &rhs);
+	
+	/**
+	 Adds a sample to the history of a stream and computes an output sample if the input completes it
+	 
+	 @param input the sample
+	 @param state the state of the stream
+	 @return true if state.output contains a new output sample
+	 */
+	bool resample(const SensorSample & input, State & state) const;
+	
+public:
+	
+	/**
+	 Main constructor. The filter is a Blackman windowed sinc with its cutoff at 90% of the lower of the two Nyquist frequencies
+	 
+	 @param interpolation L, the factor the samples are upsampled by, at least 1
+	 @param decimation M, the factor the upsampled samples are downsampled by, not smaller than L so that every input produces at most one output
+	 @param columns the columns of the samples that are resampled. The other columns are copied from the last input sample
+	 @param numZeroCrossings the number of zero crossings of the sinc on each side, the filter has 2 * numZeroCrossings * M coefficients at the upsampled rate. Larger values make the transition band narrower
+	 */
+	Resampler(UINT interpolation, UINT decimation, const Vector<uint8_t> &columns, UINT numZeroCrossings = 8);
+	
+	~Resampler();
+	
+	UINT getNumTapsPerPhase() const{
+		return numTapsPerPhase;
+	}
+	
+	/**
+	 Clears the state used when the algorithm is executed without a state block
+	 */
+	void reset();
+	
+	/**
+	 Adds a SensorSample to the resampler
+	 
+	 @param data A SensorSample
+	 @return A new SensorSample at the output rate, or NULL if the input does not complete an output sample
+	 */
+	Data* execute(Data * data) override;
+	
+	/**
+	 Adds a SensorSample to the resampler of the stream being executed
+	 
+	 @param data A SensorSample
+	 @param context the execution context
+	 @return A SensorSample at the output rate, which belongs to the stream and remains valid until the algorithm is executed again for the stream, or NULL if the input does not complete an output sample
+	 */
+	Data* execute(Data * data, ExecutionContext & context) override;
+	
+	UINT getStateSize() const override;
+	void initializeState(void * state) const override;
+	void destroyState(void * state) const override;
+};
+
+}
+
+#endif //ARF_RESAMPLER_H
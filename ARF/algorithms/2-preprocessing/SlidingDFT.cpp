@@ -0,0 +1,157 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SlidingDFT.h"
+#include "../../dataStructures/Value.h"
+#include "../../dataStructures/DataIterator.h"
+#include <cstring>
+#include <math.h>
+
+namespace ARF {
+
+/**
+ Retrieves the factor of the power of a frequency, which counts the power of the negative frequency as well except at 0 Hz and at the Nyquist frequency. The powers have the same scale as the band powers of SpectralFeatures
+ */
+static double GetScale(Float frequency, Float sampleRate, UINT windowSize){
+	bool isEdge = (frequency == 0 || frequency * 2 == sampleRate);
+	return (isEdge ? 1.0 : 2.0) / windowSize;
+}
+
+SlidingDFT::SlidingDFT(UINT windowSize, Float sampleRate, const Vector<Float> &frequencies, UINT output, double damping) : windowSize(windowSize), sampleRate(sampleRate), frequencies(frequencies), output(output), damping(damping) {
+	
+	if(windowSize == 0){
+		throw ARFException("SlidingDFT::SlidingDFT() windowSize should be greater than 0");
+	}
+	if(frequencies.getSize() == 0){
+		throw ARFException("SlidingDFT::SlidingDFT() at least one frequency should be tracked");
+	}
+	if(output != kTotalPower && output != kPowers){
+		throw ARFException("SlidingDFT::SlidingDFT() invalid output");
+	}
+	if(!(damping > 0 && damping <= 1)){
+		throw ARFException("SlidingDFT::SlidingDFT() damping should be in (0 1]");
+	}
+	
+	UINT numFrequencies = frequencies.getSize();
+	rotations.resize(2 * numFrequencies);
+	tailRotations.resize(2 * numFrequencies);
+	scales.resize(numFrequencies);
+	double tailDamping = pow(damping, (double) windowSize);
+	
+	for(UINT i = 0 ; i < numFrequencies ; i++){
+		if(frequencies[i] < 0 || frequencies[i] * 2 > sampleRate){
+			throw ARFException("SlidingDFT::SlidingDFT() frequencies should be in [0 sampleRate/2]");
+		}
+		
+		//the angle of the tail is reduced before computing its sine, which is more accurate than multiplying the rotation windowSize times
+		double angle = 2.0 * M_PI * frequencies[i] / sampleRate;
+		double tailAngle = fmod(angle * windowSize, 2.0 * M_PI);
+		rotations[2 * i] = damping * cos(angle);
+		rotations[2 * i + 1] = damping * sin(angle);
+		tailRotations[2 * i] = tailDamping * cos(tailAngle);
+		tailRotations[2 * i + 1] = tailDamping * sin(tailAngle);
+		scales[i] = GetScale(frequencies[i], sampleRate, windowSize);
+	}
+	
+	ownedState.resize((getStateSize() + sizeof(double) - 1) / sizeof(double));
+	initializeState(ownedState.data());
+}
+
+UINT SlidingDFT::getStateSize() const{
+	return sizeof(State) + 2 * frequencies.getSize() * sizeof(double) + windowSize * sizeof(Float);
+}
+
+void SlidingDFT::initializeState(void * state) const{
+	memset(state, 0, getStateSize());
+}
+
+Float SlidingDFT::update(Float value, void * state, Float * powers) const{
+	
+	State * header = (State*) state;
+	double * dfts = (double*) (header + 1);
+	Float * history = (Float*) (dfts + 2 * frequencies.getSize());
+	
+	//the value received windowSize samples ago leaves the window, zero until the window is full
+	double oldestValue = history[header->position];
+	history[header->position] = value;
+	header->position = (header->position + 1 == windowSize) ? 0 : header->position + 1;
+	
+	//S[n] = r*e^(iw) * S[n-1] + x[n] - r^N*e^(iwN) * x[n-N]
+	double totalPower = 0.0;
+	for(UINT i = 0 ; i < frequencies.getSize() ; i++){
+		double re = dfts[2 * i], im = dfts[2 * i + 1];
+		double wr = rotations[2 * i], wi = rotations[2 * i + 1];
+		double newRe = re * wr - im * wi + value - tailRotations[2 * i] * oldestValue;
+		double newIm = re * wi + im * wr - tailRotations[2 * i + 1] * oldestValue;
+		dfts[2 * i] = newRe;
+		dfts[2 * i + 1] = newIm;
+		
+		double power = scales[i] * (newRe * newRe + newIm * newIm);
+		totalPower += power;
+		if(powers != nullptr){
+			powers[i] = (Float) power;
+		}
+	}
+	return (Float) totalPower;
+}
+
+Float SlidingDFT::Compute(const Signal & signal, UINT windowSize, Float sampleRate, Float frequency, double damping){
+	
+	UINT n = signal.getSize();
+	UINT numValues = (n < windowSize) ? n : windowSize;
+	double angle = 2.0 * M_PI * frequency / sampleRate;
+	
+	//the newest value has the angle 0 and the weight 1
+	double re = 0.0, im = 0.0, weight = 1.0;
+	for(UINT m = 0 ; m < numValues ; m++){
+		double value = signal[n - 1 - m];
+		re += weight * cos(angle * m) * value;
+		im += weight * sin(angle * m) * value;
+		weight *= damping;
+	}
+	return (Float) (GetScale(frequency, sampleRate, windowSize) * (re * re + im * im));
+}
+
+Data* SlidingDFT::execute(Data * data) {
+	Float value = ((Value*) data)->getValue();
+	if(output == kPowers){
+		FeatureVector * powers = new FeatureVector(frequencies.getSize());
+		update(value, ownedState.data(), &(*powers)[0]);
+		return powers;
+	}
+	return new Value(update(value, ownedState.data(), nullptr));
+}
+
+Data* SlidingDFT::execute(Data * data, ExecutionContext & context) {
+	void * state = context.getState(this);
+	if(state == nullptr){
+		state = ownedState.data();
+	}
+	
+	Float value = ((Value*) data)->getValue();
+	if(output == kPowers){
+		FeatureVector * powers = context.create<FeatureVector>(frequencies.getSize());
+		update(value, state, &(*powers)[0]);
+		return powers;
+	}
+	return context.create<Value>(update(value, state, nullptr));
+}
+
+}
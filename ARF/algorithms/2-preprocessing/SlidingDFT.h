@@ -0,0 +1,130 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief This preprocessing algorithm tracks the power of a few frequencies over the last samples of a stream of Values with a sliding DFT, updated in O(k) operations per sample for k frequencies. Its output can be passed to a PeakDetector to detect when the power of the frequencies rises
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#ifndef ARF_SLIDING_DFT_H
+#define ARF_SLIDING_DFT_H
+
+#include "../core/Algorithm.h"
+#include "../../utils/ARFTypedefs.h"
+#include "../../dataStructures/Vector.h"
+#include <vector>
+
+namespace ARF {
+
+class SlidingDFT : public Algorithm {
+	
+public:
+	
+	//the outputs of the algorithm
+	static const UINT kTotalPower = 0; ///< A Value with the sum of the power of the frequencies
+	static const UINT kPowers = 1; ///< A FeatureVector with the power of every frequency
+	
+private:
+	
+	/**
+	 The header of the state of a stream. The DFT of every frequency follows it as the real and imaginary parts in double precision, followed by the last windowSize values of the stream
+	 */
+	struct State {
+		UINT position; ///< The index of the oldest value in the history of the stream
+		UINT padding[3]; ///< Keeps the DFTs aligned to 16 bytes
+	};
+	
+	UINT windowSize; ///< The number of values the DFTs are computed over
+	Float sampleRate; ///< The sampling rate of the Values in Hz
+	Vector<Float> frequencies; ///< The frequencies tracked in Hz
+	UINT output; ///< kTotalPower or kPowers
+	double damping; ///< The factor the DFTs are multiplied by on every sample, which makes the errors of the updates decay
+	std::vector<double> rotations; ///< damping * e^(i*w) for every frequency, interleaved
+	std::vector<double> tailRotations; ///< damping^windowSize * e^(i*w*windowSize) for every frequency, interleaved
+	std::vector<double> scales; ///< The factor of the power of every frequency
+	std::vector<double> ownedState; ///< The state used when the algorithm is executed without a state block
+	
+	/**
+	 Adds a value to the DFTs of a stream and removes the oldest value
+	 
+	 @param value the new value of the stream
+	 @param state the state of the stream
+	 @param powers set to the power of every frequency after the update, unless it is NULL
+	 @return the sum of the power of the frequencies
+	 */
+	Float update(Float value, void * state, Float * powers) const;
+	
+public:
+	
+	/**
+	 Main constructor
+	 
+	 @param windowSize the number of values the DFTs are computed over
+	 @param sampleRate the sampling rate of the Values in Hz
+	 @param frequencies the frequencies that will be tracked in Hz, in [0 sampleRate/2]
+	 @param output kTotalPower or kPowers
+	 @param damping a factor in (0 1] the DFTs are multiplied by on every sample. Values slightly below 1 bound the rounding errors accumulated over long streams, at the cost of weighting the value received m samples ago by damping^m
+	 */
+	SlidingDFT(UINT windowSize, Float sampleRate, const Vector<Float> &frequencies, UINT output = kTotalPower, double damping = 0.999999);
+	
+	UINT getWindowSize() const{
+		return windowSize;
+	}
+	
+	const Vector<Float> & getFrequencies() const{
+		return frequencies;
+	}
+	
+	/**
+	 Computes the power of a frequency over the last values of a Signal directly, with the same weights and scale as the sliding DFT
+	 
+	 @param signal A Signal whose last windowSize values are used, or all of them if it has fewer
+	 @param windowSize the number of values the DFT is computed over
+	 @param sampleRate the sampling rate of the Signal in Hz
+	 @param frequency the frequency in Hz
+	 @param damping the damping of the sliding DFT
+	 @return the power of the frequency
+	 */
+	static Float Compute(const Signal & signal, UINT windowSize, Float sampleRate, Float frequency, double damping = 0.999999);
+	
+	/**
+	 Adds a Value to the sliding DFTs
+	 
+	 @param data A Value
+	 @return A Value with the sum of the power of the frequencies, or a FeatureVector with the power of every frequency
+	 */
+	Data* execute(Data * data) override;
+	
+	/**
+	 Adds a Value to the sliding DFTs of the stream being executed
+	 
+	 @param data A Value
+	 @param context the context the output is allocated from
+	 @return A Value with the sum of the power of the frequencies, or a FeatureVector with the power of every frequency
+	 */
+	Data* execute(Data * data, ExecutionContext & context) override;
+	
+	UINT getStateSize() const override;
+	void initializeState(void * state) const override;
+};
+
+}
+
+#endif //ARF_SLIDING_DFT_H
@@ -28,8 +28,18 @@ using namespace std;
 
 namespace ARF {
 
-PeakDetector::PeakDetector(float minPeakHeight, UINT minPeakDistance) : minPeakHeight(minPeakHeight), minPeakDistance(minPeakDistance), samplesSinceLastPeak(-1), lastPeakValue(0.0) {
-	
+PeakDetector::PeakDetector(float minPeakHeight, UINT minPeakDistance) : minPeakHeight(minPeakHeight), minPeakDistance(minPeakDistance) {
+	initializeState(&state);
+}
+
+UINT PeakDetector::getStateSize() const {
+	return sizeof(State);
+}
+
+void PeakDetector::initializeState(void * state) const {
+	State * peakState = (State*) state;
+	peakState->samplesSinceLastPeak = -1;
+	peakState->lastPeakValue = 0.0;
 }
 
 /**
@@ -39,27 +49,48 @@ PeakDetector::PeakDetector(float minPeakHeight, UINT minPeakDistance) : minPeakH
  @return Returns the current sample if it was detected as a peak. Otherwise returns nullptr.
  */
 Data* PeakDetector::execute(Data* data) {
+	return detect(data, state);
+}
+
+Data* PeakDetector::execute(Data* data, ExecutionContext & context) {
+	State * streamState = (State*) context.getState(this);
+	return detect(data, (streamState == nullptr) ? state : *streamState);
+}
+
+UINT PeakDetector::detectPeaks(const Float * magnitudes, UINT numMagnitudes, Vector<UINT> & peakIndices) {
+	UINT numPeaks = 0;
+	for(UINT i = 0 ; i < numMagnitudes ; i++){
+		if(update(magnitudes[i], state)){
+			peakIndices.push_back(i);
+			numPeaks++;
+		}
+	}
+	return numPeaks;
+}
+
+Data* PeakDetector::detect(Data* data, State & state) const {
 	Value * value = (Value*) data;
+	return update(value->getValue(), state) ? data : nullptr;
+}
+
+bool PeakDetector::update(Float magnitude, State & state) const {
+	state.samplesSinceLastPeak++;
 	
-	samplesSinceLastPeak++;
-	
-	if (lastPeakValue > 0 && samplesSinceLastPeak >= (int) minPeakDistance) {
+	if (state.lastPeakValue > 0 && state.samplesSinceLastPeak >= (int) minPeakDistance) {
 		//cout << lastPeakValue << " " << samplesSinceLastPeak << " " << endl;
 		
-		lastPeakValue = 0.0;
-		samplesSinceLastPeak = -1;
-		return data; //new Value(lastPeakValue);
+		state.lastPeakValue = 0.0;
+		state.samplesSinceLastPeak = -1;
+		return true;
 	}
 	
-	float sampleMagnitude = value->getValue();
-	
-	if (sampleMagnitude >= minPeakHeight) {
-		if (sampleMagnitude > lastPeakValue || samplesSinceLastPeak >= (int) minPeakDistance) {
-			lastPeakValue = sampleMagnitude;
-			samplesSinceLastPeak = 0;
+	if (magnitude >= minPeakHeight) {
+		if (magnitude > state.lastPeakValue || state.samplesSinceLastPeak >= (int) minPeakDistance) {
+			state.lastPeakValue = magnitude;
+			state.samplesSinceLastPeak = 0;
 		}
 	}
-	return nullptr;
+	return false;
 }
 
 }
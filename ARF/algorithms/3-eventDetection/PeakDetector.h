@@ -26,6 +26,7 @@
 #define ARF_PEAKDETECTOR_H
 
 #include "../core/Algorithm.h"
+#include "../../dataStructures/Vector.h"
 
 namespace ARF {
 
@@ -35,14 +36,58 @@ public:
 	
 	Data * execute(Data* data) override;
 	
+	/**
+	 Checks if the current sample is a peak, using the state of the current stream if the context has a state block
+	 
+	 @param data A Value containing the magnitude of the current sample
+	 @param context the execution context
+	 @return Returns the current sample if it was detected as a peak. Otherwise returns nullptr.
+	 */
+	Data * execute(Data* data, ExecutionContext & context) override;
+	
+	/**
+	 Checks every value of an array of magnitudes, for example computed with Magnitude::ComputeBlock(), continuing from the state left by the previous calls
+	 
+	 @param magnitudes the magnitudes of consecutive samples
+	 @param numMagnitudes the number of magnitudes
+	 @param peakIndices the indices of the magnitudes at which the detector reports a peak are appended to it, which are the samples at which execute() would return a sample
+	 @return the number of peaks appended
+	 */
+	UINT detectPeaks(const Float * magnitudes, UINT numMagnitudes, Vector<UINT> & peakIndices);
+	
+	UINT getStateSize() const override;
+	void initializeState(void * state) const override;
+	
 	PeakDetector(float minPeakHeight, UINT minPeakDistance);
 	
 private:
 	
-	int samplesSinceLastPeak;
+	struct State {
+		int samplesSinceLastPeak; ///< The number of samples since the last peak candidate
+		float lastPeakValue; ///< The value of the last peak candidate, or 0 if there is none
+	};
+	
+	State state; ///< The state used when the algorithm is executed without a state block
 	float minPeakHeight;
 	int minPeakDistance;
-	float lastPeakValue;
+	
+	/**
+	 Checks if the current sample is a peak
+	 
+	 @param data A Value containing the magnitude of the current sample
+	 @param state the state of the detector, updated with the current sample
+	 @return Returns the current sample if it was detected as a peak. Otherwise returns nullptr.
+	 */
+	Data * detect(Data * data, State & state) const;
+	
+	/**
+	 Updates the state of the detector with the magnitude of the current sample
+	 
+	 @param magnitude the magnitude of the current sample
+	 @param state the state of the detector
+	 @return true if a peak is reported at the current sample
+	 */
+	bool update(Float magnitude, State & state) const;
 };
 
 }
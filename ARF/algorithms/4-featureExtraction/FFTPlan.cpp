@@ -0,0 +1,147 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "FFTPlan.h"
+#include "../../utils/ARFException.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <math.h>
+
+namespace ARF {
+
+FFTPlan::FFTPlan(UINT size) : size(size) {
+	
+	UINT numComplex = size / 2;
+	UINT numBits = 0;
+	while((1u << numBits) < numComplex){
+		numBits++;
+	}
+	
+	bitReversal.resize(numComplex);
+	for(UINT i = 0 ; i < numComplex ; i++){
+		UINT reversed = 0;
+		for(UINT bit = 0 ; bit < numBits ; bit++){
+			reversed |= ((i >> bit) & 1) << (numBits - 1 - bit);
+		}
+		bitReversal[i] = reversed;
+	}
+	
+	//the twiddles are computed in double precision to avoid accumulating rounding errors
+	twiddles.resize(std::max(numComplex / 2, 1u) * 2);
+	for(UINT k = 0 ; k < numComplex / 2 ; k++){
+		double angle = -2.0 * M_PI * k / numComplex;
+		twiddles[2 * k] = (Float) cos(angle);
+		twiddles[2 * k + 1] = (Float) sin(angle);
+	}
+	
+	realTwiddles.resize((numComplex + 1) * 2);
+	for(UINT k = 0 ; k <= numComplex ; k++){
+		double angle = -2.0 * M_PI * k / size;
+		realTwiddles[2 * k] = (Float) cos(angle);
+		realTwiddles[2 * k + 1] = (Float) sin(angle);
+	}
+}
+
+const FFTPlan & FFTPlan::GetPlan(UINT size){
+	if(size < 4 || (size & (size - 1)) != 0){
+		throw ARFException("FFTPlan::GetPlan() size should be a power of two not smaller than 4");
+	}
+	
+	static std::mutex plansMutex;
+	static std::map<UINT, std::unique_ptr<FFTPlan> > plans;
+	
+	std::lock_guard<std::mutex> lock(plansMutex);
+	std::unique_ptr<FFTPlan> & plan = plans[size];
+	if(plan == nullptr){
+		plan.reset(new FFTPlan(size));
+	}
+	return *plan;
+}
+
+UINT FFTPlan::GetPlanSize(UINT windowSize){
+	UINT planSize = 4;
+	while(planSize < windowSize){
+		planSize *= 2;
+	}
+	return planSize;
+}
+
+void FFTPlan::transformComplex(Float * values) const{
+	
+	UINT numComplex = size / 2;
+	for(UINT i = 0 ; i < numComplex ; i++){
+		UINT j = bitReversal[i];
+		if(i < j){
+			std::swap(values[2 * i], values[2 * j]);
+			std::swap(values[2 * i + 1], values[2 * j + 1]);
+		}
+	}
+	
+	//butterflies of blocks of 2, 4, ..., numComplex values. The twiddle of a block of length n is the twiddle of index k * numComplex / n
+	for(UINT length = 2 ; length <= numComplex ; length *= 2){
+		UINT halfLength = length / 2;
+		UINT twiddleStride = numComplex / length;
+		for(UINT blockStart = 0 ; blockStart < numComplex ; blockStart += length){
+			for(UINT k = 0 ; k < halfLength ; k++){
+				Float wr = twiddles[2 * k * twiddleStride];
+				Float wi = twiddles[2 * k * twiddleStride + 1];
+				Float * even = values + 2 * (blockStart + k);
+				Float * odd = values + 2 * (blockStart + k + halfLength);
+				Float tr = odd[0] * wr - odd[1] * wi;
+				Float ti = odd[0] * wi + odd[1] * wr;
+				odd[0] = even[0] - tr;
+				odd[1] = even[1] - ti;
+				even[0] += tr;
+				even[1] += ti;
+			}
+		}
+	}
+}
+
+void FFTPlan::computePowerSpectrum(Float * values, Float * power) const{
+	
+	//the even values are the real parts and the odd values the imaginary parts of size/2 complex values
+	transformComplex(values);
+	
+	//X[k] = (Z[k] + conj(Z[M-k])) / 2 - i * W^k * (Z[k] - conj(Z[M-k])) / 2, with M = size/2 and Z[M] = Z[0]
+	UINT numComplex = size / 2;
+	for(UINT k = 0 ; k <= numComplex ; k++){
+		UINT idx = (k == numComplex) ? 0 : k;
+		UINT mirrorIdx = (k == 0) ? 0 : numComplex - k;
+		Float zr = values[2 * idx], zi = values[2 * idx + 1];
+		Float mr = values[2 * mirrorIdx], mi = -values[2 * mirrorIdx + 1];
+		
+		Float evenR = (zr + mr) * 0.5f, evenI = (zi + mi) * 0.5f;
+		Float oddR = (zr - mr) * 0.5f, oddI = (zi - mi) * 0.5f;
+		
+		//-i * (oddR + i oddI) = oddI - i oddR, multiplied by the twiddle
+		Float wr = realTwiddles[2 * k], wi = realTwiddles[2 * k + 1];
+		Float rotatedR = oddI * wr + oddR * wi;
+		Float rotatedI = oddI * wi - oddR * wr;
+		
+		Float xr = evenR + rotatedR;
+		Float xi = evenI + rotatedI;
+		power[k] = xr * xr + xi * xi;
+	}
+}
+
+}
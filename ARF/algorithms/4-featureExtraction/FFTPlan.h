@@ -0,0 +1,94 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The FFTPlan computes the power spectrum of windows of real values with a fast Fourier transform. A window of N real values is transformed as N/2 complex values with an iterative radix-2 FFT, whose spectrum is then split into the spectrum of the real values. The bit reversal permutation and the twiddle factors are computed once per size, and the plans are shared: GetPlan() returns the same plan to every algorithm and stream that uses the same size. Transforming a window does not allocate memory
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+#ifndef ARF_FFT_PLAN_H
+#define ARF_FFT_PLAN_H
+
+#include "../../utils/ARFTypedefs.h"
+#include <vector>
+
+namespace ARF {
+
+class FFTPlan {
+	
+private:
+	UINT size; ///< The number of real values transformed, a power of two
+	std::vector<UINT> bitReversal; ///< The index every complex value is moved to before the butterflies
+	std::vector<Float> twiddles; ///< cos and sin of -2*pi*k/(size/2), interleaved, for k in [0 size/4)
+	std::vector<Float> realTwiddles; ///< cos and sin of -2*pi*k/size, interleaved, for k in [0 size/2]
+	
+	FFTPlan(UINT size);
+	FFTPlan(const FFTPlan &rhs);
+	FFTPlan& operator=(const FFTPlan &rhs);
+	
+	/**
+	 Transforms size/2 interleaved complex values in place
+	 
+	 @param values the real and imaginary parts of the complex values
+	 */
+	void transformComplex(Float * values) const;
+	
+public:
+	
+	/**
+	 Retrieves the plan of a size, creating it the first time it is requested. The plans are never destroyed, so the reference remains valid
+	 
+	 @param size the number of real values transformed, a power of two not smaller than 4
+	 @return the plan shared by all the users of the size
+	 */
+	static const FFTPlan & GetPlan(UINT size);
+	
+	/**
+	 Retrieves the smallest size of a plan that can transform a window
+	 
+	 @param windowSize the number of values of the window
+	 @return the smallest power of two not smaller than windowSize and 4
+	 */
+	static UINT GetPlanSize(UINT windowSize);
+	
+	UINT getSize() const{
+		return size;
+	}
+	
+	/**
+	 Retrieves the number of frequency bins of the power spectrum, from 0 to the Nyquist frequency
+	 
+	 @return size/2 + 1
+	 */
+	UINT getNumBins() const{
+		return size / 2 + 1;
+	}
+	
+	/**
+	 Computes the power spectrum of a window, |X[k]|^2 for k in [0 size/2]
+	 
+	 @param values the size values of the window, overwritten by the transform
+	 @param power the getNumBins() values of the power spectrum
+	 */
+	void computePowerSpectrum(Float * values, Float * power) const;
+};
+
+}
+
+#endif //ARF_FFT_PLAN_H
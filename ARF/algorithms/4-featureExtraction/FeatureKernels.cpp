@@ -0,0 +1,516 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "FeatureKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <float.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARF_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace ARF {
+
+/**
+ The implementations of the kernels for an instruction set
+ */
+struct KernelTable {
+	Float (*sum)(const Float * values, UINT numValues);
+	Float (*sumSquaredDifferences)(const Float * values, UINT numValues, Float mean);
+	Float (*minimum)(const Float * values, UINT numValues);
+	UINT (*countSignChanges)(const Float * values, UINT numValues);
+	Float (*dotProduct)(const Float * values, const Float * weights, UINT numValues);
+	void (*magnitudes)(const Float * const * columns, UINT numColumns, UINT numRows, Float * magnitudes, UINT squareRoot);
+};
+
+//scalar kernels
+
+static Float SumScalar(const Float * values, UINT numValues){
+	Float sum = 0.0;
+	for(UINT i = 0 ; i < numValues ; i++){
+		sum += values[i];
+	}
+	return sum;
+}
+
+static Float SumSquaredDifferencesScalar(const Float * values, UINT numValues, Float mean){
+	Float sum = 0.0;
+	for(UINT i = 0 ; i < numValues ; i++){
+		Float diff = values[i] - mean;
+		sum += diff * diff;
+	}
+	return sum;
+}
+
+static Float MinimumScalar(const Float * values, UINT numValues){
+	Float minimum = values[0];
+	for(UINT i = 1 ; i < numValues ; i++){
+		minimum = std::min(minimum, values[i]);
+	}
+	return minimum;
+}
+
+static UINT CountSignChangesScalar(const Float * values, UINT numValues){
+	UINT count = 0;
+	for(UINT i = 1 ; i < numValues ; i++){
+		count += (signbit(values[i]) != signbit(values[i - 1]));
+	}
+	return count;
+}
+
+static Float DotProductScalar(const Float * values, const Float * weights, UINT numValues){
+	Float sum = 0.0;
+	for(UINT i = 0 ; i < numValues ; i++){
+		sum += values[i] * weights[i];
+	}
+	return sum;
+}
+
+static inline Float SumSquaredValues(const Float * const * columns, UINT numColumns, UINT rowIdx){
+	Float sum = 0.0;
+	for(UINT c = 0 ; c < numColumns ; c++){
+		sum += columns[c][rowIdx] * columns[c][rowIdx];
+	}
+	return sum;
+}
+
+//the square root of x computed as x / sqrt(x) like the SIMD kernels, with the reciprocal square root estimated from the bits of x and refined with Newton-Raphson steps to the error bound of the mode
+static inline Float SquareRoot(Float x, UINT squareRoot){
+	if(squareRoot == FeatureKernels::kExactSquareRoot){
+		return sqrtf(x);
+	}
+	Float clamped = std::max(x, FLT_MIN);
+	uint32_t bits;
+	memcpy(&bits, &clamped, sizeof(bits));
+	bits = 0x5f375a86 - (bits >> 1);
+	Float reciprocal;
+	memcpy(&reciprocal, &bits, sizeof(reciprocal));
+	Float halfX = 0.5f * clamped;
+	reciprocal *= 1.5f - halfX * reciprocal * reciprocal;
+	reciprocal *= 1.5f - halfX * reciprocal * reciprocal;
+	if(squareRoot == FeatureKernels::kRefinedSquareRoot){
+		reciprocal *= 1.5f - halfX * reciprocal * reciprocal;
+	}
+	return x * reciprocal;
+}
+
+static void MagnitudesScalar(const Float * const * columns, UINT numColumns, UINT numRows, Float * magnitudes, UINT squareRoot){
+	for(UINT i = 0 ; i < numRows ; i++){
+		magnitudes[i] = SquareRoot(SumSquaredValues(columns, numColumns, i), squareRoot);
+	}
+}
+
+static const KernelTable kScalarKernels = {SumScalar, SumSquaredDifferencesScalar, MinimumScalar, CountSignChangesScalar, DotProductScalar, MagnitudesScalar};
+
+#ifdef ARF_X86_KERNELS
+
+//SSE2 kernels, available on every x86-64 processor
+
+__attribute__((target("sse2")))
+static inline Float HorizontalSum(__m128 sums){
+	__m128 shuffled = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(2, 3, 0, 1));
+	sums = _mm_add_ps(sums, shuffled);
+	shuffled = _mm_movehl_ps(shuffled, sums);
+	return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+
+__attribute__((target("sse2")))
+static inline Float HorizontalMinimum(__m128 minima){
+	minima = _mm_min_ps(minima, _mm_shuffle_ps(minima, minima, _MM_SHUFFLE(2, 3, 0, 1)));
+	minima = _mm_min_ps(minima, _mm_movehl_ps(minima, minima));
+	return _mm_cvtss_f32(minima);
+}
+
+__attribute__((target("sse2")))
+static Float SumSSE2(const Float * values, UINT numValues){
+	__m128 sums0 = _mm_setzero_ps();
+	__m128 sums1 = _mm_setzero_ps();
+	UINT i = 0;
+	for( ; i + 8 <= numValues ; i += 8){
+		sums0 = _mm_add_ps(sums0, _mm_loadu_ps(values + i));
+		sums1 = _mm_add_ps(sums1, _mm_loadu_ps(values + i + 4));
+	}
+	Float sum = HorizontalSum(_mm_add_ps(sums0, sums1));
+	for( ; i < numValues ; i++){
+		sum += values[i];
+	}
+	return sum;
+}
+
+__attribute__((target("sse2")))
+static Float SumSquaredDifferencesSSE2(const Float * values, UINT numValues, Float mean){
+	__m128 means = _mm_set1_ps(mean);
+	__m128 sums0 = _mm_setzero_ps();
+	__m128 sums1 = _mm_setzero_ps();
+	UINT i = 0;
+	for( ; i + 8 <= numValues ; i += 8){
+		__m128 diffs0 = _mm_sub_ps(_mm_loadu_ps(values + i), means);
+		__m128 diffs1 = _mm_sub_ps(_mm_loadu_ps(values + i + 4), means);
+		sums0 = _mm_add_ps(sums0, _mm_mul_ps(diffs0, diffs0));
+		sums1 = _mm_add_ps(sums1, _mm_mul_ps(diffs1, diffs1));
+	}
+	Float sum = HorizontalSum(_mm_add_ps(sums0, sums1));
+	for( ; i < numValues ; i++){
+		Float diff = values[i] - mean;
+		sum += diff * diff;
+	}
+	return sum;
+}
+
+__attribute__((target("sse2")))
+static Float MinimumSSE2(const Float * values, UINT numValues){
+	if(numValues < 4){
+		return MinimumScalar(values, numValues);
+	}
+	__m128 minima = _mm_loadu_ps(values);
+	UINT i = 4;
+	for( ; i + 4 <= numValues ; i += 4){
+		minima = _mm_min_ps(minima, _mm_loadu_ps(values + i));
+	}
+	Float minimum = HorizontalMinimum(minima);
+	for( ; i < numValues ; i++){
+		minimum = std::min(minimum, values[i]);
+	}
+	return minimum;
+}
+
+__attribute__((target("sse2")))
+static UINT CountSignChangesSSE2(const Float * values, UINT numValues){
+	UINT count = 0;
+	UINT i = 1;
+	
+	//the sign bits of values[i] xor values[i-1], extracted as a 4 bits mask
+	for( ; i + 4 <= numValues ; i += 4){
+		__m128 changes = _mm_xor_ps(_mm_loadu_ps(values + i), _mm_loadu_ps(values + i - 1));
+		count += __builtin_popcount(_mm_movemask_ps(changes));
+	}
+	for( ; i < numValues ; i++){
+		count += (signbit(values[i]) != signbit(values[i - 1]));
+	}
+	return count;
+}
+
+__attribute__((target("sse2")))
+static Float DotProductSSE2(const Float * values, const Float * weights, UINT numValues){
+	__m128 sums0 = _mm_setzero_ps();
+	__m128 sums1 = _mm_setzero_ps();
+	UINT i = 0;
+	for( ; i + 8 <= numValues ; i += 8){
+		sums0 = _mm_add_ps(sums0, _mm_mul_ps(_mm_loadu_ps(values + i), _mm_loadu_ps(weights + i)));
+		sums1 = _mm_add_ps(sums1, _mm_mul_ps(_mm_loadu_ps(values + i + 4), _mm_loadu_ps(weights + i + 4)));
+	}
+	Float sum = HorizontalSum(_mm_add_ps(sums0, sums1));
+	for( ; i < numValues ; i++){
+		sum += values[i] * weights[i];
+	}
+	return sum;
+}
+
+//the square root of x computed as x / sqrt(x), with x clamped so that the reciprocal of 0 does not turn into NaN
+__attribute__((target("sse2")))
+static inline __m128 SquareRoot(__m128 x, UINT squareRoot){
+	if(squareRoot == FeatureKernels::kExactSquareRoot){
+		return _mm_sqrt_ps(x);
+	}
+	__m128 reciprocal = _mm_rsqrt_ps(_mm_max_ps(x, _mm_set1_ps(FLT_MIN)));
+	if(squareRoot == FeatureKernels::kRefinedSquareRoot){
+		__m128 halfX = _mm_mul_ps(x, _mm_set1_ps(0.5f));
+		reciprocal = _mm_mul_ps(reciprocal, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfX, _mm_mul_ps(reciprocal, reciprocal))));
+	}
+	return _mm_mul_ps(x, reciprocal);
+}
+
+__attribute__((target("sse2")))
+static void MagnitudesSSE2(const Float * const * columns, UINT numColumns, UINT numRows, Float * magnitudes, UINT squareRoot){
+	UINT i = 0;
+	for( ; i + 4 <= numRows ; i += 4){
+		__m128 sums = _mm_setzero_ps();
+		for(UINT c = 0 ; c < numColumns ; c++){
+			__m128 values = _mm_loadu_ps(columns[c] + i);
+			sums = _mm_add_ps(sums, _mm_mul_ps(values, values));
+		}
+		_mm_storeu_ps(magnitudes + i, SquareRoot(sums, squareRoot));
+	}
+	
+	//the last rows go through the same square root as the others, so that a magnitude does not depend on the position of its row
+	if(i < numRows){
+		Float sums[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+		for(UINT k = 0 ; i + k < numRows ; k++){
+			sums[k] = SumSquaredValues(columns, numColumns, i + k);
+		}
+		_mm_storeu_ps(sums, SquareRoot(_mm_loadu_ps(sums), squareRoot));
+		std::copy(sums, sums + (numRows - i), magnitudes + i);
+	}
+}
+
+static const KernelTable kSSE2Kernels = {SumSSE2, SumSquaredDifferencesSSE2, MinimumSSE2, CountSignChangesSSE2, DotProductSSE2, MagnitudesSSE2};
+
+//AVX2 kernels
+
+__attribute__((target("avx2")))
+static inline Float HorizontalSum(__m256 sums){
+	return HorizontalSum(_mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1)));
+}
+
+__attribute__((target("avx2")))
+static Float SumAVX2(const Float * values, UINT numValues){
+	__m256 sums0 = _mm256_setzero_ps();
+	__m256 sums1 = _mm256_setzero_ps();
+	__m256 sums2 = _mm256_setzero_ps();
+	__m256 sums3 = _mm256_setzero_ps();
+	UINT i = 0;
+	for( ; i + 32 <= numValues ; i += 32){
+		sums0 = _mm256_add_ps(sums0, _mm256_loadu_ps(values + i));
+		sums1 = _mm256_add_ps(sums1, _mm256_loadu_ps(values + i + 8));
+		sums2 = _mm256_add_ps(sums2, _mm256_loadu_ps(values + i + 16));
+		sums3 = _mm256_add_ps(sums3, _mm256_loadu_ps(values + i + 24));
+	}
+	for( ; i + 8 <= numValues ; i += 8){
+		sums0 = _mm256_add_ps(sums0, _mm256_loadu_ps(values + i));
+	}
+	Float sum = HorizontalSum(_mm256_add_ps(_mm256_add_ps(sums0, sums1), _mm256_add_ps(sums2, sums3)));
+	for( ; i < numValues ; i++){
+		sum += values[i];
+	}
+	return sum;
+}
+
+__attribute__((target("avx2")))
+static Float SumSquaredDifferencesAVX2(const Float * values, UINT numValues, Float mean){
+	__m256 means = _mm256_set1_ps(mean);
+	__m256 sums0 = _mm256_setzero_ps();
+	__m256 sums1 = _mm256_setzero_ps();
+	__m256 sums2 = _mm256_setzero_ps();
+	__m256 sums3 = _mm256_setzero_ps();
+	UINT i = 0;
+	for( ; i + 32 <= numValues ; i += 32){
+		__m256 diffs0 = _mm256_sub_ps(_mm256_loadu_ps(values + i), means);
+		__m256 diffs1 = _mm256_sub_ps(_mm256_loadu_ps(values + i + 8), means);
+		__m256 diffs2 = _mm256_sub_ps(_mm256_loadu_ps(values + i + 16), means);
+		__m256 diffs3 = _mm256_sub_ps(_mm256_loadu_ps(values + i + 24), means);
+		sums0 = _mm256_add_ps(sums0, _mm256_mul_ps(diffs0, diffs0));
+		sums1 = _mm256_add_ps(sums1, _mm256_mul_ps(diffs1, diffs1));
+		sums2 = _mm256_add_ps(sums2, _mm256_mul_ps(diffs2, diffs2));
+		sums3 = _mm256_add_ps(sums3, _mm256_mul_ps(diffs3, diffs3));
+	}
+	for( ; i + 8 <= numValues ; i += 8){
+		__m256 diffs = _mm256_sub_ps(_mm256_loadu_ps(values + i), means);
+		sums0 = _mm256_add_ps(sums0, _mm256_mul_ps(diffs, diffs));
+	}
+	Float sum = HorizontalSum(_mm256_add_ps(_mm256_add_ps(sums0, sums1), _mm256_add_ps(sums2, sums3)));
+	for( ; i < numValues ; i++){
+		Float diff = values[i] - mean;
+		sum += diff * diff;
+	}
+	return sum;
+}
+
+__attribute__((target("avx2")))
+static Float MinimumAVX2(const Float * values, UINT numValues){
+	if(numValues < 8){
+		return MinimumScalar(values, numValues);
+	}
+	__m256 minima0 = _mm256_loadu_ps(values);
+	__m256 minima1 = minima0;
+	UINT i = 8;
+	for( ; i + 16 <= numValues ; i += 16){
+		minima0 = _mm256_min_ps(minima0, _mm256_loadu_ps(values + i));
+		minima1 = _mm256_min_ps(minima1, _mm256_loadu_ps(values + i + 8));
+	}
+	__m256 minima = _mm256_min_ps(minima0, minima1);
+	Float minimum = HorizontalMinimum(_mm_min_ps(_mm256_castps256_ps128(minima), _mm256_extractf128_ps(minima, 1)));
+	for( ; i < numValues ; i++){
+		minimum = std::min(minimum, values[i]);
+	}
+	return minimum;
+}
+
+__attribute__((target("avx2,popcnt")))
+static UINT CountSignChangesAVX2(const Float * values, UINT numValues){
+	UINT count = 0;
+	UINT i = 1;
+	
+	//the sign bits of values[i] xor values[i-1], extracted as an 8 bits mask
+	for( ; i + 8 <= numValues ; i += 8){
+		__m256 changes = _mm256_xor_ps(_mm256_loadu_ps(values + i), _mm256_loadu_ps(values + i - 1));
+		count += _mm_popcnt_u32(_mm256_movemask_ps(changes));
+	}
+	for( ; i < numValues ; i++){
+		count += (signbit(values[i]) != signbit(values[i - 1]));
+	}
+	return count;
+}
+
+__attribute__((target("avx2")))
+static Float DotProductAVX2(const Float * values, const Float * weights, UINT numValues){
+	__m256 sums0 = _mm256_setzero_ps();
+	__m256 sums1 = _mm256_setzero_ps();
+	__m256 sums2 = _mm256_setzero_ps();
+	__m256 sums3 = _mm256_setzero_ps();
+	UINT i = 0;
+	for( ; i + 32 <= numValues ; i += 32){
+		sums0 = _mm256_add_ps(sums0, _mm256_mul_ps(_mm256_loadu_ps(values + i), _mm256_loadu_ps(weights + i)));
+		sums1 = _mm256_add_ps(sums1, _mm256_mul_ps(_mm256_loadu_ps(values + i + 8), _mm256_loadu_ps(weights + i + 8)));
+		sums2 = _mm256_add_ps(sums2, _mm256_mul_ps(_mm256_loadu_ps(values + i + 16), _mm256_loadu_ps(weights + i + 16)));
+		sums3 = _mm256_add_ps(sums3, _mm256_mul_ps(_mm256_loadu_ps(values + i + 24), _mm256_loadu_ps(weights + i + 24)));
+	}
+	for( ; i + 8 <= numValues ; i += 8){
+		sums0 = _mm256_add_ps(sums0, _mm256_mul_ps(_mm256_loadu_ps(values + i), _mm256_loadu_ps(weights + i)));
+	}
+	Float sum = HorizontalSum(_mm256_add_ps(_mm256_add_ps(sums0, sums1), _mm256_add_ps(sums2, sums3)));
+	for( ; i < numValues ; i++){
+		sum += values[i] * weights[i];
+	}
+	return sum;
+}
+
+__attribute__((target("avx2")))
+static inline __m256 SquareRoot(__m256 x, UINT squareRoot){
+	if(squareRoot == FeatureKernels::kExactSquareRoot){
+		return _mm256_sqrt_ps(x);
+	}
+	__m256 reciprocal = _mm256_rsqrt_ps(_mm256_max_ps(x, _mm256_set1_ps(FLT_MIN)));
+	if(squareRoot == FeatureKernels::kRefinedSquareRoot){
+		__m256 halfX = _mm256_mul_ps(x, _mm256_set1_ps(0.5f));
+		reciprocal = _mm256_mul_ps(reciprocal, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(halfX, _mm256_mul_ps(reciprocal, reciprocal))));
+	}
+	return _mm256_mul_ps(x, reciprocal);
+}
+
+__attribute__((target("avx2")))
+static void MagnitudesAVX2(const Float * const * columns, UINT numColumns, UINT numRows, Float * magnitudes, UINT squareRoot){
+	UINT i = 0;
+	for( ; i + 8 <= numRows ; i += 8){
+		__m256 sums = _mm256_setzero_ps();
+		for(UINT c = 0 ; c < numColumns ; c++){
+			__m256 values = _mm256_loadu_ps(columns[c] + i);
+			sums = _mm256_add_ps(sums, _mm256_mul_ps(values, values));
+		}
+		_mm256_storeu_ps(magnitudes + i, SquareRoot(sums, squareRoot));
+	}
+	
+	//the last rows go through the same square root as the others
+	if(i < numRows){
+		Float sums[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+		for(UINT k = 0 ; i + k < numRows ; k++){
+			sums[k] = SumSquaredValues(columns, numColumns, i + k);
+		}
+		_mm256_storeu_ps(sums, SquareRoot(_mm256_loadu_ps(sums), squareRoot));
+		std::copy(sums, sums + (numRows - i), magnitudes + i);
+	}
+}
+
+static const KernelTable kAVX2Kernels = {SumAVX2, SumSquaredDifferencesAVX2, MinimumAVX2, CountSignChangesAVX2, DotProductAVX2, MagnitudesAVX2};
+
+#endif
+
+/**
+ Retrieves the kernels of an instruction set
+ 
+ @param instructionSet kScalar, kSSE2 or kAVX2
+ @return the table of the kernels
+ */
+static const KernelTable * GetKernelTable(UINT instructionSet){
+#ifdef ARF_X86_KERNELS
+	if(instructionSet == FeatureKernels::kAVX2){
+		return &kAVX2Kernels;
+	} else if(instructionSet == FeatureKernels::kSSE2){
+		return &kSSE2Kernels;
+	}
+#endif
+	return &kScalarKernels;
+}
+
+//the instruction set of the kernels in use, selected the first time a kernel is invoked
+static std::atomic<int> currentInstructionSet(-1);
+static std::atomic<const KernelTable *> currentKernels(nullptr);
+
+static inline const KernelTable * GetKernels(){
+	const KernelTable * kernels = currentKernels.load(std::memory_order_acquire);
+	if(kernels == nullptr){
+		FeatureKernels::SetInstructionSet(FeatureKernels::GetSupportedInstructionSet());
+		kernels = currentKernels.load(std::memory_order_acquire);
+	}
+	return kernels;
+}
+
+Float FeatureKernels::Sum(const Float * values, UINT numValues){
+	return GetKernels()->sum(values, numValues);
+}
+
+Float FeatureKernels::SumSquaredDifferences(const Float * values, UINT numValues, Float mean){
+	return GetKernels()->sumSquaredDifferences(values, numValues, mean);
+}
+
+Float FeatureKernels::Minimum(const Float * values, UINT numValues){
+	return GetKernels()->minimum(values, numValues);
+}
+
+UINT FeatureKernels::CountSignChanges(const Float * values, UINT numValues){
+	return GetKernels()->countSignChanges(values, numValues);
+}
+
+Float FeatureKernels::DotProduct(const Float * values, const Float * weights, UINT numValues){
+	return GetKernels()->dotProduct(values, weights, numValues);
+}
+
+void FeatureKernels::Magnitudes(const Float * const * columns, UINT numColumns, UINT numRows, Float * magnitudes, UINT squareRoot){
+	GetKernels()->magnitudes(columns, numColumns, numRows, magnitudes, squareRoot);
+}
+
+UINT FeatureKernels::GetInstructionSet(){
+	GetKernels();
+	return (UINT) currentInstructionSet.load(std::memory_order_relaxed);
+}
+
+UINT FeatureKernels::GetSupportedInstructionSet(){
+#ifdef ARF_X86_KERNELS
+	if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")){
+		return kAVX2;
+	}
+	if(__builtin_cpu_supports("sse2")){
+		return kSSE2;
+	}
+#endif
+	return kScalar;
+}
+
+bool FeatureKernels::SetInstructionSet(UINT instructionSet){
+	if(instructionSet > GetSupportedInstructionSet()){
+		return false;
+	}
+	currentInstructionSet.store((int) instructionSet, std::memory_order_relaxed);
+	currentKernels.store(GetKernelTable(instructionSet), std::memory_order_release);
+	return true;
+}
+
+const char * FeatureKernels::GetInstructionSetName(UINT instructionSet){
+	switch(instructionSet){
+		case kAVX2: return "AVX2";
+		case kSSE2: return "SSE2";
+		default: return "scalar";
+	}
+}
+
+}
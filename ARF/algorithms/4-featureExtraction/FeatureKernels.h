@@ -0,0 +1,138 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The FeatureKernels compute the sums, minima and sign changes the feature extraction algorithms are built on, over contiguous arrays of Floats. Every kernel has a portable scalar implementation and, on x86 processors, SSE2 and AVX2 implementations. The fastest implementation supported by the processor is selected at runtime the first time a kernel is invoked. The vectorized kernels accumulate the values in a different order than the scalar ones, so their sums can differ by rounding errors.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_FEATURE_KERNELS_H
+#define ARF_FEATURE_KERNELS_H
+
+#include "../../utils/ARFTypedefs.h"
+
+namespace ARF {
+
+class FeatureKernels {
+	
+public:
+	
+	//the instruction sets the kernels are implemented with
+	static const UINT kScalar = 0;
+	static const UINT kSSE2 = 1;
+	static const UINT kAVX2 = 2;
+	
+	//the ways the square roots of the magnitudes are computed
+	static const UINT kExactSquareRoot = 0; ///< Correctly rounded square root
+	static const UINT kRefinedSquareRoot = 1; ///< Approximate reciprocal square root refined with a Newton-Raphson step, relative error below 1e-6
+	static const UINT kApproximateSquareRoot = 2; ///< Approximate reciprocal square root, relative error below 4e-4
+	
+	/**
+	 Computes the sum of an array of values
+	 
+	 @param values the values
+	 @param numValues the number of values
+	 @return the sum of the values
+	 */
+	static Float Sum(const Float * values, UINT numValues);
+	
+	/**
+	 Computes the sum of the squared differences between an array of values and a reference value
+	 
+	 @param values the values
+	 @param numValues the number of values
+	 @param mean the value subtracted from every value
+	 @return the sum of (values[i] - mean)^2
+	 */
+	static Float SumSquaredDifferences(const Float * values, UINT numValues, Float mean);
+	
+	/**
+	 Computes the minimum of an array of values
+	 
+	 @param values the values
+	 @param numValues the number of values, at least one
+	 @return the smallest value
+	 */
+	static Float Minimum(const Float * values, UINT numValues);
+	
+	/**
+	 Counts the number of times the sign bit changes between consecutive values of an array
+	 
+	 @param values the values
+	 @param numValues the number of values
+	 @return the number of indices i in [1 numValues) where the sign bits of values[i] and values[i-1] differ
+	 */
+	static UINT CountSignChanges(const Float * values, UINT numValues);
+	
+	/**
+	 Computes the dot product of two arrays of values
+	 
+	 @param values the values
+	 @param weights the weights of the values
+	 @param numValues the number of values and weights
+	 @return the sum of values[i] * weights[i]
+	 */
+	static Float DotProduct(const Float * values, const Float * weights, UINT numValues);
+	
+	/**
+	 Computes the euclidean norm of the rows of a set of columns. The approximate square roots come from the reciprocal square root instruction of the SIMD kernels, and from the bits of the values in the scalar kernels, so they differ slightly between instruction sets within the error bound of the mode. Within an instruction set, the magnitude of a row does not depend on its position
+	 
+	 @param columns the values of every column, numRows consecutive values each
+	 @param numColumns the number of columns
+	 @param numRows the number of rows
+	 @param magnitudes set to the square root of the sum of the squared values of every row
+	 @param squareRoot kExactSquareRoot, kRefinedSquareRoot or kApproximateSquareRoot
+	 */
+	static void Magnitudes(const Float * const * columns, UINT numColumns, UINT numRows, Float * magnitudes, UINT squareRoot = kExactSquareRoot);
+	
+	/**
+	 Retrieves the instruction set used by the kernels
+	 
+	 @return kScalar, kSSE2 or kAVX2
+	 */
+	static UINT GetInstructionSet();
+	
+	/**
+	 Retrieves the fastest instruction set supported by the processor
+	 
+	 @return kScalar, kSSE2 or kAVX2
+	 */
+	static UINT GetSupportedInstructionSet();
+	
+	/**
+	 Selects the instruction set used by the kernels, for example to compare the implementations. Should not be called while kernels are being executed
+	 
+	 @param instructionSet kScalar, kSSE2 or kAVX2
+	 @return false if the processor does not support the instruction set, in which case the selection does not change
+	 */
+	static bool SetInstructionSet(UINT instructionSet);
+	
+	/**
+	 Retrieves the name of an instruction set
+	 
+	 @param instructionSet kScalar, kSSE2 or kAVX2
+	 @return the name of the instruction set
+	 */
+	static const char * GetInstructionSetName(UINT instructionSet);
+};
+
+}
+
+#endif //ARF_FEATURE_KERNELS_H
@@ -22,11 +22,22 @@
 #include "../../dataStructures/Vector.h"
 #include "../../dataStructures/Value.h"
 #include "DataIterator.h"
+#include "FeatureKernels.h"
 
 namespace ARF {
 
-Data* Mean::execute(Data * data) {
-	const Signal &signal = *(Signal*) data;
+Feature Mean::Compute(const Signal & signal) {
+	
+	RangeAggregate aggregate;
+	if(signal.getAggregate(aggregate)){
+		return aggregate.getMean();
+	}
+	
+	StridedSpan span;
+	if(signal.getSpan(span)){
+		return Compute(span);
+	}
+	
 	UINT n = signal.getSize();
 	
 	float sum = 0.0;
@@ -34,9 +45,33 @@ Data* Mean::execute(Data * data) {
 	for(int i = 0 ; i < n ; i++)
 		sum += signal[i];
 	
-	float mean = sum / (float)n;
+	return sum / (float)n;
+}
+
+Feature Mean::Compute(const StridedSpan & span) {
+	
+	if(span.stride == 1){
+		Float sum = FeatureKernels::Sum(span.first, span.firstSize) + FeatureKernels::Sum(span.second, span.secondSize);
+		return sum / (float) span.getSize();
+	}
 	
-	return new Value(mean);
+	float sum = 0.0;
+	for(UINT i = 0 ; i < span.firstSize ; i++){
+		sum += span.first[(size_t) i * span.stride];
+	}
+	for(UINT i = 0 ; i < span.secondSize ; i++){
+		sum += span.second[(size_t) i * span.stride];
+	}
+	
+	return sum / (float) span.getSize();
+}
+
+Data* Mean::execute(Data * data) {
+	return new Value(Compute(*(Signal*) data));
+}
+
+Data* Mean::execute(Data * data, ExecutionContext & context) {
+	return context.create<Value>(Compute(*(Signal*) data));
 }
 
 }
@@ -33,6 +33,22 @@ namespace ARF {
 
 class Mean : public Algorithm {
 public:
+	/**
+	Computes the mean of a Signal
+	
+	@param signal A Signal
+	@return The mean of the Signal
+	*/
+	static Feature Compute(const Signal & signal);
+	
+	/**
+	Computes the mean of the values of a span, without virtual calls nor bounds checks
+	
+	@param span The values of a Signal
+	@return The mean of the values
+	*/
+	static Feature Compute(const StridedSpan & span);
+	
 	/**
 	Returns the mean of the input Signal
 	
@@ -40,6 +56,15 @@ public:
 	@return The mean of the Signal
 	*/
 	Data* execute(Data * data) override;
+	
+	/**
+	Returns the mean of the input Signal, allocated from the execution context
+	
+	@param data A Signal
+	@param context the context the output is allocated from
+	@return The mean of the Signal
+	*/
+	Data* execute(Data * data, ExecutionContext & context) override;
 };
 
 }
@@ -21,28 +21,68 @@
 #include "Minimum.h"
 #include "../../dataStructures/Value.h"
 #include "../../dataStructures/DataIterator.h"
+#include "FeatureKernels.h"
+#include <algorithm>
 
 namespace ARF {
 
 /**
  Returns the mean for the currently selected data that is provided by the DAO.
  
- @param data A DataAccessObject containing an iterator
+ @param signal A Signal
  @return The mean for the currently selected data
  */
-Data* Minimum::execute(Data * data) {
-	Signal * signal = (Signal *) data;
+Feature Minimum::Compute(const Signal & signal) {
+	
+	RangeAggregate aggregate;
+	if(signal.getAggregate(aggregate)){
+		return aggregate.minimum;
+	}
+	
+	StridedSpan span;
+	if(signal.getSpan(span)){
+		return Compute(span);
+	}
 	
-	Float minimum = (*signal)[0];
+	Float minimum = signal[0];
 	
-	for(int i = 0 ; i < signal->getSize() ; i++){
-		Float value = (*signal)[i];
+	for(int i = 0 ; i < signal.getSize() ; i++){
+		Float value = signal[i];
 		if (value < minimum){
 			minimum = value;
 		}
 	}
 	
-	return new Value(minimum);
+	return minimum;
+}
+
+Feature Minimum::Compute(const StridedSpan & span) {
+	
+	if(span.stride == 1){
+		Float minimum = FeatureKernels::Minimum(span.first, span.firstSize);
+		if(span.secondSize > 0){
+			minimum = std::min(minimum, FeatureKernels::Minimum(span.second, span.secondSize));
+		}
+		return minimum;
+	}
+	
+	Float minimum = span.first[0];
+	for(UINT i = 1 ; i < span.firstSize ; i++){
+		minimum = std::min(minimum, span.first[(size_t) i * span.stride]);
+	}
+	for(UINT i = 0 ; i < span.secondSize ; i++){
+		minimum = std::min(minimum, span.second[(size_t) i * span.stride]);
+	}
+	
+	return minimum;
+}
+
+Data* Minimum::execute(Data * data) {
+	return new Value(Compute(*(Signal*) data));
+}
+
+Data* Minimum::execute(Data * data, ExecutionContext & context) {
+	return context.create<Value>(Compute(*(Signal*) data));
 }
 
 }
@@ -33,7 +33,25 @@ namespace ARF {
 
 class Minimum : public Algorithm {
 public:
+	
+	/**
+	Computes the minimum of a Signal
+	
+	@param signal A Signal
+	@return The minimum of the Signal
+	*/
+	static Feature Compute(const Signal & signal);
+	
+	/**
+	Computes the minimum of the values of a span, without virtual calls nor bounds checks
+	
+	@param span The values of a Signal
+	@return The minimum of the values
+	*/
+	static Feature Compute(const StridedSpan & span);
+	
 	Data* execute(Data * data) override;
+	Data* execute(Data * data, ExecutionContext & context) override;
 };
 
 }
@@ -22,29 +22,72 @@
 #include "../../dataStructures/Value.h"
 #include "DataIterator.h"
 #include "Mean.h"
+#include "FeatureKernels.h"
 #include <math.h>
 
 namespace ARF {
 
-Data* STD::execute(Data * data) {
+template <typename Math>
+Feature BasicSTD<Math>::Compute(const Signal & signal) {
 	
-	const Signal &signal = *(Signal*) data;
+	RangeAggregate aggregate;
+	if(signal.getAggregate(aggregate)){
+		return Math::Sqrt(aggregate.getVariance());
+	}
+	
+	StridedSpan span;
+	if(signal.getSpan(span)){
+		return Compute(span);
+	}
 	
-	Mean meanComputer;
-	Value * output = (Value*) meanComputer.execute(data);
-	Float mean = output->getValue();
+	Float mean = Mean::Compute(signal);
 	
 	UINT n = signal.getSize();
 	
 	Float accum = 0.0;
 	for(int i = 0 ; i < n ; i++){
 		Float diff = signal[i] - mean;
-		accum = diff * diff;
+		accum += diff * diff;
+	}
+
+	return Math::Sqrt(accum / float(n-1));
+}
+
+template <typename Math>
+Feature BasicSTD<Math>::Compute(const StridedSpan & span) {
+	
+	Float mean = Mean::Compute(span);
+	
+	if(span.stride == 1){
+		Float accum = FeatureKernels::SumSquaredDifferences(span.first, span.firstSize, mean) + FeatureKernels::SumSquaredDifferences(span.second, span.secondSize, mean);
+		return Math::Sqrt(accum / float(span.getSize() - 1));
 	}
+	
+	Float accum = 0.0;
+	for(UINT i = 0 ; i < span.firstSize ; i++){
+		Float diff = span.first[(size_t) i * span.stride] - mean;
+		accum += diff * diff;
+	}
+	for(UINT i = 0 ; i < span.secondSize ; i++){
+		Float diff = span.second[(size_t) i * span.stride] - mean;
+		accum += diff * diff;
+	}
+	
+	return Math::Sqrt(accum / float(span.getSize() - 1));
+}
+
+template <typename Math>
+Data* BasicSTD<Math>::execute(Data * data) {
+	return new Value(Compute(*(Signal*) data));
+}
 
-	Float stdev = sqrt(accum / float(n-1));
-	output->setValue(stdev);
-	return output;
+template <typename Math>
+Data* BasicSTD<Math>::execute(Data * data, ExecutionContext & context) {
+	return context.create<Value>(Compute(*(Signal*) data));
 }
 
+template class BasicSTD<ExactMath>;
+template class BasicSTD<FastMath>;
+template class BasicSTD<TableMath>;
+
 }
@@ -27,12 +27,33 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Algorithm.h"
 #include "../../utils/ARFTypedefs.h"
+#include "../../utils/MathPolicies.h"
 
 namespace ARF {
 
-class STD : public Algorithm {
+/**
+ The standard deviation with the square root computed by a math policy: ExactMath, FastMath or TableMath
+ */
+template <typename Math>
+class BasicSTD : public Algorithm {
 public:
 	
+	/**
+	Computes the standard deviation of a Signal
+	
+	@param signal A Signal
+	@return The standard deviation of the Signal
+	*/
+	static Feature Compute(const Signal & signal);
+	
+	/**
+	Computes the standard deviation of the values of a span, without virtual calls nor bounds checks
+	
+	@param span The values of a Signal
+	@return The standard deviation of the values
+	*/
+	static Feature Compute(const StridedSpan & span);
+	
 	/**
 	Returns the standard deviation of the input Signal
 	
@@ -40,8 +61,19 @@ public:
 	@return The standard deviation of the Signal
 	*/
 	Data* execute(Data * data) override;
+	
+	/**
+	Returns the standard deviation of the input Signal, allocated from the execution context
+	
+	@param data A Signal
+	@param context the context the output is allocated from
+	@return The standard deviation of the Signal
+	*/
+	Data* execute(Data * data, ExecutionContext & context) override;
 };
 
+typedef BasicSTD<ExactMath> STD;
+
 }
 
 #endif /* STD_h */
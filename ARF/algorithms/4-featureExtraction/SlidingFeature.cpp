@@ -0,0 +1,83 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SlidingFeature.h"
+#include "Statistics.h"
+#include "../1-dataAcquisition/RingBufferAlgorithm.h"
+#include "../../dataStructures/SlidingStatistics.h"
+#include "../../dataStructures/Value.h"
+
+namespace ARF {
+
+SlidingFeature::SlidingFeature(RingBufferSource & source, UINT columnIdx, UINT statistic) : source(source), columnIdx(columnIdx), statistic(statistic) {
+	
+	const UINT supportedStatistics = Statistics::kMean | Statistics::kVariance | Statistics::kSTD | Statistics::kMinimum | Statistics::kMaximum | Statistics::kRange | Statistics::kRMS | Statistics::kEnergy;
+	if(Statistics::GetNumFeatures(statistic) != 1 || (statistic & supportedStatistics) == 0){
+		throw ARFException("SlidingFeature::SlidingFeature() statistic should be one of kMean, kVariance, kSTD, kMinimum, kMaximum, kRange, kRMS or kEnergy");
+	}
+	
+	source.trackColumn(columnIdx);
+}
+
+Feature SlidingFeature::Compute(const SlidingStatistics & statistics, UINT statistic) {
+	switch(statistic){
+		case Statistics::kMean: return statistics.getMean();
+		case Statistics::kVariance: return statistics.getVariance();
+		case Statistics::kSTD: return statistics.getSTD();
+		case Statistics::kMinimum: return statistics.getMinimum();
+		case Statistics::kMaximum: return statistics.getMaximum();
+		case Statistics::kRange: return statistics.getMaximum() - statistics.getMinimum();
+		case Statistics::kRMS: return statistics.getRMS();
+		case Statistics::kEnergy: return statistics.getEnergy();
+		default: throw ARFException("SlidingFeature::Compute() unsupported statistic");
+	}
+}
+
+Data* SlidingFeature::execute(Data * data) {
+	return new Value(Compute(*source.getSlidingStatistics(columnIdx), statistic));
+}
+
+Data* SlidingFeature::execute(Data * data, ExecutionContext & context) {
+	const SlidingStatistics * statistics = source.getSlidingStatistics(columnIdx, context);
+	if(statistics == nullptr){
+		throw ARFException("SlidingFeature::execute() the column is not tracked by the stream, the SlidingFeature should be created before the StreamRuntime");
+	}
+	return context.create<Value>(Compute(*statistics, statistic));
+}
+
+bool SlidingFeature::getColumnIndices(Vector<uint8_t> & columnIndices) const {
+	columnIndices.resize(1);
+	columnIndices[0] = (uint8_t) columnIdx;
+	return true;
+}
+
+void SlidingFeature::setColumnIndices(const Vector<uint8_t> & columnIndices) {
+	columnIdx = columnIndices[0];
+}
+
+const IterableValues * SlidingFeature::getColumnsIterable() const {
+	return source.getIterable();
+}
+
+const Algorithm * SlidingFeature::getColumnsSource() const {
+	return &source;
+}
+
+}
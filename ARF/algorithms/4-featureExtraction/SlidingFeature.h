@@ -0,0 +1,112 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+@brief This feature extraction algorithm returns a statistic of a column over the whole ring buffer of a RingBufferAlgorithm in constant time. The RingBufferAlgorithm updates the statistic as samples enter and leave the ring buffer, so the cost of a notification does not depend on the size of the window. It is connected to the RingBufferAlgorithm directly, instead of to a DataSelector: ringBufferAlgorithm << slidingFeature
+
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#ifndef ARF_SLIDING_FEATURE_H
+#define ARF_SLIDING_FEATURE_H
+
+#include "Algorithm.h"
+#include "../../utils/ARFTypedefs.h"
+
+namespace ARF {
+
+class RingBufferSource;
+class SlidingStatistics;
+
+class SlidingFeature : public Algorithm {
+	
+private:
+	const RingBufferSource & source; ///< The algorithm whose ring buffer the feature is computed on
+	UINT columnIdx; ///< The column the feature is computed on
+	UINT statistic; ///< The statistic returned
+	
+public:
+	
+	/**
+	 Main constructor. Starts tracking the column in the source, which should be done before samples are added to it and before a StreamRuntime is created for the pipeline
+	 
+	 @param source the RingBufferAlgorithm whose ring buffer the feature is computed on
+	 @param columnIdx the column the feature is computed on
+	 @param statistic one of Statistics::kMean, kVariance, kSTD, kMinimum, kMaximum, kRange, kRMS or kEnergy
+	 */
+	SlidingFeature(RingBufferSource & source, UINT columnIdx, UINT statistic);
+	
+	/**
+	 Retrieves a statistic from the sliding statistics of a column
+	 
+	 @param statistics the statistics of the column
+	 @param statistic one of Statistics::kMean, kVariance, kSTD, kMinimum, kMaximum, kRange, kRMS or kEnergy
+	 @return the value of the statistic
+	 */
+	static Feature Compute(const SlidingStatistics & statistics, UINT statistic);
+	
+	/**
+	 Returns the statistic of the column over the ring buffer of the source
+	 
+	 @param data The notification sample of the source, which is ignored
+	 @return The statistic of the column over the ring buffer
+	 */
+	Data* execute(Data * data) override;
+	
+	/**
+	 Returns the statistic of the column over the ring buffer of the stream being executed, allocated from the execution context
+	 
+	 @param data The notification sample of the source, which is ignored
+	 @param context the context the output is allocated from
+	 @return The statistic of the column over the ring buffer
+	 */
+	Data* execute(Data * data, ExecutionContext & context) override;
+	
+	/**
+	 Retrieves the column the feature is computed on
+	 
+	 @param columnIndices set to the column
+	 @return true
+	 */
+	bool getColumnIndices(Vector<uint8_t> & columnIndices) const override;
+	
+	/**
+	 Replaces the column the feature is computed on. The source tracks the same column in the projected samples, since it reports its tracked columns as well
+	 
+	 @param columnIndices the new column
+	 */
+	void setColumnIndices(const Vector<uint8_t> & columnIndices) override;
+	
+	/**
+	 Retrieves the ring buffer the column belongs to
+	 
+	 @return the ring buffer of the source
+	 */
+	const IterableValues * getColumnsIterable() const override;
+	
+	/**
+	 Retrieves the algorithm whose statistics are read in every stream
+	 
+	 @return the source
+	 */
+	const Algorithm * getColumnsSource() const override;
+};
+
+}
+
+#endif //ARF_SLIDING_FEATURE_H
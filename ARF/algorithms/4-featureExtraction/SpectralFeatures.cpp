@@ -0,0 +1,198 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "SpectralFeatures.h"
+#include "../../dataStructures/DataIterator.h"
+#include <math.h>
+#include <new>
+
+namespace ARF {
+
+template <typename Math>
+BasicSpectralFeatures<Math>::BasicSpectralFeatures(UINT windowSize, Float sampleRate, UINT features, const Vector<Float> &bandEdges) : plan(FFTPlan::GetPlan(FFTPlan::GetPlanSize(windowSize))), windowSize(windowSize), sampleRate(sampleRate), features(features), bandEdges(bandEdges), scratch(GetScratchSize(plan)), state(GetNumFeatures(features, bandEdges)) {
+	
+	if(windowSize == 0){
+		throw ARFException("SpectralFeatures::SpectralFeatures() windowSize should be greater than 0");
+	}
+	if(sampleRate <= 0){
+		throw ARFException("SpectralFeatures::SpectralFeatures() sampleRate should be greater than 0");
+	}
+	if(features == 0 || (features & ~kAll) != 0){
+		throw ARFException("SpectralFeatures::SpectralFeatures() invalid bit mask of features");
+	}
+	if(features & kBandPowers){
+		if(bandEdges.getSize() < 2){
+			throw ARFException("SpectralFeatures::SpectralFeatures() at least two band edges are needed to compute band powers");
+		}
+		for(UINT i = 1 ; i < bandEdges.getSize() ; i++){
+			if(bandEdges[i] <= bandEdges[i-1]){
+				throw ARFException("SpectralFeatures::SpectralFeatures() band edges should be in increasing order");
+			}
+		}
+	}
+}
+
+template <typename Math>
+UINT BasicSpectralFeatures<Math>::GetNumFeatures(UINT features, const Vector<Float> &bandEdges){
+	UINT numFeatures = __builtin_popcount(features & (kDominantFrequency | kSpectralEnergy | kSpectralEntropy));
+	if((features & kBandPowers) && bandEdges.getSize() > 1){
+		numFeatures += bandEdges.getSize() - 1;
+	}
+	return numFeatures;
+}
+
+template <typename Math>
+void BasicSpectralFeatures<Math>::Compute(const Signal & signal, const FFTPlan & plan, Float sampleRate, UINT features, const Vector<Float> &bandEdges, FeatureVector & output, Float * scratch){
+	
+	UINT n = signal.getSize();
+	UINT size = plan.getSize();
+	if(n > size){
+		throw ARFException("SpectralFeatures::Compute() the Signal has more values than the size of the plan");
+	}
+	
+	//the values are gathered and their mean is removed so that the bin at 0 Hz does not dominate the spectrum
+	Float * values = scratch;
+	Float * power = scratch + size;
+	StridedSpan span;
+	if(signal.getSpan(span)){
+		for(UINT i = 0 ; i < span.firstSize ; i++){
+			values[i] = span.first[(size_t) i * span.stride];
+		}
+		for(UINT i = 0 ; i < span.secondSize ; i++){
+			values[span.firstSize + i] = span.second[(size_t) i * span.stride];
+		}
+	} else {
+		for(UINT i = 0 ; i < n ; i++){
+			values[i] = signal[i];
+		}
+	}
+	
+	Float mean = 0;
+	for(UINT i = 0 ; i < n ; i++){
+		mean += values[i];
+	}
+	mean /= n;
+	for(UINT i = 0 ; i < n ; i++){
+		values[i] -= mean;
+	}
+	for(UINT i = n ; i < size ; i++){
+		values[i] = 0;
+	}
+	
+	plan.computePowerSpectrum(values, power);
+	
+	//the one-sided spectrum counts every bin twice except the ones at 0 Hz and at the Nyquist frequency, so that the powers add up to the energy of the values
+	UINT numBins = plan.getNumBins();
+	Float scale = 1.0f / size;
+	power[0] *= scale;
+	for(UINT k = 1 ; k < numBins - 1 ; k++){
+		power[k] *= 2 * scale;
+	}
+	power[numBins - 1] *= scale;
+	
+	Float binWidth = sampleRate / size;
+	output.resize(GetNumFeatures(features, bandEdges));
+	UINT featureIdx = 0;
+	
+	if(features & kDominantFrequency){
+		UINT dominantBin = 1;
+		for(UINT k = 2 ; k < numBins ; k++){
+			if(power[k] > power[dominantBin]){
+				dominantBin = k;
+			}
+		}
+		output[featureIdx++] = dominantBin * binWidth;
+	}
+	
+	if(features & (kSpectralEnergy | kSpectralEntropy)){
+		Float energy = 0;
+		for(UINT k = 0 ; k < numBins ; k++){
+			energy += power[k];
+		}
+		if(features & kSpectralEnergy){
+			output[featureIdx++] = energy;
+		}
+		if(features & kSpectralEntropy){
+			Float total = energy - power[0];
+			Float entropy = 0;
+			if(total > 0){
+				for(UINT k = 1 ; k < numBins ; k++){
+					Float p = power[k] / total;
+					if(p > 0){
+						entropy -= p * Math::Log2(p);
+					}
+				}
+				entropy /= Math::Log2((Float) (numBins - 1));
+			}
+			output[featureIdx++] = entropy;
+		}
+	}
+	
+	if((features & kBandPowers) && bandEdges.getSize() > 1){
+		UINT k = 0;
+		for(UINT band = 0 ; band + 1 < bandEdges.getSize() ; band++){
+			while(k < numBins && k * binWidth < bandEdges[band]){
+				k++;
+			}
+			Float bandPower = 0;
+			while(k < numBins && k * binWidth < bandEdges[band + 1]){
+				bandPower += power[k++];
+			}
+			output[featureIdx++] = bandPower;
+		}
+	}
+}
+
+template <typename Math>
+Data* BasicSpectralFeatures<Math>::execute(Data * data) {
+	FeatureVector * output = new FeatureVector(getNumFeatures());
+	Compute(*(Signal*) data, plan, sampleRate, features, bandEdges, *output, &scratch[0]);
+	return output;
+}
+
+template <typename Math>
+Data* BasicSpectralFeatures<Math>::execute(Data * data, ExecutionContext & context) {
+	State * streamState = (State*) context.getState(this);
+	State & currentState = (streamState == nullptr) ? state : *streamState;
+	Float * contextScratch = (Float*) context.getArena().allocate(sizeof(Float) * GetScratchSize(plan));
+	Compute(*(Signal*) data, plan, sampleRate, features, bandEdges, currentState.output, contextScratch);
+	return &currentState.output;
+}
+
+template <typename Math>
+UINT BasicSpectralFeatures<Math>::getStateSize() const {
+	return sizeof(State);
+}
+
+template <typename Math>
+void BasicSpectralFeatures<Math>::initializeState(void * state) const {
+	new (state) State(getNumFeatures());
+}
+
+template <typename Math>
+void BasicSpectralFeatures<Math>::destroyState(void * state) const {
+	((State*) state)->~State();
+}
+
+template class BasicSpectralFeatures<ExactMath>;
+template class BasicSpectralFeatures<FastMath>;
+template class BasicSpectralFeatures<TableMath>;
+
+}
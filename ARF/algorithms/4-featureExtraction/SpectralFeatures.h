@@ -0,0 +1,158 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+@brief This feature extraction algorithm computes frequency-domain features of a Signal, like its dominant frequency, spectral energy, spectral entropy and the power in frequency bands, from a single FFT of the Signal. The mean of the Signal is removed and the Signal is padded with zeros to the size of its FFTPlan, which is shared with the other algorithms transforming windows of the same size. The FFT is computed in scratch memory allocated from the execution context, and when executed with a context the features are written to a FeatureVector of the stream that is reused, so that the steady state does not allocate memory
+
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#ifndef ARF_SPECTRAL_FEATURES_H
+#define ARF_SPECTRAL_FEATURES_H
+
+#include "Algorithm.h"
+#include "FFTPlan.h"
+#include "../../utils/ARFTypedefs.h"
+#include "../../utils/MathPolicies.h"
+#include "../../dataStructures/Vector.h"
+
+namespace ARF {
+
+/**
+ The spectral features with the logarithms of the spectral entropy computed by a math policy: ExactMath, FastMath or TableMath
+ */
+template <typename Math>
+class BasicSpectralFeatures : public Algorithm {
+	
+public:
+	
+	//the features that can be computed, combined as a bit mask. The FeatureVector contains the selected features in this order
+	static const UINT kDominantFrequency = 1 << 0; ///< The frequency of the bin with the highest power, excluding the bin at 0 Hz
+	static const UINT kSpectralEnergy = 1 << 1; ///< The sum of the power of all the bins, which equals the sum of the squared values without their mean
+	static const UINT kSpectralEntropy = 1 << 2; ///< The Shannon entropy of the power of the bins above 0 Hz normalized to a distribution, divided by its maximum so that it is in [0 1]
+	static const UINT kBandPowers = 1 << 3; ///< The power of each frequency band, one feature per band
+	static const UINT kAll = (1 << 4) - 1;
+	
+private:
+	const FFTPlan & plan; ///< The plan of the FFT, shared with other algorithms
+	UINT windowSize; ///< The maximum number of values of the Signals
+	Float sampleRate; ///< The sampling rate of the Signals in Hz
+	UINT features; ///< The bit mask of the features computed
+	Vector<Float> bandEdges; ///< The frequencies delimiting the bands, in increasing order
+	Vector<Float> scratch; ///< The memory of the FFT when the algorithm is executed without context
+	
+	/**
+	 The state of a stream
+	 */
+	struct State {
+		FeatureVector output; ///< The features of the last window of the stream
+		
+		State(UINT numFeatures) : output(numFeatures) { }
+	};
+	
+	State state; ///< The state used when the algorithm is executed without a state block
+	
+public:
+	
+	/**
+	 Main constructor
+	 
+	 @param windowSize the maximum number of values of the Signals, which determines the size of the FFT
+	 @param sampleRate the sampling rate of the Signals in Hz
+	 @param features a bit mask of the features that will be computed
+	 @param bandEdges the frequencies delimiting the bands whose power is computed with kBandPowers, in increasing order. Band i contains the bins with a frequency in [bandEdges[i] bandEdges[i+1])
+	 */
+	BasicSpectralFeatures(UINT windowSize, Float sampleRate, UINT features = kDominantFrequency | kSpectralEnergy | kSpectralEntropy, const Vector<Float> &bandEdges = Vector<Float>());
+	
+	/**
+	 Retrieves the number of features in the FeatureVectors returned by this algorithm
+	 
+	 @return the number of features
+	 */
+	UINT getNumFeatures() const{
+		return GetNumFeatures(features, bandEdges);
+	}
+	
+	/**
+	 Retrieves the plan of the FFT
+	 
+	 @return the plan shared by the algorithms transforming windows of the same size
+	 */
+	const FFTPlan & getPlan() const{
+		return plan;
+	}
+	
+	/**
+	 Counts the features computed for a bit mask and frequency bands
+	 
+	 @param features a bit mask of features
+	 @param bandEdges the frequencies delimiting the bands
+	 @return the number of features
+	 */
+	static UINT GetNumFeatures(UINT features, const Vector<Float> &bandEdges);
+	
+	/**
+	 Retrieves the number of Floats of scratch memory needed to compute features with a plan
+	 
+	 @param plan the plan of the FFT
+	 @return the number of Floats
+	 */
+	static UINT GetScratchSize(const FFTPlan &plan){
+		return plan.getSize() + plan.getNumBins();
+	}
+	
+	/**
+	 Computes spectral features of a Signal with a single FFT
+	 
+	 @param signal A Signal with at most plan.getSize() values
+	 @param plan the plan of the FFT
+	 @param sampleRate the sampling rate of the Signal in Hz
+	 @param features the bit mask of the features that will be computed
+	 @param bandEdges the frequencies delimiting the bands
+	 @param output The FeatureVector the features are written to, resized to GetNumFeatures(features, bandEdges)
+	 @param scratch An array of at least GetScratchSize(plan) Floats
+	 */
+	static void Compute(const Signal & signal, const FFTPlan & plan, Float sampleRate, UINT features, const Vector<Float> &bandEdges, FeatureVector & output, Float * scratch);
+	
+	/**
+	 Returns a FeatureVector with the spectral features of the input Signal
+	 
+	 @param data A Signal
+	 @return A FeatureVector with the spectral features of the Signal
+	 */
+	Data* execute(Data * data) override;
+	
+	/**
+	 Returns a FeatureVector with the spectral features of the input Signal. The FFT is computed in memory allocated from the execution context. The FeatureVector belongs to the stream being executed and remains valid until the algorithm is executed again for the stream
+	 
+	 @param data A Signal
+	 @param context the context the memory of the FFT is allocated from
+	 @return A FeatureVector with the spectral features of the Signal
+	 */
+	Data* execute(Data * data, ExecutionContext & context) override;
+	
+	UINT getStateSize() const override;
+	void initializeState(void * state) const override;
+	void destroyState(void * state) const override;
+};
+
+typedef BasicSpectralFeatures<ExactMath> SpectralFeatures;
+
+}
+
+#endif //ARF_SPECTRAL_FEATURES_H
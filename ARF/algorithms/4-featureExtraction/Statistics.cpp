@@ -0,0 +1,163 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Statistics.h"
+#include "../../dataStructures/DataIterator.h"
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+namespace ARF {
+
+/**
+ The running statistics of the values read so far
+ */
+struct StatisticsAccumulator {
+	UINT numValues;
+	Float mean; ///< The mean of the values read so far
+	Float m2; ///< The sum of the squared differences to the mean, updated with Welford's algorithm
+	Float minimum;
+	Float maximum;
+	Float sumSquares;
+	UINT signChanges;
+	bool previousSign;
+	
+	StatisticsAccumulator(Float firstValue) : numValues(1), mean(firstValue), m2(0.0), minimum(firstValue), maximum(firstValue), sumSquares(firstValue * firstValue), signChanges(0), previousSign(signbit(firstValue)) { }
+	
+	inline void add(Float value){
+		numValues++;
+		Float delta = value - mean;
+		mean += delta / numValues;
+		m2 += delta * (value - mean);
+		minimum = std::min(minimum, value);
+		maximum = std::max(maximum, value);
+		sumSquares += value * value;
+		bool sign = signbit(value);
+		signChanges += (sign != previousSign);
+		previousSign = sign;
+	}
+};
+
+/**
+ Invokes a function on every value of a Signal except the first one, through the memory of the Signal when it is available
+ 
+ @param signal the Signal
+ @param function the function, invoked with the index of the value and the value
+ */
+template <typename Function>
+static inline void ForEachNextValue(const Signal & signal, Function function){
+	StridedSpan span;
+	if(signal.getSpan(span)){
+		for(UINT i = 1 ; i < span.firstSize ; i++){
+			function(i, span.first[(size_t) i * span.stride]);
+		}
+		for(UINT i = 0 ; i < span.secondSize ; i++){
+			function(span.firstSize + i, span.second[(size_t) i * span.stride]);
+		}
+	} else {
+		UINT n = signal.getSize();
+		for(UINT i = 1 ; i < n ; i++){
+			function(i, signal[i]);
+		}
+	}
+}
+
+Statistics::Statistics(UINT statistics) : statistics(statistics) {
+	if(statistics == 0 || (statistics & ~kAll) != 0){
+		throw ARFException("Statistics::Statistics() invalid bit mask of statistics");
+	}
+}
+
+UINT Statistics::GetNumFeatures(UINT statistics){
+	return __builtin_popcount(statistics & kAll);
+}
+
+UINT Statistics::GetFeatureIdx(UINT statistics, UINT statistic){
+	return __builtin_popcount(statistics & kAll & (statistic - 1));
+}
+
+void Statistics::Compute(const Signal & signal, UINT statistics, FeatureVector & features, Float * scratch) {
+	
+	UINT n = signal.getSize();
+	bool computeMeanCrossings = (statistics & kMeanCrossingRate) != 0;
+	std::vector<Float> ownedScratch;
+	if(computeMeanCrossings && scratch == nullptr){
+		ownedScratch.resize(n);
+		scratch = ownedScratch.data();
+	}
+	
+	//a single pass over the Signal
+	StatisticsAccumulator accumulator(signal[0]);
+	if(computeMeanCrossings){
+		scratch[0] = signal[0];
+		ForEachNextValue(signal, [&](UINT i, Float value){
+			accumulator.add(value);
+			scratch[i] = value;
+		});
+	} else {
+		ForEachNextValue(signal, [&](UINT i, Float value){
+			accumulator.add(value);
+		});
+	}
+	
+	//the crossings of the mean are counted on the gathered values
+	UINT meanCrossings = 0;
+	if(computeMeanCrossings){
+		bool previousSign = signbit(scratch[0] - accumulator.mean);
+		for(UINT i = 1 ; i < n ; i++){
+			bool sign = signbit(scratch[i] - accumulator.mean);
+			meanCrossings += (sign != previousSign);
+			previousSign = sign;
+		}
+	}
+	
+	Float variance = accumulator.m2 / (float) (n - 1);
+	features.resize(GetNumFeatures(statistics));
+	UINT featureIdx = 0;
+	if(statistics & kMean) features[featureIdx++] = accumulator.mean;
+	if(statistics & kVariance) features[featureIdx++] = variance;
+	if(statistics & kSTD) features[featureIdx++] = sqrt(variance);
+	if(statistics & kMinimum) features[featureIdx++] = accumulator.minimum;
+	if(statistics & kMaximum) features[featureIdx++] = accumulator.maximum;
+	if(statistics & kRange) features[featureIdx++] = accumulator.maximum - accumulator.minimum;
+	if(statistics & kRMS) features[featureIdx++] = sqrt(accumulator.sumSquares / (float) n);
+	if(statistics & kEnergy) features[featureIdx++] = accumulator.sumSquares;
+	if(statistics & kZeroCrossingRate) features[featureIdx++] = (float) accumulator.signChanges / (float) n;
+	if(statistics & kMeanCrossingRate) features[featureIdx++] = (float) meanCrossings / (float) n;
+}
+
+Data* Statistics::execute(Data * data) {
+	FeatureVector * features = new FeatureVector(getNumFeatures());
+	Compute(*(Signal*) data, statistics, *features);
+	return features;
+}
+
+Data* Statistics::execute(Data * data, ExecutionContext & context) {
+	Signal * signal = (Signal*) data;
+	FeatureVector * features = context.create<FeatureVector>(getNumFeatures());
+	Float * scratch = nullptr;
+	if(statistics & kMeanCrossingRate){
+		scratch = (Float*) context.getArena().allocate(sizeof(Float) * signal->getSize());
+	}
+	Compute(*signal, statistics, *features, scratch);
+	return features;
+}
+
+}
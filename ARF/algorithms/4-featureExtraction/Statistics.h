@@ -0,0 +1,128 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+@brief This feature extraction algorithm computes a set of statistics of a Signal in a single pass over the Signal and returns them in a FeatureVector. It replaces a branch of Mean, STD, Minimum and ZCR algorithms that read the same window once each
+
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#ifndef ARF_STATISTICS_H
+#define ARF_STATISTICS_H
+
+#include "Algorithm.h"
+#include "../../utils/ARFTypedefs.h"
+#include "../../dataStructures/Vector.h"
+
+namespace ARF {
+
+class Statistics : public Algorithm {
+	
+public:
+	
+	//the statistics that can be computed, combined as a bit mask. The FeatureVector contains the selected statistics in this order
+	static const UINT kMean = 1 << 0;
+	static const UINT kVariance = 1 << 1; ///< The sample variance, computed with Welford's algorithm
+	static const UINT kSTD = 1 << 2; ///< The sample standard deviation, as computed by STD
+	static const UINT kMinimum = 1 << 3;
+	static const UINT kMaximum = 1 << 4;
+	static const UINT kRange = 1 << 5; ///< The maximum minus the minimum
+	static const UINT kRMS = 1 << 6; ///< The root mean square
+	static const UINT kEnergy = 1 << 7; ///< The sum of the squared values
+	static const UINT kZeroCrossingRate = 1 << 8; ///< The number of sign changes divided by the number of values, as computed by ZCR
+	static const UINT kMeanCrossingRate = 1 << 9; ///< The number of times the Signal crosses its mean divided by the number of values
+	static const UINT kAll = (1 << 10) - 1;
+	
+private:
+	UINT statistics; ///< The bit mask of the statistics computed
+	
+public:
+	
+	/**
+	 Main constructor
+	 
+	 @param statistics a bit mask of the statistics that will be computed, e.g. kMean | kSTD | kMinimum | kZeroCrossingRate
+	 */
+	Statistics(UINT statistics = kAll);
+	
+	/**
+	 Retrieves the statistics computed by this algorithm
+	 
+	 @return the bit mask of the statistics
+	 */
+	UINT getStatistics() const{
+		return statistics;
+	}
+	
+	/**
+	 Retrieves the number of features in the FeatureVectors returned by this algorithm
+	 
+	 @return the number of statistics computed
+	 */
+	UINT getNumFeatures() const{
+		return GetNumFeatures(statistics);
+	}
+	
+	/**
+	 Counts the statistics selected in a bit mask
+	 
+	 @param statistics a bit mask of statistics
+	 @return the number of features computed for the bit mask
+	 */
+	static UINT GetNumFeatures(UINT statistics);
+	
+	/**
+	 Retrieves the index of a statistic in the FeatureVectors computed for a bit mask
+	 
+	 @param statistics the bit mask of the statistics computed
+	 @param statistic the statistic, e.g. kSTD
+	 @return the index of the statistic in the FeatureVector
+	 */
+	static UINT GetFeatureIdx(UINT statistics, UINT statistic);
+	
+	/**
+	 Computes a set of statistics of a Signal reading every value of the Signal once. When the mean crossing rate is computed, the values read are gathered in the scratch array and the crossings are counted on it once the mean is known
+	 
+	 @param signal A Signal with at least two values
+	 @param statistics the bit mask of the statistics that will be computed
+	 @param features The FeatureVector the statistics are written to, resized to GetNumFeatures(statistics)
+	 @param scratch An array of at least signal.getSize() Floats, used only to compute the mean crossing rate. If NULL, the array is allocated when needed
+	 */
+	static void Compute(const Signal & signal, UINT statistics, FeatureVector & features, Float * scratch = nullptr);
+	
+	/**
+	 Returns a FeatureVector with the statistics of the input Signal
+	 
+	 @param data A Signal
+	 @return A FeatureVector with the statistics of the Signal
+	 */
+	Data* execute(Data * data) override;
+	
+	/**
+	 Returns a FeatureVector with the statistics of the input Signal, allocated from the execution context
+	 
+	 @param data A Signal
+	 @param context the context the output is allocated from
+	 @return A FeatureVector with the statistics of the Signal
+	 */
+	Data* execute(Data * data, ExecutionContext & context) override;
+};
+
+}
+
+#endif //ARF_STATISTICS_H
@@ -19,21 +19,61 @@
  */
 
 #include "ZCR.h"
+#include "FeatureKernels.h"
 #include "../../dataStructures/Value.h"
 #include "DataIterator.h"
 #include <math.h>
 
 namespace ARF {
 
-Data* ZCR::execute(Data * data) {
-	const Signal &signal = *(Signal*) data;
+Feature ZCR::Compute(const Signal & signal) {
+	
+	StridedSpan span;
+	if(signal.getSpan(span)){
+		return Compute(span);
+	}
+	
 	UINT n = signal.getSize();
 	
 	int zeroCrossingCount = 0;
 	for (int i = 0; i < n-1; i++) {
 		if (signbit(signal[i+1]) != signbit(signal[i])) zeroCrossingCount++;
 	}
-	return new Value((float)zeroCrossingCount / (float)n);
+	return (float)zeroCrossingCount / (float)n;
+}
+
+Feature ZCR::Compute(const StridedSpan & span) {
+	
+	if(span.stride == 1){
+		UINT zeroCrossingCount = FeatureKernels::CountSignChanges(span.first, span.firstSize);
+		if(span.secondSize > 0){
+			zeroCrossingCount += FeatureKernels::CountSignChanges(span.second, span.secondSize);
+			zeroCrossingCount += (signbit(span.second[0]) != signbit(span.first[span.firstSize - 1]));
+		}
+		return (float)zeroCrossingCount / (float) span.getSize();
+	}
+	
+	int zeroCrossingCount = 0;
+	bool previousSign = signbit(span.first[0]);
+	for(UINT i = 1 ; i < span.firstSize ; i++){
+		bool sign = signbit(span.first[(size_t) i * span.stride]);
+		zeroCrossingCount += (sign != previousSign);
+		previousSign = sign;
+	}
+	for(UINT i = 0 ; i < span.secondSize ; i++){
+		bool sign = signbit(span.second[(size_t) i * span.stride]);
+		zeroCrossingCount += (sign != previousSign);
+		previousSign = sign;
+	}
+	return (float)zeroCrossingCount / (float) span.getSize();
+}
+
+Data* ZCR::execute(Data * data) {
+	return new Value(Compute(*(Signal*) data));
+}
+
+Data* ZCR::execute(Data * data, ExecutionContext & context) {
+	return context.create<Value>(Compute(*(Signal*) data));
 }
 
 }
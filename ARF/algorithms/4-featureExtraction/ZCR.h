@@ -33,6 +33,22 @@ namespace ARF {
 class ZCR : public Algorithm {
 public:
 	
+	/**
+	Computes the zero-crossing rate of a Signal
+	
+	@param signal A Signal
+	@return The zero-crossing rate of the Signal
+	*/
+	static Feature Compute(const Signal & signal);
+	
+	/**
+	Computes the zero crossing rate of the values of a span, without virtual calls nor bounds checks
+	
+	@param span The values of a Signal
+	@return The zero crossing rate of the values
+	*/
+	static Feature Compute(const StridedSpan & span);
+	
 	/**
 	Returns the zero-crossing-rate of the input Signal
 	
@@ -40,6 +56,15 @@ public:
 	@return The zero-crossing rate of the Signal
 	*/
 	Data* execute(Data * data) override;
+	
+	/**
+	Returns the zero-crossing rate of the input Signal, allocated from the execution context
+	
+	@param data A Signal
+	@param context the context the output is allocated from
+	@return The zero-crossing rate of the Signal
+	*/
+	Data* execute(Data * data, ExecutionContext & context) override;
 };
 
 }
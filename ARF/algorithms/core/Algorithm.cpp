@@ -18,16 +18,13 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
-#include <stack>
 #include "Algorithm.h"
+#include "PipelinePlan.h"
 #include "ARFTypedefs.h"
-#include "../../dataStructures/DataIterator.h"
 #include "../../dataStructures/Data.h"
 
 namespace ARF {
 
-typedef std::shared_ptr<Data> SharedDataPtr;
-
 const Vector<Algorithm*> & Algorithm::getNextAlgorithms() const{
 	return nextAlgorithms;
 }
@@ -46,58 +43,65 @@ Algorithm& Algorithm::operator<<(Algorithm &&algorithm){
 	return algorithm;
 }
 
-UINT Algorithm::ExecutePipeline(Algorithm * root, Data * inputData, Vector<Data*> & outputVector) {
-	std::stack<Algorithm*> algorithmStack;
-	std::stack<SharedDataPtr> dataStack;
+Data* Algorithm::execute(Data* data, ExecutionContext & context){
+	Data * output = execute(data);
 	
-	//add first algorithm to algorithm stack
-	algorithmStack.push(root);
-	
-	//add input data to data stack
-	Data * input = inputData->clone();
-	dataStack.push(SharedDataPtr(input));
+	//data passed through is owned by whoever allocated it
+	if(output != data){
+		context.getArena().adopt(output);
+	}
+	return output;
+}
+
+bool Algorithm::supportsBatch() const{
+	return false;
+}
+
+void Algorithm::executeBatch(Data** input, Data** output, UINT numInputs, ExecutionContext & context){
+	for(UINT i = 0 ; i < numInputs ; i++){
+		output[i] = (input[i] == nullptr) ? nullptr : execute(input[i], context);
+	}
+}
+
+UINT Algorithm::getStateSize() const{
+	return 0;
+}
+
+void Algorithm::initializeState(void * state) const{
+}
+
+void Algorithm::destroyState(void * state) const{
+}
+
+bool Algorithm::getColumnIndices(Vector<uint8_t> & columnIndices) const{
+	return false;
+}
+
+void Algorithm::setColumnIndices(const Vector<uint8_t> & columnIndices){
+}
+
+const IterableValues * Algorithm::getColumnsIterable() const{
+	return nullptr;
+}
+
+const Algorithm * Algorithm::getColumnsSource() const{
+	return nullptr;
+}
+
+const IterableValues * Algorithm::getSamplesIterable() const{
+	return nullptr;
+}
+
+UINT Algorithm::ExecutePipeline(Algorithm * root, Data * inputData, Vector<Data*> & outputVector) {
+	PipelinePlan plan(root);
 	
-	UINT outputCount = 0;
+	UINT outputCount = plan.execute(inputData, outputVector);
 	
-	while (!algorithmStack.empty()) {
-		
-		//get top algorithm and remove it from the stack
-		root = algorithmStack.top();
-		algorithmStack.pop();
-		
-		//get top data and remove it from the stack
-		SharedDataPtr inputDataPtr = dataStack.top();
-		Data * input = inputDataPtr.get();
-		dataStack.pop();
-		
-		//execute algorithm
-		Data * output = root->execute(input);
-		
-		//finish if the current algorithm did not produce an output
-		if(output == nullptr) break;
-		
-		//reuse shared pointer if the same input was returned
-		SharedDataPtr outputDataPtr;
-		if(input == output){
-			outputDataPtr = inputDataPtr;
-		} else {
-			outputDataPtr = SharedDataPtr(output);
-		}
-		
-		Vector<Algorithm*> nextAlgorithms = root->getNextAlgorithms();
-		if(nextAlgorithms.empty()){
-			outputVector[outputCount++] = output->clone();
-		} else {
-			//push next algorithms to the stack backwards
-			for (int i = nextAlgorithms.getSize()-1 ; i >= 0 ; i--){
-				Algorithm * algorithm = nextAlgorithms[i];
-				algorithmStack.push(algorithm);
-				dataStack.push(outputDataPtr);
-			}
-		}
+	//the caller owns the output, the data in the plan is released with it
+	for(UINT i = 0 ; i < outputCount ; i++){
+		outputVector[i] = outputVector[i]->clone();
 	}
 	return outputCount;
-	
 }
 
 }
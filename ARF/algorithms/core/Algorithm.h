@@ -28,6 +28,8 @@
 
 #include "../../dataStructures/Data.h"
 #include "../../dataStructures/Vector.h"
+#include "../../utils/ARFTypedefs.h"
+#include "ExecutionContext.h"
 
 namespace ARF {
 
@@ -45,6 +47,89 @@ public:
 	*/
 	virtual Data* execute(Data* data) = 0;
 	
+	/**
+	Executes the main function of this algorithm, allocating its output from the execution context. The output is owned by the context and must not be deleted by the caller. Algorithms that do not override this method fall back to execute(Data*) and the context adopts the data they allocate
+	
+	@param data the data used as input to this algorithm
+	@param context the context the output is allocated from
+	@return the output of this algorithm, or a NULL pointer if the algorithm does not return any output
+	*/
+	virtual Data* execute(Data* data, ExecutionContext & context);
+	
+	/**
+	Retrieves whether this algorithm can process several inputs in a single call to executeBatch(). A PipelinePlan passes every input of a block to executeBatch() once, in sample order and with the execution context of the stream, before the algorithms that are not batched process the samples of the block. Algorithms whose output depends only on their current and previous inputs, like a BiquadFilter keeping its state per stream, can return true. Algorithms that read state modified by other algorithms, like a DataSelector reading a ring buffer, should return false
+	
+	@return true if the algorithm can be executed on blocks of inputs, false otherwise
+	*/
+	virtual bool supportsBatch() const;
+	
+	/**
+	Executes the main function of this algorithm on a block of inputs. The default implementation invokes execute() once per input
+	
+	@param input the inputs to this algorithm. Inputs can be NULL pointers
+	@param output the outputs of this algorithm, output[i] is the output for input[i], or a NULL pointer if input[i] is NULL or the algorithm did not return any output. The outputs should remain valid until the context is reset
+	@param numInputs the number of elements in the input and output arrays
+	@param context the context the outputs are allocated from
+	*/
+	virtual void executeBatch(Data** input, Data** output, UINT numInputs, ExecutionContext & context);
+	
+	/**
+	Retrieves the number of bytes of mutable state this algorithm needs per stream. Algorithms that keep state between executions store it in their own members when they are executed without a state block, and in the memory returned by ExecutionContext::getState() otherwise, so that a single graph can process many streams
+	
+	@return the size of the state in bytes, 0 for stateless algorithms
+	*/
+	virtual UINT getStateSize() const;
+	
+	/**
+	Initializes the state of a new stream
+	
+	@param state uninitialized memory of getStateSize() bytes, aligned for any fundamental type
+	*/
+	virtual void initializeState(void * state) const;
+	
+	/**
+	Destroys the state of a stream
+	
+	@param state the state initialized by initializeState()
+	*/
+	virtual void destroyState(void * state) const;
+	
+	/**
+	Retrieves the columns of the samples this algorithm selects, so that a ColumnProjection can collect the columns read by a pipeline
+	
+	@param columnIndices set to the indices of the columns this algorithm reads
+	@return false if the algorithm does not select columns of the samples
+	*/
+	virtual bool getColumnIndices(Vector<uint8_t> & columnIndices) const;
+	
+	/**
+	Replaces the columns of the samples this algorithm selects, after the samples were projected to fewer columns by a ColumnProjection. Only algorithms whose getColumnIndices() returns true are asked to replace them
+	
+	@param columnIndices the indices of the columns in the projected samples, in the order of the ones returned by getColumnIndices()
+	*/
+	virtual void setColumnIndices(const Vector<uint8_t> & columnIndices);
+	
+	/**
+	Retrieves the samples the columns returned by getColumnIndices() belong to, so that a ColumnProjection only replaces the columns of the algorithms that read the projected samples
+	
+	@return the iterable the algorithm reads the columns from, like the ring buffer of a DataSelector, or NULL if it reads them from the samples passed to execute()
+	*/
+	virtual const IterableValues * getColumnsIterable() const;
+	
+	/**
+	Retrieves the algorithm that keeps the iterable returned by getColumnsIterable() in the state of every stream, so that the iterable of the stream being executed is read, like the RingBufferAlgorithm of a DataSelector created from it
+	
+	@return the algorithm, or NULL if the algorithm always reads the iterable returned by getColumnsIterable()
+	*/
+	virtual const Algorithm * getColumnsSource() const;
+	
+	/**
+	Retrieves the iterable the samples passed to execute() are stored in, for algorithms that store them and output them unchanged, like a RingBufferAlgorithm. The algorithms that follow such an algorithm receive the same samples
+	
+	@return the iterable the samples are stored in, or NULL if the algorithm does not store the samples it receives
+	*/
+	virtual const IterableValues * getSamplesIterable() const;
+	
 	/**
 	Virtual destructor of this algorithm
 	*/
@@ -81,7 +166,7 @@ public:
 	Algorithm& operator<<(Algorithm &&algorithm);
 	
 	/**
-	Performs a depth-first traversal of the directed graph that as a root the input algorithm. It invokes the execute() method of every algorithm passing as input the pointer to the data instance output by the previous algorithm's execute() method
+	Performs a depth-first traversal of the directed graph that as a root the input algorithm. It invokes the execute() method of every algorithm passing as input the pointer to the data instance output by the previous algorithm's execute() method. The algorithms below an algorithm that does not produce an output are skipped. To execute the same graph many times, compile it once into a PipelinePlan instead
 	
 	@param algorithm the root of the directed graph
 	@param data the input data 	
@@ -0,0 +1,144 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ColumnProjection.h"
+#include "../../utils/ARFException.h"
+#include <algorithm>
+#include <string>
+
+namespace ARF {
+
+ColumnProjection::ColumnProjection(Algorithm * root, UINT numSourceColumns) : numSourceColumns(numSourceColumns), projectedColumns(numSourceColumns, -1), applied(false) {
+	
+	if(root != nullptr){
+		collect(root);
+	}
+	
+	//the union of the selected columns, in increasing order
+	for(size_t i = 0 ; i < algorithms.size() ; i++){
+		const Vector<uint8_t> & columnIndices = sourceColumnIndices[i];
+		for(UINT j = 0 ; j < columnIndices.getSize() ; j++){
+			if(columnIndices[j] >= numSourceColumns){
+				throw ARFException("ColumnProjection::ColumnProjection() an algorithm selects column " + std::to_string(columnIndices[j]) + " of samples of " + std::to_string(numSourceColumns) + " columns");
+			}
+			projectedColumns[columnIndices[j]] = 0;
+		}
+	}
+	for(UINT j = 0 ; j < numSourceColumns ; j++){
+		if(projectedColumns[j] == 0 || algorithms.size() == 0){
+			projectedColumns[j] = (int) columns.getSize();
+			columns.push_back(j);
+		}
+	}
+}
+
+//finds the algorithms that receive the samples of the root: the root, and the algorithms that follow an algorithm that stores them and outputs them unchanged, like a RingBufferAlgorithm
+static void FindSampleReceivers(Algorithm * algorithm, std::vector<Algorithm*> & receivers, std::vector<const IterableValues*> & sampleIterables){
+	if(std::find(receivers.begin(), receivers.end(), algorithm) != receivers.end()){
+		return;
+	}
+	receivers.push_back(algorithm);
+	
+	const IterableValues * samples = algorithm->getSamplesIterable();
+	if(samples != nullptr){
+		sampleIterables.push_back(samples);
+		const Vector<Algorithm*> & nextAlgorithms = algorithm->getNextAlgorithms();
+		for(UINT i = 0 ; i < nextAlgorithms.getSize() ; i++){
+			FindSampleReceivers(nextAlgorithms[i], receivers, sampleIterables);
+		}
+	}
+}
+
+//finds every algorithm of a graph, each of them once
+static void FindAlgorithms(Algorithm * algorithm, std::vector<Algorithm*> & graph){
+	if(std::find(graph.begin(), graph.end(), algorithm) != graph.end()){
+		return;
+	}
+	graph.push_back(algorithm);
+	
+	const Vector<Algorithm*> & nextAlgorithms = algorithm->getNextAlgorithms();
+	for(UINT i = 0 ; i < nextAlgorithms.getSize() ; i++){
+		FindAlgorithms(nextAlgorithms[i], graph);
+	}
+}
+
+void ColumnProjection::collect(Algorithm * root){
+	
+	std::vector<Algorithm*> receivers;
+	std::vector<const IterableValues*> sampleIterables;
+	FindSampleReceivers(root, receivers, sampleIterables);
+	
+	std::vector<Algorithm*> graph;
+	FindAlgorithms(root, graph);
+	
+	//the columns of an algorithm are projected if it reads them from the samples it receives and it receives the samples of the root, or from an iterable the samples of the root are stored in. Algorithms reading other data, like a DataSelector over the output of a FeatureVector, are not modified
+	for(size_t i = 0 ; i < graph.size() ; i++){
+		Vector<uint8_t> columnIndices;
+		if(!graph[i]->getColumnIndices(columnIndices)){
+			continue;
+		}
+		const IterableValues * iterable = graph[i]->getColumnsIterable();
+		bool readsSamples = (iterable == nullptr) ? std::find(receivers.begin(), receivers.end(), graph[i]) != receivers.end() :
+		std::find(sampleIterables.begin(), sampleIterables.end(), iterable) != sampleIterables.end();
+		if(readsSamples){
+			algorithms.push_back(graph[i]);
+			sourceColumnIndices.push_back(columnIndices);
+		}
+	}
+}
+
+void ColumnProjection::apply(){
+	if(applied){
+		return;
+	}
+	for(size_t i = 0 ; i < algorithms.size() ; i++){
+		Vector<uint8_t> columnIndices = sourceColumnIndices[i];
+		for(UINT j = 0 ; j < columnIndices.getSize() ; j++){
+			columnIndices[j] = (uint8_t) projectedColumns[columnIndices[j]];
+		}
+		algorithms[i]->setColumnIndices(columnIndices);
+	}
+	applied = true;
+}
+
+void ColumnProjection::restore(){
+	if(!applied){
+		return;
+	}
+	for(size_t i = 0 ; i < algorithms.size() ; i++){
+		algorithms[i]->setColumnIndices(sourceColumnIndices[i]);
+	}
+	applied = false;
+}
+
+void ColumnProjection::project(const Float * sample, Float * projectedSample) const{
+	for(UINT k = 0 ; k < columns.getSize() ; k++){
+		projectedSample[k] = sample[columns[k]];
+	}
+}
+
+void ColumnProjection::projectRows(const Float * samples, UINT numSamples, UINT stride, Float * projectedSamples) const{
+	const UINT numColumns = columns.getSize();
+	for(UINT i = 0 ; i < numSamples ; i++){
+		project(samples + (size_t) i * stride, projectedSamples + (size_t) i * numColumns);
+	}
+}
+
+}
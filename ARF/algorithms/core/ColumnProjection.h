@@ -0,0 +1,151 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The ColumnProjection collects the columns of the samples read by the DataSelectors of a pipeline, so that the samples are loaded, copied and stored in the ring buffer with only those columns, and maps the column indices of the DataSelectors to the columns of the projected samples
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_COLUMN_PROJECTION_H
+#define ARF_COLUMN_PROJECTION_H
+
+#include <vector>
+#include "Algorithm.h"
+#include "../../dataStructures/Vector.h"
+#include "../../utils/ARFTypedefs.h"
+#include "../../utils/ARFException.h"
+
+namespace ARF {
+
+/**
+ Traverses the graph of a pipeline and collects the union of the columns of the samples selected by its algorithms: the columns of its DataSelectors and SlidingFeatures, and the columns tracked and indexed by its ring buffers. Only the algorithms that read the samples passed to the root, or the ring buffers they are stored in, are collected. apply() replaces their column indices by the indices of the same columns in the projected samples, which contain only the collected columns in increasing order. A pipeline that reads columns 0, 1 and 2 of samples of 16 columns is then executed on samples of 3 columns, which a DataSetReader reads without the other columns:
+ 
+	ColumnProjection projection(pipeline.getRoot(), reader.getNumColumns());
+	projection.apply();
+	reader.selectColumns(projection.getColumns());
+	for(UINT numSamples = reader.readBlock() ; numSamples > 0 ; numSamples = reader.readBlock()){
+		plan.executeBlock(reader.getBlock(), numSamples, reader.getNumColumns(), reader.getNumColumns(), output, sampleIndices);
+	}
+ 
+ Only the algorithms that select columns through Algorithm::getColumnIndices() are remapped, and Algorithm::getColumnsIterable() tells which samples the columns belong to. Algorithms that process whole samples before they reach the ring buffer, like a BiquadFilter, receive the projected samples and should be configured for getNumColumns() channels. A pipeline whose algorithms select no columns keeps every column
+ */
+class ColumnProjection {
+	
+private:
+	UINT numSourceColumns; ///< The number of values of the samples before they are projected
+	Vector<UINT> columns; ///< The columns of the samples kept in the projected samples, in increasing order
+	Vector<int> projectedColumns; ///< The index in the projected samples of every column of the samples, or -1 if it is not kept
+	std::vector<Algorithm*> algorithms; ///< The algorithms of the graph that select columns of the samples, each of them once
+	std::vector<Vector<uint8_t> > sourceColumnIndices; ///< The columns selected by every algorithm before the projection was applied
+	bool applied; ///< Whether the column indices of the algorithms refer to the projected samples
+	
+	/**
+	 Collects the algorithms of a graph that select columns of the samples passed to its root
+	 
+	 @param root the root of the graph
+	 */
+	void collect(Algorithm * root);
+	
+	ColumnProjection(const ColumnProjection &rhs);
+	ColumnProjection& operator=(const ColumnProjection &rhs);
+	
+public:
+	
+	/**
+	 Collects the columns read by a pipeline. The pipeline is not modified until apply() is called. Throws an ARFException if an algorithm selects a column the samples do not have
+	 
+	 @param root the root of the graph of the pipeline
+	 @param numSourceColumns the number of values of the samples the pipeline was built for
+	 */
+	ColumnProjection(Algorithm * root, UINT numSourceColumns);
+	
+	/**
+	 Makes the algorithms of the pipeline select the columns of the projected samples. The pipeline should be executed on projected samples afterwards
+	 */
+	void apply();
+	
+	/**
+	 Makes the algorithms of the pipeline select the columns of the samples again, as before apply() was called
+	 */
+	void restore();
+	
+	/**
+	 Copies the columns of a sample that are kept into a projected sample
+	 
+	 @param sample the getNumSourceColumns() values of the sample
+	 @param projectedSample set to the getNumColumns() values of the projected sample
+	 */
+	void project(const Float * sample, Float * projectedSample) const;
+	
+	/**
+	 Copies the columns of consecutive samples that are kept into projected samples, which are stored one after the other
+	 
+	 @param samples the values of the first sample
+	 @param numSamples the number of samples
+	 @param stride the number of values between the beginning of two consecutive samples, at least getNumSourceColumns()
+	 @param projectedSamples set to the numSamples * getNumColumns() values of the projected samples
+	 */
+	void projectRows(const Float * samples, UINT numSamples, UINT stride, Float * projectedSamples) const;
+	
+	/**
+	 Retrieves the columns of the samples read by the pipeline, which DataSetReader::selectColumns() and DataSet::selectColumns() accept
+	 
+	 @return the indices of the columns in the samples, in increasing order
+	 */
+	const Vector<UINT> & getColumns() const{
+		return columns;
+	}
+	
+	/**
+	 Retrieves the index of a column of the samples in the projected samples
+	 
+	 @param sourceColumn the index of the column in the samples, should be in the range [0 getNumSourceColumns())
+	 @return the index of the column in the projected samples, or -1 if the pipeline does not read the column
+	 */
+	int getProjectedColumn(UINT sourceColumn) const{
+		if(sourceColumn >= numSourceColumns) throw ARFException("ColumnProjection::getProjectedColumn() invalid column index");
+		return projectedColumns[sourceColumn];
+	}
+	
+	UINT getNumColumns() const{
+		return columns.getSize();
+	}
+	
+	UINT getNumSourceColumns() const{
+		return numSourceColumns;
+	}
+	
+	/**
+	 Retrieves the number of algorithms of the pipeline whose columns are remapped
+	 
+	 @return the number of algorithms that select columns
+	 */
+	UINT getNumAlgorithms() const{
+		return (UINT) algorithms.size();
+	}
+	
+	bool isApplied() const{
+		return applied;
+	}
+};
+
+}
+
+#endif //ARF_COLUMN_PROJECTION_H
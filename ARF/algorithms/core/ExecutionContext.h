@@ -0,0 +1,163 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The ExecutionContext holds the resources an Algorithm can use while it executes as part of a pipeline. Algorithms allocate their outputs from the context's DataArena instead of the heap, so that the data produced during an execution is owned by the context and released at once when its arena is reset.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_EXECUTION_CONTEXT_H
+#define ARF_EXECUTION_CONTEXT_H
+
+#include <utility>
+#include "../../dataStructures/DataArena.h"
+
+namespace ARF {
+
+class Algorithm;
+
+/**
+ The location of the state of an algorithm in a state block
+ */
+struct AlgorithmState {
+	const Algorithm * algorithm; ///< The algorithm the state belongs to
+	UINT offset; ///< The offset of the state in bytes from the beginning of the state block
+};
+
+class ExecutionContext {
+	
+private:
+	DataArena arena; ///< The arena the outputs of the algorithms are allocated from
+	char * stateBlock; ///< The state of the stream being executed, or NULL if the algorithms use their own state
+	const AlgorithmState * states; ///< The location of the state of every stateful algorithm in the state block
+	UINT numStates; ///< The number of elements in the states array
+	
+	ExecutionContext(const ExecutionContext &rhs);
+	ExecutionContext& operator=(const ExecutionContext &rhs);
+	
+public:
+	
+	/**
+	 Main constructor of the execution context
+	 
+	 @param arenaChunkSize the number of bytes the arena requests to the system when it runs out of memory
+	 */
+	ExecutionContext(size_t arenaChunkSize = 4096) : arena(arenaChunkSize), stateBlock(nullptr), states(nullptr), numStates(0) { }
+	
+	/**
+	 Retrieves the arena the outputs of the algorithms are allocated from
+	 
+	 @return a reference to the arena
+	 */
+	DataArena & getArena(){
+		return arena;
+	}
+	
+	/**
+	 Constructs an object in the arena of this context
+	 
+	 @param args the arguments passed to the constructor of the object
+	 @return a pointer to the new object, valid until the arena is reset
+	 */
+	template <typename T, typename... Args>
+	T * create(Args&&... args){
+		return arena.create<T>(std::forward<Args>(args)...);
+	}
+	
+	/**
+	 Constructs an array of objects in the arena of this context
+	 
+	 @param size the number of objects in the array
+	 @param args the arguments passed to the constructor of every object
+	 @return a pointer to the first object, valid until the arena is reset
+	 */
+	template <typename T, typename... Args>
+	T * createArray(UINT size, const Args&... args){
+		return arena.createArray<T>(size, args...);
+	}
+	
+	/**
+	 Sets the state block of the stream being executed. While a state block is set, stateful algorithms read and modify the state in the block instead of their own state
+	 
+	 @param stateBlock the state of the stream, or NULL to let the algorithms use their own state
+	 @param states the location of the state of every stateful algorithm in the block
+	 @param numStates the number of elements in the states array
+	 */
+	void setStateBlock(char * stateBlock, const AlgorithmState * states, UINT numStates){
+		this->stateBlock = stateBlock;
+		this->states = states;
+		this->numStates = numStates;
+	}
+	
+	/**
+	 Retrieves the state block of the stream being executed
+	 
+	 @return the state block, or NULL if the algorithms use their own state
+	 */
+	char * getStateBlock() const{
+		return stateBlock;
+	}
+	
+	/**
+	 Retrieves the location of the state of every stateful algorithm in the state block
+	 
+	 @return the states array passed to setStateBlock()
+	 */
+	const AlgorithmState * getStates() const{
+		return states;
+	}
+	
+	/**
+	 Retrieves the number of stateful algorithms in the state block
+	 
+	 @return the number of elements in the states array
+	 */
+	UINT getNumStates() const{
+		return numStates;
+	}
+	
+	/**
+	 Retrieves the state of an algorithm in the current state block
+	 
+	 @param algorithm the algorithm
+	 @return a pointer to the state of the algorithm, or NULL if no state block is set or the algorithm has no state in it
+	 */
+	void * getState(const Algorithm * algorithm) const{
+		if(stateBlock != nullptr){
+			for(UINT i = 0 ; i < numStates ; i++){
+				if(states[i].algorithm == algorithm){
+					return stateBlock + states[i].offset;
+				}
+			}
+		}
+		return nullptr;
+	}
+	
+	/**
+	 Destroys the data allocated in this context
+	 */
+	void reset(){
+		arena.reset();
+	}
+};
+
+}
+
+#endif //ARF_EXECUTION_CONTEXT_H
@@ -0,0 +1,338 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "PipelinePlan.h"
+#include "../../utils/ARFException.h"
+
+namespace ARF {
+
+PipelinePlan::PipelinePlan(Algorithm * root) : numLeaves(0), numBatchedNodes(0), blockSize(0),
+threadPool(nullptr), numParallelNodes(0), parallelBlockIdx(-1) {
+	
+	if(root == nullptr){
+		throw ARFException("PipelinePlan::PipelinePlan() root should not be NULL");
+	}
+	
+	compile(root, -1);
+	
+	//preallocate the memory used during the execution
+	results.resize(nodes.getSize(), nullptr);
+	leafResults.resize(numLeaves, nullptr);
+	parallelTasks.resize(nodes.getSize(), 0);
+}
+
+PipelinePlan::~PipelinePlan(){
+	for(UINT i = 1 ; i < workerContexts.getSize() ; i++){
+		delete workerContexts[i];
+	}
+}
+
+void PipelinePlan::compile(Algorithm * algorithm, int parentIdx){
+	
+	//an algorithm that is its own ancestor would make the graph infinite
+	for(int idx = parentIdx ; idx >= 0 ; idx = nodes[idx].parentIdx){
+		if(nodes[idx].algorithm == algorithm){
+			throw ARFException("PipelinePlan::compile() the graph contains a cycle");
+		}
+	}
+	
+	const Vector<Algorithm*> & nextAlgorithms = algorithm->getNextAlgorithms();
+	
+	Node node;
+	node.algorithm = algorithm;
+	node.parentIdx = parentIdx;
+	node.subtreeEnd = 0;
+	node.isLeaf = nextAlgorithms.empty();
+	node.batchIdx = -1;
+	node.firstLeafIdx = numLeaves;
+	node.leafEnd = numLeaves;
+	node.isParallel = false;
+	
+	//an algorithm is executed in batches only if its whole input block can be computed beforehand
+	bool parentBatched = (parentIdx < 0 || nodes[parentIdx].batchIdx >= 0);
+	if(parentBatched && algorithm->supportsBatch()){
+		node.batchIdx = numBatchedNodes++;
+	}
+	
+	UINT nodeIdx = nodes.getSize();
+	nodes.push_back(node);
+	
+	if(node.isLeaf){
+		numLeaves++;
+	}
+	
+	for(UINT i = 0 ; i < nextAlgorithms.getSize() ; i++){
+		compile(nextAlgorithms[i], nodeIdx);
+	}
+	
+	nodes[nodeIdx].subtreeEnd = nodes.getSize();
+	nodes[nodeIdx].leafEnd = numLeaves;
+}
+
+void PipelinePlan::setThreadPool(ThreadPool * threadPool, UINT minParallelNodes){
+	
+	//a pool without threads executes every task on the calling thread
+	if(threadPool != nullptr && threadPool->getNumWorkers() < 2){
+		threadPool = nullptr;
+	}
+	
+	this->threadPool = threadPool;
+	numParallelNodes = 0;
+	
+	for(UINT i = 1 ; i < workerContexts.getSize() ; i++){
+		delete workerContexts[i];
+	}
+	workerContexts.clear();
+	
+	for(UINT nodeIdx = 0 ; nodeIdx < nodes.getSize() ; nodeIdx++){
+		Node & node = nodes[nodeIdx];
+		node.isParallel = false;
+		
+		UINT numNodesBelow = node.subtreeEnd - nodeIdx - 1;
+		if(threadPool == nullptr || node.isLeaf || numNodesBelow < minParallelNodes){
+			continue;
+		}
+		
+		//the subtrees need at least two next algorithms and should not share algorithm instances
+		UINT numSubtrees = 0;
+		bool independent = true;
+		for(UINT childIdx = nodeIdx + 1 ; childIdx < node.subtreeEnd ; childIdx = nodes[childIdx].subtreeEnd){
+			for(UINT idx = childIdx ; idx < nodes[childIdx].subtreeEnd && independent ; idx++){
+				for(UINT otherIdx = nodes[childIdx].subtreeEnd ; otherIdx < node.subtreeEnd ; otherIdx++){
+					if(nodes[idx].algorithm == nodes[otherIdx].algorithm){
+						independent = false;
+						break;
+					}
+				}
+			}
+			numSubtrees++;
+		}
+		
+		if(numSubtrees > 1 && independent){
+			node.isParallel = true;
+			numParallelNodes++;
+		}
+	}
+	
+	//the first context is the context of the calling thread
+	if(numParallelNodes > 0){
+		workerContexts.push_back(nullptr);
+		for(UINT i = 1 ; i < threadPool->getNumWorkers() ; i++){
+			workerContexts.push_back(new ExecutionContext());
+		}
+	}
+}
+
+UINT PipelinePlan::getNumParallelNodes() const{
+	return numParallelNodes;
+}
+
+void PipelinePlan::resetContexts(){
+	context.reset();
+	for(UINT i = 1 ; i < workerContexts.getSize() ; i++){
+		workerContexts[i]->reset();
+	}
+}
+
+UINT PipelinePlan::execute(Data * data, Vector<Data*> & output){
+	
+	//release the data produced by the previous execution
+	resetContexts();
+	
+	return execute(data, output, context);
+}
+
+UINT PipelinePlan::execute(Data * data, Vector<Data*> & output, ExecutionContext & context){
+	return executeNodes(0, nodes.getSize(), data, output.getData(), context, -1);
+}
+
+UINT PipelinePlan::executeBlock(const SensorSample * samples, UINT numSamples, Vector<Data*> & output, Vector<UINT> & sampleIndices){
+	
+	//release the data produced by the previous block
+	resetContexts();
+	
+	UINT maxOutputCount = numSamples * numLeaves;
+	if(output.getSize() < maxOutputCount){
+		output.resize(maxOutputCount);
+	}
+	if(sampleIndices.getSize() < maxOutputCount){
+		sampleIndices.resize(maxOutputCount);
+	}
+	
+	executeBatchedNodes(samples, numSamples);
+	
+	UINT outputCount = 0;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		UINT sampleOutputCount = executeNodes(0, nodes.getSize(), (Data*) &samples[i], output.getData() + outputCount, context, i);
+		for(UINT j = 0 ; j < sampleOutputCount ; j++){
+			sampleIndices[outputCount++] = i;
+		}
+	}
+	return outputCount;
+}
+
+UINT PipelinePlan::executeBlock(const Float * data, UINT numSamples, UINT numColumns, UINT stride, Vector<Data*> & output, Vector<UINT> & sampleIndices){
+	
+	if(stride < numColumns){
+		throw ARFException("PipelinePlan::executeBlock() stride should not be smaller than numColumns");
+	}
+	
+	if(blockSamples.getSize() < numSamples){
+		blockSamples.resize(numSamples);
+	}
+	
+	for(UINT i = 0 ; i < numSamples ; i++){
+		SensorSample & sample = blockSamples[i];
+		if(sample.getSize() != numColumns){
+			sample.resize(numColumns);
+		}
+		std::copy(data + i * stride, data + i * stride + numColumns, sample.getData());
+	}
+	
+	return executeBlock(blockSamples.getData(), numSamples, output, sampleIndices);
+}
+
+void PipelinePlan::executeBatchedNodes(const SensorSample * samples, UINT numSamples){
+	
+	blockSize = numSamples;
+	
+	if(numBatchedNodes == 0){
+		return;
+	}
+	
+	//the inputs of the root are stored before the outputs of the batched nodes
+	UINT batchResultsSize = (numBatchedNodes + 1) * numSamples;
+	if(batchResults.getSize() < batchResultsSize){
+		batchResults.resize(batchResultsSize);
+	}
+	
+	Data ** inputs = batchResults.getData();
+	for(UINT i = 0 ; i < numSamples ; i++){
+		inputs[i] = (Data*) &samples[i];
+	}
+	
+	for(UINT nodeIdx = 0 ; nodeIdx < nodes.getSize() ; nodeIdx++){
+		const Node & node = nodes[nodeIdx];
+		if(node.batchIdx >= 0){
+			int inputIdx = (node.parentIdx < 0) ? 0 : nodes[node.parentIdx].batchIdx + 1;
+			Data ** input = batchResults.getData() + inputIdx * numSamples;
+			Data ** output = batchResults.getData() + (node.batchIdx + 1) * numSamples;
+			node.algorithm->executeBatch(input, output, numSamples, context);
+		}
+	}
+}
+
+UINT PipelinePlan::executeNodes(UINT firstNode, UINT endNode, Data * data, Data ** output, ExecutionContext & context, int blockIdx){
+	
+	UINT outputCount = 0;
+	UINT nodeIdx = firstNode;
+	
+	while(nodeIdx < endNode){
+		const Node & node = nodes[nodeIdx];
+		Data * input = (node.parentIdx < 0) ? data : results[node.parentIdx];
+		
+		//execute algorithm, unless it was already executed for the whole block
+		Data * result;
+		if(blockIdx >= 0 && node.batchIdx >= 0){
+			result = batchResults[(node.batchIdx + 1) * blockSize + blockIdx];
+		} else {
+			result = node.algorithm->execute(input, context);
+		}
+		
+		//skip the subtree if the current algorithm did not produce an output
+		if(result == nullptr){
+			nodeIdx = node.subtreeEnd;
+			continue;
+		}
+		
+		results[nodeIdx] = result;
+		
+		if(node.isLeaf){
+			if(output != nullptr){
+				output[outputCount++] = result;
+			} else {
+				leafResults[node.firstLeafIdx] = result;
+			}
+		} else if(node.isParallel && output != nullptr){
+			outputCount += executeParallel(nodeIdx, output + outputCount, context, blockIdx);
+			nodeIdx = node.subtreeEnd;
+			continue;
+		}
+		nodeIdx++;
+	}
+	
+	return outputCount;
+}
+
+UINT PipelinePlan::executeParallel(UINT nodeIdx, Data ** output, ExecutionContext & context, int blockIdx){
+	const Node & node = nodes[nodeIdx];
+	
+	for(UINT leafIdx = node.firstLeafIdx ; leafIdx < node.leafEnd ; leafIdx++){
+		leafResults[leafIdx] = nullptr;
+	}
+	
+	UINT numTasks = 0;
+	for(UINT childIdx = nodeIdx + 1 ; childIdx < node.subtreeEnd ; childIdx = nodes[childIdx].subtreeEnd){
+		parallelTasks[numTasks++] = childIdx;
+	}
+	
+	//the workers execute the branches on the state of the stream of the caller
+	workerContexts[0] = &context;
+	for(UINT i = 1 ; i < workerContexts.getSize() ; i++){
+		workerContexts[i]->setStateBlock(context.getStateBlock(), context.getStates(), context.getNumStates());
+	}
+	parallelBlockIdx = blockIdx;
+	threadPool->run(&PipelinePlan::ExecuteTask, this, numTasks);
+	
+	//collect the outputs in depth-first order
+	UINT outputCount = 0;
+	for(UINT leafIdx = node.firstLeafIdx ; leafIdx < node.leafEnd ; leafIdx++){
+		if(leafResults[leafIdx] != nullptr){
+			output[outputCount++] = leafResults[leafIdx];
+		}
+	}
+	return outputCount;
+}
+
+void PipelinePlan::ExecuteTask(void * argument, UINT taskIdx, UINT workerIdx){
+	PipelinePlan * plan = (PipelinePlan*) argument;
+	UINT firstNode = plan->parallelTasks[taskIdx];
+	UINT endNode = plan->nodes[firstNode].subtreeEnd;
+	plan->executeNodes(firstNode, endNode, nullptr, nullptr, *plan->workerContexts[workerIdx], plan->parallelBlockIdx);
+}
+
+ExecutionContext & PipelinePlan::getContext(){
+	return context;
+}
+
+UINT PipelinePlan::getNumNodes() const{
+	return nodes.getSize();
+}
+
+UINT PipelinePlan::getNumLeaves() const{
+	return numLeaves;
+}
+
+Algorithm * PipelinePlan::getAlgorithm(UINT nodeIdx) const{
+	return nodes[nodeIdx].algorithm;
+}
+
+}
@@ -0,0 +1,229 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The PipelinePlan is a compiled version of the directed graph formed by a root Algorithm. The graph is traversed once when the plan is created and flattened into an array of nodes in the same depth-first order used by Algorithm::ExecutePipeline(). Each node stores the index of the node whose output it receives and the index of the first node after its subtree, so that the execute() method can run the whole graph with a single loop over the array, without building stacks, cloning data or copying the lists of next algorithms.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_PIPELINE_PLAN_H
+#define ARF_PIPELINE_PLAN_H
+
+#include "Algorithm.h"
+#include "ExecutionContext.h"
+#include "../../utils/ThreadPool.h"
+#include "../../dataStructures/Data.h"
+#include "../../dataStructures/Vector.h"
+#include "../../utils/ARFTypedefs.h"
+
+namespace ARF {
+
+class PipelinePlan {
+	
+public:
+	
+	/**
+	 Compiles the directed graph that has the input algorithm as root
+	 
+	 @param root the root of the directed graph
+	 */
+	PipelinePlan(Algorithm * root);
+	
+	/**
+	 Destructor, releases the execution contexts of the worker threads
+	 */
+	~PipelinePlan();
+	
+	/**
+	 Invokes the execute() method of every algorithm in the plan, passing as input the data produced by its parent algorithm. When an algorithm does not produce an output, the algorithms below it in the graph are skipped. The data produced by the algorithms is allocated from the plan's execution context, which is reset at the beginning of every execution, so the data in the output vector remains valid until the next call to execute()
+	 
+	 @param data the input data, passed to the root algorithm without being copied
+	 @param output the data produced by the leaf algorithms in the graph. Should have at least getNumLeaves() elements
+	 @return the number of results in the output vector
+	 */
+	UINT execute(Data * data, Vector<Data*> & output);
+	
+	/**
+	 Invokes the execute() method of every algorithm in the plan, allocating the data produced by the algorithms from the input execution context. The context is not reset, the caller decides when the data it holds is released
+	 
+	 @param data the input data, passed to the root algorithm without being copied
+	 @param output the data produced by the leaf algorithms in the graph. Should have at least getNumLeaves() elements
+	 @param context the context the data produced by the algorithms is allocated from
+	 @return the number of results in the output vector
+	 */
+	UINT execute(Data * data, Vector<Data*> & output, ExecutionContext & context);
+	
+	/**
+	 Executes the plan on a block of consecutive samples with a single call. The algorithms at the top of the graph that support batch execution, and whose ancestors support it as well, process the whole block with one call to executeBatch(). The rest of the algorithms are executed sample by sample in the same order as with execute(), so stateful algorithms behave exactly as if every sample had been passed to execute(). The samples are not copied. The execution context is reset once per block
+	 
+	 @param samples the first sample of the block
+	 @param numSamples the number of samples in the block
+	 @param output the data produced by the leaf algorithms for all the samples in the block, in the order they were produced. The vector is grown if it has less than numSamples * getNumLeaves() elements
+	 @param sampleIndices the index in the block of the sample that produced each element in the output vector. The vector is grown like the output vector
+	 @return the number of results in the output vector
+	 */
+	UINT executeBlock(const SensorSample * samples, UINT numSamples, Vector<Data*> & output, Vector<UINT> & sampleIndices);
+	
+	/**
+	 Executes the plan on a block of consecutive samples stored in a raw array. Every sample is copied to a buffer owned by the plan before the block is executed
+	 
+	 @param data a pointer to the first value of the first sample
+	 @param numSamples the number of samples in the block
+	 @param numColumns the number of values in every sample
+	 @param stride the number of values between the beginning of two consecutive samples, at least numColumns
+	 @param output the data produced by the leaf algorithms for all the samples in the block
+	 @param sampleIndices the index in the block of the sample that produced each element in the output vector
+	 @return the number of results in the output vector
+	 */
+	UINT executeBlock(const Float * data, UINT numSamples, UINT numColumns, UINT stride, Vector<Data*> & output, Vector<UINT> & sampleIndices);
+	
+	/**
+	 Enables the parallel execution of independent branches of the graph. When an algorithm with several next algorithms produces an output, the subgraphs below it are executed as separate tasks on the thread pool. Only algorithms with at least minParallelNodes algorithms below them are parallelized, smaller graphs are executed on the calling thread. An algorithm whose subgraphs share an algorithm instance is never parallelized. The algorithms in sibling subgraphs should not share any other state. The output vector has the same order as with sequential execution
+	 
+	 @param threadPool the thread pool the branches are executed on, or a NULL pointer to disable the parallel execution. The pool should outlive the plan and should not be used by two plans at the same time
+	 @param minParallelNodes the minimum number of algorithms below an algorithm for its subgraphs to be executed in parallel
+	 */
+	void setThreadPool(ThreadPool * threadPool, UINT minParallelNodes = 32);
+	
+	/**
+	 Retrieves the number of nodes whose subgraphs are executed in parallel
+	 
+	 @return the number of parallel nodes
+	 */
+	UINT getNumParallelNodes() const;
+	
+	/**
+	 Retrieves the execution context used by execute(Data*, Vector<Data*>&)
+	 
+	 @return a reference to the execution context of the plan
+	 */
+	ExecutionContext & getContext();
+	
+	/**
+	 Retrieves the number of nodes in the plan. An algorithm reachable through several paths in the graph appears once per path
+	 
+	 @return the number of nodes
+	 */
+	UINT getNumNodes() const;
+	
+	/**
+	 Retrieves the number of leaf nodes in the plan, which is the maximum number of results produced by execute()
+	 
+	 @return the number of leaf nodes
+	 */
+	UINT getNumLeaves() const;
+	
+	/**
+	 Retrieves the algorithm executed by a node
+	 
+	 @param nodeIdx the index of the node, in depth-first order
+	 @return the algorithm of the node
+	 */
+	Algorithm * getAlgorithm(UINT nodeIdx) const;
+	
+private:
+	
+	struct Node {
+		Algorithm * algorithm; ///< The algorithm executed by this node
+		int parentIdx; ///< The index of the node whose output is passed to this node, or -1 for the root
+		UINT subtreeEnd; ///< The index of the first node that is not a descendant of this node
+		bool isLeaf; ///< Whether this node has no next algorithms
+		int batchIdx; ///< The index of the node among the nodes executed in batches by executeBlock(), or -1 if it is executed sample by sample
+		UINT firstLeafIdx; ///< The index of the first leaf in the subtree of this node, counting leaves in depth-first order
+		UINT leafEnd; ///< The index of the first leaf that is not in the subtree of this node
+		bool isParallel; ///< Whether the subtrees of the next algorithms of this node are executed in parallel
+	};
+	
+	Vector<Node> nodes; ///< The nodes of the graph in depth-first order
+	Vector<Data*> results; ///< The output of every node in the last execution
+	ExecutionContext context; ///< The context the data produced by the algorithms is allocated from
+	UINT numLeaves; ///< The number of leaf nodes
+	UINT numBatchedNodes; ///< The number of nodes executed in batches by executeBlock()
+	UINT blockSize; ///< The number of samples in the block being executed by executeBlock()
+	Vector<Data*> batchResults; ///< The outputs of the batched nodes for every sample in the current block
+	Vector<SensorSample> blockSamples; ///< The samples copied from a raw array by executeBlock()
+	ThreadPool * threadPool; ///< The pool the parallel nodes are executed on, or NULL
+	UINT numParallelNodes; ///< The number of nodes whose subtrees are executed in parallel
+	Vector<ExecutionContext*> workerContexts; ///< The execution context of every worker of the thread pool. The first element is set to the context of the caller
+	Vector<Data*> leafResults; ///< The output of every leaf executed by a parallel task, or NULL
+	Vector<UINT> parallelTasks; ///< The first node of every subtree executed in parallel
+	int parallelBlockIdx; ///< The blockIdx parameter of the current parallel execution
+	
+	/**
+	 Appends the input algorithm and all the algorithms below it to the nodes vector
+	 
+	 @param algorithm the algorithm to append
+	 @param parentIdx the index of the node the algorithm receives its input from
+	 */
+	void compile(Algorithm * algorithm, int parentIdx);
+	
+	/**
+	 Executes the algorithms in a range of nodes on a single input
+	 
+	 @param firstNode the index of the first node to execute
+	 @param endNode the index of the first node that should not be executed, the end of a subtree
+	 @param data the input data of the root
+	 @param output the array where the data produced by the leaf algorithms is written, or NULL to store it in the leafResults vector. Parallel nodes are executed in parallel only when the output array is provided
+	 @param context the context the data produced by the algorithms is allocated from
+	 @param blockIdx the index of the sample in the current block, used to retrieve the output of the batched nodes, or -1 to execute every node
+	 @return the number of results written to the output array
+	 */
+	UINT executeNodes(UINT firstNode, UINT endNode, Data * data, Data ** output, ExecutionContext & context, int blockIdx);
+	
+	/**
+	 Executes the subtrees of the next algorithms of a parallel node on the thread pool
+	 
+	 @param nodeIdx the index of the parallel node, whose output has already been computed
+	 @param output the array where the data produced by the leaf algorithms is written, in depth-first order
+	 @param context the context of the calling thread
+	 @param blockIdx the index of the sample in the current block, or -1
+	 @return the number of results written to the output array
+	 */
+	UINT executeParallel(UINT nodeIdx, Data ** output, ExecutionContext & context, int blockIdx);
+	
+	/**
+	 Executes one of the subtrees of a parallel node, the function invoked by the thread pool
+	 
+	 @param argument the plan
+	 @param taskIdx the index of the subtree in the parallelTasks vector
+	 @param workerIdx the index of the worker, used to select the execution context
+	 */
+	static void ExecuteTask(void * argument, UINT taskIdx, UINT workerIdx);
+	
+	/**
+	 Resets the context of the plan and the contexts of the workers
+	 */
+	void resetContexts();
+	
+	/**
+	 Executes the batched nodes on every sample in the block and stores their outputs in the batchResults vector
+	 
+	 @param samples the first sample of the block
+	 @param numSamples the number of samples in the block
+	 */
+	void executeBatchedNodes(const SensorSample * samples, UINT numSamples);
+	
+	PipelinePlan(const PipelinePlan &rhs);
+	PipelinePlan& operator=(const PipelinePlan &rhs);
+};
+
+}
+
+#endif //ARF_PIPELINE_PLAN_H
@@ -0,0 +1,237 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "StreamRuntime.h"
+#include "../../utils/ARFException.h"
+
+namespace ARF {
+
+//the state blocks are aligned to cache lines so that streams executed by different workers do not share lines
+static const UINT kCacheLineSize = 64;
+
+//alignment of the state of every algorithm in a state block
+static const UINT kStateAlignment = 16;
+
+static UINT alignSize(UINT size, UINT alignment){
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+StreamRuntime::StreamRuntime(Algorithm * root, UINT numStreams, ThreadPool * threadPool) :
+numStreams(numStreams), threadPool(threadPool), stateSize(0), memory(nullptr), stateBlocks(nullptr),
+blocks(nullptr), handler(nullptr), argument(nullptr) {
+	
+	if(root == nullptr){
+		throw ARFException("StreamRuntime::StreamRuntime() root should not be NULL");
+	}
+	
+	UINT numWorkers = (threadPool == nullptr) ? 1 : threadPool->getNumWorkers();
+	for(UINT i = 0 ; i < numWorkers ; i++){
+		workers.push_back(new Worker(root));
+	}
+	const PipelinePlan & plan = workers[0]->plan;
+	
+	if(!readsStreamIterables(plan)){
+		for(UINT i = 0 ; i < workers.getSize() ; i++){
+			delete workers[i];
+		}
+		throw ARFException("StreamRuntime::StreamRuntime() a DataSelector reads the ring buffer of a RingBufferAlgorithm through a pointer, it should be created from the RingBufferAlgorithm to read the ring buffer of every stream");
+	}
+	
+	//an algorithm reachable through several paths keeps a single state
+	for(UINT nodeIdx = 0 ; nodeIdx < plan.getNumNodes() ; nodeIdx++){
+		const Algorithm * algorithm = plan.getAlgorithm(nodeIdx);
+		UINT algorithmStateSize = algorithm->getStateSize();
+		if(algorithmStateSize == 0){
+			continue;
+		}
+		
+		bool found = false;
+		for(UINT i = 0 ; i < states.getSize() ; i++){
+			if(states[i].algorithm == algorithm){
+				found = true;
+				break;
+			}
+		}
+		
+		if(!found){
+			AlgorithmState state;
+			state.algorithm = algorithm;
+			state.offset = stateSize;
+			states.push_back(state);
+			stateSize += alignSize(algorithmStateSize, kStateAlignment);
+		}
+	}
+	stateSize = alignSize(stateSize, kCacheLineSize);
+	
+	if(stateSize > 0 && numStreams > 0){
+		memory = new char[(size_t) stateSize * numStreams + kCacheLineSize];
+		size_t misalignment = ((size_t) memory) % kCacheLineSize;
+		stateBlocks = memory + ((misalignment == 0) ? 0 : kCacheLineSize - misalignment);
+		
+		for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+			initializeStream(streamIdx);
+		}
+	}
+}
+
+bool StreamRuntime::readsStreamIterables(const PipelinePlan & plan){
+	
+	//the iterables that every stream keeps in its own state, like the ring buffers of the RingBufferAlgorithms
+	Vector<const IterableValues*> streamIterables;
+	for(UINT nodeIdx = 0 ; nodeIdx < plan.getNumNodes() ; nodeIdx++){
+		const Algorithm * algorithm = plan.getAlgorithm(nodeIdx);
+		if(algorithm->getStateSize() > 0 && algorithm->getSamplesIterable() != nullptr){
+			streamIterables.push_back(algorithm->getSamplesIterable());
+		}
+	}
+	
+	//an algorithm reading one of them without its source would read the iterable no stream writes to
+	for(UINT nodeIdx = 0 ; nodeIdx < plan.getNumNodes() ; nodeIdx++){
+		const Algorithm * algorithm = plan.getAlgorithm(nodeIdx);
+		const IterableValues * iterable = algorithm->getColumnsIterable();
+		if(iterable == nullptr || algorithm->getColumnsSource() != nullptr){
+			continue;
+		}
+		for(UINT i = 0 ; i < streamIterables.getSize() ; i++){
+			if(streamIterables[i] == iterable){
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+StreamRuntime::~StreamRuntime(){
+	if(stateBlocks != nullptr){
+		for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+			destroyStream(streamIdx);
+		}
+	}
+	delete[] memory;
+	
+	for(UINT i = 0 ; i < workers.getSize() ; i++){
+		delete workers[i];
+	}
+}
+
+char * StreamRuntime::getStateBlock(UINT streamIdx) const{
+	return stateBlocks + (size_t) streamIdx * stateSize;
+}
+
+void StreamRuntime::initializeStream(UINT streamIdx){
+	char * stateBlock = getStateBlock(streamIdx);
+	for(UINT i = 0 ; i < states.getSize() ; i++){
+		states[i].algorithm->initializeState(stateBlock + states[i].offset);
+	}
+}
+
+void StreamRuntime::destroyStream(UINT streamIdx){
+	char * stateBlock = getStateBlock(streamIdx);
+	for(UINT i = 0 ; i < states.getSize() ; i++){
+		states[i].algorithm->destroyState(stateBlock + states[i].offset);
+	}
+}
+
+UINT StreamRuntime::executeSample(Worker & worker, UINT streamIdx, Data * sample){
+	
+	//release the data produced by the previous sample
+	worker.context.reset();
+	worker.context.setStateBlock((stateBlocks == nullptr) ? nullptr : getStateBlock(streamIdx), states.getData(), states.getSize());
+	
+	return worker.plan.execute(sample, worker.output, worker.context);
+}
+
+UINT StreamRuntime::execute(UINT streamIdx, Data * sample, Vector<Data*> & output){
+	
+	if(streamIdx >= numStreams){
+		throw ARFException("StreamRuntime::execute() streamIdx out of bounds");
+	}
+	
+	Worker & worker = *workers[0];
+	UINT outputCount = executeSample(worker, streamIdx, sample);
+	for(UINT i = 0 ; i < outputCount ; i++){
+		output[i] = worker.output[i];
+	}
+	return outputCount;
+}
+
+void StreamRuntime::execute(const StreamBlock * blocks, UINT numBlocks, OutputHandler handler, void * argument){
+	
+	for(UINT i = 0 ; i < numBlocks ; i++){
+		if(blocks[i].streamIdx >= numStreams){
+			throw ARFException("StreamRuntime::execute() streamIdx out of bounds");
+		}
+	}
+	
+	this->blocks = blocks;
+	this->handler = handler;
+	this->argument = argument;
+	
+	if(threadPool == nullptr){
+		for(UINT i = 0 ; i < numBlocks ; i++){
+			ExecuteBlock(this, i, 0);
+		}
+	} else {
+		threadPool->run(&StreamRuntime::ExecuteBlock, this, numBlocks);
+	}
+}
+
+void StreamRuntime::ExecuteBlock(void * argument, UINT taskIdx, UINT workerIdx){
+	StreamRuntime * runtime = (StreamRuntime*) argument;
+	const StreamBlock & block = runtime->blocks[taskIdx];
+	Worker & worker = *runtime->workers[workerIdx];
+	
+	for(UINT i = 0 ; i < block.numSamples ; i++){
+		UINT outputCount = runtime->executeSample(worker, block.streamIdx, (Data*) &block.samples[i]);
+		if(outputCount > 0){
+			runtime->handler(runtime->argument, block.streamIdx, i, worker.output.getData(), outputCount);
+		}
+	}
+}
+
+void StreamRuntime::resetStream(UINT streamIdx){
+	
+	if(streamIdx >= numStreams){
+		throw ARFException("StreamRuntime::resetStream() streamIdx out of bounds");
+	}
+	
+	if(stateBlocks != nullptr){
+		destroyStream(streamIdx);
+		initializeStream(streamIdx);
+	}
+}
+
+UINT StreamRuntime::getNumStreams() const{
+	return numStreams;
+}
+
+UINT StreamRuntime::getNumLeaves() const{
+	return workers[0]->plan.getNumLeaves();
+}
+
+UINT StreamRuntime::getStateSize() const{
+	return stateSize;
+}
+
+size_t StreamRuntime::getMemorySize() const{
+	return (size_t) stateSize * numStreams;
+}
+
+}
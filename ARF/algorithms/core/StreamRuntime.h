@@ -0,0 +1,216 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The StreamRuntime executes a single graph of algorithms on many independent streams of samples, for example one stream per user or per sensor. The mutable state of the stateful algorithms in the graph (ring buffers, peak detectors...) is stored in a state block per stream, allocated contiguously when the runtime is created, so the graph is built once and adding a stream costs only the size of its state block. Blocks of samples from different streams can be executed in parallel on a ThreadPool, every worker executes the graph with its own PipelinePlan and ExecutionContext.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_STREAM_RUNTIME_H
+#define ARF_STREAM_RUNTIME_H
+
+#include "Algorithm.h"
+#include "ExecutionContext.h"
+#include "PipelinePlan.h"
+#include "../../utils/ThreadPool.h"
+#include "../../dataStructures/Data.h"
+#include "../../dataStructures/Vector.h"
+#include "../../utils/ARFTypedefs.h"
+
+namespace ARF {
+
+/**
+ Executes a graph on several independent streams of samples. The state of the stateful algorithms, like the ring buffer of a RingBufferAlgorithm, is kept in a state block per stream instead of in the algorithms. DataSelectors read the ring buffer of the stream being executed only when they are created with the constructor taking the RingBufferSource, DataSelector(ringBufferAlgorithm, startRow, endRow, columnIndices). A DataSelector created with a pointer to the ring buffer of a RingBufferAlgorithm of the graph, like the ones of examples/main.cpp, would read a ring buffer no stream writes to, so the constructor rejects it
+ */
+class StreamRuntime {
+	
+public:
+	
+	/**
+	 A block of consecutive samples of a stream
+	 */
+	struct StreamBlock {
+		UINT streamIdx; ///< The index of the stream the samples belong to
+		const SensorSample * samples; ///< The first sample of the block
+		UINT numSamples; ///< The number of samples in the block
+	};
+	
+	/**
+	 The function invoked for every sample of a block that produced an output. It can be invoked concurrently by the workers of the thread pool
+	 
+	 @param argument the argument passed to execute()
+	 @param streamIdx the index of the stream of the sample
+	 @param sampleIdx the index of the sample in its block
+	 @param output the data produced by the leaf algorithms, valid until the handler returns
+	 @param numOutputs the number of elements in the output array
+	 */
+	typedef void (*OutputHandler)(void * argument, UINT streamIdx, UINT sampleIdx, Data ** output, UINT numOutputs);
+	
+	/**
+	 Creates the state blocks of the streams and compiles the graph for every worker of the thread pool. The graph should not be modified while the runtime exists. Throws an ARFException if a DataSelector of the graph was created with a pointer to the ring buffer of a RingBufferAlgorithm of the graph
+	 
+	 @param root the root of the directed graph executed on every stream
+	 @param numStreams the number of streams
+	 @param threadPool the pool the blocks of samples are executed on, or a NULL pointer to execute them on the calling thread. The pool should outlive the runtime
+	 */
+	StreamRuntime(Algorithm * root, UINT numStreams, ThreadPool * threadPool = nullptr);
+	
+	/**
+	 Destructor, destroys the state of every stream
+	 */
+	~StreamRuntime();
+	
+	/**
+	 Executes the graph on a sample of a stream, on the calling thread
+	 
+	 @param streamIdx the index of the stream
+	 @param sample the input data, passed to the root algorithm without being copied
+	 @param output the data produced by the leaf algorithms. Should have at least getNumLeaves() elements. The data remains valid until the next call to execute()
+	 @return the number of results in the output vector
+	 */
+	UINT execute(UINT streamIdx, Data * sample, Vector<Data*> & output);
+	
+	/**
+	 Executes the graph on several blocks of samples. Every block is executed sample by sample in order, and the blocks are distributed across the workers of the thread pool. Two blocks of the same stream should not be passed in the same call, since they could be executed at the same time
+	 
+	 @param blocks the blocks of samples
+	 @param numBlocks the number of elements in the blocks array
+	 @param handler the function invoked for every sample that produced an output
+	 @param argument the argument passed to the handler
+	 */
+	void execute(const StreamBlock * blocks, UINT numBlocks, OutputHandler handler, void * argument);
+	
+	/**
+	 Destroys the state of a stream and initializes it again, as if the stream had not received any sample
+	 
+	 @param streamIdx the index of the stream
+	 */
+	void resetStream(UINT streamIdx);
+	
+	/**
+	 Retrieves the number of streams
+	 
+	 @return the number of streams
+	 */
+	UINT getNumStreams() const;
+	
+	/**
+	 Retrieves the number of leaf algorithms in the graph, which is the maximum number of results produced by a sample
+	 
+	 @return the number of leaf algorithms
+	 */
+	UINT getNumLeaves() const;
+	
+	/**
+	 Retrieves the size of the state block of every stream, including the padding that aligns the blocks to cache lines
+	 
+	 @return the size of a state block in bytes
+	 */
+	UINT getStateSize() const;
+	
+	/**
+	 Retrieves the memory used by the state blocks of all the streams. Memory owned by the state, like the values of the samples stored in a ring buffer, is not included
+	 
+	 @return the size of the state blocks in bytes
+	 */
+	size_t getMemorySize() const;
+	
+private:
+	
+	/**
+	 The plan and the context a worker executes the graph with
+	 */
+	struct Worker {
+		PipelinePlan plan; ///< The graph compiled for this worker
+		ExecutionContext context; ///< The context the outputs of the algorithms are allocated from
+		Vector<Data*> output; ///< The outputs of the last sample executed by this worker
+		
+		Worker(Algorithm * root) : plan(root), output(plan.getNumLeaves()) { }
+	};
+	
+	UINT numStreams; ///< The number of streams
+	ThreadPool * threadPool; ///< The pool the blocks are executed on, or NULL
+	Vector<Worker*> workers; ///< The plan and context of every worker of the thread pool
+	Vector<AlgorithmState> states; ///< The location of the state of every stateful algorithm in a state block
+	UINT stateSize; ///< The size of a state block in bytes
+	char * memory; ///< The memory of the state blocks, as allocated
+	char * stateBlocks; ///< The first state block, aligned to a cache line
+	
+	//arguments of the blocks executed by the thread pool
+	const StreamBlock * blocks;
+	OutputHandler handler;
+	void * argument;
+	
+	/**
+	 Checks that the algorithms reading an iterable that every stream keeps in its state, like a DataSelector reading the ring buffer of a RingBufferAlgorithm, read the iterable of the stream being executed
+	 
+	 @param plan the compiled graph
+	 @return false if an algorithm reads such an iterable through a pointer to it
+	 */
+	static bool readsStreamIterables(const PipelinePlan & plan);
+	
+	/**
+	 Retrieves the state block of a stream
+	 
+	 @param streamIdx the index of the stream
+	 @return a pointer to the state block
+	 */
+	char * getStateBlock(UINT streamIdx) const;
+	
+	/**
+	 Initializes the state of every stateful algorithm in a state block
+	 
+	 @param streamIdx the index of the stream
+	 */
+	void initializeStream(UINT streamIdx);
+	
+	/**
+	 Destroys the state of every stateful algorithm in a state block
+	 
+	 @param streamIdx the index of the stream
+	 */
+	void destroyStream(UINT streamIdx);
+	
+	/**
+	 Executes a sample of a stream with the plan and context of a worker
+	 
+	 @param worker the worker
+	 @param streamIdx the index of the stream
+	 @param sample the input sample
+	 @return the number of results in the output vector of the worker
+	 */
+	UINT executeSample(Worker & worker, UINT streamIdx, Data * sample);
+	
+	/**
+	 Executes one of the blocks, the function invoked by the thread pool
+	 
+	 @param argument the runtime
+	 @param taskIdx the index of the block
+	 @param workerIdx the index of the worker
+	 */
+	static void ExecuteBlock(void * argument, UINT taskIdx, UINT workerIdx);
+	
+	StreamRuntime(const StreamRuntime &rhs);
+	StreamRuntime& operator=(const StreamRuntime &rhs);
+};
+
+}
+
+#endif //ARF_STREAM_RUNTIME_H
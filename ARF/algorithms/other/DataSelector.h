@@ -26,6 +26,7 @@
 #define ARF_DATA_SELECTOR_H
 
 #include "../core/Algorithm.h"
+#include "../1-dataAcquisition/RingBufferAlgorithm.h"
 #include "../../dataStructures/DataIterator.h"
 #include "../../dataStructures/DataIterator.h"
 #include "../../utils/ARFTypedefs.h"
@@ -35,19 +36,30 @@ namespace ARF {
 class DataSelector : public Algorithm {
 	
 private:
-	const Iterable<SensorSample> * iterable;
-	const IterableRange iterableRange;
+	const IterableValues * iterable;
+	IterableRange iterableRange; ///< The rows and columns selected, whose columns are replaced when the samples are projected by a ColumnProjection
+	const RingBufferSource * source; ///< The algorithm whose ring buffer is accessed, or NULL to access the iterable
+	
+	/**
+	 Retrieves the iterable the data is selected from in the current execution
+	 
+	 @param context the execution context
+	 @return the ring buffer of the current stream if the DataSelector has a source, or the iterable otherwise
+	 */
+	const IterableValues * getIterable(const ExecutionContext & context) const{
+		return (source == nullptr) ? iterable : source->getIterable(context);
+	}
 	
 public:
 	/**
-	 Main constructor for the DataSelector to return elements from a 2D iterator
+	 Main constructor for the DataSelector to return elements from a 2D iterator. The iterable is accessed by every stream of a StreamRuntime, so a StreamRuntime rejects DataSelectors created with the ring buffer of a RingBufferAlgorithm of its graph, which should be created from the algorithm instead
 	 
 	 @param iterable The collection of SensorSamples that will be accessed
 	 @param startRow The first row that should be accessed in the 2D iterator
 	 @param endRow The last row that should returned in the 2D iterator
 	 @param columnIndices The columns to be returned
 	 */
-	DataSelector(const Iterable<SensorSample> * iterable, const UINT startRow, const UINT endRow, const Vector<uint8_t> &columnIndices) : iterable(iterable), iterableRange(startRow, endRow, columnIndices){ }
+	DataSelector(const IterableValues * iterable, const UINT startRow, const UINT endRow, const Vector<uint8_t> &columnIndices) : iterable(iterable), iterableRange(startRow, endRow, columnIndices), source(nullptr){ }
 	
 	/**
 	 Main constructor for the DataSelector to return elements from a 2D iterator
@@ -57,7 +69,17 @@ public:
 	 @param endRow The last row that should returned in the 2D iterator
 	 @param columnIndices The columns to be returned
 	 */
-	DataSelector(const Iterable<SensorSample> * iterable, const UINT startRow, const UINT endRow, std::initializer_list<uint8_t> columnIndices) : iterable(iterable), iterableRange(startRow, endRow, Vector<uint8_t>(columnIndices)){ }
+	DataSelector(const IterableValues * iterable, const UINT startRow, const UINT endRow, std::initializer_list<uint8_t> columnIndices) : iterable(iterable), iterableRange(startRow, endRow, Vector<uint8_t>(columnIndices)), source(nullptr){ }
+	
+	/**
+	 Constructor for a DataSelector that returns elements from the ring buffer of a RingBufferAlgorithm, or of a BasicRingBufferAlgorithm of any sample type. When the pipeline processes several streams, the elements are selected from the ring buffer of the stream being executed
+	 
+	 @param source The RingBufferAlgorithm whose ring buffer will be accessed
+	 @param startRow The first row that should be accessed in the ring buffer
+	 @param endRow The last row that should returned in the ring buffer
+	 @param columnIndices The columns to be returned
+	 */
+	DataSelector(const RingBufferSource & source, const UINT startRow, const UINT endRow, std::initializer_list<uint8_t> columnIndices) : iterable(source.getIterable()), iterableRange(startRow, endRow, Vector<uint8_t>(columnIndices)), source(&source){ }
 	
 	/**
 	 Main constructor for the DataSelector to return elements from a 2D iterator
@@ -66,7 +88,7 @@ public:
 	 @param iterableRange The range of indices that will be accessed
 	 
 	 */
-	DataSelector(const Iterable<SensorSample> * iterable, const IterableRange &iterableRange ) : iterable(iterable), iterableRange(iterableRange) {}
+	DataSelector(const IterableValues * iterable, const IterableRange &iterableRange ) : iterable(iterable), iterableRange(iterableRange), source(nullptr) {}
 					 
 	/**
 	 Copy constructor for the DataSelector
@@ -75,6 +97,7 @@ public:
 	 */
 	DataSelector(const DataSelector& dataSelector) :
 	DataSelector(dataSelector.getIterable(),dataSelector.getIterableRange()){
+		source = dataSelector.getSource();
 	}
 	
 	/**
@@ -82,10 +105,19 @@ public:
 	
 	@return a pointer to the iterable
 	*/
-	const Iterable<SensorSample> * getIterable() const{
+	const IterableValues * getIterable() const{
 		return iterable;
 	}
 	
+	/**
+	Returns the RingBufferAlgorithm this instance of the DataSelector selects data from
+	
+	@return a pointer to the source, or NULL if the DataSelector accesses its iterable
+	*/
+	const RingBufferSource * getSource() const{
+		return source;
+	}
+	
 	/**
 	Returns the iterable range this instance of the DataSelector uses to select data
 	
@@ -95,6 +127,44 @@ public:
 		return iterableRange;
 	}
 	
+	/**
+	 Retrieves the columns this DataSelector selects
+	 
+	 @param columnIndices set to the column indices of the iterable range
+	 @return true
+	 */
+	bool getColumnIndices(Vector<uint8_t> & columnIndices) const override {
+		columnIndices = iterableRange.columnIndices;
+		return true;
+	}
+	
+	/**
+	 Replaces the columns this DataSelector selects. The DataIterators returned by execute(Data*, ExecutionContext&) refer to the iterable range, so it should not be called while the pipeline is being executed
+	 
+	 @param columnIndices the new column indices of the iterable range
+	 */
+	void setColumnIndices(const Vector<uint8_t> & columnIndices) override {
+		iterableRange.columnIndices = columnIndices;
+	}
+	
+	/**
+	 Retrieves the iterable the columns are selected from
+	 
+	 @return the iterable, which is the ring buffer of the source when the DataSelector has one
+	 */
+	const IterableValues * getColumnsIterable() const override {
+		return iterable;
+	}
+	
+	/**
+	 Retrieves the algorithm whose ring buffer is read in every stream
+	 
+	 @return the source, or NULL if the DataSelector was created with a pointer to its iterable
+	 */
+	const Algorithm * getColumnsSource() const override {
+		return source;
+	}
+	
 	/**
 	 Returns a DataIterator that can access a selection of the data in the container defined in the 'iterable' property,
 	 or in the input parameter in case the 'iterable' property is nil
@@ -105,6 +175,17 @@ public:
 	Data * execute(Data * data) override {
 		return new DataIterator(iterable, iterableRange);
 	}
+	
+	/**
+	 Returns a DataIterator allocated from the execution context. The DataIterator refers to the iterable range of this DataSelector instead of copying it
+	 
+	 @param data A nil pointer or an Iterable from which data can be accessed
+	 @param context the context the DataIterator is allocated from
+	 @return A DataIterator object
+	 */
+	Data * execute(Data * data, ExecutionContext & context) override {
+		return context.create<DataIterator>(getIterable(context), &iterableRange);
+	}
 };
 
 }
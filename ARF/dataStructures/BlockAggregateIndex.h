@@ -0,0 +1,169 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The BlockAggregateIndex divides the slots of a ring buffer into blocks of consecutive slots and stores the RangeAggregate (sum, sum of squared differences, minimum and maximum) of every column in every block. The aggregate of a column over any range of slots is the merge of the aggregates of the blocks inside the range and of the values of the slots at its edges, which costs O(blocks + blockSize) instead of O(slots). The ring buffer recomputes the aggregates of a block after it writes the last slot of the block, so every block except the one being written is up to date. Queries only read the index, so several threads can query it at the same time
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+#ifndef ARF_BLOCK_AGGREGATE_INDEX_H
+#define ARF_BLOCK_AGGREGATE_INDEX_H
+
+#include "../utils/ARFException.h"
+#include "../utils/ARFTypedefs.h"
+#include <algorithm>
+#include <vector>
+
+namespace ARF {
+
+class BlockAggregateIndex {
+	
+private:
+	UINT capacity; ///< The number of slots of the ring buffer
+	UINT numColumns; ///< The number of columns indexed
+	UINT blockSize; ///< The number of slots in a block
+	UINT numBlocks; ///< The number of blocks, the last one can be smaller than blockSize
+	std::vector<RangeAggregate> aggregates; ///< The aggregate of every column in every block, stored block by block
+	
+	/**
+	 Computes the aggregate of a column over a range of slots in two passes, the second one summing the squared differences to the mean of the first one, which avoids a division per value
+	 
+	 @param colIdx the index of the column
+	 @param firstSlot the first slot of the range
+	 @param endSlot the slot after the last slot of the range
+	 @param getValue returns the value of a slot in a column, invoked as getValue(slotIdx, colIdx)
+	 @return the aggregate of the values
+	 */
+	template <typename GetValue>
+	static RangeAggregate ComputeAggregate(UINT colIdx, UINT firstSlot, UINT endSlot, GetValue getValue){
+		RangeAggregate aggregate;
+		aggregate.count = endSlot - firstSlot;
+		aggregate.minimum = aggregate.maximum = getValue(firstSlot, colIdx);
+		for(UINT slotIdx = firstSlot ; slotIdx < endSlot ; slotIdx++){
+			Float value = getValue(slotIdx, colIdx);
+			aggregate.sum += value;
+			aggregate.minimum = std::min(aggregate.minimum, value);
+			aggregate.maximum = std::max(aggregate.maximum, value);
+		}
+		Float mean = aggregate.getMean();
+		for(UINT slotIdx = firstSlot ; slotIdx < endSlot ; slotIdx++){
+			Float diff = getValue(slotIdx, colIdx) - mean;
+			aggregate.m2 += diff * diff;
+		}
+		return aggregate;
+	}
+	
+public:
+	
+	/**
+	 Main constructor
+	 
+	 @param capacity the number of slots of the ring buffer
+	 @param numColumns the number of columns indexed, starting from the first column
+	 @param blockSize the number of slots in a block
+	 */
+	BlockAggregateIndex(UINT capacity, UINT numColumns, UINT blockSize = 32) : capacity(capacity), numColumns(numColumns), blockSize(blockSize) {
+		if(capacity == 0 || numColumns == 0 || blockSize == 0){
+			throw ARFException("BlockAggregateIndex::BlockAggregateIndex() capacity, numColumns and blockSize should not be zero");
+		}
+		numBlocks = (capacity + blockSize - 1) / blockSize;
+		aggregates.resize((size_t) numBlocks * numColumns);
+	}
+	
+	UINT getNumColumns() const{
+		return numColumns;
+	}
+	
+	UINT getBlockSize() const{
+		return blockSize;
+	}
+	
+	UINT getNumBlocks() const{
+		return numBlocks;
+	}
+	
+	/**
+	 Retrieves the block a slot belongs to
+	 
+	 @param slotIdx the index of the slot
+	 @return the index of the block
+	 */
+	UINT getBlockIdx(UINT slotIdx) const{
+		return slotIdx / blockSize;
+	}
+	
+	/**
+	 Retrieves the aggregate of a column in a block
+	 
+	 @param blockIdx the index of the block
+	 @param colIdx the index of the column
+	 @return the aggregate of the values of the column in the block
+	 */
+	const RangeAggregate & getBlockAggregate(UINT blockIdx, UINT colIdx) const{
+		return aggregates[(size_t) blockIdx * numColumns + colIdx];
+	}
+	
+	/**
+	 Recomputes the aggregates of a block, after all its slots have been written
+	 
+	 @param blockIdx the index of the block
+	 @param getValue returns the value of a slot in a column, invoked as getValue(slotIdx, colIdx)
+	 */
+	template <typename GetValue>
+	void updateBlock(UINT blockIdx, GetValue getValue){
+		UINT firstSlot = blockIdx * blockSize;
+		UINT endSlot = std::min(firstSlot + blockSize, capacity);
+		for(UINT colIdx = 0 ; colIdx < numColumns ; colIdx++){
+			aggregates[(size_t) blockIdx * numColumns + colIdx] = ComputeAggregate(colIdx, firstSlot, endSlot, getValue);
+		}
+	}
+	
+	/**
+	 Merges the aggregate of a column over a range of slots into an aggregate. The blocks entirely inside the range are merged from the index, except the block being written, and the values of the other slots are read
+	 
+	 @param colIdx the index of the column
+	 @param firstSlot the first slot of the range
+	 @param lastSlot the last slot of the range, not smaller than firstSlot
+	 @param dirtyBlockIdx the block whose aggregates are not up to date
+	 @param getValue returns the value of a slot in a column, invoked as getValue(slotIdx, colIdx)
+	 @param aggregate the aggregate the range is merged into
+	 */
+	template <typename GetValue>
+	void aggregate(UINT colIdx, UINT firstSlot, UINT lastSlot, UINT dirtyBlockIdx, GetValue getValue, RangeAggregate & aggregate) const{
+		UINT slotIdx = firstSlot;
+		while(slotIdx <= lastSlot){
+			UINT blockIdx = slotIdx / blockSize;
+			UINT blockFirstSlot = blockIdx * blockSize;
+			UINT blockLastSlot = std::min(blockFirstSlot + blockSize, capacity) - 1;
+			
+			if(slotIdx == blockFirstSlot && blockLastSlot <= lastSlot && blockIdx != dirtyBlockIdx){
+				aggregate.merge(getBlockAggregate(blockIdx, colIdx));
+				slotIdx = blockLastSlot + 1;
+			} else {
+				UINT endPartialSlot = std::min(blockLastSlot, lastSlot) + 1;
+				aggregate.merge(ComputeAggregate(colIdx, slotIdx, endPartialSlot, getValue));
+				slotIdx = endPartialSlot;
+			}
+		}
+	}
+};
+
+}
+
+#endif //ARF_BLOCK_AGGREGATE_INDEX_H
@@ -0,0 +1,433 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The ColumnRingBuffer is a ring buffer of SensorSamples with a fixed number of channels that stores every channel in its own contiguous array of Floats (structure of arrays) instead of storing an array of SensorSamples. Adding a sample copies its values without allocating memory, and reading a channel over a window accesses consecutive memory, which can be retrieved directly with getColumnSpan(). It can be used wherever an Iterable<SensorSample> is accepted, like in DataSelectors and DataIterators. A mirrored ColumnRingBuffer stores every column followed by a copy of itself, so that any window of up to capacity samples is a single contiguous range. When the size of a column is a multiple of the page size, the copy is a second mapping of the same pages (see MirroredMemory) and costs nothing to maintain, otherwise every value is written twice.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_COLUMN_RING_BUFFER_H
+#define ARF_COLUMN_RING_BUFFER_H
+
+#include <algorithm>
+#include "Data.h"
+#include "Vector.h"
+#include "../utils/ARFException.h"
+#include "../utils/ARFTypedefs.h"
+#include "../utils/MirroredMemory.h"
+
+namespace ARF {
+
+/**
+ The values of a column over a range of rows of a ColumnRingBuffer. When the range wraps around the end of a buffer that is not mirrored the values are split in two contiguous parts, otherwise the second part is empty
+ */
+struct ColumnSpan {
+	const Float * first; ///< The values of the first part
+	UINT firstSize; ///< The number of values in the first part
+	const Float * second; ///< The values of the second part, or NULL
+	UINT secondSize; ///< The number of values in the second part
+	
+	/**
+	 Retrieves the total number of values in the span
+	 
+	 @return the number of values
+	 */
+	UINT getSize() const{
+		return firstSize + secondSize;
+	}
+	
+	/**
+	 Retrieves a value of the span
+	 
+	 @param idx the index of the value, should be in the range [0 getSize())
+	 @return the value
+	 */
+	const Float& operator[](const UINT idx) const{
+		return (idx < firstSize) ? first[idx] : second[idx - firstSize];
+	}
+};
+
+class ColumnRingBuffer : public Iterable<SensorSample>{
+	
+private:
+	//number of Floats the beginning of every column is aligned to (a cache line)
+	static const UINT kColumnAlignment = 16;
+	
+	Float * memory; ///< The memory of the columns, as allocated, or NULL if the columns are mapped
+	Float * data; ///< The first column, aligned to a cache line
+	UINT numChannels; ///< The number of values in every sample
+	UINT capacity; ///< The number of samples the buffer can hold
+	UINT columnStride; ///< The number of Floats between the beginning of two columns
+	UINT size; ///< The amount of samples currently in the buffer
+	UINT endIdx; ///< The index where the next sample will be written
+	bool mirrored; ///< Whether every column is followed by a copy of itself
+	bool mapped; ///< Whether the copy of every column is a mirrored mapping of its pages, instead of values written twice
+	
+	/**
+	 Allocates the memory of the columns
+	 */
+	void allocate(){
+		mapped = false;
+		
+		if(mirrored){
+			size_t columnSize = (size_t) capacity * sizeof(Float);
+			if(columnSize % MirroredMemory::GetPageSize() == 0){
+				data = (Float*) MirroredMemory::Map(columnSize, numChannels);
+				if(data != nullptr){
+					memory = nullptr;
+					mapped = true;
+					columnStride = 2 * capacity;
+					return;
+				}
+			}
+		}
+		
+		UINT columnSize = mirrored ? 2 * capacity : capacity;
+		columnStride = (columnSize + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+		memory = new Float[(size_t) columnStride * numChannels + kColumnAlignment];
+		
+		size_t misalignment = ((size_t) memory) % (kColumnAlignment * sizeof(Float));
+		data = memory + ((misalignment == 0) ? 0 : (kColumnAlignment * sizeof(Float) - misalignment) / sizeof(Float));
+	}
+	
+	/**
+	 Retrieves the offset of the position of the samples in a column. Mapped columns start at page boundaries, so writing a sample at the same position of every column would access the same cache set. Their positions are rotated by a cache line per column instead
+	 
+	 @param colIdx the index of the channel
+	 @return the offset in the range [0 capacity)
+	 */
+	inline UINT getColumnOffset(UINT colIdx) const{
+		return mapped ? (colIdx * kColumnAlignment) % capacity : 0;
+	}
+	
+	/**
+	 Retrieves the position of a sample in a column. The position is smaller than the capacity, so in a mirrored buffer the following samples are contiguous
+	 
+	 @param colIdx the index of the channel
+	 @param rowIdx the index of the sample, 0 being the oldest sample
+	 @return the index of the sample in the column
+	 */
+	inline UINT getPhysicalIdx(UINT colIdx, UINT rowIdx) const{
+		UINT physicalIdx = rowIdx + getFirstElementIdx();
+		if(physicalIdx >= capacity){
+			physicalIdx -= capacity;
+		}
+		physicalIdx += getColumnOffset(colIdx);
+		return (physicalIdx >= capacity) ? physicalIdx - capacity : physicalIdx;
+	}
+	
+	ColumnRingBuffer& operator=(const ColumnRingBuffer &rhs);
+	
+public:
+	
+	/**
+	 Main constructor of the column ring buffer
+	 
+	 @param capacity the number of samples the ring buffer should store
+	 @param numChannels the number of values in every sample
+	 @param mirrored whether every window should be a single contiguous range. Use a capacity such that capacity * sizeof(Float) is a multiple of the page size to avoid writing every value twice
+	 */
+	ColumnRingBuffer(UINT capacity, UINT numChannels, bool mirrored = false) : numChannels(numChannels), capacity(capacity), size(0), endIdx(0), mirrored(mirrored){
+		
+		if (capacity == 0){
+			throw ARFException("ColumnRingBuffer::ColumnRingBuffer() capacity should not be zero");
+		}
+		
+		if (numChannels == 0){
+			throw ARFException("ColumnRingBuffer::ColumnRingBuffer() numChannels should not be zero");
+		}
+		
+		allocate();
+	}
+	
+	/**
+	 Copy constructor of the column ring buffer
+	 
+	 @param rhs the ring buffer that will be copied
+	 */
+	ColumnRingBuffer(const ColumnRingBuffer &rhs) : numChannels(rhs.numChannels), capacity(rhs.capacity), size(rhs.size), endIdx(rhs.endIdx), mirrored(rhs.mirrored){
+		allocate();
+		for(UINT i = 0 ; i < numChannels ; i++){
+			Float * column = data + (size_t) i * columnStride;
+			std::copy(rhs.getColumnData(i), rhs.getColumnData(i) + capacity, column);
+			if(mirrored && !mapped){
+				std::copy(column, column + capacity, column + capacity);
+			}
+		}
+	}
+	
+	/**
+	 Main destructor of the column ring buffer
+	 */
+	~ColumnRingBuffer(){
+		if(mapped){
+			MirroredMemory::Unmap(data, capacity * sizeof(Float), numChannels);
+		}
+		delete[] memory;
+	}
+	
+	/**
+	 Adds a sample to the ring buffer
+	 
+	 @param sample the sample to append, should have getNumChannels() values
+	 */
+	void add(const SensorSample &sample){
+		
+		if(sample.getSize() != numChannels){
+			throw ARFException("ColumnRingBuffer::add() the sample should have numChannels values");
+		}
+		
+		add(&sample[0]);
+	}
+	
+	/**
+	 Adds a sample stored in a raw array to the ring buffer
+	 
+	 @param values the values of the sample, getNumChannels() Floats
+	 */
+	void add(const Float * values){
+		
+		if(mapped){
+			for(UINT i = 0 ; i < numChannels ; i++){
+				UINT physicalIdx = endIdx + getColumnOffset(i);
+				data[(size_t) i * columnStride + ((physicalIdx >= capacity) ? physicalIdx - capacity : physicalIdx)] = values[i];
+			}
+		} else {
+			for(UINT i = 0 ; i < numChannels ; i++){
+				data[(size_t) i * columnStride + endIdx] = values[i];
+			}
+		}
+		
+		//the copy of the columns is written explicitly unless its pages are mapped to the columns
+		if(mirrored && !mapped){
+			for(UINT i = 0 ; i < numChannels ; i++){
+				data[(size_t) i * columnStride + capacity + endIdx] = values[i];
+			}
+		}
+		
+		//increase ring buffer size by one
+		if (size < capacity) {
+			size++;
+		}
+		
+		//increase endIdx by one
+		endIdx++;
+		if (endIdx == capacity) {
+			endIdx = 0;
+		}
+	}
+	
+	/**
+	 Removes every sample from the ring buffer
+	 */
+	void clear(){
+		size = 0;
+		endIdx = 0;
+	}
+	
+	/**
+	 Retrieves whether the ring buffer is full
+	 
+	 @return true if the ring buffer is full, false otherwise
+	 */
+	inline bool isFull() const{
+		return size == capacity;
+	}
+	
+	/**
+	 Retrieves the amount of samples in the ring buffer
+	 
+	 @return the size of the ring buffer
+	 */
+	inline UINT getSize() const override{
+		return size;
+	}
+	
+	/**
+	 Retrieves the amount of samples the ring buffer is able to hold
+	 
+	 @return the capacity of the ring buffer
+	 */
+	inline UINT getCapacity() const{
+		return capacity;
+	}
+	
+	/**
+	 Retrieves the number of values in every sample
+	 
+	 @return the number of channels
+	 */
+	inline UINT getNumChannels() const{
+		return numChannels;
+	}
+	
+	/**
+	 Retrieves whether every window of the buffer is a single contiguous range
+	 
+	 @return true if the columns are mirrored
+	 */
+	inline bool isMirrored() const{
+		return mirrored;
+	}
+	
+	/**
+	 Retrieves whether the columns are mirrored by mapping their pages twice
+	 
+	 @return true if the mirror of the columns is a second mapping of their pages
+	 */
+	inline bool isMapped() const{
+		return mapped;
+	}
+	
+	/**
+	 Retrieves the position in the columns where the next sample will be written
+	 
+	 @return the endIdx
+	 */
+	inline UINT getEndIdx() const{
+		return endIdx;
+	}
+	
+	/**
+	 Retrieves the position in the columns of the oldest sample
+	 
+	 @return the index of the first sample
+	 */
+	inline UINT getFirstElementIdx() const{
+		return (size < capacity) ? 0 : endIdx;
+	}
+	
+	/**
+	 Retrieves a value of a sample in the ring buffer
+	 
+	 @param rowIdx the index of the sample, 0 being the oldest sample
+	 @param colIdx the index of the channel
+	 @return the value
+	 */
+	inline const Float& getValue(const UINT rowIdx, const UINT colIdx) const override{
+		if(rowIdx >= size || colIdx >= numChannels){
+			throw ARFException("ColumnRingBuffer::getValue() index out of bounds");
+		}
+		return data[(size_t) colIdx * columnStride + getPhysicalIdx(colIdx, rowIdx)];
+	}
+	
+	/**
+	 Copies a sample of the ring buffer
+	 
+	 @param rowIdx the index of the sample, 0 being the oldest sample
+	 @param sample the sample the values are copied to, resized to getNumChannels() values
+	 */
+	void getSample(const UINT rowIdx, SensorSample &sample) const{
+		if(rowIdx >= size){
+			throw ARFException("ColumnRingBuffer::getSample() row index out of bounds");
+		}
+		
+		if(sample.getSize() != numChannels){
+			sample.resize(numChannels);
+		}
+		
+		for(UINT i = 0 ; i < numChannels ; i++){
+			sample[i] = data[(size_t) i * columnStride + getPhysicalIdx(i, rowIdx)];
+		}
+	}
+	
+	/**
+	 Retrieves the values of a channel over a range of samples without copying them
+	 
+	 @param colIdx the index of the channel
+	 @param startRow the index of the first sample, 0 being the oldest sample
+	 @param endRow the index of the last sample, included in the span
+	 @return the values of the channel, in one or two contiguous parts
+	 */
+	ColumnSpan getColumnSpan(const UINT colIdx, const UINT startRow, const UINT endRow) const{
+		if(colIdx >= numChannels){
+			throw ARFException("ColumnRingBuffer::getColumnSpan() column index out of bounds");
+		}
+		if(startRow > endRow || endRow >= size){
+			throw ARFException("ColumnRingBuffer::getColumnSpan() invalid row range");
+		}
+		
+		const Float * column = data + (size_t) colIdx * columnStride;
+		UINT numRows = endRow - startRow + 1;
+		UINT physicalIdx = getPhysicalIdx(colIdx, startRow);
+		
+		ColumnSpan span;
+		span.first = column + physicalIdx;
+		span.firstSize = mirrored ? numRows : std::min(numRows, capacity - physicalIdx);
+		span.second = (span.firstSize < numRows) ? column : nullptr;
+		span.secondSize = numRows - span.firstSize;
+		return span;
+	}
+	
+	/**
+	 Retrieves the values of a channel over a range of samples as a StridedSpan with a stride of one, like getColumnSpan()
+	 
+	 @param colIdx the index of the channel
+	 @param startRow the index of the first sample
+	 @param endRow the index of the last sample
+	 @param span set to the values of the channel
+	 @return false if the range is invalid
+	 */
+	bool getStridedSpan(const UINT colIdx, const UINT startRow, const UINT endRow, StridedSpan &span) const override{
+		
+		if(startRow > endRow || endRow >= size || colIdx >= numChannels){
+			return false;
+		}
+		
+		ColumnSpan columnSpan = getColumnSpan(colIdx, startRow, endRow);
+		span.first = columnSpan.first;
+		span.firstSize = columnSpan.firstSize;
+		span.second = columnSpan.second;
+		span.secondSize = columnSpan.secondSize;
+		span.stride = 1;
+		return true;
+	}
+	
+	/**
+	 Retrieves the values of a channel over a range of samples as a single contiguous range, available in mirrored buffers only
+	 
+	 @param colIdx the index of the channel
+	 @param startRow the index of the first sample, 0 being the oldest sample
+	 @return a pointer to the value of the first sample, followed by the values of the next getSize() - startRow - 1 samples
+	 */
+	inline const Float * getColumnWindow(const UINT colIdx, const UINT startRow) const{
+		if(!mirrored){
+			throw ARFException("ColumnRingBuffer::getColumnWindow() the ring buffer is not mirrored");
+		}
+		if(colIdx >= numChannels || startRow >= size){
+			throw ARFException("ColumnRingBuffer::getColumnWindow() index out of bounds");
+		}
+		return data + (size_t) colIdx * columnStride + getPhysicalIdx(colIdx, startRow);
+	}
+	
+	/**
+	 Retrieves the storage of a channel, in the order the samples were written and not in the order they were added. The samples in a mapped column are rotated by getColumnOffset()
+	 
+	 @param colIdx the index of the channel
+	 @return a pointer to getCapacity() values, aligned to a cache line
+	 */
+	inline const Float * getColumnData(const UINT colIdx) const{
+		return data + (size_t) colIdx * columnStride;
+	}
+};
+
+}
+
+#endif //ARF_COLUMN_RING_BUFFER_H
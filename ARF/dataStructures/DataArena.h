@@ -0,0 +1,271 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The DataArena is a bump allocator for the Data produced by the algorithms during the execution of a pipeline. Objects are created with create(), which places them in large chunks of memory requested from the system only when the arena runs out of space. The reset() method destroys every object in the arena at once and makes its memory available again, so that a pipeline executed repeatedly reaches a steady state in which it does not allocate memory.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_DATA_ARENA_H
+#define ARF_DATA_ARENA_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "Data.h"
+#include "../utils/ARFTypedefs.h"
+#include "../utils/ARFException.h"
+
+namespace ARF {
+
+class DataArena {
+	
+private:
+	
+	struct Chunk {
+		Chunk * next; ///< The next chunk in the list of chunks owned by the arena
+		size_t capacity; ///< The number of bytes available after the header of the chunk
+	};
+	
+	struct Destructor {
+		void (*destroy)(void * object); ///< The function that destroys the object
+		void * object; ///< The object that should be destroyed
+		Destructor * previous; ///< The destructor registered before this one
+	};
+	
+	Chunk * firstChunk; ///< The first chunk in the list of chunks
+	Chunk * currentChunk; ///< The chunk objects are currently allocated from
+	size_t offset; ///< The number of bytes used in the current chunk
+	size_t chunkSize; ///< The minimum capacity of the chunks requested to the system
+	Destructor * lastDestructor; ///< The last destructor registered, or NULL
+	UINT numAllocations; ///< The number of chunks requested to the system
+	
+	static const size_t alignment = alignof(std::max_align_t);
+	
+	static size_t alignSize(size_t size){
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+	
+	static char * getChunkData(Chunk * chunk){
+		return ((char*) chunk) + alignSize(sizeof(Chunk));
+	}
+	
+	template <typename T>
+	struct Array {
+		T * objects; ///< The first element of the array
+		UINT size; ///< The number of elements in the array
+	};
+	
+	template <typename T>
+	static void destroyObject(void * object){
+		((T*) object)->~T();
+	}
+	
+	template <typename T>
+	static void destroyArray(void * object){
+		Array<T> * array = (Array<T>*) object;
+		for(UINT i = array->size ; i > 0 ; i--){
+			array->objects[i-1].~T();
+		}
+	}
+	
+	static void deleteData(void * object){
+		delete (Data*) object;
+	}
+	
+	/**
+	 Requests a new chunk to the system and appends it after the current chunk
+	 
+	 @param minCapacity the minimum number of bytes the chunk should hold
+	 @return the new chunk
+	 */
+	Chunk * allocateChunk(size_t minCapacity){
+		size_t capacity = (minCapacity > chunkSize) ? minCapacity : chunkSize;
+		Chunk * chunk = (Chunk*) std::malloc(alignSize(sizeof(Chunk)) + capacity);
+		if(chunk == nullptr){
+			throw std::bad_alloc();
+		}
+		chunk->capacity = capacity;
+		numAllocations++;
+		
+		if(currentChunk == nullptr){
+			chunk->next = firstChunk;
+			firstChunk = chunk;
+		} else {
+			chunk->next = currentChunk->next;
+			currentChunk->next = chunk;
+		}
+		return chunk;
+	}
+	
+	void registerDestructor(void (*destroy)(void*), void * object){
+		Destructor * destructor = (Destructor*) allocate(sizeof(Destructor));
+		destructor->destroy = destroy;
+		destructor->object = object;
+		destructor->previous = lastDestructor;
+		lastDestructor = destructor;
+	}
+	
+	DataArena(const DataArena &rhs);
+	DataArena& operator=(const DataArena &rhs);
+	
+public:
+	
+	/**
+	 Main constructor of the arena. No memory is requested until the first object is created
+	 
+	 @param chunkSize the number of bytes requested to the system every time the arena runs out of memory
+	 */
+	DataArena(size_t chunkSize = 4096) : firstChunk(nullptr), currentChunk(nullptr), offset(0),
+	chunkSize(alignSize(chunkSize)), lastDestructor(nullptr), numAllocations(0){
+		
+		if(chunkSize == 0){
+			throw ARFException("DataArena::DataArena() chunkSize should not be zero");
+		}
+	}
+	
+	/**
+	 Destroys the objects in the arena and returns its memory to the system
+	 */
+	~DataArena(){
+		reset();
+		while(firstChunk != nullptr){
+			Chunk * next = firstChunk->next;
+			std::free(firstChunk);
+			firstChunk = next;
+		}
+	}
+	
+	/**
+	 Allocates uninitialized memory from the arena. The memory is aligned for any fundamental type
+	 
+	 @param size the number of bytes to allocate
+	 @return a pointer to the allocated memory, valid until the next call to reset()
+	 */
+	void * allocate(size_t size){
+		size = alignSize(size);
+		
+		if(currentChunk == nullptr || offset + size > currentChunk->capacity){
+			
+			//reuse the chunks allocated before the last reset
+			Chunk * next = (currentChunk == nullptr) ? firstChunk : currentChunk->next;
+			if(next == nullptr || next->capacity < size){
+				next = allocateChunk(size);
+			}
+			currentChunk = next;
+			offset = 0;
+		}
+		
+		void * memory = getChunkData(currentChunk) + offset;
+		offset += size;
+		return memory;
+	}
+	
+	/**
+	 Constructs an object in the arena. The object is destroyed by the next call to reset()
+	 
+	 @param args the arguments passed to the constructor of the object
+	 @return a pointer to the new object, owned by the arena
+	 */
+	template <typename T, typename... Args>
+	T * create(Args&&... args){
+		T * object = new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+		if(!std::is_trivially_destructible<T>::value){
+			registerDestructor(&DataArena::destroyObject<T>, object);
+		}
+		return object;
+	}
+	
+	/**
+	 Constructs an array of objects in the arena with a single allocation. The objects are destroyed by the next call to reset()
+	 
+	 @param size the number of objects in the array
+	 @param args the arguments passed to the constructor of every object
+	 @return a pointer to the first object, owned by the arena
+	 */
+	template <typename T, typename... Args>
+	T * createArray(UINT size, const Args&... args){
+		T * objects = (T*) allocate(sizeof(T) * size);
+		for(UINT i = 0 ; i < size ; i++){
+			new (objects + i) T(args...);
+		}
+		if(!std::is_trivially_destructible<T>::value){
+			Array<T> * array = (Array<T>*) allocate(sizeof(Array<T>));
+			array->objects = objects;
+			array->size = size;
+			registerDestructor(&DataArena::destroyArray<T>, array);
+		}
+		return objects;
+	}
+	
+	/**
+	 Transfers the ownership of an object allocated with new to the arena. The object is deleted by the next call to reset()
+	 
+	 @param data the object to adopt
+	 @return the same object
+	 */
+	Data * adopt(Data * data){
+		if(data != nullptr){
+			registerDestructor(&DataArena::deleteData, data);
+		}
+		return data;
+	}
+	
+	/**
+	 Destroys every object in the arena in the reverse order of creation. The memory is kept and reused by the next allocations
+	 */
+	void reset(){
+		while(lastDestructor != nullptr){
+			Destructor * destructor = lastDestructor;
+			lastDestructor = destructor->previous;
+			destructor->destroy(destructor->object);
+		}
+		currentChunk = nullptr;
+		offset = 0;
+	}
+	
+	/**
+	 Retrieves the number of times the arena requested memory to the system. The number stops growing once the arena holds enough memory for the objects created between two calls to reset()
+	 
+	 @return the number of chunk allocations
+	 */
+	UINT getNumAllocations() const{
+		return numAllocations;
+	}
+	
+	/**
+	 Retrieves the number of bytes the arena holds
+	 
+	 @return the sum of the capacities of the chunks
+	 */
+	size_t getCapacity() const{
+		size_t capacity = 0;
+		for(Chunk * chunk = firstChunk ; chunk != nullptr ; chunk = chunk->next){
+			capacity += chunk->capacity;
+		}
+		return capacity;
+	}
+};
+
+}
+
+#endif //ARF_DATA_ARENA_H
@@ -56,21 +56,54 @@ struct IterableRange {
 class DataIterator : public Data {
 	
 private:
-	const Iterable<SensorSample> * iterable; ///< The iterable that will be accessed
-	IterableRange iterableRange;
+	const IterableValues * iterable; ///< The iterable that will be accessed
+	IterableRange ownedRange; ///< The range of the iterator, unless it refers to a range owned by someone else
+	const IterableRange * iterableRange; ///< Points either to ownedRange or to a range that outlives the iterator
+	
+	/**
+	 Copies the referenced range into ownedRange before it is modified
+	 
+	 @return the range owned by this iterator
+	 */
+	IterableRange & getOwnedRange(){
+		if(iterableRange != &ownedRange){
+			ownedRange = *iterableRange;
+			iterableRange = &ownedRange;
+		}
+		return ownedRange;
+	}
 	
 public:
 	
-	DataIterator(const Iterable<SensorSample> * iterable, UINT startRow, UINT endRow, const Vector<uint8_t> &columnIndices) :
-	iterable(iterable), iterableRange({startRow, endRow, columnIndices}){
+	DataIterator(const IterableValues * iterable, UINT startRow, UINT endRow, const Vector<uint8_t> &columnIndices) :
+	iterable(iterable), ownedRange({startRow, endRow, columnIndices}), iterableRange(&ownedRange){
+	}
+	
+	DataIterator(const IterableValues * iterable, const IterableRange &iterableRange) :
+	iterable(iterable), ownedRange(iterableRange), iterableRange(&ownedRange){
 	}
 	
-	DataIterator(const Iterable<SensorSample> * iterable, const IterableRange &iterableRange) :
+	/**
+	 Creates a DataIterator that refers to an existing range instead of copying it, so that creating the iterator does not allocate memory. The range is copied only if it is modified through this iterator
+	 
+	 @param iterable the iterable that will be accessed
+	 @param iterableRange a pointer to the range of indices that will be accessed, which should outlive the iterator
+	 */
+	DataIterator(const IterableValues * iterable, const IterableRange * iterableRange) :
 	iterable(iterable), iterableRange(iterableRange){
 	}
 	
 	DataIterator(const DataIterator & rhs) :
-	iterable(rhs.getIterable()), iterableRange(rhs.getIterableRange()){
+	iterable(rhs.getIterable()), ownedRange(rhs.getIterableRange()), iterableRange(&ownedRange){
+	}
+	
+	DataIterator& operator=(const DataIterator & rhs){
+		if(this != &rhs){
+			iterable = rhs.getIterable();
+			ownedRange = rhs.getIterableRange();
+			iterableRange = &ownedRange;
+		}
+		return *this;
 	}
 	
 	/**
@@ -81,46 +114,47 @@ public:
 		return new DataIterator(*this);
 	}
 	
-	const Iterable<SensorSample> * getIterable() const{
+	const IterableValues * getIterable() const{
 		return iterable;
 	}
 	
 	const IterableRange& getIterableRange() const{
-		return iterableRange;
+		return *iterableRange;
 	}
 	
 	void setColumnIndices(const Vector<uint8_t> &newColumnIndices) {
-		iterableRange.columnIndices = newColumnIndices;
+		getOwnedRange().columnIndices = newColumnIndices;
 	}
 	
 	void setRowRange(UINT newStartRow, UINT newEndRow) {
-		iterableRange.startRow = newStartRow;
-		iterableRange.endRow = newEndRow;
+		IterableRange & range = getOwnedRange();
+		range.startRow = newStartRow;
+		range.endRow = newEndRow;
 	}
 	
 	UINT getStartRow() const{
-		return iterableRange.startRow;
+		return iterableRange->startRow;
 	}
 	
 	UINT getEndRow() const{
-		return iterableRange.endRow;
+		return iterableRange->endRow;
 	}
 	
 	UINT getFirstColumn() const{
-		return iterableRange.columnIndices[0];
+		return iterableRange->columnIndices[0];
 	}
 	
 	UINT getLastColumn() const{
-		UINT lastIdx = iterableRange.columnIndices.getSize()-1;
-		return iterableRange.columnIndices[lastIdx];
+		UINT lastIdx = iterableRange->columnIndices.getSize()-1;
+		return iterableRange->columnIndices[lastIdx];
 	}
 	
 	UINT getNumRows() const {
-		return iterableRange.getNumRows();
+		return iterableRange->getNumRows();
 	}
 	
 	UINT getNumColumns() const{
-		return (UINT) iterableRange.getNumColumns();
+		return (UINT) iterableRange->getNumColumns();
 	}
 	
 	/**
@@ -132,6 +166,58 @@ public:
 		return getNumRows() * getNumColumns();
 	}
 	
+	/**
+	 Retrieves the memory of the values accessed by an iterator over a single column, so that they can be iterated without virtual calls nor bounds checks. The range is checked once by the iterable. When ARF_CHECKED_ITERATORS is defined the spans are never provided, so that every access goes through the checked getDataAtIdx()
+	 
+	 @param span set to the values of the column, in up to two strided parts
+	 @return false if the iterator accesses several columns, or the iterable does not store the values with a constant stride, or the range is invalid
+	 */
+	inline bool getSpan(StridedSpan & span) const{
+#ifdef ARF_CHECKED_ITERATORS
+		return false;
+#else
+		if(iterableRange->getNumColumns() != 1){
+			return false;
+		}
+		return iterable->getStridedSpan(iterableRange->columnIndices[0], iterableRange->startRow, iterableRange->endRow, span);
+#endif
+	}
+	
+	/**
+	 Retrieves the memory of the values of one of the columns accessed by an iterator, so that iterators over several columns can be processed column by column. When ARF_CHECKED_ITERATORS is defined the spans are never provided
+	 
+	 @param colIdx the index of the column in the iterator, should be in the range [0 columns)
+	 @param span set to the values of the column, in up to two strided parts
+	 @return false if the iterable does not store the values with a constant stride, or the range is invalid
+	 */
+	inline bool getColumnSpan(const UINT colIdx, StridedSpan & span) const{
+#ifdef ARF_CHECKED_ITERATORS
+		return false;
+#else
+		if(colIdx >= iterableRange->getNumColumns()){
+			return false;
+		}
+		return iterable->getStridedSpan(iterableRange->columnIndices[colIdx], iterableRange->startRow, iterableRange->endRow, span);
+#endif
+	}
+	
+	/**
+	 Computes the aggregate of the values accessed by an iterator over a single column from the index of the iterable, if it has one. When ARF_CHECKED_ITERATORS is defined the aggregates are never provided
+	 
+	 @param aggregate set to the aggregate of the values of the column
+	 @return false if the iterator accesses several columns, or the iterable has no index for the column, or the range is invalid
+	 */
+	inline bool getAggregate(RangeAggregate & aggregate) const{
+#ifdef ARF_CHECKED_ITERATORS
+		return false;
+#else
+		if(iterableRange->getNumColumns() != 1){
+			return false;
+		}
+		return iterable->getRangeAggregate(iterableRange->columnIndices[0], iterableRange->startRow, iterableRange->endRow, aggregate);
+#endif
+	}
+	
 	/**
 	 Returns a reference to the data at (rowIdx, colIdx)
 	 
@@ -153,9 +239,9 @@ public:
 		if(rowIdx >= getNumRows()) throw ARFException("DataIterator::getDataAtIdx() invalid row index");
 		if(colIdx >= getNumColumns()) throw ARFException("DataIterator::getDataAtIdx() invalid colum index");
 		
-		UINT iterableRowIdx = rowIdx + iterableRange.startRow;
-		UINT iterableColumnIdx = iterableRange.columnIndices[colIdx];
-		return (*iterable)[iterableRowIdx][iterableColumnIdx];
+		UINT iterableRowIdx = rowIdx + iterableRange->startRow;
+		UINT iterableColumnIdx = iterableRange->columnIndices[colIdx];
+		return iterable->getValue(iterableRowIdx, iterableColumnIdx);
 	}
 	
 	/**
@@ -190,15 +276,15 @@ public:
 			if(idx >= getNumColumns()){
 				throw ARFException("DataIterator::getDataAtIdx() column index out of bounds");
 			} else {
-				UINT columnIdx = iterableRange.columnIndices[idx];
-				return (*iterable)[iterableRange.startRow][columnIdx];
+				UINT columnIdx = iterableRange->columnIndices[idx];
+				return iterable->getValue(iterableRange->startRow, columnIdx);
 			}
 		} else if(getNumColumns() == 1){
 			if(idx >= getNumRows()){
 				throw ARFException("DataIterator::getDataAtIdx() row index out of bounds");
 			} else {
-				UINT columnIdx = iterableRange.columnIndices[0];
-				return (*iterable)[iterableRange.startRow + idx][columnIdx];
+				UINT columnIdx = iterableRange->columnIndices[0];
+				return iterable->getValue(iterableRange->startRow + idx, columnIdx);
 			}
 		} else {
 			
@@ -0,0 +1,410 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DataSetReader.h"
+#include "DataSetWriter.h"
+#include "../utils/CSVParser.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ARF {
+
+static bool EndsWith(const std::string &text, const std::string &suffix){
+	return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static uint32_t ReadUInt32(const uint8_t * data){
+	return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+static uint64_t ReadUInt64(const uint8_t * data){
+	return (uint64_t) ReadUInt32(data) | ((uint64_t) ReadUInt32(data + 4) << 32);
+}
+
+DataSetReader::DataSetReader(const std::string &fileName, UINT blockSize, bool parseColumnHeader, char delimiter) : csv(EndsWith(fileName, ".csv") || EndsWith(fileName, ".txt")), delimiter(delimiter), blockSize(blockSize), numColumns(0), numBlockColumns(0), numSamples(0), position(0), blockStart(0), numBlockSamples(0), dataOffset(0), version(0), fileBlockSize(0), fileBlockIdx(0), nextFileBlockIdx(0), textBegin(0), textEnd(0), endOfFile(false), numEmptyLines(0) {
+	
+	if(blockSize == 0){
+		throw ARFException("DataSetReader::DataSetReader() the block size should be greater than 0");
+	}
+	file.open(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+	if(!file.is_open()){
+		throw ARFException("DataSetReader::DataSetReader() could not open file " + fileName);
+	}
+	
+	if(csv){
+		textBuffer.resize(kTextBufferSize);
+		readCSVHeader(parseColumnHeader);
+	} else {
+		readHeader();
+	}
+	block.resize((size_t) blockSize * numColumns);
+	numBlockColumns = numColumns;
+	blockColumnNames = columnNames;
+}
+
+void DataSetReader::selectColumns(const Vector<UINT> &columns){
+	if(columns.getSize() == 0){
+		throw ARFException("DataSetReader::selectColumns() at least one column should be selected");
+	}
+	for(UINT k = 0 ; k < columns.getSize() ; k++){
+		if(columns[k] >= numColumns || (k > 0 && columns[k] <= columns[k - 1])){
+			throw ARFException("DataSetReader::selectColumns() the columns should be columns of the file in increasing order");
+		}
+	}
+	
+	//selecting every column is the same as not selecting any
+	selectedColumns.clear();
+	blockColumnNames.clear();
+	if(columns.getSize() < numColumns){
+		selectedColumns = columns;
+		for(UINT k = 0 ; k < columns.getSize() && columnNames.getSize() == numColumns ; k++){
+			blockColumnNames.push_back(columnNames[columns[k]]);
+		}
+	} else {
+		blockColumnNames = columnNames;
+	}
+	numBlockColumns = columns.getSize();
+	numBlockSamples = 0;
+	fileBlockIdx = (UINT) fileBlockNumSamples.size();
+}
+
+void DataSetReader::projectRows(UINT numRows){
+	if(selectedColumns.getSize() == 0){
+		return;
+	}
+	
+	//every value moves to an index that is not greater than its own, so the rows are projected front to back in place
+	const UINT * columns = selectedColumns.getData();
+	for(UINT i = 0 ; i < numRows ; i++){
+		const Float * row = block.data() + (size_t) i * numColumns;
+		Float * projectedRow = block.data() + (size_t) i * numBlockColumns;
+		for(UINT k = 0 ; k < numBlockColumns ; k++){
+			projectedRow[k] = row[columns[k]];
+		}
+	}
+}
+
+void DataSetReader::readHeader(){
+	std::string word;
+	
+	//compressed files start with the version of the format
+	file >> word;
+	version = 1;
+	if(word == "ARFVersion:"){
+		file >> version;
+		if(version != DataSetWriter::kVersion){
+			throw ARFException("DataSetReader::DataSetReader() unsupported version " + std::to_string(version) + " of the .arf format");
+		}
+		file >> word;
+	}
+	if(word != "DatasetName:"){
+		throw ARFException("DataSetReader::DataSetReader() failed to find DatasetName header");
+	}
+	file >> datasetName;
+	
+	file >> word;
+	if(word != "InfoText:"){
+		throw ARFException("DataSetReader::DataSetReader() failed to find InfoText header");
+	}
+	file >> word;
+	while(file && word != "NumDimensions:"){
+		infoText += word + " ";
+		file >> word;
+	}
+	file >> numColumns;
+	
+	file >> word;
+	if(word != "TotalNumSamples:"){
+		throw ARFException("DataSetReader::DataSetReader() failed to find TotalNumSamples header");
+	}
+	file >> numSamples;
+	
+	if(version == DataSetWriter::kVersion){
+		file >> word;
+		if(word != "BlockSize:"){
+			throw ARFException("DataSetReader::DataSetReader() failed to find BlockSize header");
+		}
+		file >> fileBlockSize;
+		if(fileBlockSize == 0){
+			throw ARFException("DataSetReader::DataSetReader() invalid block size");
+		}
+	}
+	
+	file >> word;
+	if(word != "ColumnHeaders:"){
+		throw ARFException("DataSetReader::DataSetReader() failed to find ColumnHeaders header");
+	}
+	columnNames.resize(numColumns);
+	for(UINT j = 0 ; j < numColumns ; j++){
+		file >> columnNames[j];
+	}
+	
+	//the rows follow the character ending the line of the column headers
+	file.get();
+	if(!file || numColumns == 0){
+		throw ARFException("DataSetReader::DataSetReader() invalid header");
+	}
+	dataOffset = file.tellg();
+	
+	if(version == DataSetWriter::kVersion){
+		readIndex();
+	}
+}
+
+void DataSetReader::readIndex(){
+	
+	//the footer at the end of the file locates the index
+	file.seekg(0, std::ifstream::end);
+	uint64_t fileSize = (uint64_t) file.tellg();
+	if(!file || fileSize < (uint64_t) dataOffset + DataSetWriter::kFooterSize){
+		throw ARFException("DataSetReader::DataSetReader() the compressed file has no index");
+	}
+	uint8_t footer[DataSetWriter::kFooterSize];
+	file.seekg((std::streamoff) (fileSize - DataSetWriter::kFooterSize));
+	file.read(reinterpret_cast<char*>(footer), DataSetWriter::kFooterSize);
+	uint64_t indexOffset = ReadUInt64(footer);
+	UINT numBlocks = ReadUInt32(footer + 8);
+	if(!file || ReadUInt64(footer + 16) != DataSetWriter::kIndexMagic || indexOffset < (uint64_t) dataOffset ||
+	   indexOffset + (uint64_t) numBlocks * DataSetWriter::kIndexEntrySize + DataSetWriter::kFooterSize != fileSize){
+		throw ARFException("DataSetReader::DataSetReader() the compressed file has no index");
+	}
+	
+	std::vector<uint8_t> index((size_t) numBlocks * DataSetWriter::kIndexEntrySize);
+	file.seekg((std::streamoff) indexOffset);
+	file.read(reinterpret_cast<char*>(index.data()), index.size());
+	if(!file || ColumnCodec::Checksum(index.data(), index.size()) != ReadUInt32(footer + 12)){
+		throw ARFException("DataSetReader::DataSetReader() the index of the compressed file is corrupted");
+	}
+	
+	//every block but the last one has fileBlockSize samples, and the blocks are stored one after the other before the index
+	fileBlockOffsets.resize(numBlocks + 1);
+	fileBlockNumSamples.resize(numBlocks);
+	uint64_t numIndexedSamples = 0;
+	for(UINT i = 0 ; i < numBlocks ; i++){
+		fileBlockOffsets[i] = ReadUInt64(index.data() + (size_t) i * DataSetWriter::kIndexEntrySize);
+		fileBlockNumSamples[i] = ReadUInt32(index.data() + (size_t) i * DataSetWriter::kIndexEntrySize + 8);
+		numIndexedSamples += fileBlockNumSamples[i];
+		bool validSize = (i + 1 < numBlocks) ? (fileBlockNumSamples[i] == fileBlockSize) : (fileBlockNumSamples[i] > 0 && fileBlockNumSamples[i] <= fileBlockSize);
+		uint64_t previousEnd = (i > 0) ? fileBlockOffsets[i - 1] + DataSetWriter::kBlockHeaderSize : (uint64_t) dataOffset;
+		if(!validSize || fileBlockOffsets[i] < previousEnd){
+			throw ARFException("DataSetReader::DataSetReader() the index of the compressed file is corrupted");
+		}
+	}
+	fileBlockOffsets[numBlocks] = indexOffset;
+	if(numIndexedSamples != numSamples || (numBlocks > 0 && fileBlockOffsets[numBlocks - 1] + DataSetWriter::kBlockHeaderSize > indexOffset)){
+		throw ARFException("DataSetReader::DataSetReader() the index of the compressed file does not match its header");
+	}
+	
+	fileBlock.resize((size_t) fileBlockSize * numColumns);
+	fileBlockIdx = numBlocks;
+	nextFileBlockIdx = numBlocks;
+}
+
+void DataSetReader::decodeFileBlock(UINT blockIdx){
+	UINT numBlocks = (UINT) fileBlockNumSamples.size();
+	fileBlockIdx = numBlocks;
+	
+	//sequential blocks are read without seeking
+	if(blockIdx != nextFileBlockIdx){
+		file.clear();
+		file.seekg((std::streamoff) fileBlockOffsets[blockIdx]);
+	}
+	size_t numBytes = (size_t) (fileBlockOffsets[blockIdx + 1] - fileBlockOffsets[blockIdx]);
+	compressedBlock.resize(numBytes);
+	file.read(reinterpret_cast<char*>(compressedBlock.data()), numBytes);
+	if((size_t) file.gcount() != numBytes){
+		nextFileBlockIdx = numBlocks;
+		throw ARFException("DataSetReader::readBlock() the file is shorter than its index states");
+	}
+	nextFileBlockIdx = blockIdx + 1;
+	
+	UINT numFileBlockSamples = fileBlockNumSamples[blockIdx];
+	const uint8_t * payload = compressedBlock.data() + DataSetWriter::kBlockHeaderSize;
+	const uint8_t * payloadEnd = compressedBlock.data() + numBytes;
+	if(ReadUInt32(compressedBlock.data()) != numFileBlockSamples || ReadUInt32(compressedBlock.data() + 4) != (uint32_t) (payloadEnd - payload) ||
+	   ColumnCodec::Checksum(payload, payloadEnd - payload) != ReadUInt32(compressedBlock.data() + 8)){
+		throw ARFException("DataSetReader::readBlock() block " + std::to_string(blockIdx) + " of the compressed file is corrupted");
+	}
+	
+	//the columns that are not selected are skipped without decoding them
+	UINT numDecodedColumns = 0;
+	for(UINT j = 0 ; j < numColumns && payload != nullptr ; j++){
+		if(selectedColumns.getSize() == 0 || (numDecodedColumns < numBlockColumns && selectedColumns[numDecodedColumns] == j)){
+			payload = codec.decode(payload, payloadEnd, numFileBlockSamples, fileBlock.data() + (size_t) numDecodedColumns * numFileBlockSamples);
+			numDecodedColumns++;
+		} else {
+			payload = ColumnCodec::Skip(payload, payloadEnd, numFileBlockSamples);
+		}
+	}
+	if(payload != payloadEnd){
+		throw ARFException("DataSetReader::readBlock() block " + std::to_string(blockIdx) + " of the compressed file could not be decoded");
+	}
+	fileBlockIdx = blockIdx;
+}
+
+void DataSetReader::readCompressedRows(UINT numRows){
+	UINT numReadRows = 0;
+	while(numReadRows < numRows){
+		UINT sampleIdx = position + numReadRows;
+		UINT blockIdx = sampleIdx / fileBlockSize;
+		if(blockIdx != fileBlockIdx){
+			decodeFileBlock(blockIdx);
+		}
+		
+		//the columns of the block of the file are copied into the rows of the block
+		UINT numFileBlockSamples = fileBlockNumSamples[blockIdx];
+		UINT startRow = sampleIdx - blockIdx * fileBlockSize;
+		UINT numCopiedRows = std::min(numRows - numReadRows, numFileBlockSamples - startRow);
+		for(UINT k = 0 ; k < numBlockColumns ; k++){
+			const Float * column = fileBlock.data() + (size_t) k * numFileBlockSamples + startRow;
+			Float * rows = block.data() + (size_t) numReadRows * numBlockColumns + k;
+			for(UINT i = 0 ; i < numCopiedRows ; i++){
+				rows[(size_t) i * numBlockColumns] = column[i];
+			}
+		}
+		numReadRows += numCopiedRows;
+	}
+}
+
+void DataSetReader::readCSVHeader(bool parseColumnHeader){
+	size_t lineEnd = findLineEnd();
+	if(textBegin == textEnd){
+		if(parseColumnHeader){
+			throw ARFException("DataSetReader::DataSetReader() the file has no header");
+		}
+		return;
+	}
+	
+	//the first line is parsed by a CSVParser, which counts the columns and splits the header
+	CSVParser lineParser(textBuffer.data() + textBegin, lineEnd - textBegin, parseColumnHeader, delimiter);
+	numColumns = lineParser.getNumColumns();
+	if(parseColumnHeader){
+		columnNames = lineParser.getColumnNames();
+		textBegin = std::min(lineEnd + 1, textEnd);
+	}
+}
+
+void DataSetReader::fillTextBuffer(){
+	if(textBegin > 0){
+		memmove(textBuffer.data(), textBuffer.data() + textBegin, textEnd - textBegin);
+		textEnd -= textBegin;
+		textBegin = 0;
+	}
+	if(textEnd == textBuffer.size()){
+		textBuffer.resize(textBuffer.size() * 2);
+	}
+	file.read(textBuffer.data() + textEnd, textBuffer.size() - textEnd);
+	textEnd += (size_t) file.gcount();
+	if(!file){
+		endOfFile = true;
+	}
+}
+
+size_t DataSetReader::findLineEnd(){
+	size_t searchStart = textBegin;
+	while(true){
+		const char * newLine = (const char*) memchr(textBuffer.data() + searchStart, '\n', textEnd - searchStart);
+		if(newLine != nullptr){
+			return newLine - textBuffer.data();
+		}
+		if(endOfFile){
+			return textEnd;
+		}
+		
+		//the characters already searched are not searched again after the buffer is filled
+		size_t numSearched = textEnd - textBegin;
+		fillTextBuffer();
+		searchStart = textBegin + numSearched;
+	}
+}
+
+UINT DataSetReader::readCSVRows(){
+	UINT numRows = 0;
+	while(numRows < blockSize){
+		size_t lineEnd = findLineEnd();
+		if(lineEnd == textBegin && textBegin == textEnd){
+			break;
+		}
+		const char * line = textBuffer.data() + textBegin;
+		size_t lineLength = lineEnd - textBegin;
+		size_t nextLine = std::min(lineEnd + 1, textEnd);
+		
+		//empty lines are only allowed at the end of the file
+		if(lineLength == 0 || (lineLength == 1 && line[0] == '\r')){
+			numEmptyLines++;
+			textBegin = nextLine;
+			continue;
+		}
+		if(numEmptyLines > 0){
+			throw ARFException("DataSetReader::readBlock() empty line before row " + std::to_string(position + numRows));
+		}
+		
+		const char * rowEnd = CSVParser::ParseRow(line, textBuffer.data() + nextLine, block.data() + (size_t) numRows * numColumns, numColumns, delimiter);
+		if(rowEnd != textBuffer.data() + nextLine){
+			throw ARFException("DataSetReader::readBlock() invalid value or wrong number of values in row " + std::to_string(position + numRows));
+		}
+		textBegin = nextLine;
+		numRows++;
+	}
+	return numRows;
+}
+
+UINT DataSetReader::readBlock(){
+	blockStart = position;
+	if(csv){
+		numBlockSamples = (numColumns > 0) ? readCSVRows() : 0;
+		projectRows(numBlockSamples);
+	} else if(version == DataSetWriter::kVersion){
+		UINT numRows = std::min(blockSize, numSamples - position);
+		numBlockSamples = 0;
+		readCompressedRows(numRows);
+		numBlockSamples = numRows;
+	} else {
+		numBlockSamples = std::min(blockSize, numSamples - position);
+		size_t numBytes = (size_t) numBlockSamples * numColumns * sizeof(Float);
+		file.read(reinterpret_cast<char*>(block.data()), numBytes);
+		if((size_t) file.gcount() != numBytes){
+			numBlockSamples = 0;
+			throw ARFException("DataSetReader::readBlock() the file is shorter than its header states");
+		}
+		projectRows(numBlockSamples);
+	}
+	position += numBlockSamples;
+	return numBlockSamples;
+}
+
+void DataSetReader::seek(UINT sampleIdx){
+	if(csv){
+		throw ARFException("DataSetReader::seek() only .arf files can be sought");
+	}
+	if(sampleIdx > numSamples){
+		throw ARFException("DataSetReader::seek() invalid sample index");
+	}
+	
+	//the blocks of compressed files are sought when they are decoded
+	if(version == 1){
+		file.clear();
+		file.seekg(dataOffset + (std::streamoff) sampleIdx * numColumns * sizeof(Float));
+	}
+	position = sampleIdx;
+	numBlockSamples = 0;
+}
+
+}
@@ -0,0 +1,299 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The DataSetReader reads a recording stored in an .arf or a CSV file in blocks of samples, so that only one block is in memory at a time
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_DATA_SET_READER_H
+#define ARF_DATA_SET_READER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Data.h"
+#include "Vector.h"
+#include "../utils/ARFTypedefs.h"
+#include "../utils/ARFException.h"
+#include "../utils/ColumnCodec.h"
+
+namespace ARF {
+
+/**
+ Reads the samples of a file block after block into a single buffer, whose rows can be passed to PipelinePlan::executeBlock(). Compressed .arf files written by a DataSetWriter are decoded one block of the file at a time, and their checksums are verified:
+ 
+	DataSetReader reader("recording.arf");
+	for(UINT numSamples = reader.readBlock() ; numSamples > 0 ; numSamples = reader.readBlock()){
+		plan.executeBlock(reader.getBlock(), numSamples, reader.getNumColumns(), reader.getNumColumns(), output, sampleIndices);
+	}
+ */
+class DataSetReader {
+	
+public:
+	
+	static const UINT kDefaultBlockSize = 4096; ///< The default number of samples of a block
+	static const UINT kTextBufferSize = 1 << 16; ///< The number of characters read from a CSV file at a time
+	
+private:
+	std::ifstream file; ///< The file being read
+	bool csv; ///< Whether the file is a CSV file, otherwise it is an .arf file
+	char delimiter; ///< The character separating the values of a row of a CSV file
+	UINT blockSize; ///< The maximum number of samples of a block
+	UINT numColumns; ///< The number of values in every sample of the file
+	Vector<UINT> selectedColumns; ///< The columns of the file kept in the block, in increasing order, or empty if every column is kept
+	UINT numBlockColumns; ///< The number of values in every sample of the block
+	UINT numSamples; ///< The number of samples of an .arf file
+	UINT position; ///< The index of the next sample that will be read
+	UINT blockStart; ///< The index of the first sample of the current block
+	UINT numBlockSamples; ///< The number of samples of the current block
+	std::vector<Float> block; ///< The samples of the current block, one row after the other. It has room for the rows of the file, which are projected to the selected columns in place
+	std::streamoff dataOffset; ///< The position of the first sample in an .arf file
+	
+	UINT version; ///< The version of the format of an .arf file, 1 for the uncompressed files written by DataSet::saveDatasetToFile()
+	UINT fileBlockSize; ///< The number of samples of every block of a compressed file but the last one
+	std::vector<uint64_t> fileBlockOffsets; ///< The position in a compressed file of every block, from its index, followed by the position of the index
+	std::vector<UINT> fileBlockNumSamples; ///< The number of samples of every block of a compressed file, from its index
+	UINT fileBlockIdx; ///< The index of the block of the compressed file stored in fileBlock, or the number of blocks if none is
+	UINT nextFileBlockIdx; ///< The index of the block of the compressed file at the position of the file stream
+	std::vector<Float> fileBlock; ///< The selected columns of a block of the compressed file, one after the other
+	std::vector<uint8_t> compressedBlock; ///< The header and the payload of a block of the compressed file
+	ColumnCodec codec; ///< Decodes the columns of the blocks of a compressed file
+	
+	std::vector<char> textBuffer; ///< The characters of a CSV file that were read but not parsed yet
+	size_t textBegin; ///< The first character of textBuffer that was not parsed
+	size_t textEnd; ///< The character following the last character read into textBuffer
+	bool endOfFile; ///< Whether every character of the CSV file was read into textBuffer
+	UINT numEmptyLines; ///< The number of empty lines read, which are only allowed at the end of a CSV file
+	
+	std::string datasetName;
+	std::string infoText;
+	Vector<std::string> columnNames;
+	Vector<std::string> blockColumnNames; ///< The names of the selected columns
+	
+	/**
+	 Parses the header of an .arf file, in the format of DataSet::saveDatasetToFile() or of a DataSetWriter
+	 */
+	void readHeader();
+	
+	/**
+	 Reads and verifies the index of the blocks at the end of a compressed file
+	 */
+	void readIndex();
+	
+	/**
+	 Reads a block of a compressed file, verifies its checksum and decodes it into fileBlock
+	 
+	 @param blockIdx the index of the block
+	 */
+	void decodeFileBlock(UINT blockIdx);
+	
+	/**
+	 Moves the selected columns of the rows of the block to the start of the rows, so that the rows of the block are consecutive
+	 
+	 @param numRows the number of rows of the block
+	 */
+	void projectRows(UINT numRows);
+	
+	/**
+	 Copies the next rows of a compressed file into the block, decoding the blocks of the file they are in
+	 
+	 @param numRows the number of rows
+	 */
+	void readCompressedRows(UINT numRows);
+	
+	/**
+	 Parses the first line of a CSV file to count its columns, and reads the names of the columns if the line is a header
+	 
+	 @param parseColumnHeader whether the first line contains the names of the columns
+	 */
+	void readCSVHeader(bool parseColumnHeader);
+	
+	/**
+	 Moves the characters that were not parsed to the beginning of textBuffer and reads more characters after them. The buffer is grown if it is full, which only happens with lines longer than the buffer
+	 */
+	void fillTextBuffer();
+	
+	/**
+	 Finds the end of the next line of a CSV file, reading more characters if needed
+	 
+	 @return the position in textBuffer of the new line ending the line, or textEnd if the line is the last of the file, or textBegin if the whole file was read
+	 */
+	size_t findLineEnd();
+	
+	/**
+	 Reads the next rows of a CSV file into the block
+	 
+	 @return the number of rows read
+	 */
+	UINT readCSVRows();
+	
+	DataSetReader(const DataSetReader &rhs);
+	DataSetReader& operator=(const DataSetReader &rhs);
+	
+public:
+	
+	/**
+	 Opens a file and parses its header. Files ending in '.csv' or '.txt' are read as CSV files and the rest as .arf files, like DataSet::load() does
+	 
+	 @param fileName the name of the file
+	 @param blockSize the maximum number of samples read by readBlock()
+	 @param parseColumnHeader whether the first line of a CSV file contains the names of the columns, ignored for .arf files
+	 @param delimiter the character separating the values of a CSV file
+	 */
+	DataSetReader(const std::string &fileName, UINT blockSize = kDefaultBlockSize, bool parseColumnHeader = false, char delimiter = ',');
+	
+	/**
+	 Reads the next samples of the file into the block, replacing the previous ones. Throws an ARFException if a row of a CSV file is invalid, an .arf file is shorter than its header states or a block of a compressed file does not match its checksum
+	 
+	 @return the number of samples read, up to the block size, or 0 at the end of the file
+	 */
+	UINT readBlock();
+	
+	/**
+	 Keeps only some of the columns of the file in the blocks read by the next calls to readBlock(), like the columns read by a pipeline collected by a ColumnProjection. The columns that are not selected are not decoded from compressed files, and are dropped as the rows of uncompressed and CSV files are read. getNumColumns() and getColumnNames() refer to the selected columns
+	 
+	 @param columns the indices of the columns of the file that are kept, in increasing order
+	 */
+	void selectColumns(const Vector<UINT> &columns);
+	
+	/**
+	 Moves to a sample of an .arf file, so that the next call to readBlock() starts at that sample. Compressed files are sought through their index and decoded from the start of the block containing the sample. CSV files cannot be sought because their rows have different lengths
+	 
+	 @param sampleIdx the index of the sample, should be in the range [0 getNumSamples()]
+	 */
+	void seek(UINT sampleIdx);
+	
+	/**
+	 Retrieves the samples read by the last call to readBlock()
+	 
+	 @return the values of the samples, one row of getNumColumns() values after the other
+	 */
+	const Float * getBlock() const{
+		return block.data();
+	}
+	
+	/**
+	 Retrieves a sample of the block
+	 
+	 @param rowIdx the index of the sample in the block, should be in the range [0 getNumBlockSamples())
+	 @return the values of the sample
+	 */
+	const Float * getRow(const UINT rowIdx) const{
+		if(rowIdx >= numBlockSamples) throw ARFException("DataSetReader::getRow() invalid row index");
+		return block.data() + (size_t) rowIdx * numBlockColumns;
+	}
+	
+	/**
+	 Retrieves the number of samples read by the last call to readBlock()
+	 
+	 @return the number of samples of the block
+	 */
+	UINT getNumBlockSamples() const{
+		return numBlockSamples;
+	}
+	
+	/**
+	 Retrieves the index in the file of the first sample of the block
+	 
+	 @return the index of the first sample read by the last call to readBlock()
+	 */
+	UINT getBlockStart() const{
+		return blockStart;
+	}
+	
+	/**
+	 Retrieves the index in the file of the sample the next call to readBlock() starts at
+	 
+	 @return the number of samples read or skipped so far
+	 */
+	UINT getPosition() const{
+		return position;
+	}
+	
+	UINT getBlockSize() const{
+		return blockSize;
+	}
+	
+	/**
+	 Retrieves the number of values of the samples of the block
+	 
+	 @return the number of selected columns, which is the number of columns of the file unless selectColumns() was called
+	 */
+	UINT getNumColumns() const{
+		return numBlockColumns;
+	}
+	
+	UINT getNumFileColumns() const{
+		return numColumns;
+	}
+	
+	/**
+	 Retrieves the columns of the file kept in the block
+	 
+	 @return the indices of the selected columns in the file, empty if every column is kept
+	 */
+	const Vector<UINT> & getSelectedColumns() const{
+		return selectedColumns;
+	}
+	
+	/**
+	 Retrieves the number of samples of an .arf file. The rows of CSV files are only counted as they are read
+	 
+	 @return the TotalNumSamples of the header of an .arf file, or 0 for a CSV file
+	 */
+	UINT getNumSamples() const{
+		return numSamples;
+	}
+	
+	/**
+	 Retrieves the version of the format of an .arf file
+	 
+	 @return 1 for the files written by DataSet::saveDatasetToFile(), DataSetWriter::kVersion for the compressed files written by a DataSetWriter, 0 for a CSV file
+	 */
+	UINT getVersion() const{
+		return version;
+	}
+	
+	/**
+	 Retrieves whether the file is a CSV file, which cannot be sought
+	 
+	 @return true if the file is read as a CSV file
+	 */
+	bool isCSV() const{
+		return csv;
+	}
+	
+	const std::string & getDatasetName() const{
+		return datasetName;
+	}
+	
+	const std::string & getInfoText() const{
+		return infoText;
+	}
+	
+	const Vector<std::string> & getColumnNames() const{
+		return blockColumnNames;
+	}
+};
+
+}
+
+#endif //ARF_DATA_SET_READER_H
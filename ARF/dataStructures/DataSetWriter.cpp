@@ -0,0 +1,153 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DataSetWriter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace ARF {
+
+//the TotalNumSamples is written when the file is closed, over as many spaces as the digits of the largest UINT
+static const UINT kNumSamplesWidth = 10;
+
+static void StoreUInt32(uint8_t * data, uint32_t value){
+	for(UINT i = 0 ; i < 4 ; i++){
+		data[i] = (uint8_t) (value >> (8 * i));
+	}
+}
+
+static void StoreUInt64(uint8_t * data, uint64_t value){
+	for(UINT i = 0 ; i < 8 ; i++){
+		data[i] = (uint8_t) (value >> (8 * i));
+	}
+}
+
+DataSetWriter::DataSetWriter(const std::string &fileName, UINT numColumns, const std::string &datasetName, const std::string &infoText, const Vector<std::string> &columnNames, UINT blockSize) : numColumns(numColumns), blockSize(blockSize), numSamples(0), numSamplesOffset(0), block((size_t) blockSize * numColumns), numBlockSamples(0) {
+	
+	if(numColumns == 0 || blockSize == 0){
+		throw ARFException("DataSetWriter::DataSetWriter() the number of columns and the block size should be greater than 0");
+	}
+	file.open(fileName.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if(!file.is_open()){
+		throw ARFException("DataSetWriter::DataSetWriter() could not create file " + fileName);
+	}
+	
+	file << "ARFVersion: " << kVersion << "\n";
+	file << "DatasetName: " << datasetName << "\n";
+	file << "InfoText: " << infoText << "\n";
+	file << "NumDimensions: " << numColumns << "\n";
+	file << "TotalNumSamples: ";
+	numSamplesOffset = file.tellp();
+	file << std::string(kNumSamplesWidth, ' ') << "\n";
+	file << "BlockSize: " << blockSize << "\n";
+	file << "ColumnHeaders:\n";
+	for(UINT j = 0 ; j < numColumns ; j++){
+		if(columnNames.getSize() < numColumns){
+			file << "\t" << "col_" << j + 1;
+		} else {
+			file << "\t" << columnNames[j];
+		}
+	}
+	file << "\n";
+	if(!file){
+		throw ARFException("DataSetWriter::DataSetWriter() could not write the header of file " + fileName);
+	}
+}
+
+DataSetWriter::~DataSetWriter(){
+	if(file.is_open()){
+		try {
+			close();
+		} catch(const ARFException &){
+		}
+	}
+}
+
+void DataSetWriter::writeSample(const Float * sample){
+	writeSamples(sample, 1);
+}
+
+void DataSetWriter::writeSamples(const Float * samples, UINT numNewSamples){
+	if(!file.is_open()){
+		throw ARFException("DataSetWriter::writeSamples() the file is closed");
+	}
+	while(numNewSamples > 0){
+		UINT numCopiedSamples = std::min(numNewSamples, blockSize - numBlockSamples);
+		memcpy(block.data() + (size_t) numBlockSamples * numColumns, samples, (size_t) numCopiedSamples * numColumns * sizeof(Float));
+		numBlockSamples += numCopiedSamples;
+		numSamples += numCopiedSamples;
+		samples += (size_t) numCopiedSamples * numColumns;
+		numNewSamples -= numCopiedSamples;
+		if(numBlockSamples == blockSize){
+			writeBlock();
+		}
+	}
+}
+
+void DataSetWriter::writeBlock(){
+	payload.resize(kBlockHeaderSize);
+	for(UINT j = 0 ; j < numColumns ; j++){
+		codec.encode(block.data() + j, numBlockSamples, numColumns, payload);
+	}
+	size_t payloadSize = payload.size() - kBlockHeaderSize;
+	StoreUInt32(payload.data(), numBlockSamples);
+	StoreUInt32(payload.data() + 4, (uint32_t) payloadSize);
+	StoreUInt32(payload.data() + 8, ColumnCodec::Checksum(payload.data() + kBlockHeaderSize, payloadSize));
+	
+	blockOffsets.push_back((uint64_t) file.tellp());
+	blockNumSamples.push_back(numBlockSamples);
+	file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+	numBlockSamples = 0;
+}
+
+void DataSetWriter::close(){
+	if(!file.is_open()){
+		return;
+	}
+	if(numBlockSamples > 0){
+		writeBlock();
+	}
+	
+	//the index of the blocks and the footer locating it
+	uint64_t indexOffset = (uint64_t) file.tellp();
+	UINT numBlocks = (UINT) blockOffsets.size();
+	std::vector<uint8_t> index((size_t) numBlocks * kIndexEntrySize + kFooterSize);
+	for(UINT i = 0 ; i < numBlocks ; i++){
+		StoreUInt64(index.data() + (size_t) i * kIndexEntrySize, blockOffsets[i]);
+		StoreUInt32(index.data() + (size_t) i * kIndexEntrySize + 8, blockNumSamples[i]);
+	}
+	uint8_t * footer = index.data() + (size_t) numBlocks * kIndexEntrySize;
+	StoreUInt64(footer, indexOffset);
+	StoreUInt32(footer + 8, numBlocks);
+	StoreUInt32(footer + 12, ColumnCodec::Checksum(index.data(), (size_t) numBlocks * kIndexEntrySize));
+	StoreUInt64(footer + 16, kIndexMagic);
+	file.write(reinterpret_cast<const char*>(index.data()), index.size());
+	
+	file.seekp(numSamplesOffset);
+	file << numSamples;
+	
+	bool written = (bool) file;
+	file.close();
+	if(!written){
+		throw ARFException("DataSetWriter::close() could not write the file");
+	}
+}
+
+}
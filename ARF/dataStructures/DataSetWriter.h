@@ -0,0 +1,149 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The DataSetWriter writes a recording block after block into a compressed .arf file, which a DataSetReader reads back
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_DATA_SET_WRITER_H
+#define ARF_DATA_SET_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Data.h"
+#include "Vector.h"
+#include "../utils/ARFTypedefs.h"
+#include "../utils/ARFException.h"
+#include "../utils/ColumnCodec.h"
+
+namespace ARF {
+
+/**
+ Writes samples into a compressed .arf file, the version 2 of the format written by DataSet::saveDatasetToFile(). The text header starts with an ARFVersion: 2 line and states the BlockSize after the TotalNumSamples. The samples follow in blocks of BlockSize samples, only the last block can be shorter. Every block starts with its number of samples, the size of its payload and the CRC-32C of the payload, and its payload contains its columns one after the other, each encoded by a ColumnCodec. The blocks are followed by an index with the offset in the file and the number of samples of every block, and the file ends with the offset of the index, the number of blocks, the CRC-32C of the index and kIndexMagic. The integers are stored in little endian:
+ 
+	DataSetWriter writer("recording.arf", 3, "recording", "", columnNames);
+	writer.writeSample(sample);
+	...
+	writer.close();
+ */
+class DataSetWriter {
+	
+public:
+	
+	static const UINT kVersion = 2; ///< The version of the .arf format written
+	static const UINT kDefaultBlockSize = 16384; ///< The default number of samples of a block
+	static const UINT kBlockHeaderSize = 12; ///< The number of bytes before the payload of a block
+	static const UINT kIndexEntrySize = 12; ///< The number of bytes of the offset and the number of samples of a block in the index
+	static const UINT kFooterSize = 24; ///< The number of bytes after the index
+	static const uint64_t kIndexMagic = 0x5845444E49465241ull; ///< The last 8 bytes of the file, "ARFINDEX"
+	
+private:
+	std::ofstream file; ///< The file being written
+	UINT numColumns; ///< The number of values in every sample
+	UINT blockSize; ///< The number of samples of every block but the last one
+	UINT numSamples; ///< The number of samples written
+	std::streamoff numSamplesOffset; ///< The position of the TotalNumSamples in the header, which is written when the file is closed
+	std::vector<Float> block; ///< The samples of the block being filled, one row after the other
+	UINT numBlockSamples; ///< The number of samples in the block being filled
+	std::vector<uint8_t> payload; ///< The header and the payload of the block being written
+	std::vector<uint64_t> blockOffsets; ///< The position in the file of every block written
+	std::vector<UINT> blockNumSamples; ///< The number of samples of every block written
+	ColumnCodec codec; ///< Encodes the columns of the blocks
+	
+	/**
+	 Compresses the samples of the block and writes them to the file
+	 */
+	void writeBlock();
+	
+	DataSetWriter(const DataSetWriter &rhs);
+	DataSetWriter& operator=(const DataSetWriter &rhs);
+	
+public:
+	
+	/**
+	 Creates a file and writes its header
+	 
+	 @param fileName the name of the file
+	 @param numColumns the number of values in every sample
+	 @param datasetName the name of the dataset, which should not contain spaces
+	 @param infoText a text describing the dataset
+	 @param columnNames the names of the columns, which should not contain spaces. The columns are named col_1, col_2... if fewer than numColumns names are given
+	 @param blockSize the number of samples compressed together. Larger blocks compress better but are decoded at once
+	 */
+	DataSetWriter(const std::string &fileName, UINT numColumns, const std::string &datasetName = "dataset", const std::string &infoText = "", const Vector<std::string> &columnNames = Vector<std::string>(), UINT blockSize = kDefaultBlockSize);
+	
+	/**
+	 Closes the file if close() was not called. Errors are ignored, close() should be called to detect them
+	 */
+	~DataSetWriter();
+	
+	/**
+	 Appends a sample to the file
+	 
+	 @param sample the getNumColumns() values of the sample
+	 */
+	void writeSample(const Float * sample);
+	
+	/**
+	 Appends samples to the file
+	 
+	 @param samples the values of the samples, one row of getNumColumns() values after the other
+	 @param numSamples the number of samples
+	 */
+	void writeSamples(const Float * samples, UINT numSamples);
+	
+	/**
+	 Writes the last block, the index and the number of samples, and closes the file. Throws an ARFException if the file could not be written
+	 */
+	void close();
+	
+	/**
+	 Retrieves whether the file is open, until close() is called
+	 
+	 @return true if samples can be written to the file
+	 */
+	bool isOpen() const{
+		return file.is_open();
+	}
+	
+	UINT getNumColumns() const{
+		return numColumns;
+	}
+	
+	UINT getBlockSize() const{
+		return blockSize;
+	}
+	
+	/**
+	 Retrieves the number of samples written so far
+	 
+	 @return the number of samples passed to writeSample() and writeSamples()
+	 */
+	UINT getNumSamples() const{
+		return numSamples;
+	}
+};
+
+}
+
+#endif //ARF_DATA_SET_WRITER_H
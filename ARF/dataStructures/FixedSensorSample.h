@@ -0,0 +1,178 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The FixedSensorSample is a sensor reading with a number of values known at compile time. The values are stored inline, so a FixedSensorSample does not allocate memory and has no vtable pointer nor size field: a FixedSensorSample<16> occupies 64 bytes, against the 40 bytes of a SensorSample plus its heap-allocated values. It can be stored in RingBuffers and BasicRingBufferAlgorithms and accessed through DataIterators, but it is not a Data object and cannot be passed between algorithms like a SensorSample.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_FIXED_SENSOR_SAMPLE_H
+#define ARF_FIXED_SENSOR_SAMPLE_H
+
+#include <algorithm>
+#include "Vector.h"
+#include "../utils/ARFException.h"
+#include "../utils/ARFTypedefs.h"
+
+namespace ARF {
+
+template <UINT N>
+struct FixedSensorSample {
+	
+	static_assert(N > 0, "FixedSensorSample should have at least one value");
+	
+	Float values[N]; ///< The values of the sample
+	
+	/**
+	 Default constructor, sets all the values to zero
+	 */
+	FixedSensorSample(){
+		std::fill(values, values + N, (Float) 0);
+	}
+	
+	/**
+	 Constructor, copies the values of a SensorSample
+	 
+	 @param sample the sample to copy, which should have N values
+	 */
+	FixedSensorSample(const SensorSample &sample){
+		*this = sample;
+	}
+	
+	/**
+	 Copies the values of a SensorSample
+	 
+	 @param sample the sample to copy, which should have N values
+	 @return a reference to this sample
+	 */
+	FixedSensorSample& operator=(const SensorSample &sample){
+		if(sample.getSize() != N){
+			throw ARFException("FixedSensorSample::operator=() the sample does not have N values");
+		}
+		std::copy(sample.begin(), sample.end(), values);
+		return *this;
+	}
+	
+	/**
+	 Copies the values of this sample to a SensorSample
+	 
+	 @param sample the sample the values are copied to, resized to N values if needed
+	 */
+	void copyTo(SensorSample &sample) const{
+		if(sample.getSize() != N){
+			sample.resize(N);
+		}
+		std::copy(values, values + N, sample.begin());
+	}
+	
+	/**
+	 Retrieves the number of values of the sample
+	 
+	 @return N
+	 */
+	static constexpr UINT getSize(){
+		return N;
+	}
+	
+	/**
+	 Checks that the sample can hold a number of values. Provided so that code written for SensorSamples can be used with FixedSensorSamples, the size of a FixedSensorSample cannot change
+	 
+	 @param newSize the number of values
+	 @return true if newSize is N, false otherwise
+	 */
+	bool resize(const UINT newSize){
+		return newSize == N;
+	}
+	
+	/**
+	 Returns the value at the input index
+	 
+	 @param idx the index of the value, should be in the range [0 N)
+	 @return a reference to the value
+	 */
+	inline Float& operator[](const UINT idx){
+		return values[idx];
+	}
+	
+	/**
+	 Returns the value at the input index
+	 
+	 @param idx the index of the value, should be in the range [0 N)
+	 @return a reference to the value
+	 */
+	inline const Float& operator[](const UINT idx) const{
+		return values[idx];
+	}
+	
+	/**
+	 Returns a pointer to the first value
+	 
+	 @return a pointer to the first value
+	 */
+	inline Float* begin(){
+		return values;
+	}
+	
+	/**
+	 Returns a pointer to the first value
+	 
+	 @return a pointer to the first value
+	 */
+	inline const Float* begin() const{
+		return values;
+	}
+	
+	/**
+	 Returns a pointer past the last value
+	 
+	 @return a pointer past the last value
+	 */
+	inline Float* end(){
+		return values + N;
+	}
+	
+	/**
+	 Returns a pointer past the last value
+	 
+	 @return a pointer past the last value
+	 */
+	inline const Float* end() const{
+		return values + N;
+	}
+};
+
+template <UINT N> struct IterableElement<FixedSensorSample<N> > {
+	static const Float& GetValue(const FixedSensorSample<N> &element, const UINT colIdx){
+		return element.values[colIdx];
+	}
+	
+	static UINT GetStride(){
+		static_assert(sizeof(FixedSensorSample<N>) == N * sizeof(Float), "the samples in an array of FixedSensorSamples should be consecutive");
+		return N;
+	}
+	
+	static UINT GetNumValues(){
+		return N;
+	}
+};
+
+}
+
+#endif //ARF_FIXED_SENSOR_SAMPLE_H
@@ -0,0 +1,243 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MappedDataSet.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ARF_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ARF {
+
+/**
+ Reads the words of the header separated by whitespace, like the >> operator used by DataSet::loadDatasetFromFile()
+ */
+class HeaderReader {
+	const char * text;
+	size_t size;
+	size_t position;
+	
+public:
+	HeaderReader(const char * text, size_t size) : text(text), size(size), position(0) { }
+	
+	std::string readWord(){
+		while(position < size && isspace((unsigned char) text[position])){
+			position++;
+		}
+		size_t start = position;
+		while(position < size && !isspace((unsigned char) text[position])){
+			position++;
+		}
+		if(start == position){
+			throw ARFException("MappedDataSet::MappedDataSet() unexpected end of the header");
+		}
+		return std::string(text + start, position - start);
+	}
+	
+	void expectWord(const char * word){
+		if(readWord() != word){
+			throw ARFException(std::string("MappedDataSet::MappedDataSet() failed to find ") + word + " header");
+		}
+	}
+	
+	UINT readNumber(){
+		std::string word = readWord();
+		char * end = nullptr;
+		unsigned long number = strtoul(word.c_str(), &end, 10);
+		if(*end != '\0'){
+			throw ARFException("MappedDataSet::MappedDataSet() invalid number in the header");
+		}
+		return (UINT) number;
+	}
+	
+	size_t getPosition() const{
+		return position;
+	}
+};
+
+MappedDataSet::MappedDataSet(const std::string &fileName) : mapping(nullptr), fileSize(0), mapped(false), data(nullptr), aligned(true), numColumns(0), numSamples(0) {
+	
+#ifdef ARF_MMAP
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if(fd < 0){
+		throw ARFException("MappedDataSet::MappedDataSet() could not open file " + fileName);
+	}
+	struct stat fileStatus;
+	if(fstat(fd, &fileStatus) != 0 || fileStatus.st_size == 0){
+		close(fd);
+		throw ARFException("MappedDataSet::MappedDataSet() could not read the size of file " + fileName);
+	}
+	fileSize = (size_t) fileStatus.st_size;
+	
+	void * memory = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	
+	//the mapping keeps the file open
+	close(fd);
+	if(memory == MAP_FAILED){
+		throw ARFException("MappedDataSet::MappedDataSet() could not map file " + fileName);
+	}
+	mapping = (const char*) memory;
+	mapped = true;
+#else
+	std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+	if(!file.is_open()){
+		throw ARFException("MappedDataSet::MappedDataSet() could not open file " + fileName);
+	}
+	fileBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	fileSize = fileBuffer.size();
+	mapping = fileBuffer.data();
+#endif
+	
+	try {
+		parseHeader();
+	} catch(...) {
+		unmap();
+		throw;
+	}
+	
+	//the rows were copied, so the file is no longer needed
+	if(!aligned){
+		unmap();
+		std::vector<char>().swap(fileBuffer);
+		mapping = nullptr;
+		return;
+	}
+	advise(kSequential);
+}
+
+MappedDataSet::~MappedDataSet(){
+	unmap();
+}
+
+void MappedDataSet::unmap(){
+#ifdef ARF_MMAP
+	if(mapped){
+		munmap((void*) mapping, fileSize);
+		mapped = false;
+	}
+#endif
+}
+
+void MappedDataSet::parseHeader(){
+	
+	HeaderReader reader(mapping, fileSize);
+	
+	//the rows of compressed files are not stored in the file as they are
+	std::string firstWord = reader.readWord();
+	if(firstWord == "ARFVersion:"){
+		throw ARFException("MappedDataSet::MappedDataSet() compressed .arf files cannot be mapped, they can be read with a DataSetReader");
+	}
+	if(firstWord != "DatasetName:"){
+		throw ARFException("MappedDataSet::MappedDataSet() failed to find DatasetName: header");
+	}
+	datasetName = reader.readWord();
+	
+	reader.expectWord("InfoText:");
+	std::string word = reader.readWord();
+	while(word != "NumDimensions:"){
+		infoText += word + " ";
+		word = reader.readWord();
+	}
+	numColumns = reader.readNumber();
+	
+	reader.expectWord("TotalNumSamples:");
+	numSamples = reader.readNumber();
+	
+	reader.expectWord("ColumnHeaders:");
+	columnNames.resize(numColumns);
+	for(UINT j = 0 ; j < numColumns ; j++){
+		columnNames[j] = reader.readWord();
+	}
+	
+	//the rows follow the character ending the line of the column headers
+	size_t dataOffset = reader.getPosition() + 1;
+	if(numColumns == 0 || dataOffset > fileSize || (fileSize - dataOffset) / sizeof(Float) / numColumns < numSamples){
+		throw ARFException("MappedDataSet::MappedDataSet() the file is shorter than its header states");
+	}
+	
+	//Floats can only be read in place from addresses aligned to them
+	const char * rows = mapping + dataOffset;
+	aligned = ((size_t) rows) % sizeof(Float) == 0;
+	if(aligned){
+		data = (const Float*) rows;
+	} else {
+		alignedRows.resize((size_t) numSamples * numColumns);
+		memcpy(alignedRows.data(), rows, alignedRows.size() * sizeof(Float));
+		data = alignedRows.data();
+	}
+}
+
+void MappedDataSet::getSample(const UINT rowIdx, SensorSample &sample) const{
+	const Float * row = getRow(rowIdx);
+	if(sample.getSize() != numColumns){
+		sample.resize(numColumns);
+	}
+	for(UINT i = 0 ; i < numColumns ; i++){
+		sample[i] = row[i];
+	}
+}
+
+bool MappedDataSet::getStridedSpan(const UINT colIdx, const UINT startRow, const UINT endRow, StridedSpan &span) const{
+	if(startRow > endRow || endRow >= numSamples || colIdx >= numColumns){
+		return false;
+	}
+	span.first = data + (size_t) startRow * numColumns + colIdx;
+	span.firstSize = endRow - startRow + 1;
+	span.second = nullptr;
+	span.secondSize = 0;
+	span.stride = numColumns;
+	return true;
+}
+
+bool MappedDataSet::advise(UINT advice, UINT startRow, UINT endRow) const{
+	if(startRow > endRow || endRow >= numSamples){
+		return false;
+	}
+#ifdef ARF_MMAP
+	if(!mapped){
+		return true;
+	}
+	
+	const int advices[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED};
+	if(advice > kDontNeed){
+		return false;
+	}
+	
+	//the advice applies to whole pages
+	size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+	size_t rowSize = (size_t) numColumns * sizeof(Float);
+	size_t dataOffset = (const char*) data - mapping;
+	size_t start = (dataOffset + startRow * rowSize) / pageSize * pageSize;
+	size_t end = dataOffset + (endRow + 1) * rowSize;
+	return madvise((void*) (mapping + start), end - start, advices[advice]) == 0;
+#else
+	return true;
+#endif
+}
+
+}
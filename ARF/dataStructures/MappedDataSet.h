@@ -0,0 +1,217 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The MappedDataSet reads a recording stored in the .arf format written by DataSet::saveDatasetToFile() by mapping the file into memory instead of loading it. The text header is parsed once and the rows are accessed in place, as pointers into the mapping, so opening a file of any size neither copies nor allocates its samples, and the pages of the file are only read when they are accessed. It can be used wherever an Iterable<SensorSample> is accepted, like in DataSelectors and DataIterators, so that a pipeline reads straight from the file. The mapping uses mmap() on POSIX platforms; on other platforms the file is read into memory.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_MAPPED_DATA_SET_H
+#define ARF_MAPPED_DATA_SET_H
+
+#include <string>
+#include <vector>
+#include "Data.h"
+#include "Vector.h"
+#include "../utils/ARFTypedefs.h"
+#include "../utils/ARFException.h"
+
+namespace ARF {
+
+class MappedDataSet : public Iterable<SensorSample>{
+	
+public:
+	
+	//the ways the rows are going to be accessed, passed to advise()
+	static const UINT kNormal = 0; ///< No particular order
+	static const UINT kSequential = 1; ///< From the first row to the last, like when a recording is replayed. The system reads ahead aggressively and can drop the pages once they are read
+	static const UINT kRandom = 2; ///< In random order, the system does not read ahead
+	static const UINT kWillNeed = 3; ///< The rows will be accessed soon, the system starts reading them in the background
+	static const UINT kDontNeed = 4; ///< The rows will not be accessed again, their pages are released from the memory of the process
+	
+private:
+	const char * mapping; ///< The first byte of the file, mapped or read into fileBuffer
+	size_t fileSize; ///< The number of bytes of the file
+	bool mapped; ///< Whether the file is mapped, instead of read into fileBuffer
+	std::vector<char> fileBuffer; ///< The contents of the file on platforms without mmap()
+	
+	const Float * data; ///< The first value of the first row, which follows the header, or the first value of alignedRows
+	bool aligned; ///< Whether the rows in the file start at an address aligned to a Float
+	std::vector<Float> alignedRows; ///< The rows of files whose rows are not aligned, copied out of the file
+	UINT numColumns; ///< The number of values in every row
+	UINT numSamples; ///< The number of rows
+	std::string datasetName;
+	std::string infoText;
+	Vector<std::string> columnNames;
+	
+	/**
+	 Parses the header of the file and locates the rows
+	 */
+	void parseHeader();
+	
+	/**
+	 Unmaps the file if it is mapped
+	 */
+	void unmap();
+	
+	MappedDataSet(const MappedDataSet &rhs);
+	MappedDataSet& operator=(const MappedDataSet &rhs);
+	
+public:
+	
+	/**
+	 Maps a file and parses its header. The rows are accessed sequentially by default
+	 
+	 @param fileName the name of the .arf file
+	 */
+	MappedDataSet(const std::string &fileName);
+	
+	/**
+	 Unmaps the file. The pointers to the rows and the DataIterators over this dataset become invalid
+	 */
+	~MappedDataSet();
+	
+	const std::string & getDatasetName() const{
+		return datasetName;
+	}
+	
+	const std::string & getInfoText() const{
+		return infoText;
+	}
+	
+	const Vector<std::string> & getColumnNames() const{
+		return columnNames;
+	}
+	
+	/**
+	 Retrieves the number of values in every row
+	 
+	 @return the number of columns, the NumDimensions of the header
+	 */
+	inline UINT getNumColumns() const{
+		return numColumns;
+	}
+	
+	/**
+	 Retrieves the number of rows
+	 
+	 @return the number of samples, the TotalNumSamples of the header
+	 */
+	inline UINT getNumSamples() const{
+		return numSamples;
+	}
+	
+	/**
+	 Retrieves the number of rows
+	 
+	 @return the number of samples
+	 */
+	inline UINT getSize() const override{
+		return numSamples;
+	}
+	
+	/**
+	 Retrieves whether the file is mapped into memory or was read into memory because the platform has no mmap()
+	 
+	 @return true if the rows are read from the mapping of the file
+	 */
+	bool isMapped() const{
+		return mapped;
+	}
+	
+	/**
+	 Retrieves whether the rows in the file start at an address aligned to a Float, so that they are read in place. The rows of files whose header is not a multiple of sizeof(Float) bytes long are unaligned, and reading them through a Float pointer is undefined behavior, so they are copied into an aligned buffer when the file is opened and the file is unmapped
+	 
+	 @return true if the rows are read in place
+	 */
+	bool isAligned() const{
+		return aligned;
+	}
+	
+	/**
+	 Retrieves a row of the file without copying it
+	 
+	 @param rowIdx the index of the row
+	 @return a pointer to the getNumColumns() values of the row, in the mapping of the file or in the aligned copy of its rows
+	 */
+	inline const Float * getRow(const UINT rowIdx) const{
+		if(rowIdx >= numSamples){
+			throw ARFException("MappedDataSet::getRow() row index out of bounds");
+		}
+		return data + (size_t) rowIdx * numColumns;
+	}
+	
+	/**
+	 Retrieves a value of a row
+	 
+	 @param rowIdx the index of the row
+	 @param colIdx the index of the column
+	 @return the value, in the mapping of the file or in the aligned copy of its rows
+	 */
+	inline const Float& getValue(const UINT rowIdx, const UINT colIdx) const override{
+		if(rowIdx >= numSamples || colIdx >= numColumns){
+			throw ARFException("MappedDataSet::getValue() index out of bounds");
+		}
+		return data[(size_t) rowIdx * numColumns + colIdx];
+	}
+	
+	/**
+	 Copies a row into a sample
+	 
+	 @param rowIdx the index of the row
+	 @param sample the sample the values are copied to, resized to getNumColumns() values
+	 */
+	void getSample(const UINT rowIdx, SensorSample &sample) const;
+	
+	/**
+	 Retrieves the values of a column over a range of rows in the mapping, with a stride of getNumColumns()
+	 
+	 @param colIdx the index of the column
+	 @param startRow the index of the first row
+	 @param endRow the index of the last row
+	 @param span set to the values of the column
+	 @return false if the range is invalid
+	 */
+	bool getStridedSpan(const UINT colIdx, const UINT startRow, const UINT endRow, StridedSpan &span) const override;
+	
+	/**
+	 Tells the system how a range of rows is going to be accessed, so that it reads the pages of the file ahead or releases them. Has no effect when the file is not mapped, or its rows were copied because they are not aligned
+	 
+	 @param advice kNormal, kSequential, kRandom, kWillNeed or kDontNeed
+	 @param startRow the index of the first row
+	 @param endRow the index of the last row
+	 @return false if the system rejected the advice or the range is invalid
+	 */
+	bool advise(UINT advice, UINT startRow, UINT endRow) const;
+	
+	/**
+	 Tells the system how all the rows are going to be accessed
+	 
+	 @param advice kNormal, kSequential, kRandom, kWillNeed or kDontNeed
+	 @return false if the system rejected the advice
+	 */
+	bool advise(UINT advice) const{
+		return (numSamples == 0) || advise(advice, 0, numSamples - 1);
+	}
+};
+
+}
+
+#endif //ARF_MAPPED_DATA_SET_H
@@ -29,6 +29,9 @@
 #include "../utils/ARFException.h"
 #include "../utils/ARFConstants.h"
 #include "../utils/ARFTypedefs.h"
+#include "BlockAggregateIndex.h"
+#include <algorithm>
+#include <new>
 
 namespace ARF {
 
@@ -40,6 +43,28 @@ private:
 	UINT size; ///< The amount of elements currently in the ringBuffer
 	UINT capacity; ///< The capacity of the RingBuffer
 	UINT endIdx; ///< The index of the last element in the RingBuffer
+	bool ownsData; ///< Whether the data was allocated by the RingBuffer
+	BlockAggregateIndex * index; ///< The aggregates of the blocks of elements, or NULL if the ring buffer is not indexed
+	
+	/**
+	 Retrieves the block of the last element written, whose aggregates are not up to date
+	 
+	 @return the index of the block
+	 */
+	UINT getDirtyBlockIdx() const{
+		return index->getBlockIdx((endIdx == 0) ? capacity - 1 : endIdx - 1);
+	}
+	
+	/**
+	 Recomputes the aggregates of a block of the index
+	 
+	 @param blockIdx the index of the block
+	 */
+	void updateIndexBlock(UINT blockIdx){
+		index->updateBlock(blockIdx, [this](UINT slotIdx, UINT colIdx){
+			return IterableElement<T>::GetValue(data[slotIdx], colIdx);
+		});
+	}
 
 public:
 	
@@ -48,7 +73,7 @@ public:
 	 
 	 @param capacity the number of elements the ring buffer should store
 	 */
-	RingBuffer(UINT capacity) : capacity(capacity), size(0), endIdx(0){
+	RingBuffer(UINT capacity) : capacity(capacity), size(0), endIdx(0), ownsData(true), index(nullptr){
 		
 		if (capacity == 0){
 			throw ARFException("RingBuffer::RingBuffer() capacity should not be zero");
@@ -57,22 +82,50 @@ public:
 		data = new T[capacity];
 	}
 	
+	/**
+	 Constructor of a ring buffer that stores its elements in memory provided by the caller, for example in a state block shared with other data. The elements are constructed and destroyed by the ring buffer, but the memory is not released
+	 
+	 @param storage uninitialized memory for capacity elements, which should outlive the ring buffer
+	 @param capacity the number of elements the ring buffer should store
+	 */
+	RingBuffer(void * storage, UINT capacity) : capacity(capacity), size(0), endIdx(0), ownsData(false), index(nullptr){
+		
+		if (capacity == 0){
+			throw ARFException("RingBuffer::RingBuffer() capacity should not be zero");
+		}
+		
+		data = (T*) storage;
+		for(UINT i = 0 ; i < capacity ; i++){
+			new (data + i) T();
+		}
+	}
+	
 	/**
 	 Copy constructor of the ring buffer
 	 
 	 @param rhs the ringBuffer that will be copied
 	 */
 	RingBuffer(const RingBuffer & rhs) : capacity(rhs.getCapacity()),
-	size(rhs.getSize()), endIdx(rhs.getEndIdx()){
+	size(rhs.getSize()), endIdx(rhs.getEndIdx()), ownsData(true), index(nullptr){
 		data = new T[capacity];
 		std::copy(rhs.begin(),rhs.end(),data);
+		if(rhs.getIndex() != nullptr){
+			index = new BlockAggregateIndex(*rhs.getIndex());
+		}
 	}
 	
 	/**
 	 Main destructor of the ring buffer
 	 */
 	~RingBuffer(){
-		delete[] data;
+		delete index;
+		if(ownsData){
+			delete[] data;
+		} else {
+			for(UINT i = 0 ; i < capacity ; i++){
+				data[i].~T();
+			}
+		}
 		size = 0;
 		capacity = 0;
 		endIdx = 0;
@@ -93,8 +146,22 @@ public:
 	 @param rhs the element to append to the ring buffer
 	 */
 	void add(const T &rhs){
+		addInPlace() = rhs;
+	}
+	
+	/**
+	 Adds an element to the ringBuffer without copying it. The element that is returned is the oldest element when the ring buffer is full, and should be overwritten by the caller. This avoids constructing a temporary element when the elements own memory, like SensorSamples
+	 
+	 @return a reference to the added element
+	 */
+	T & addInPlace(){
+		
+		//the previous element completed its block, whose aggregates can be computed now that all its elements are written
+		if(index != nullptr && size > 0 && endIdx % index->getBlockSize() == 0){
+			updateIndexBlock(getDirtyBlockIdx());
+		}
 		
-		data[endIdx] = rhs;
+		T & element = data[endIdx];
 		
 		//increase ring buffer size by one
 		if (size < capacity) {
@@ -106,6 +173,75 @@ public:
 		if (endIdx == capacity) {
 			endIdx = 0;
 		}
+		return element;
+	}
+	
+	/**
+	 Creates an index of the aggregates of blocks of elements, so that the sum, mean, variance, minimum and maximum of a column over any range of elements can be computed without reading every element (see getRangeAggregate()). Keeping the index up to date costs one pass over every block each time the block is overwritten
+	 
+	 @param numColumns the number of columns indexed, starting from the first column
+	 @param blockSize the number of elements in a block
+	 */
+	void createIndex(UINT numColumns, UINT blockSize = 32){
+		delete index;
+		index = nullptr;
+		index = new BlockAggregateIndex(capacity, numColumns, blockSize);
+		
+		//index the blocks already written, except the block of the last element
+		if(size > 0){
+			UINT dirtyBlockIdx = getDirtyBlockIdx();
+			for(UINT blockIdx = 0 ; blockIdx < index->getNumBlocks() ; blockIdx++){
+				UINT blockEndSlot = std::min((blockIdx + 1) * blockSize, capacity);
+				if(blockIdx != dirtyBlockIdx && (isFull() || blockEndSlot <= size)){
+					updateIndexBlock(blockIdx);
+				}
+			}
+		}
+	}
+	
+	/**
+	 Retrieves the index of the aggregates of blocks of elements
+	 
+	 @return the index, or NULL if the ring buffer is not indexed
+	 */
+	const BlockAggregateIndex * getIndex() const{
+		return index;
+	}
+	
+	/**
+	 Computes the aggregate of a column over a range of elements from the index
+	 
+	 @param colIdx the index of the value in the elements
+	 @param startRow the index of the first element
+	 @param endRow the index of the last element
+	 @param aggregate set to the aggregate of the values
+	 @return false if the ring buffer is not indexed, the column is not indexed or the range is invalid
+	 */
+	bool getRangeAggregate(const UINT colIdx, const UINT startRow, const UINT endRow, RangeAggregate &aggregate) const override{
+		
+		if(index == nullptr || colIdx >= index->getNumColumns() || startRow > endRow || endRow >= size){
+			return false;
+		}
+		
+		auto getValue = [this](UINT slotIdx, UINT colIdx){
+			return IterableElement<T>::GetValue(data[slotIdx], colIdx);
+		};
+		
+		//the range of elements is one or two ranges of slots, when it wraps around the end of the ring buffer
+		UINT numRows = endRow - startRow + 1;
+		UINT firstSlot = startRow + getFirstElementIdx();
+		if(firstSlot >= capacity){
+			firstSlot -= capacity;
+		}
+		UINT firstPartSize = std::min(numRows, capacity - firstSlot);
+		UINT dirtyBlockIdx = getDirtyBlockIdx();
+		
+		aggregate = RangeAggregate();
+		index->aggregate(colIdx, firstSlot, firstSlot + firstPartSize - 1, dirtyBlockIdx, getValue, aggregate);
+		if(firstPartSize < numRows){
+			index->aggregate(colIdx, 0, numRows - firstPartSize - 1, dirtyBlockIdx, getValue, aggregate);
+		}
+		return true;
 	}
 	
 	/**
@@ -183,6 +319,47 @@ public:
 		return getElementAtIdx(idx);
 	}
 	
+	/**
+	 Retrieves a value of an element of the ring buffer without a virtual call to operator[]
+	 
+	 @param rowIdx the index of the element
+	 @param colIdx the index of the value in the element
+	 @return the value
+	 */
+	inline const Float& getValue(const UINT rowIdx, const UINT colIdx) const override{
+		return IterableElement<T>::GetValue(getElementAtIdx(rowIdx), colIdx);
+	}
+	
+	/**
+	 Retrieves the memory of the values of a column over a range of elements, when the values are stored inside the elements, like in FixedSensorSamples
+	 
+	 @param colIdx the index of the value in the elements
+	 @param startRow the index of the first element
+	 @param endRow the index of the last element
+	 @param span set to the values, in two parts if the range wraps around the end of the ring buffer
+	 @return false if the elements do not store their values or the range is invalid
+	 */
+	bool getStridedSpan(const UINT colIdx, const UINT startRow, const UINT endRow, StridedSpan &span) const override{
+		
+		UINT stride = IterableElement<T>::GetStride();
+		if(stride == 0 || colIdx >= IterableElement<T>::GetNumValues() || startRow > endRow || endRow >= size){
+			return false;
+		}
+		
+		UINT numRows = endRow - startRow + 1;
+		UINT physicalIdx = startRow + getFirstElementIdx();
+		if(physicalIdx >= capacity){
+			physicalIdx -= capacity;
+		}
+		
+		span.first = &IterableElement<T>::GetValue(data[physicalIdx], colIdx);
+		span.firstSize = std::min(numRows, capacity - physicalIdx);
+		span.second = (span.firstSize < numRows) ? &IterableElement<T>::GetValue(data[0], colIdx) : nullptr;
+		span.secondSize = numRows - span.firstSize;
+		span.stride = stride;
+		return true;
+	}
+	
 	/**
 	 Retrieves an element from the ring buffer
 	 
@@ -0,0 +1,358 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The SampleQueue passes SensorSamples with a fixed number of channels from one producer thread, for example a thread decoding sensor packets, to one consumer thread executing a pipeline, without locks. Pushing and consuming samples is wait-free: the producer and the consumer only write their own index, and each index lives in its own cache line. Samples can be published and consumed in batches, so that the indices are exchanged once per batch. The consumer can wait for samples by polling or by blocking on a futex.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_SAMPLE_QUEUE_H
+#define ARF_SAMPLE_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "Vector.h"
+#include "../utils/ARFException.h"
+#include "../utils/ARFTypedefs.h"
+#include "../utils/Futex.h"
+
+namespace ARF {
+
+class SampleQueue {
+	
+private:
+	
+	//number of bytes the indices of the producer and the consumer are padded to
+	static const UINT kCacheLineSize = 64;
+	
+	//number of times a blocking consumer checks for samples before blocking
+	static const UINT kNumSpinIterations = 100;
+	
+	/**
+	 The state written by the producer
+	 */
+	struct ProducerState {
+		std::atomic<UINT> writeIdx; ///< The number of samples published, the only variable of the producer read by the consumer
+		UINT cachedReadIdx; ///< The last readIdx seen by the producer, so that it reads the index of the consumer only when the queue seems full
+		char padding[kCacheLineSize - sizeof(std::atomic<UINT>) - sizeof(UINT)];
+	};
+	
+	/**
+	 The state written by the consumer
+	 */
+	struct ConsumerState {
+		std::atomic<UINT> readIdx; ///< The number of samples consumed, the only variable of the consumer read by the producer
+		UINT cachedWriteIdx; ///< The last writeIdx seen by the consumer, so that it reads the index of the producer only when it needs more samples
+		std::atomic<UINT> wakeCount; ///< The futex the consumer blocks on, incremented to wake it up
+		std::atomic<bool> waiting; ///< Whether the consumer is blocked or about to block in wait()
+		char padding[kCacheLineSize - 3 * sizeof(UINT) - sizeof(std::atomic<bool>)];
+	};
+	
+	char leadingPadding[kCacheLineSize]; ///< Keeps the producer state away from the data that precedes the queue
+	ProducerState producer;
+	ConsumerState consumer;
+	std::atomic<bool> closed; ///< Whether the producer will not push more samples
+	Float * data; ///< The values of the samples, numChannels consecutive values per sample
+	UINT capacity; ///< The number of samples the queue can hold, a power of two
+	UINT numChannels; ///< The number of values in every sample
+	bool blocking; ///< Whether the consumer blocks on a futex instead of polling when the queue is empty
+	
+	/**
+	 Publishes the samples written by the producer, and wakes up the consumer if it is blocked
+	 
+	 @param writeIdx the new number of samples published
+	 */
+	inline void publish(UINT writeIdx){
+		if(blocking){
+			//sequentially consistent so that either the consumer sees the samples or the producer sees the consumer waiting
+			producer.writeIdx.store(writeIdx, std::memory_order_seq_cst);
+			if(consumer.waiting.load(std::memory_order_seq_cst)){
+				wakeConsumer();
+			}
+		} else {
+			producer.writeIdx.store(writeIdx, std::memory_order_release);
+		}
+	}
+	
+	/**
+	 Wakes up the consumer blocked in wait()
+	 */
+	void wakeConsumer(){
+		consumer.wakeCount.fetch_add(1, std::memory_order_seq_cst);
+		Futex::WakeAll(&consumer.wakeCount);
+	}
+	
+	/**
+	 Retrieves the number of samples the producer can push without overwriting samples that were not consumed
+	 
+	 @param writeIdx the number of samples published
+	 @param numSamples the number of samples the producer wants to push
+	 @return the number of free samples
+	 */
+	inline UINT getFreeSize(UINT writeIdx, UINT numSamples){
+		UINT freeSize = capacity - (writeIdx - producer.cachedReadIdx);
+		if(freeSize < numSamples){
+			producer.cachedReadIdx = consumer.readIdx.load(std::memory_order_acquire);
+			freeSize = capacity - (writeIdx - producer.cachedReadIdx);
+		}
+		return freeSize;
+	}
+	
+	SampleQueue(const SampleQueue &rhs);
+	SampleQueue& operator=(const SampleQueue &rhs);
+	
+public:
+	
+	/**
+	 Main constructor of the sample queue
+	 
+	 @param capacity the minimum number of samples the queue should hold, rounded up to a power of two
+	 @param numChannels the number of values in every sample
+	 @param blocking whether wait() should block the consumer thread on a futex instead of polling the queue. Polling has the lowest latency but keeps a core busy
+	 */
+	SampleQueue(UINT capacity, UINT numChannels, bool blocking = false) : closed(false), capacity(1), numChannels(numChannels), blocking(blocking){
+		
+		if (capacity == 0 || capacity > (1u << 31)){
+			throw ARFException("SampleQueue::SampleQueue() capacity should be in the range [1,2^31]");
+		}
+		
+		if (numChannels == 0){
+			throw ARFException("SampleQueue::SampleQueue() numChannels should not be zero");
+		}
+		
+		while(this->capacity < capacity){
+			this->capacity *= 2;
+		}
+		
+		data = new Float[(size_t) this->capacity * numChannels];
+		producer.writeIdx.store(0);
+		producer.cachedReadIdx = 0;
+		consumer.readIdx.store(0);
+		consumer.cachedWriteIdx = 0;
+		consumer.waiting.store(false);
+		consumer.wakeCount.store(0);
+	}
+	
+	/**
+	 Main destructor of the sample queue
+	 */
+	~SampleQueue(){
+		delete[] data;
+	}
+	
+	/**
+	 Pushes a sample, called by the producer thread only
+	 
+	 @param values the numChannels values of the sample
+	 @return true if the sample was pushed, false if the queue is full
+	 */
+	bool push(const Float * values){
+		return push(values, 1) == 1;
+	}
+	
+	/**
+	 Pushes a sample, called by the producer thread only
+	 
+	 @param sample the sample, which should have numChannels values
+	 @return true if the sample was pushed, false if the queue is full
+	 */
+	bool push(const SensorSample & sample){
+		
+		if(sample.getSize() != numChannels){
+			throw ARFException("SampleQueue::push() the sample does not have numChannels values");
+		}
+		
+		UINT writeIdx = producer.writeIdx.load(std::memory_order_relaxed);
+		if(getFreeSize(writeIdx, 1) == 0){
+			return false;
+		}
+		
+		std::copy(sample.begin(), sample.end(), data + (size_t) (writeIdx & (capacity - 1)) * numChannels);
+		publish(writeIdx + 1);
+		return true;
+	}
+	
+	/**
+	 Pushes a batch of samples and publishes them at once, called by the producer thread only
+	 
+	 @param values the values of the samples, numChannels consecutive values per sample
+	 @param numSamples the number of samples
+	 @return the number of samples pushed, smaller than numSamples if the queue is full
+	 */
+	UINT push(const Float * values, UINT numSamples){
+		
+		UINT writeIdx = producer.writeIdx.load(std::memory_order_relaxed);
+		numSamples = std::min(numSamples, getFreeSize(writeIdx, numSamples));
+		if(numSamples == 0){
+			return 0;
+		}
+		
+		//the batch is copied in two parts when it wraps around the end of the queue
+		UINT startIdx = writeIdx & (capacity - 1);
+		UINT firstSize = std::min(numSamples, capacity - startIdx);
+		std::copy(values, values + (size_t) firstSize * numChannels, data + (size_t) startIdx * numChannels);
+		std::copy(values + (size_t) firstSize * numChannels, values + (size_t) numSamples * numChannels, data);
+		
+		publish(writeIdx + numSamples);
+		return numSamples;
+	}
+	
+	/**
+	 Indicates that the producer will not push more samples and wakes up the consumer. The consumer can still consume the samples in the queue
+	 */
+	void close(){
+		closed.store(true, std::memory_order_seq_cst);
+		wakeConsumer();
+	}
+	
+	/**
+	 Retrieves whether the queue was closed by the producer
+	 
+	 @return true if close() was called
+	 */
+	bool isClosed() const{
+		return closed.load(std::memory_order_acquire);
+	}
+	
+	/**
+	 Retrieves the number of samples that can be consumed, called by the consumer thread only
+	 
+	 @return the number of samples in the queue
+	 */
+	inline UINT getSize(){
+		consumer.cachedWriteIdx = producer.writeIdx.load(std::memory_order_acquire);
+		return consumer.cachedWriteIdx - consumer.readIdx.load(std::memory_order_relaxed);
+	}
+	
+	/**
+	 Retrieves the oldest samples in the queue without consuming them, called by the consumer thread only. The samples are consecutive in memory, so that they can be passed to PipelinePlan::executeBlock(), and remain valid until they are released
+	 
+	 @param values set to the values of the oldest sample, followed by the values of the next samples
+	 @param maxSamples the maximum number of samples to retrieve
+	 @return the number of samples retrieved, which can be smaller than the number of samples in the queue when they wrap around its end
+	 */
+	UINT acquire(const Float * & values, UINT maxSamples){
+		UINT readIdx = consumer.readIdx.load(std::memory_order_relaxed);
+		UINT startIdx = readIdx & (capacity - 1);
+		values = data + (size_t) startIdx * numChannels;
+		
+		UINT numSamples = consumer.cachedWriteIdx - readIdx;
+		if(numSamples < maxSamples){
+			numSamples = getSize();
+		}
+		return std::min(std::min(numSamples, maxSamples), capacity - startIdx);
+	}
+	
+	/**
+	 Consumes the oldest samples in the queue, returning their memory to the producer. Called by the consumer thread only
+	 
+	 @param numSamples the number of samples to consume, at most the number of samples retrieved by acquire()
+	 */
+	void release(UINT numSamples){
+		UINT readIdx = consumer.readIdx.load(std::memory_order_relaxed);
+		consumer.readIdx.store(readIdx + numSamples, std::memory_order_release);
+	}
+	
+	/**
+	 Consumes the oldest sample in the queue, called by the consumer thread only
+	 
+	 @param sample the sample the values are copied to, resized to numChannels values if needed
+	 @return true if a sample was consumed, false if the queue is empty
+	 */
+	bool pop(SensorSample & sample){
+		
+		const Float * values;
+		if(acquire(values, 1) == 0){
+			return false;
+		}
+		
+		if(sample.getSize() != numChannels){
+			sample.resize(numChannels);
+		}
+		std::copy(values, values + numChannels, sample.begin());
+		release(1);
+		return true;
+	}
+	
+	/**
+	 Waits until the queue has samples to consume or is closed, called by the consumer thread only
+	 
+	 @return true if there are samples to consume, false if the queue is empty and closed
+	 */
+	bool wait(){
+		
+		for(UINT i = 0 ; ; i++){
+			
+			if(getSize() > 0){
+				return true;
+			}
+			if(isClosed()){
+				//samples pushed right before closing the queue
+				return getSize() > 0;
+			}
+			
+			if(!blocking || i < kNumSpinIterations){
+				std::this_thread::yield();
+				continue;
+			}
+			
+			//announce that the consumer is waiting, and check again for samples published before the producer could see it
+			UINT wakeCount = consumer.wakeCount.load(std::memory_order_seq_cst);
+			consumer.waiting.store(true, std::memory_order_seq_cst);
+			UINT readIdx = consumer.readIdx.load(std::memory_order_relaxed);
+			if(producer.writeIdx.load(std::memory_order_seq_cst) == readIdx && !closed.load(std::memory_order_seq_cst)){
+				Futex::Wait(&consumer.wakeCount, wakeCount);
+			}
+			consumer.waiting.store(false, std::memory_order_relaxed);
+		}
+	}
+	
+	/**
+	 Retrieves the number of samples the queue can hold
+	 
+	 @return the capacity, a power of two
+	 */
+	inline UINT getCapacity() const{
+		return capacity;
+	}
+	
+	/**
+	 Retrieves the number of values in every sample
+	 
+	 @return the number of channels
+	 */
+	inline UINT getNumChannels() const{
+		return numChannels;
+	}
+	
+	/**
+	 Retrieves whether the consumer blocks on a futex when the queue is empty
+	 
+	 @return true if wait() blocks, false if it polls
+	 */
+	inline bool isBlocking() const{
+		return blocking;
+	}
+};
+
+}
+
+#endif //ARF_SAMPLE_QUEUE_H
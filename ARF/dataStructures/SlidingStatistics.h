@@ -0,0 +1,261 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The SlidingStatistics keeps the mean, variance, minimum and maximum of the last capacity values of a stream up to date as values enter and leave the window, so that they can be read in constant time instead of being recomputed over the whole window. The sum and the sum of squares of the values are accumulated with Kahan compensation, relative to the first value of the stream to avoid cancellation in the variance. The minimum and the maximum are the front of two monotonic queues, which costs amortized constant time per value. The values are not stored: when the window is full, the value leaving it should be passed together with the value entering it
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+#ifndef ARF_SLIDING_STATISTICS_H
+#define ARF_SLIDING_STATISTICS_H
+
+#include "../utils/ARFException.h"
+#include "../utils/ARFTypedefs.h"
+#include <math.h>
+#include <vector>
+
+namespace ARF {
+
+class SlidingStatistics {
+	
+private:
+	
+	/**
+	 A value in a monotonic queue, with the position it was added at
+	 */
+	struct Entry {
+		UINT position;
+		Float value;
+	};
+	
+	/**
+	 A queue of the values of the window that can still become the minimum (or the maximum), in increasing (or decreasing) order. It is stored in a circular array of capacity entries, since it never holds more entries than the window
+	 */
+	struct MonotonicQueue {
+		std::vector<Entry> entries;
+		UINT head; ///< The index of the front entry
+		UINT size; ///< The number of entries in the queue
+		
+		MonotonicQueue(UINT capacity = 0) : entries(capacity), head(0), size(0) { }
+		
+		/**
+		 Adds a value at the back, removing the values that it dominates and the values that left the window
+		 
+		 @param value the value entering the window
+		 @param position the position of the value in the stream
+		 @param capacity the size of the window
+		 @param dominates returns true if its first parameter makes its second parameter irrelevant
+		 */
+		template <typename Compare>
+		inline void push(Float value, UINT position, UINT capacity, Compare dominates){
+			UINT numEntries = (UINT) entries.size();
+			while(size > 0 && position - entries[head].position >= capacity){
+				head = (head + 1 == numEntries) ? 0 : head + 1;
+				size--;
+			}
+			while(size > 0){
+				UINT backIdx = head + size - 1;
+				if(backIdx >= numEntries){
+					backIdx -= numEntries;
+				}
+				if(!dominates(value, entries[backIdx].value)){
+					break;
+				}
+				size--;
+			}
+			UINT idx = head + size;
+			if(idx >= numEntries){
+				idx -= numEntries;
+			}
+			entries[idx].position = position;
+			entries[idx].value = value;
+			size++;
+		}
+		
+		inline Float front() const{
+			return entries[head].value;
+		}
+	};
+	
+	/**
+	 Adds a value to a sum with Kahan compensation
+	 
+	 @param value the value to add, negative to subtract
+	 @param sum the sum
+	 @param compensation the low order bits lost by the previous additions
+	 */
+	static inline void KahanAdd(Float value, Float & sum, Float & compensation){
+		Float y = value - compensation;
+		Float t = sum + y;
+		compensation = (t - sum) - y;
+		sum = t;
+	}
+	
+	UINT capacity; ///< The number of values in a full window
+	UINT size; ///< The number of values in the window
+	UINT position; ///< The number of values added since the last reset, modulo 2^32
+	Float shift; ///< The first value of the stream, subtracted from every value before summing it
+	Float sum; ///< The sum of the shifted values in the window
+	Float sumCompensation;
+	Float sumSquares; ///< The sum of the squared shifted values in the window
+	Float sumSquaresCompensation;
+	MonotonicQueue minima;
+	MonotonicQueue maxima;
+	
+public:
+	
+	/**
+	 Main constructor
+	 
+	 @param capacity the number of values in a full window, usually the capacity of the ring buffer the values are added to
+	 */
+	SlidingStatistics(UINT capacity = 1) : capacity(capacity), minima(capacity), maxima(capacity) {
+		if(capacity == 0){
+			throw ARFException("SlidingStatistics::SlidingStatistics() capacity should not be zero");
+		}
+		reset();
+	}
+	
+	/**
+	 Empties the window
+	 */
+	void reset(){
+		size = 0;
+		position = 0;
+		shift = sum = sumCompensation = sumSquares = sumSquaresCompensation = 0.0;
+		minima.head = minima.size = 0;
+		maxima.head = maxima.size = 0;
+	}
+	
+	/**
+	 Adds a value to a window that is not full
+	 
+	 @param value the value entering the window
+	 */
+	inline void add(Float value){
+		if(size == capacity){
+			throw ARFException("SlidingStatistics::add() the window is full, the value leaving it should be passed to slide()");
+		}
+		if(size == 0 && position == 0){
+			shift = value;
+		}
+		size++;
+		addValue(value);
+	}
+	
+	/**
+	 Replaces the oldest value of a full window with a new value
+	 
+	 @param leavingValue the oldest value of the window, which leaves it
+	 @param value the value entering the window
+	 */
+	inline void slide(Float leavingValue, Float value){
+		Float leaving = leavingValue - shift;
+		KahanAdd(-leaving, sum, sumCompensation);
+		KahanAdd(-leaving * leaving, sumSquares, sumSquaresCompensation);
+		addValue(value);
+	}
+	
+	/**
+	 Adds a value to the window, sliding it when it is full
+	 
+	 @param leavingValue the oldest value of the window, ignored if the window is not full
+	 @param value the value entering the window
+	 */
+	inline void push(Float leavingValue, Float value){
+		if(size == capacity){
+			slide(leavingValue, value);
+		} else {
+			add(value);
+		}
+	}
+	
+	UINT getCapacity() const{
+		return capacity;
+	}
+	
+	UINT getSize() const{
+		return size;
+	}
+	
+	bool isFull() const{
+		return size == capacity;
+	}
+	
+	Float getSum() const{
+		return sum + size * shift;
+	}
+	
+	Float getMean() const{
+		return shift + sum / size;
+	}
+	
+	/**
+	 Retrieves the sample variance of the window, like STD computes it
+	 
+	 @return the sum of the squared differences to the mean divided by size - 1
+	 */
+	Float getVariance() const{
+		if(size < 2){
+			return 0.0;
+		}
+		Float variance = (sumSquares - sum * sum / size) / (size - 1);
+		return (variance > 0.0) ? variance : 0.0;
+	}
+	
+	Float getSTD() const{
+		return sqrt(getVariance());
+	}
+	
+	/**
+	 Retrieves the sum of the squared values of the window
+	 
+	 @return the energy of the window
+	 */
+	Float getEnergy() const{
+		return sumSquares + 2 * shift * sum + size * shift * shift;
+	}
+	
+	Float getRMS() const{
+		return sqrt(getEnergy() / size);
+	}
+	
+	Float getMinimum() const{
+		return minima.front();
+	}
+	
+	Float getMaximum() const{
+		return maxima.front();
+	}
+	
+private:
+	
+	inline void addValue(Float value){
+		Float shifted = value - shift;
+		KahanAdd(shifted, sum, sumCompensation);
+		KahanAdd(shifted * shifted, sumSquares, sumSquaresCompensation);
+		minima.push(value, position, capacity, [](Float newValue, Float oldValue){ return newValue <= oldValue; });
+		maxima.push(value, position, capacity, [](Float newValue, Float oldValue){ return newValue >= oldValue; });
+		position++;
+	}
+};
+
+}
+
+#endif //ARF_SLIDING_STATISTICS_H
@@ -57,7 +57,7 @@ public:
 	 @param value the Float value that should be set
 	 */
 	void setValue(Float value) {
-		value = value;
+		this->value = value;
 	}
 	
 	
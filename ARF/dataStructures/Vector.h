@@ -177,6 +177,28 @@ public:
 	inline const T& operator[](const UINT idx) const override{
 		return data[idx];
 	}
+	
+	/**
+	 Retrieves the memory of the values of a column over a range of elements, when the values are stored inside the elements, like in a Vector of Floats
+	 
+	 @param colIdx the index of the value in the elements
+	 @param startRow the index of the first element
+	 @param endRow the index of the last element
+	 @return false if the elements do not store their values or the range is invalid
+	 */
+	bool getStridedSpan(const UINT colIdx, const UINT startRow, const UINT endRow, StridedSpan &span) const override{
+		UINT stride = IterableElement<T>::GetStride();
+		if(stride == 0 || colIdx >= IterableElement<T>::GetNumValues() || startRow > endRow || endRow >= getSize()){
+			return false;
+		}
+		
+		span.first = &IterableElement<T>::GetValue(data[startRow], colIdx);
+		span.firstSize = endRow - startRow + 1;
+		span.second = nullptr;
+		span.secondSize = 0;
+		span.stride = stride;
+		return true;
+	}
 
 		
 	/**
@@ -346,6 +368,10 @@ public:
 	
 };
 
+inline const Float& IterableElement<Vector<Float> >::GetValue(const Vector<Float> &element, const UINT colIdx){
+	return element[colIdx];
+}
+
 }
 
 #endif //ARF_VECTOR_H
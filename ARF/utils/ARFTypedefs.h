@@ -42,6 +42,7 @@ typedef unsigned int UINT;
 //stages: Data Acquisition -> Preprocessing -> Feature Extraction -> Classification
 //types: SensorSample -> Signal -> Feature -> FeatureVector -> ClassificationResult
 typedef Vector<Float> SensorSample; //A single sensor reading (e.g. ax,ay,az,gx,gy,gz)
+template <UINT N> struct FixedSensorSample; //A single sensor reading with N values stored inline, without heap memory
 
 class DataIterator;
 typedef DataIterator Signal;//A one-dimensional signal (e.g. several ax readings)
@@ -52,8 +53,141 @@ typedef Vector<Float> FeatureVector;//A vector of features (e.g. mean, std, corr
 
 typedef uint8_t ClassificationResult;//the result of a classifier (e.g. running)
 
+//access to the values stored in the elements of an Iterable, specialized for the element types that store values
+template <typename T> struct IterableElement {
+	static const Float& GetValue(const T &element, const UINT colIdx){
+		throw ARFException("ARFTypedefs::IterableElement GetValue() called on an element without values");
+	}
+	
+	//the number of Floats between the same value of two consecutive elements in an array, or 0 if the values are not stored inside the elements
+	static UINT GetStride(){
+		return 0;
+	}
+	
+	//the number of values of the elements, or 0 if it is not known at compile time
+	static UINT GetNumValues(){
+		return 0;
+	}
+};
+
+//the values of an array of Floats form a single column
+template <> struct IterableElement<Float> {
+	static const Float& GetValue(const Float &element, const UINT colIdx){
+		if(colIdx != 0) throw ARFException("ARFTypedefs::IterableElement GetValue() invalid column index of a Float");
+		return element;
+	}
+	
+	static UINT GetStride(){
+		return 1;
+	}
+	
+	static UINT GetNumValues(){
+		return 1;
+	}
+};
+
+template <> struct IterableElement<Vector<Float> > {
+	static const Float& GetValue(const Vector<Float> &element, const UINT colIdx);
+	
+	//the values of a Vector are allocated separately from it
+	static UINT GetStride(){
+		return 0;
+	}
+	
+	static UINT GetNumValues(){
+		return 0;
+	}
+};
+
 //interfaces
-template <typename T> class Iterable {
+
+//the values of a column over a range of rows, in up to two parts of values separated by a constant stride. The second part is used by iterables whose rows wrap around the end of their storage
+struct StridedSpan {
+	const Float * first; ///< The first value of the first part
+	UINT firstSize; ///< The number of values in the first part
+	const Float * second; ///< The first value of the second part, or NULL
+	UINT secondSize; ///< The number of values in the second part
+	UINT stride; ///< The number of Floats between two consecutive values
+	
+	UINT getSize() const{
+		return firstSize + secondSize;
+	}
+	
+	const Float& operator[](const UINT idx) const{
+		return (idx < firstSize) ? first[(size_t) idx * stride] : second[(size_t) (idx - firstSize) * stride];
+	}
+};
+
+//the count, sum, sum of squared differences to the mean, minimum and maximum of a set of values. Aggregates of disjoint sets are merged with Chan's formula, which keeps the variance accurate
+struct RangeAggregate {
+	UINT count;
+	Float sum;
+	Float m2; ///< The sum of the squared differences to the mean
+	Float minimum;
+	Float maximum;
+	
+	RangeAggregate() : count(0), sum(0.0), m2(0.0), minimum(0.0), maximum(0.0) { }
+	
+	Float getMean() const{
+		return sum / count;
+	}
+	
+	//the sample variance, as computed by STD
+	Float getVariance() const{
+		return (count > 1) ? m2 / (count - 1) : 0.0;
+	}
+	
+	void add(Float value){
+		if(count == 0){
+			count = 1;
+			sum = minimum = maximum = value;
+			m2 = 0.0;
+			return;
+		}
+		Float delta = value - sum / count;
+		count++;
+		sum += value;
+		m2 += delta * (value - sum / count);
+		minimum = (value < minimum) ? value : minimum;
+		maximum = (value > maximum) ? value : maximum;
+	}
+	
+	void merge(const RangeAggregate &rhs){
+		if(rhs.count == 0){
+			return;
+		}
+		if(count == 0){
+			*this = rhs;
+			return;
+		}
+		Float delta = rhs.sum / rhs.count - sum / count;
+		UINT mergedCount = count + rhs.count;
+		m2 += rhs.m2 + delta * delta * ((Float) count * rhs.count / mergedCount);
+		count = mergedCount;
+		sum += rhs.sum;
+		minimum = (rhs.minimum < minimum) ? rhs.minimum : minimum;
+		maximum = (rhs.maximum > maximum) ? rhs.maximum : maximum;
+	}
+};
+
+//the values of a two-dimensional collection, independent of the type of its elements, as accessed by DataIterators
+class IterableValues {
+public:
+	virtual UINT getSize() const = 0;
+	virtual const Float& getValue(const UINT rowIdx, const UINT colIdx) const = 0;
+	
+	//retrieves the memory of the values of a column over a range of rows, returns false if the values are not stored with a constant stride or the range is invalid
+	virtual bool getStridedSpan(const UINT colIdx, const UINT startRow, const UINT endRow, StridedSpan &span) const {
+		return false;
+	}
+	
+	//computes the aggregate of a column over a range of rows from precomputed aggregates, returns false if the iterable has no index of aggregates or the range is invalid
+	virtual bool getRangeAggregate(const UINT colIdx, const UINT startRow, const UINT endRow, RangeAggregate &aggregate) const {
+		return false;
+	}
+};
+
+template <typename T> class Iterable : public IterableValues {
 public:
 	virtual const T& operator()(const UINT rowIdx, const UINT colIdx) const {
 		throw ARFException("ARFTypedefs::Iterable operator() called on Iterable()");
@@ -64,7 +198,12 @@ public:
 	virtual const T& operator[](const UINT idx) const {
 		throw ARFException("ARFTypedefs::Iterable operator() called on Iterable()");
 	}
-	virtual UINT getSize() const = 0;
+	virtual UINT getSize() const override = 0;
+	
+	//retrieves the value in column colIdx of the element at rowIdx, overridden by iterables that do not store their elements as rows
+	const Float& getValue(const UINT rowIdx, const UINT colIdx) const override {
+		return IterableElement<T>::GetValue((*this)[rowIdx], colIdx);
+	}
 };
 
 }
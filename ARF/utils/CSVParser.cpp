@@ -0,0 +1,426 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "CSVParser.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARF_X86_CSV_SCANNING
+#include <immintrin.h>
+#endif
+
+namespace ARF {
+
+//the powers of ten that are exactly representable as doubles
+static const double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static inline bool IsDigit(char c){
+	return (unsigned char) (c - '0') < 10;
+}
+
+/**
+ Parses a number with strtof(), for the numbers the fast path of ParseFloat() cannot round correctly
+ */
+static const char * ParseFloatSlow(const char * begin, const char * end, Float &value){
+	
+	//strtof() would skip the white space, and the new line, before a missing value
+	if(begin == end || isspace((unsigned char) *begin)){
+		return nullptr;
+	}
+	char number[64];
+	size_t length = std::min((size_t) (end - begin), sizeof(number) - 1);
+	memcpy(number, begin, length);
+	number[length] = '\0';
+	
+	char * numberEnd;
+	value = strtof(number, &numberEnd);
+	if(numberEnd == number){
+		return nullptr;
+	}
+	return begin + (numberEnd - number);
+}
+
+//the powers of ten that fit in the mantissa of ParseFloat()
+static const uint64_t kIntegerPowersOfTen[] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ARF_SWAR_DIGITS
+
+/**
+ Flags the characters loaded in a little endian integer that are not digits. Only the lowest flag is exact, the bytes after it can be flagged wrongly
+ 
+ @return the highest bit of every byte is set if the character is not a digit
+ */
+static inline uint64_t NonDigits(uint64_t characters){
+	uint64_t values = characters ^ 0x3030303030303030ull;
+	return ((values + 0x7676767676767676ull) | values) & 0x8080808080808080ull;
+}
+
+/**
+ Converts 8 digits loaded in a little endian integer to their value with three multiplications instead of eight
+ */
+static inline uint64_t ParseEightDigits(uint64_t characters){
+	const uint64_t mask = 0x000000FF000000FFull;
+	characters -= 0x3030303030303030ull;
+	characters = (characters * 10) + (characters >> 8);
+	return (((characters & mask) * 0x000F424000000064ull) + (((characters >> 16) & mask) * 0x0000271000000001ull)) >> 32;
+}
+
+#endif
+
+/**
+ Accumulates a sequence of digits into an integer, 8 digits at a time when the text has 8 characters left
+ 
+ @param p the first character of the digits
+ @param end the character following the last character that can be read
+ @param mantissa the integer the digits are appended to, which overflows after 19 digits
+ @return the first character that is not a digit
+ */
+static inline const char * ParseDigits(const char * p, const char * end, uint64_t &mantissa){
+#ifdef ARF_SWAR_DIGITS
+	while(end - p >= 8){
+		uint64_t characters;
+		memcpy(&characters, p, sizeof(characters));
+		uint64_t nonDigits = NonDigits(characters);
+		if(nonDigits == 0){
+			mantissa = mantissa * 100000000 + ParseEightDigits(characters);
+			p += 8;
+			continue;
+		}
+		
+		//the digits before the first non digit are moved to the highest bytes and the lowest ones filled with zeros
+		UINT numDigits = __builtin_ctzll(nonDigits) >> 3;
+		if(numDigits > 0){
+			characters = (characters << (64 - 8 * numDigits)) | (0x3030303030303030ull >> (8 * numDigits));
+			mantissa = mantissa * kIntegerPowersOfTen[numDigits] + ParseEightDigits(characters);
+		}
+		return p + numDigits;
+	}
+#endif
+	for( ; p != end && IsDigit(*p) ; p++){
+		mantissa = mantissa * 10 + (*p - '0');
+	}
+	return p;
+}
+
+const char * CSVParser::ParseFloat(const char * begin, const char * end, Float &value){
+	const char * p = begin;
+	
+	//the signs are random in recordings, so they are skipped without branches
+	bool negative = false;
+	if(p != end){
+		negative = (*p == '-');
+		p += (negative || *p == '+');
+	}
+	
+	//the digits are accumulated into an integer, the position of the point into a power of ten
+	uint64_t mantissa = 0;
+	const char * integerBegin = p;
+	for( ; p != end && IsDigit(*p) ; p++){
+		mantissa = mantissa * 10 + (*p - '0');
+	}
+	size_t numDigits = p - integerBegin;
+	int exponent = 0;
+	if(p != end && *p == '.'){
+		const char * fractionBegin = ++p;
+		p = ParseDigits(p, end, mantissa);
+		numDigits += p - fractionBegin;
+		exponent = -(int) std::min(p - fractionBegin, (ptrdiff_t) 100000);
+	}
+	if(numDigits == 0){
+		//nan, inf or not a number
+		return ParseFloatSlow(begin, end, value);
+	}
+	
+	//the exponent is only part of the number if it has digits
+	if(p != end && (*p == 'e' || *p == 'E')){
+		const char * q = p + 1;
+		bool negativeExponent = false;
+		if(q != end && (*q == '-' || *q == '+')){
+			negativeExponent = (*q == '-');
+			q++;
+		}
+		if(q != end && IsDigit(*q)){
+			int explicitExponent = 0;
+			for( ; q != end && IsDigit(*q) ; q++){
+				if(explicitExponent < 100000){
+					explicitExponent = explicitExponent * 10 + (*q - '0');
+				}
+			}
+			exponent += negativeExponent ? -explicitExponent : explicitExponent;
+			p = q;
+		}
+	}
+	
+	//more than 19 significant digits overflow the mantissa
+	if(numDigits > 19){
+		size_t numLeadingZeros = 0;
+		for(const char * q = integerBegin ; q != p && (*q == '0' || *q == '.') ; q++){
+			numLeadingZeros += (*q == '0');
+		}
+		if(numDigits - numLeadingZeros > 19){
+			return (ParseFloatSlow(begin, end, value) == p) ? p : nullptr;
+		}
+	}
+	
+	if(mantissa == 0){
+		value = negative ? -0.0f : 0.0f;
+		return p;
+	}
+	
+	//the mantissa and the power of ten are exact doubles, so the product or quotient is the correctly rounded double.
+	//Its magnitude is within [1e-22 2^53*1e22], far from the subnormal and infinite floats
+	if(mantissa > (1ull << 53) || exponent < -22 || exponent > 22){
+		return (ParseFloatSlow(begin, end, value) == p) ? p : nullptr;
+	}
+	double number = (exponent < 0) ? (double) mantissa / kPowersOfTen[-exponent] : (double) mantissa * kPowersOfTen[exponent];
+	
+	//rounding the double to a float rounds twice, which differs from rounding the number once only if the double lies exactly between two floats
+	uint64_t bits;
+	memcpy(&bits, &number, sizeof(bits));
+	if((bits & 0x1FFFFFFFull) == 0x10000000ull){
+		return (ParseFloatSlow(begin, end, value) == p) ? p : nullptr;
+	}
+	
+	value = negative ? (Float) -number : (Float) number;
+	return p;
+}
+
+//new line counting
+
+static size_t CountNewLinesScalar(const char * text, size_t length){
+	return (size_t) std::count(text, text + length, '\n');
+}
+
+#ifdef ARF_X86_CSV_SCANNING
+
+__attribute__((target("sse2,popcnt")))
+static size_t CountNewLinesSSE2(const char * text, size_t length){
+	const __m128i newLines = _mm_set1_epi8('\n');
+	size_t count = 0;
+	size_t i = 0;
+	for( ; i + 16 <= length ; i += 16){
+		__m128i characters = _mm_loadu_si128((const __m128i*) (text + i));
+		count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(characters, newLines)));
+	}
+	return count + CountNewLinesScalar(text + i, length - i);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t CountNewLinesAVX2(const char * text, size_t length){
+	const __m256i newLines = _mm256_set1_epi8('\n');
+	size_t count = 0;
+	size_t i = 0;
+	for( ; i + 32 <= length ; i += 32){
+		__m256i characters = _mm256_loadu_si256((const __m256i*) (text + i));
+		count += __builtin_popcount((unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(characters, newLines)));
+	}
+	return count + CountNewLinesScalar(text + i, length - i);
+}
+
+#endif
+
+size_t CSVParser::CountNewLines(const char * text, size_t length){
+	typedef size_t (*CountFunction)(const char * text, size_t length);
+	static const CountFunction countNewLines = [](){
+#ifdef ARF_X86_CSV_SCANNING
+		if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")){
+			return (CountFunction) CountNewLinesAVX2;
+		}
+		if(__builtin_cpu_supports("sse2") && __builtin_cpu_supports("popcnt")){
+			return (CountFunction) CountNewLinesSSE2;
+		}
+#endif
+		return (CountFunction) CountNewLinesScalar;
+	}();
+	return countNewLines(text, length);
+}
+
+//parser
+
+CSVParser::CSVParser(const std::string &fileName, bool parseColumnHeader, char delimiter) : delimiter(delimiter), numRows(0), numColumns(0){
+	
+	std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+	if(!file.is_open()){
+		throw ARFException("CSVParser::CSVParser() could not open file " + fileName);
+	}
+	file.seekg(0, std::ios::end);
+	std::streamoff fileSize = file.tellg();
+	file.seekg(0, std::ios::beg);
+	fileBuffer.resize((size_t) fileSize);
+	if(fileSize > 0 && !file.read(fileBuffer.data(), fileSize)){
+		throw ARFException("CSVParser::CSVParser() could not read file " + fileName);
+	}
+	
+	text = fileBuffer.data();
+	textEnd = text + fileBuffer.size();
+	parseText(parseColumnHeader);
+}
+
+CSVParser::CSVParser(const char * text, size_t length, bool parseColumnHeader, char delimiter) : text(text), textEnd(text + length), delimiter(delimiter), numRows(0), numColumns(0){
+	parseText(parseColumnHeader);
+}
+
+void CSVParser::parseText(bool parseColumnHeader){
+	
+	//the empty lines at the end of the text are not rows
+	while(textEnd != text && (textEnd[-1] == '\n' || textEnd[-1] == '\r')){
+		textEnd--;
+	}
+	
+	const char * firstLineEnd = (const char*) memchr(text, '\n', textEnd - text);
+	if(firstLineEnd == nullptr){
+		firstLineEnd = textEnd;
+	}
+	const char * firstLineContentEnd = (firstLineEnd != text && firstLineEnd[-1] == '\r') ? firstLineEnd - 1 : firstLineEnd;
+	
+	if(parseColumnHeader){
+		if(text == textEnd){
+			throw ARFException("CSVParser::CSVParser() the text has no header");
+		}
+		const char * nameBegin = text;
+		for(const char * p = text ; p <= firstLineContentEnd ; p++){
+			if(p == firstLineContentEnd || *p == delimiter){
+				columnNames.push_back(std::string(nameBegin, p));
+				nameBegin = p + 1;
+			}
+		}
+		numColumns = columnNames.getSize();
+		text = (firstLineEnd == textEnd) ? textEnd : firstLineEnd + 1;
+	} else if(text != textEnd){
+		numColumns = (UINT) std::count(text, firstLineContentEnd, delimiter) + 1;
+	}
+	
+	//the rows are split at the first new line after every kChunkSize bytes
+	for(const char * chunkBegin = text ; chunkBegin != textEnd ; ){
+		const char * chunkEnd = textEnd;
+		if((size_t) (textEnd - chunkBegin) > kChunkSize){
+			const char * newLine = (const char*) memchr(chunkBegin + kChunkSize, '\n', textEnd - chunkBegin - kChunkSize);
+			if(newLine != nullptr){
+				chunkEnd = newLine + 1;
+			}
+		}
+		
+		//the last row has no new line after it
+		size_t numChunkRows = CountNewLines(chunkBegin, chunkEnd - chunkBegin) + (chunkEnd == textEnd);
+		if(numRows + numChunkRows > std::numeric_limits<UINT>::max()){
+			throw ARFException("CSVParser::CSVParser() the text has too many rows");
+		}
+		chunks.push_back({chunkBegin, chunkEnd, numRows, (UINT) numChunkRows});
+		numRows += (UINT) numChunkRows;
+		chunkBegin = chunkEnd;
+	}
+}
+
+const char * CSVParser::ParseRow(const char * begin, const char * end, Float * row, UINT numColumns, char delimiter){
+	const char * p = begin;
+	for(UINT j = 0 ; j < numColumns ; j++){
+		const char * valueEnd = ParseFloat(p, end, row[j]);
+		if(valueEnd == nullptr){
+			while(p != end && *p == ' '){
+				p++;
+			}
+			valueEnd = ParseFloat(p, end, row[j]);
+			if(valueEnd == nullptr){
+				return nullptr;
+			}
+		}
+		p = valueEnd;
+		
+		//every value but the last one is followed by a delimiter, the spaces and carriage returns are rare
+		char expected = (j + 1 < numColumns) ? delimiter : '\n';
+		if(p != end && *p == expected){
+			p++;
+			continue;
+		}
+		while(p != end && *p == ' '){
+			p++;
+		}
+		if(p != end && *p == '\r' && expected == '\n'){
+			p++;
+		}
+		if(p != end && *p == expected){
+			p++;
+		} else if(p != end || j + 1 < numColumns){
+			return nullptr;
+		}
+	}
+	return p;
+}
+
+bool CSVParser::parseChunk(const Chunk &chunk, Float * const * rows, UINT &errorRow) const{
+	const char * p = chunk.begin;
+	for(UINT i = 0 ; i < chunk.numRows ; i++){
+		p = ParseRow(p, chunk.end, rows[chunk.firstRow + i], numColumns, delimiter);
+		if(p == nullptr){
+			errorRow = chunk.firstRow + i;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ The arguments of the tasks that parse the chunks in parallel
+ */
+struct ReadRowsArgument {
+	const CSVParser * parser;
+	Float * const * rows;
+	std::vector<UINT> errorRows; ///< The first invalid row of every chunk, or UINT max
+};
+
+void CSVParser::ParseChunkTask(void * argument, UINT taskIdx, UINT workerIdx){
+	ReadRowsArgument * readRowsArgument = (ReadRowsArgument*) argument;
+	const CSVParser * parser = readRowsArgument->parser;
+	parser->parseChunk(parser->chunks[taskIdx], readRowsArgument->rows, readRowsArgument->errorRows[taskIdx]);
+}
+
+void CSVParser::readRows(Float * const * rows, ThreadPool * threadPool) const{
+	
+	ReadRowsArgument argument = {this, rows, std::vector<UINT>(chunks.size(), std::numeric_limits<UINT>::max())};
+	if(threadPool != nullptr && chunks.size() > 1){
+		threadPool->run(ParseChunkTask, &argument, (UINT) chunks.size());
+	} else {
+		for(UINT i = 0 ; i < chunks.size() ; i++){
+			if(!parseChunk(chunks[i], rows, argument.errorRows[i])){
+				break;
+			}
+		}
+	}
+	
+	//exceptions cannot leave the tasks, so they are thrown once every chunk is parsed
+	UINT errorRow = std::numeric_limits<UINT>::max();
+	for(UINT chunkErrorRow : argument.errorRows){
+		errorRow = std::min(errorRow, chunkErrorRow);
+	}
+	if(errorRow != std::numeric_limits<UINT>::max()){
+		throw ARFException("CSVParser::readRows() invalid value or wrong number of values in row " + std::to_string(errorRow));
+	}
+}
+
+}
@@ -0,0 +1,186 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The CSVParser reads a CSV file of floating point values into a buffer and parses its rows straight into the memory of the samples, in parallel chunks
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_CSV_PARSER_H
+#define ARF_CSV_PARSER_H
+
+#include <string>
+#include <vector>
+#include "../dataStructures/Data.h"
+#include "../dataStructures/Vector.h"
+#include "ARFTypedefs.h"
+#include "ARFException.h"
+
+namespace ARF {
+
+class ThreadPool;
+
+class CSVParser {
+	
+public:
+	
+	static const UINT kChunkSize = 1 << 20; ///< The approximate number of bytes of the chunks the rows are split into, which are parsed in parallel
+	
+private:
+	
+	/**
+	 A range of complete rows of the text
+	 */
+	struct Chunk {
+		const char * begin; ///< The first character of the first row
+		const char * end; ///< The character following the last row
+		UINT firstRow; ///< The index of the first row
+		UINT numRows; ///< The number of rows
+	};
+	
+	std::vector<char> fileBuffer; ///< The contents of the file, when the parser reads a file
+	const char * text; ///< The first character of the rows, after the header
+	const char * textEnd; ///< The character following the last row, without the trailing new lines
+	char delimiter; ///< The character separating the values of a row
+	UINT numRows; ///< The number of rows, without the header
+	UINT numColumns; ///< The number of values in every row
+	Vector<std::string> columnNames; ///< The names of the columns, if the text has a header
+	std::vector<Chunk> chunks; ///< The rows split at new lines into chunks of about kChunkSize bytes
+	
+	/**
+	 Parses the header, counts the rows and columns and splits the rows into chunks
+	 
+	 @param parseColumnHeader whether the first line contains the names of the columns
+	 */
+	void parseText(bool parseColumnHeader);
+	
+	/**
+	 Parses the rows of a chunk
+	 
+	 @param chunk the chunk
+	 @param rows the memory of every row of the text
+	 @param errorRow set to the index of the first row that could not be parsed
+	 @return false if a row has an invalid value or a wrong number of values
+	 */
+	bool parseChunk(const Chunk &chunk, Float * const * rows, UINT &errorRow) const;
+	
+	/**
+	 Parses the chunk of index taskIdx, executed by the ThreadPool
+	 */
+	static void ParseChunkTask(void * argument, UINT taskIdx, UINT workerIdx);
+	
+	CSVParser(const CSVParser &rhs);
+	CSVParser& operator=(const CSVParser &rhs);
+	
+public:
+	
+	/**
+	 Reads a file into memory, parses its header and counts its rows. The values are parsed by readRows()
+	 
+	 @param fileName the name of the file
+	 @param parseColumnHeader whether the first line of the file contains the names of the columns
+	 @param delimiter the character separating the values of a row
+	 */
+	CSVParser(const std::string &fileName, bool parseColumnHeader = false, char delimiter = ',');
+	
+	/**
+	 Parses the header of a text already in memory and counts its rows. The text is not copied and should outlive the parser
+	 
+	 @param text the first character of the text
+	 @param length the number of characters of the text
+	 @param parseColumnHeader whether the first line of the text contains the names of the columns
+	 @param delimiter the character separating the values of a row
+	 */
+	CSVParser(const char * text, size_t length, bool parseColumnHeader = false, char delimiter = ',');
+	
+	/**
+	 Retrieves the number of rows of values
+	 
+	 @return the number of rows, without the header and the empty lines at the end of the text
+	 */
+	UINT getNumRows() const{
+		return numRows;
+	}
+	
+	/**
+	 Retrieves the number of values in every row
+	 
+	 @return the number of columns of the header, or of the first row if there is no header
+	 */
+	UINT getNumColumns() const{
+		return numColumns;
+	}
+	
+	const Vector<std::string> & getColumnNames() const{
+		return columnNames;
+	}
+	
+	/**
+	 Retrieves the number of chunks the rows are split into. Texts of a single chunk gain nothing from a ThreadPool
+	 
+	 @return the number of chunks
+	 */
+	UINT getNumChunks() const{
+		return (UINT) chunks.size();
+	}
+	
+	/**
+	 Parses the values of every row into the memory of the samples. Throws an ARFException with the index of the first invalid row if a value cannot be parsed or a row does not have getNumColumns() values
+	 
+	 @param rows the memory of every row, getNumRows() pointers to getNumColumns() Floats each
+	 @param threadPool the pool that parses the chunks in parallel, or nullptr to parse them on the calling thread
+	 */
+	void readRows(Float * const * rows, ThreadPool * threadPool = nullptr) const;
+	
+	/**
+	 Parses a floating point number in decimal notation, with an optional sign and exponent. Numbers of up to 19 significant digits with exponents in [-22 22] are converted in registers, the rest with strtof(). The result is always correctly rounded
+	 
+	 @param begin the first character of the number
+	 @param end the character following the last character that can be read
+	 @param value set to the number
+	 @return the character following the number, or nullptr if begin does not point to a number
+	 */
+	static const char * ParseFloat(const char * begin, const char * end, Float &value);
+	
+	/**
+	 Parses a row of values and the new line that ends it. The values can be surrounded by spaces and the new line preceded by a carriage return
+	 
+	 @param begin the first character of the row
+	 @param end the character following the last character that can be read
+	 @param row set to the values of the row
+	 @param numColumns the number of values of the row
+	 @param delimiter the character separating the values
+	 @return the character following the new line, or end if the row is the last of the text, or nullptr if a value is invalid or the row does not have numColumns values
+	 */
+	static const char * ParseRow(const char * begin, const char * end, Float * row, UINT numColumns, char delimiter = ',');
+	
+	/**
+	 Counts the new line characters of a text, 32 characters at a time with AVX2 or 16 with SSE2 when the processor supports them
+	 
+	 @param text the first character of the text
+	 @param length the number of characters of the text
+	 @return the number of '\n' characters
+	 */
+	static size_t CountNewLines(const char * text, size_t length);
+};
+
+}
+
+#endif //ARF_CSV_PARSER_H
@@ -0,0 +1,703 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ColumnCodec.h"
+#include <cstring>
+
+#if defined(__x86_64__)
+#define ARF_X86_CODEC
+#include <immintrin.h>
+#endif
+
+namespace ARF {
+
+//the codec operates on the bits of 32 bits floats
+static_assert(sizeof(Float) == sizeof(uint32_t), "ColumnCodec requires 32 bits Floats");
+
+//the frequencies of the entropy coded bytes add up to 2^kScaleBits
+static const uint32_t kScaleBits = 12;
+static const uint32_t kScale = 1u << kScaleBits;
+
+//the rANS states are kept within [kLowerBound kLowerBound*65536), so that they are renormalized with at most one 16 bits word per byte
+static const uint32_t kLowerBound = 1u << 16;
+
+//the tables of the bytes that occur in the plane are stored as a list of bytes up to this number of bytes, and as a bitmap above it
+static const UINT kMaxListedSymbols = 32;
+
+//the number of interleaved rANS states, which the decoder updates independently of each other
+static const UINT kNumStates = 16;
+
+//the number of bytes of the bits of a Float
+static const UINT kNumPlanes = 4;
+
+//reading and writing little endian integers
+
+static inline void AppendUInt32(std::vector<uint8_t> &output, uint32_t value){
+	for(UINT i = 0 ; i < 4 ; i++){
+		output.push_back((uint8_t) (value >> (8 * i)));
+	}
+}
+
+static inline uint32_t ReadUInt16(const uint8_t * data){
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	uint16_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+#else
+	return (uint32_t) data[0] | ((uint32_t) data[1] << 8);
+#endif
+}
+
+static inline uint32_t ReadUInt32(const uint8_t * data){
+	return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+//encoding
+
+/**
+ Scales the number of occurrences of every byte so that they add up to kScale, keeping at least 1 for every byte that occurs
+ */
+static void NormalizeFrequencies(const uint32_t * counts, UINT numValues, uint32_t * frequencies){
+	uint32_t sum = 0;
+	UINT largestSymbol = 0;
+	for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+		frequencies[symbol] = 0;
+		if(counts[symbol] > 0){
+			uint64_t frequency = ((uint64_t) counts[symbol] * kScale) / numValues;
+			frequencies[symbol] = (frequency > 0) ? (uint32_t) frequency : 1;
+			sum += frequencies[symbol];
+			if(frequencies[symbol] > frequencies[largestSymbol]){
+				largestSymbol = symbol;
+			}
+		}
+	}
+	
+	//the rounding errors are compensated by the most frequent byte, or by every byte that can give up some frequency
+	if(sum <= kScale){
+		frequencies[largestSymbol] += kScale - sum;
+		return;
+	}
+	uint32_t excess = sum - kScale;
+	while(excess > 0){
+		for(UINT symbol = 0 ; symbol < 256 && excess > 0 ; symbol++){
+			if(frequencies[symbol] > 1){
+				uint32_t decrement = frequencies[symbol] / 2;
+				decrement = (decrement < excess) ? decrement : excess;
+				frequencies[symbol] -= decrement;
+				excess -= decrement;
+			}
+		}
+	}
+}
+
+/**
+ Entropy codes the bytes of a plane with kNumStates interleaved rANS states, the i-th byte with state i % kNumStates. Every state writes its coded bytes backwards from the end of its own region of streamCapacity bytes of the buffer, ending with its final state
+ 
+ @param streams set to the first byte written by every state, the bytes of a state extend to the end of its region
+ */
+static void EncodeRANS(const uint8_t * plane, UINT numValues, const uint32_t * frequencies, const uint32_t * cumulativeFrequencies, uint8_t * buffer, size_t streamCapacity, uint8_t ** streams){
+	uint32_t states[kNumStates];
+	for(UINT state = 0 ; state < kNumStates ; state++){
+		states[state] = kLowerBound;
+		streams[state] = buffer + (state + 1) * streamCapacity;
+	}
+	
+	//the bytes are coded backwards, one state after the other, so that the divisions of different states overlap
+	for(UINT i = numValues ; i-- > 0 ; ){
+		const UINT state = i % kNumStates;
+		const uint8_t symbol = plane[i];
+		const uint32_t frequency = frequencies[symbol];
+		const uint32_t maxState = ((kLowerBound >> kScaleBits) << 16) * frequency;
+		uint32_t x = states[state];
+		if(x >= maxState){
+			streams[state] -= 2;
+			streams[state][0] = (uint8_t) x;
+			streams[state][1] = (uint8_t) (x >> 8);
+			x >>= 16;
+		}
+		states[state] = ((x / frequency) << kScaleBits) + (x % frequency) + cumulativeFrequencies[symbol];
+	}
+	
+	//the states are read first by the decoder
+	for(UINT state = 0 ; state < kNumStates ; state++){
+		streams[state] -= 4;
+		streams[state][0] = (uint8_t) states[state];
+		streams[state][1] = (uint8_t) (states[state] >> 8);
+		streams[state][2] = (uint8_t) (states[state] >> 16);
+		streams[state][3] = (uint8_t) (states[state] >> 24);
+	}
+}
+
+ColumnCodec::ColumnCodec() : slots(kScale){
+}
+
+void ColumnCodec::encodePlane(const uint8_t * plane, UINT numValues, std::vector<uint8_t> &output){
+	uint32_t counts[256] = {0};
+	for(UINT i = 0 ; i < numValues ; i++){
+		counts[plane[i]]++;
+	}
+	
+	UINT numSymbols = 0;
+	for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+		numSymbols += (counts[symbol] > 0);
+	}
+	
+	if(numSymbols <= 1){
+		output.push_back((uint8_t) kConstantPlane);
+		output.push_back((numValues > 0) ? plane[0] : 0);
+		return;
+	}
+	
+	uint32_t frequencies[256];
+	uint32_t cumulativeFrequencies[256];
+	NormalizeFrequencies(counts, numValues, frequencies);
+	uint32_t cumulativeFrequency = 0;
+	for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+		cumulativeFrequencies[symbol] = cumulativeFrequency;
+		cumulativeFrequency += frequencies[symbol];
+	}
+	
+	size_t tableSize = 1 + ((numSymbols <= kMaxListedSymbols) ? numSymbols : 32);
+	for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+		tableSize += (frequencies[symbol] > 0) + (frequencies[symbol] >= 128);
+	}
+	//every state codes the bytes whose indices are congruent to its own index into its own stream, so that the decoder can update the states
+	//independently of each other. Every symbol writes at most 2 bytes to the stream of its state
+	const size_t streamCapacity = 2 * ((numValues + kNumStates - 1) / kNumStates) + 4;
+	encodedPlane.resize(kNumStates * streamCapacity);
+	uint8_t * streams[kNumStates];
+	EncodeRANS(plane, numValues, frequencies, cumulativeFrequencies, encodedPlane.data(), streamCapacity, streams);
+	size_t streamSizes[kNumStates];
+	size_t encodedSize = tableSize + 4 * kNumStates;
+	for(UINT state = 0 ; state < kNumStates ; state++){
+		streamSizes[state] = (size_t) (encodedPlane.data() + (state + 1) * streamCapacity - streams[state]);
+		encodedSize += streamSizes[state];
+	}
+	
+	//the plane is entropy coded only if the table and the streams are smaller than the plane
+	if(encodedSize >= numValues){
+		output.push_back((uint8_t) kRawPlane);
+		output.insert(output.end(), plane, plane + numValues);
+		return;
+	}
+	
+	output.push_back((uint8_t) kEntropyPlane);
+	output.push_back((uint8_t) (numSymbols - 1));
+	if(numSymbols <= kMaxListedSymbols){
+		for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+			if(frequencies[symbol] > 0){
+				output.push_back((uint8_t) symbol);
+			}
+		}
+	} else {
+		for(UINT symbol = 0 ; symbol < 256 ; symbol += 8){
+			uint8_t bitmap = 0;
+			for(UINT bit = 0 ; bit < 8 ; bit++){
+				bitmap |= (uint8_t) ((frequencies[symbol + bit] > 0) << bit);
+			}
+			output.push_back(bitmap);
+		}
+	}
+	
+	//the frequencies are stored in 7 bits, or in 12 bits if they do not fit
+	for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+		const uint32_t frequency = frequencies[symbol];
+		if(frequency >= 128){
+			output.push_back((uint8_t) (0x80 | (frequency & 0x7F)));
+			output.push_back((uint8_t) (frequency >> 7));
+		} else if(frequency > 0){
+			output.push_back((uint8_t) frequency);
+		}
+	}
+	for(UINT state = 0 ; state < kNumStates ; state++){
+		AppendUInt32(output, (uint32_t) streamSizes[state]);
+	}
+	
+	//the streams are stored one after the other, after their sizes
+	for(UINT state = 0 ; state < kNumStates ; state++){
+		output.insert(output.end(), streams[state], streams[state] + streamSizes[state]);
+	}
+}
+
+void ColumnCodec::encode(const Float * values, UINT numValues, UINT stride, std::vector<uint8_t> &output){
+	
+	//the differences between the bits of consecutive values, zigzag encoded and split into planes of bytes
+	planes.resize(kNumPlanes * (size_t) numValues);
+	uint32_t previousBits = 0;
+	for(UINT i = 0 ; i < numValues ; i++){
+		uint32_t bits;
+		memcpy(&bits, values + (size_t) i * stride, sizeof(bits));
+		const uint32_t difference = bits - previousBits;
+		const uint32_t zigzag = (difference << 1) ^ (uint32_t) ((int32_t) difference >> 31);
+		previousBits = bits;
+		for(UINT plane = 0 ; plane < kNumPlanes ; plane++){
+			planes[plane * (size_t) numValues + i] = (uint8_t) (zigzag >> (8 * plane));
+		}
+	}
+	
+	for(UINT plane = 0 ; plane < kNumPlanes ; plane++){
+		encodePlane(planes.data() + plane * (size_t) numValues, numValues, output);
+	}
+}
+
+//decoding
+
+/**
+ Decodes a byte with a rANS state and renormalizes the state without branches, reading a word from its stream if it is below kLowerBound. The stream should have 4 readable bytes
+ */
+static inline uint8_t DecodeSymbol(uint32_t &state, uint32_t &offset, const uint8_t * streams, const uint32_t * slotTable){
+	const uint32_t slot = slotTable[state & (kScale - 1)];
+	state = (slot & (kScale - 1)) * (state >> kScaleBits) + ((slot >> kScaleBits) & (kScale - 1));
+	const bool renormalize = (state < kLowerBound);
+	const uint32_t renormalizedState = (state << 16) | ReadUInt16(streams + offset);
+	state = renormalize ? renormalizedState : state;
+	offset += renormalize ? 2 : 0;
+	return (uint8_t) (slot >> 24);
+}
+
+/**
+ Decodes rounds of kNumStates bytes, every state decoding a byte of every round. Every state should be able to read 4 bytes at its offset in every round
+ 
+ @param slotTable the byte, frequency and offset of every slot of the scale
+ @param streams the start of the streams
+ @param states the states, updated after the rounds
+ @param offsets the offsets of the next words of the streams from the start of the streams, updated after the rounds
+ @param plane the plane the bytes are written to
+ @param numRounds the number of rounds
+ */
+static void DecodeRoundsScalar(const uint32_t * slotTable, const uint8_t * streams, uint32_t * states, uint32_t * offsets, uint8_t * plane, size_t numRounds){
+	
+	//the states are independent of each other, they are decoded in groups of 8 states kept in registers, so that the processor overlaps their updates
+	for(UINT group = 0 ; group < kNumStates ; group += 8){
+		uint32_t state0 = states[group], state1 = states[group + 1], state2 = states[group + 2], state3 = states[group + 3];
+		uint32_t state4 = states[group + 4], state5 = states[group + 5], state6 = states[group + 6], state7 = states[group + 7];
+		uint32_t offset0 = offsets[group], offset1 = offsets[group + 1], offset2 = offsets[group + 2], offset3 = offsets[group + 3];
+		uint32_t offset4 = offsets[group + 4], offset5 = offsets[group + 5], offset6 = offsets[group + 6], offset7 = offsets[group + 7];
+		uint8_t * groupPlane = plane + group;
+		for(size_t round = 0 ; round < numRounds ; round++, groupPlane += kNumStates){
+			groupPlane[0] = DecodeSymbol(state0, offset0, streams, slotTable);
+			groupPlane[1] = DecodeSymbol(state1, offset1, streams, slotTable);
+			groupPlane[2] = DecodeSymbol(state2, offset2, streams, slotTable);
+			groupPlane[3] = DecodeSymbol(state3, offset3, streams, slotTable);
+			groupPlane[4] = DecodeSymbol(state4, offset4, streams, slotTable);
+			groupPlane[5] = DecodeSymbol(state5, offset5, streams, slotTable);
+			groupPlane[6] = DecodeSymbol(state6, offset6, streams, slotTable);
+			groupPlane[7] = DecodeSymbol(state7, offset7, streams, slotTable);
+		}
+		states[group] = state0; states[group + 1] = state1; states[group + 2] = state2; states[group + 3] = state3;
+		states[group + 4] = state4; states[group + 5] = state5; states[group + 6] = state6; states[group + 7] = state7;
+		offsets[group] = offset0; offsets[group + 1] = offset1; offsets[group + 2] = offset2; offsets[group + 3] = offset3;
+		offsets[group + 4] = offset4; offsets[group + 5] = offset5; offsets[group + 6] = offset6; offsets[group + 7] = offset7;
+	}
+}
+
+#ifdef ARF_X86_CODEC
+
+/**
+ Decodes a byte with each of the eight states in the lanes of a vector, gathering the slots of the states and the next words of their streams
+ 
+ @return the decoded bytes, in the low 4 bytes of each 128 bits lane
+ */
+__attribute__((target("avx2")))
+static inline __m256i DecodeSymbols(const uint32_t * slotTable, const uint8_t * streams, __m256i &states, __m256i &offsets){
+	const __m256i slotMask = _mm256_set1_epi32(kScale - 1);
+	const __m256i slots = _mm256_i32gather_epi32((const int*) slotTable, _mm256_and_si256(states, slotMask), 4);
+	states = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_and_si256(slots, slotMask), _mm256_srli_epi32(states, kScaleBits)),
+							  _mm256_and_si256(_mm256_srli_epi32(slots, kScaleBits), slotMask));
+	
+	const __m256i renormalize = _mm256_cmpeq_epi32(_mm256_srli_epi32(states, 16), _mm256_setzero_si256());
+	const __m256i words = _mm256_and_si256(_mm256_i32gather_epi32((const int*) streams, offsets, 1), _mm256_set1_epi32(0xFFFF));
+	states = _mm256_blendv_epi8(states, _mm256_or_si256(_mm256_slli_epi32(states, 16), words), renormalize);
+	offsets = _mm256_add_epi32(offsets, _mm256_and_si256(renormalize, _mm256_set1_epi32(2)));
+	
+	//moves the high byte of every slot to the low 4 bytes of its 128 bits lane
+	const __m256i symbolShuffle = _mm256_setr_epi8(3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+												   3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	return _mm256_shuffle_epi8(slots, symbolShuffle);
+}
+
+//the states are decoded in two vectors of eight states, so that the processor overlaps the latencies of their gathers. The 32 bits gathered at the
+//offsets of the streams are within the buffer
+__attribute__((target("avx2")))
+static void DecodeRoundsAVX2(const uint32_t * slotTable, const uint8_t * streams, uint32_t * states, uint32_t * offsets, uint8_t * plane, size_t numRounds){
+	__m256i states0 = _mm256_loadu_si256((const __m256i*) states);
+	__m256i states1 = _mm256_loadu_si256((const __m256i*) (states + 8));
+	__m256i offsets0 = _mm256_loadu_si256((const __m256i*) offsets);
+	__m256i offsets1 = _mm256_loadu_si256((const __m256i*) (offsets + 8));
+	const __m256i symbolOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 3, 6, 7);
+	for(size_t round = 0 ; round < numRounds ; round++, plane += kNumStates){
+		const __m256i symbols0 = DecodeSymbols(slotTable, streams, states0, offsets0);
+		const __m256i symbols1 = DecodeSymbols(slotTable, streams, states1, offsets1);
+		
+		//the bytes of states 0-3 and 8-11 are in the low lane, the bytes of states 4-7 and 12-15 in the high lane
+		const __m256i symbols = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi32(symbols0, symbols1), symbolOrder);
+		_mm_storeu_si128((__m128i*) plane, _mm256_castsi256_si128(symbols));
+	}
+	_mm256_storeu_si256((__m256i*) states, states0);
+	_mm256_storeu_si256((__m256i*) (states + 8), states1);
+	_mm256_storeu_si256((__m256i*) offsets, offsets0);
+	_mm256_storeu_si256((__m256i*) (offsets + 8), offsets1);
+}
+
+#endif
+
+static void DecodeRounds(const uint32_t * slotTable, const uint8_t * streams, uint32_t * states, uint32_t * offsets, uint8_t * plane, size_t numRounds){
+	typedef void (*DecodeFunction)(const uint32_t * slotTable, const uint8_t * streams, uint32_t * states, uint32_t * offsets, uint8_t * plane, size_t numRounds);
+	static const DecodeFunction decodeRounds = [](){
+#ifdef ARF_X86_CODEC
+		if(__builtin_cpu_supports("avx2")){
+			return (DecodeFunction) DecodeRoundsAVX2;
+		}
+#endif
+		return (DecodeFunction) DecodeRoundsScalar;
+	}();
+	decodeRounds(slotTable, streams, states, offsets, plane, numRounds);
+}
+
+const uint8_t * ColumnCodec::decodeEntropyPlane(const uint8_t * data, const uint8_t * end, UINT numValues, uint8_t * plane){
+	if(end - data < 1){
+		return nullptr;
+	}
+	const UINT numSymbols = (UINT) data[0] + 1;
+	data++;
+	
+	//the bytes that occur in the plane, in increasing order
+	uint8_t symbols[256];
+	if(numSymbols <= kMaxListedSymbols){
+		if((size_t) (end - data) < numSymbols){
+			return nullptr;
+		}
+		memcpy(symbols, data, numSymbols);
+		data += numSymbols;
+	} else {
+		if(end - data < 32){
+			return nullptr;
+		}
+		UINT numListedSymbols = 0;
+		for(UINT symbol = 0 ; symbol < 256 ; symbol++){
+			if((data[symbol / 8] >> (symbol % 8)) & 1){
+				symbols[numListedSymbols++] = (uint8_t) symbol;
+			}
+		}
+		if(numListedSymbols != numSymbols){
+			return nullptr;
+		}
+		data += 32;
+	}
+	
+	//every slot of the scale stores the byte whose frequency range contains it in its 8 high bits, the frequency of the byte in its 12 low bits
+	//and the distance of the slot from the start of the range in the 12 bits between them
+	uint32_t cumulativeFrequency = 0;
+	for(UINT i = 0 ; i < numSymbols ; i++){
+		if(data == end){
+			return nullptr;
+		}
+		uint32_t frequency = *data++;
+		if(frequency >= 128){
+			if(data == end){
+				return nullptr;
+			}
+			frequency = (frequency & 0x7F) | ((uint32_t) *data++ << 7);
+		}
+		if(frequency == 0 || frequency >= kScale || cumulativeFrequency + frequency > kScale){
+			return nullptr;
+		}
+		for(uint32_t offset = 0 ; offset < frequency ; offset++){
+			slots[cumulativeFrequency + offset] = ((uint32_t) symbols[i] << 24) | (offset << kScaleBits) | frequency;
+		}
+		cumulativeFrequency += frequency;
+	}
+	if(cumulativeFrequency != kScale || (size_t) (end - data) < 4 * kNumStates){
+		return nullptr;
+	}
+	
+	//the streams of the states, which start with the states. The states read their streams at offsets from the start of the first stream
+	const uint8_t * const streams = data + 4 * kNumStates;
+	uint32_t states[kNumStates];
+	uint32_t offsets[kNumStates];
+	uint32_t offsetEnds[kNumStates];
+	uint32_t streamOffset = 0;
+	for(UINT s = 0 ; s < kNumStates ; s++){
+		const uint32_t streamSize = ReadUInt32(data + 4 * s);
+		if(streamSize < 4 || (size_t) (end - streams) - streamOffset < streamSize){
+			return nullptr;
+		}
+		states[s] = ReadUInt32(streams + streamOffset);
+		offsets[s] = streamOffset + 4;
+		streamOffset += streamSize;
+		offsetEnds[s] = streamOffset;
+	}
+	
+	//the states are renormalized without branches for as many rounds as every state can read a word within the buffer in every round. A state
+	//reads its own stream unless the data is not valid, which is detected once the states have consumed their streams
+	const size_t numReadableBytes = (size_t) (end - streams);
+	UINT i = 0;
+	while(i + kNumStates <= numValues){
+		size_t numRounds = (numValues - i) / kNumStates;
+		for(UINT s = 0 ; s < kNumStates ; s++){
+			const size_t numSafeRounds = (numReadableBytes >= offsets[s] + 4) ? (numReadableBytes - offsets[s] - 4) / 2 : 0;
+			numRounds = (numSafeRounds < numRounds) ? numSafeRounds : numRounds;
+		}
+		if(numRounds == 0){
+			break;
+		}
+		DecodeRounds(slots.data(), streams, states, offsets, plane + i, numRounds);
+		i += (UINT) numRounds * kNumStates;
+	}
+	for(UINT s = 0 ; s < kNumStates ; s++){
+		if(offsets[s] > offsetEnds[s]){
+			return nullptr;
+		}
+	}
+	
+	for( ; i < numValues ; i++){
+		const UINT s = i % kNumStates;
+		const uint32_t slot = slots[states[s] & (kScale - 1)];
+		states[s] = (slot & (kScale - 1)) * (states[s] >> kScaleBits) + ((slot >> kScaleBits) & (kScale - 1));
+		if(states[s] < kLowerBound){
+			if(offsetEnds[s] - offsets[s] < 2){
+				return nullptr;
+			}
+			states[s] = (states[s] << 16) | ReadUInt16(streams + offsets[s]);
+			offsets[s] += 2;
+		}
+		plane[i] = (uint8_t) (slot >> 24);
+	}
+	return streams + streamOffset;
+}
+
+/**
+ Merges the planes of bytes into the zigzag encoded differences, undoes the zigzag encoding and adds up the differences into the bits of the values
+ */
+static void MergePlanesScalar(const uint8_t * const * planes, UINT numValues, Float * values){
+	uint32_t bits = 0;
+	for(UINT i = 0 ; i < numValues ; i++){
+		const uint32_t zigzag = (uint32_t) planes[0][i] | ((uint32_t) planes[1][i] << 8) | ((uint32_t) planes[2][i] << 16) | ((uint32_t) planes[3][i] << 24);
+		bits += (zigzag >> 1) ^ (0u - (zigzag & 1));
+		memcpy(values + i, &bits, sizeof(bits));
+	}
+}
+
+#ifdef ARF_X86_CODEC
+
+//SSE2 is available on every x86-64 processor
+
+__attribute__((target("sse2")))
+static inline __m128i PrefixSum(__m128i differences, __m128i &carry){
+	differences = _mm_add_epi32(differences, _mm_slli_si128(differences, 4));
+	differences = _mm_add_epi32(differences, _mm_slli_si128(differences, 8));
+	differences = _mm_add_epi32(differences, carry);
+	carry = _mm_shuffle_epi32(differences, _MM_SHUFFLE(3, 3, 3, 3));
+	return differences;
+}
+
+__attribute__((target("sse2")))
+static inline __m128i UndoZigzag(__m128i zigzag){
+	const __m128i ones = _mm_set1_epi32(1);
+	return _mm_xor_si128(_mm_srli_epi32(zigzag, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(zigzag, ones)));
+}
+
+__attribute__((target("sse2")))
+static void MergePlanesSSE2(const uint8_t * const * planes, UINT numValues, Float * values){
+	__m128i carry = _mm_setzero_si128();
+	UINT i = 0;
+	for( ; i + 16 <= numValues ; i += 16){
+		const __m128i plane0 = _mm_loadu_si128((const __m128i*) (planes[0] + i));
+		const __m128i plane1 = _mm_loadu_si128((const __m128i*) (planes[1] + i));
+		const __m128i plane2 = _mm_loadu_si128((const __m128i*) (planes[2] + i));
+		const __m128i plane3 = _mm_loadu_si128((const __m128i*) (planes[3] + i));
+		const __m128i low0 = _mm_unpacklo_epi8(plane0, plane1);
+		const __m128i low1 = _mm_unpackhi_epi8(plane0, plane1);
+		const __m128i high0 = _mm_unpacklo_epi8(plane2, plane3);
+		const __m128i high1 = _mm_unpackhi_epi8(plane2, plane3);
+		const __m128i zigzags[4] = {_mm_unpacklo_epi16(low0, high0), _mm_unpackhi_epi16(low0, high0), _mm_unpacklo_epi16(low1, high1), _mm_unpackhi_epi16(low1, high1)};
+		for(UINT j = 0 ; j < 4 ; j++){
+			_mm_storeu_si128((__m128i*) (values + i + 4 * j), PrefixSum(UndoZigzag(zigzags[j]), carry));
+		}
+	}
+	
+	const uint8_t * remainingPlanes[kNumPlanes] = {planes[0] + i, planes[1] + i, planes[2] + i, planes[3] + i};
+	uint32_t bits = (uint32_t) _mm_cvtsi128_si32(carry);
+	MergePlanesScalar(remainingPlanes, numValues - i, values + i);
+	for( ; i < numValues ; i++){
+		uint32_t valueBits;
+		memcpy(&valueBits, values + i, sizeof(valueBits));
+		valueBits += bits;
+		memcpy(values + i, &valueBits, sizeof(valueBits));
+	}
+}
+
+#endif
+
+static inline void MergePlanes(const uint8_t * const * planes, UINT numValues, Float * values){
+#ifdef ARF_X86_CODEC
+	MergePlanesSSE2(planes, numValues, values);
+#else
+	MergePlanesScalar(planes, numValues, values);
+#endif
+}
+
+const uint8_t * ColumnCodec::decode(const uint8_t * data, const uint8_t * end, UINT numValues, Float * values){
+	
+	//an empty column has no values to decode, only its planes are skipped
+	if(numValues == 0){
+		return Skip(data, end, numValues);
+	}
+	planes.resize(kNumPlanes * (size_t) numValues);
+	
+	//the raw planes are read where they are stored, the other planes are decoded into the buffer
+	const uint8_t * planeBytes[kNumPlanes];
+	for(UINT plane = 0 ; plane < kNumPlanes ; plane++){
+		if(data == end){
+			return nullptr;
+		}
+		const uint8_t mode = *data++;
+		uint8_t * decodedPlane = planes.data() + plane * (size_t) numValues;
+		planeBytes[plane] = decodedPlane;
+		if(mode == kConstantPlane){
+			if(data == end){
+				return nullptr;
+			}
+			memset(decodedPlane, *data++, numValues);
+		} else if(mode == kRawPlane){
+			if((size_t) (end - data) < numValues){
+				return nullptr;
+			}
+			planeBytes[plane] = data;
+			data += numValues;
+		} else if(mode == kEntropyPlane){
+			data = decodeEntropyPlane(data, end, numValues, decodedPlane);
+			if(data == nullptr){
+				return nullptr;
+			}
+		} else {
+			return nullptr;
+		}
+	}
+	
+	MergePlanes(planeBytes, numValues, values);
+	return data;
+}
+
+const uint8_t * ColumnCodec::Skip(const uint8_t * data, const uint8_t * end, UINT numValues){
+	for(UINT plane = 0 ; plane < kNumPlanes ; plane++){
+		if(data == end){
+			return nullptr;
+		}
+		const uint8_t mode = *data++;
+		size_t planeSize = 0;
+		if(mode == kConstantPlane){
+			planeSize = 1;
+		} else if(mode == kRawPlane){
+			planeSize = numValues;
+		} else if(mode == kEntropyPlane){
+			
+			//the symbols, their frequencies and the sizes of the streams precede the streams
+			if(data == end){
+				return nullptr;
+			}
+			const UINT numSymbols = (UINT) *data++ + 1;
+			const size_t symbolsSize = (numSymbols <= kMaxListedSymbols) ? numSymbols : 32;
+			if((size_t) (end - data) < symbolsSize){
+				return nullptr;
+			}
+			data += symbolsSize;
+			for(UINT i = 0 ; i < numSymbols ; i++){
+				const size_t frequencySize = (data < end && *data >= 128) ? 2 : 1;
+				if((size_t) (end - data) < frequencySize){
+					return nullptr;
+				}
+				data += frequencySize;
+			}
+			if((size_t) (end - data) < 4 * kNumStates){
+				return nullptr;
+			}
+			for(UINT s = 0 ; s < kNumStates ; s++){
+				planeSize += ReadUInt32(data + 4 * s);
+			}
+			data += 4 * kNumStates;
+		} else {
+			return nullptr;
+		}
+		if((size_t) (end - data) < planeSize){
+			return nullptr;
+		}
+		data += planeSize;
+	}
+	return data;
+}
+
+//checksums
+
+static uint32_t ChecksumScalar(const uint8_t * data, size_t size){
+	static const struct Table {
+		uint32_t values[256];
+		Table(){
+			for(uint32_t i = 0 ; i < 256 ; i++){
+				uint32_t value = i;
+				for(UINT bit = 0 ; bit < 8 ; bit++){
+					value = (value >> 1) ^ (0x82F63B78u & (0u - (value & 1)));
+				}
+				values[i] = value;
+			}
+		}
+	} table;
+	
+	uint32_t crc = 0xFFFFFFFFu;
+	for(size_t i = 0 ; i < size ; i++){
+		crc = table.values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+#ifdef ARF_X86_CODEC
+
+__attribute__((target("sse4.2")))
+static uint32_t ChecksumSSE42(const uint8_t * data, size_t size){
+	uint64_t crc = 0xFFFFFFFFu;
+	size_t i = 0;
+	for( ; i + 8 <= size ; i += 8){
+		uint64_t word;
+		memcpy(&word, data + i, sizeof(word));
+		crc = _mm_crc32_u64(crc, word);
+	}
+	uint32_t crc32 = (uint32_t) crc;
+	for( ; i < size ; i++){
+		crc32 = _mm_crc32_u8(crc32, data[i]);
+	}
+	return ~crc32;
+}
+
+#endif
+
+uint32_t ColumnCodec::Checksum(const uint8_t * data, size_t size){
+	typedef uint32_t (*ChecksumFunction)(const uint8_t * data, size_t size);
+	static const ChecksumFunction checksum = [](){
+#ifdef ARF_X86_CODEC
+		if(__builtin_cpu_supports("sse4.2")){
+			return (ChecksumFunction) ChecksumSSE42;
+		}
+#endif
+		return (ChecksumFunction) ChecksumScalar;
+	}();
+	return checksum(data, size);
+}
+
+}
@@ -0,0 +1,113 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The ColumnCodec compresses columns of Floats without losses, for the blocks of the compressed .arf files
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_COLUMN_CODEC_H
+#define ARF_COLUMN_CODEC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "ARFTypedefs.h"
+
+namespace ARF {
+
+/**
+ Encodes the differences between consecutive values of a column: the bits of every value are subtracted from the bits of the previous one, the differences are zigzag encoded so that small negative differences have leading zeros, and their bytes are split into 4 planes. Every plane is stored as a single byte if all its bytes are equal, entropy coded with rANS if that makes it smaller, or stored as it is. The entropy coded planes are split among 16 rANS states that code their bytes into separate streams, so that the decoder updates the states independently of each other, 8 at a time in the lanes of an AVX2 vector when the processor supports it. A ColumnCodec keeps the buffers it needs between columns, so that columns are encoded and decoded without allocating memory once the buffers are large enough
+ */
+class ColumnCodec {
+	
+public:
+	
+	//the ways a plane of bytes is stored
+	static const uint8_t kConstantPlane = 0; ///< All the bytes are equal, only one is stored
+	static const uint8_t kRawPlane = 1; ///< The bytes are stored as they are
+	static const uint8_t kEntropyPlane = 2; ///< The bytes are entropy coded with rANS, after a table of the frequencies of the bytes
+	
+	ColumnCodec();
+	
+	/**
+	 Encodes a column of values and appends it to a buffer
+	 
+	 @param values the first value of the column
+	 @param numValues the number of values
+	 @param stride the distance between consecutive values of the column, the number of columns for row-major data
+	 @param output the buffer the encoded column is appended to
+	 */
+	void encode(const Float * values, UINT numValues, UINT stride, std::vector<uint8_t> &output);
+	
+	/**
+	 Decodes a column of values encoded by encode()
+	 
+	 @param data the first byte of the encoded column
+	 @param end the byte following the last byte that can be read
+	 @param numValues the number of values of the column
+	 @param values set to the numValues values of the column
+	 @return the byte following the encoded column, or nullptr if the data is not a valid column of numValues values
+	 */
+	const uint8_t * decode(const uint8_t * data, const uint8_t * end, UINT numValues, Float * values);
+	
+	/**
+	 Finds the end of a column encoded by encode() without decoding it, from the sizes stored in the column
+	 
+	 @param data the first byte of the encoded column
+	 @param end the byte following the last byte that can be read
+	 @param numValues the number of values of the column
+	 @return the byte following the encoded column, or nullptr if the column does not fit in the data
+	 */
+	static const uint8_t * Skip(const uint8_t * data, const uint8_t * end, UINT numValues);
+	
+	/**
+	 Computes the CRC-32C of a buffer, 8 bytes at a time with the SSE4.2 crc32 instruction when the processor supports it
+	 
+	 @param data the first byte of the buffer
+	 @param size the number of bytes of the buffer
+	 @return the checksum of the buffer
+	 */
+	static uint32_t Checksum(const uint8_t * data, size_t size);
+	
+private:
+	std::vector<uint8_t> planes; ///< The planes of bytes of the column being encoded or decoded, one after the other
+	std::vector<uint8_t> encodedPlane; ///< The streams written by the rANS states of the plane being encoded
+	std::vector<uint32_t> slots; ///< The byte, frequency and offset of every slot of the scale, for the rANS decoder
+	
+	ColumnCodec(const ColumnCodec &other);
+	ColumnCodec & operator=(const ColumnCodec &other);
+	
+	/**
+	 Appends a plane of bytes in the smallest of its constant, raw and entropy coded forms
+	 */
+	void encodePlane(const uint8_t * plane, UINT numValues, std::vector<uint8_t> &output);
+	
+	/**
+	 Decodes an entropy coded plane of bytes
+	 
+	 @return the byte following the plane, or nullptr if the plane is not valid
+	 */
+	const uint8_t * decodeEntropyPlane(const uint8_t * data, const uint8_t * end, UINT numValues, uint8_t * plane);
+};
+
+}
+
+#endif //ARF_COLUMN_CODEC_H
@@ -0,0 +1,59 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Futex.h"
+#include <climits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ARF {
+
+#ifdef __linux__
+
+//the futex system call operates on the 32 bits integer stored by the atomic
+static_assert(sizeof(std::atomic<UINT>) == sizeof(int), "Futex requires a lock-free 32 bits atomic");
+
+void Futex::Wait(std::atomic<UINT> * address, UINT expectedValue){
+	syscall(SYS_futex, (int*) address, FUTEX_WAIT_PRIVATE, (int) expectedValue, nullptr, nullptr, 0);
+}
+
+void Futex::WakeAll(std::atomic<UINT> * address){
+	syscall(SYS_futex, (int*) address, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+void Futex::Wait(std::atomic<UINT> * address, UINT expectedValue){
+	if(address->load(std::memory_order_acquire) == expectedValue){
+		std::this_thread::yield();
+	}
+}
+
+void Futex::WakeAll(std::atomic<UINT> * address){
+}
+
+#endif
+
+}
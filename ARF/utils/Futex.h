@@ -0,0 +1,56 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The Futex blocks a thread until another thread changes the value of an atomic integer, without a mutex. The waiting and waking are futex system calls on Linux. On other platforms Wait() yields the thread and returns, so callers should wait in a loop that checks the value again.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_FUTEX_H
+#define ARF_FUTEX_H
+
+#include <atomic>
+#include "ARFTypedefs.h"
+
+namespace ARF {
+
+class Futex {
+	
+public:
+	
+	/**
+	 Blocks the calling thread while the value of the address is equal to the expected value. Can return spuriously, for example when the thread is interrupted
+	 
+	 @param address the atomic integer being waited on
+	 @param expectedValue the value the address had when the caller decided to wait
+	 */
+	static void Wait(std::atomic<UINT> * address, UINT expectedValue);
+	
+	/**
+	 Wakes up all the threads waiting on an address
+	 
+	 @param address the atomic integer being waited on
+	 */
+	static void WakeAll(std::atomic<UINT> * address);
+};
+
+}
+
+#endif //ARF_FUTEX_H
@@ -0,0 +1,46 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MathPolicies.h"
+
+namespace ARF {
+
+Float TableMath::sqrtTable[2 * (kTableSize + 1)];
+Float TableMath::log2Table[kTableSize + 1];
+Float TableMath::atanTable[kTableSize + 1];
+
+/**
+ Fills the tables of TableMath when the program starts
+ */
+struct TableMathInitializer {
+	TableMathInitializer(){
+		for(UINT i = 0 ; i <= TableMath::kTableSize ; i++){
+			double mantissa = 1.0 + (double) i / TableMath::kTableSize;
+			TableMath::sqrtTable[i] = (Float) sqrt(mantissa);
+			TableMath::sqrtTable[TableMath::kTableSize + 1 + i] = (Float) sqrt(2.0 * mantissa);
+			TableMath::log2Table[i] = (Float) log2(mantissa);
+			TableMath::atanTable[i] = (Float) atan((double) i / TableMath::kTableSize);
+		}
+	}
+};
+
+static TableMathInitializer tableMathInitializer;
+
+}
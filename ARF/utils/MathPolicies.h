@@ -0,0 +1,194 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The math policies compute the square roots, logarithms and arc tangents used by the algorithms. They are passed as template parameters to the algorithms, so that every deployment can choose between the exact functions of the standard library, polynomial approximations and tables with linear interpolation at compile time. The error bounds hold for positive normal inputs of Sqrt() and Log2(), and for any inputs of Atan2() except infinities and NaNs, and are measured by the math benchmark.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_MATH_POLICIES_H
+#define ARF_MATH_POLICIES_H
+
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include "ARFTypedefs.h"
+
+namespace ARF {
+
+/**
+ The functions of the standard library
+ */
+struct ExactMath {
+	static const bool kExact = true;
+	
+	static inline Float Sqrt(Float x){
+		return sqrtf(x);
+	}
+	
+	static inline Float Log2(Float x){
+		return log2f(x);
+	}
+	
+	static inline Float Atan2(Float y, Float x){
+		return atan2f(y, x);
+	}
+};
+
+/**
+ Approximations without tables. Sqrt() has a relative error below 1e-5, Log2() an absolute error below 3e-6 and Atan2() an absolute error below 3e-6 radians
+ */
+struct FastMath {
+	static const bool kExact = false;
+	
+	/**
+	 Computes the square root as x times its reciprocal square root, which is estimated from the bits of x and refined with two Newton-Raphson steps
+	 */
+	static inline Float Sqrt(Float x){
+		uint32_t bits;
+		memcpy(&bits, &x, sizeof(bits));
+		bits = 0x5f375a86 - (bits >> 1);
+		Float reciprocal;
+		memcpy(&reciprocal, &bits, sizeof(reciprocal));
+		Float halfX = 0.5f * x;
+		reciprocal *= 1.5f - halfX * reciprocal * reciprocal;
+		reciprocal *= 1.5f - halfX * reciprocal * reciprocal;
+		return x * reciprocal;
+	}
+	
+	/**
+	 Computes the logarithm from the exponent of x and the series of atanh() on its mantissa, reduced to [sqrt(0.5) sqrt(2)]
+	 */
+	static inline Float Log2(Float x){
+		uint32_t bits;
+		memcpy(&bits, &x, sizeof(bits));
+		int exponent = (int) ((bits >> 23) & 0xff) - 127;
+		bits = (bits & 0x7fffff) | 0x3f800000;
+		Float mantissa;
+		memcpy(&mantissa, &bits, sizeof(mantissa));
+		//selected without a branch, which the mantissas of varying values would mispredict
+		int high = (mantissa > 1.41421356f);
+		mantissa *= high ? 0.5f : 1.0f;
+		exponent += high;
+		Float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+		Float t2 = t * t;
+		//2 * atanh(t) / ln(2)
+		Float log2Mantissa = t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * 0.412198583f)));
+		return exponent + log2Mantissa;
+	}
+	
+	/**
+	 Computes the arc tangent with a polynomial of degree 11 on [0 1] and the symmetries of the octants
+	 */
+	static inline Float Atan2(Float y, Float x){
+		Float absX = fabsf(x);
+		Float absY = fabsf(y);
+		Float maximum = (absX > absY) ? absX : absY;
+		if(maximum == 0.0f){
+			return 0.0f;
+		}
+		Float a = ((absX < absY) ? absX : absY) / maximum;
+		Float s = a * a;
+		Float angle = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+		if(absY > absX){
+			angle = 1.57079633f - angle;
+		}
+		if(x < 0.0f){
+			angle = 3.14159265f - angle;
+		}
+		return (y < 0.0f) ? -angle : angle;
+	}
+};
+
+/**
+ Tables of kTableSize intervals with linear interpolation, built when the program starts. Sqrt() has a relative error below 1e-6, Log2() an absolute error below 1e-5 and Atan2() an absolute error below 2e-6 radians
+ */
+struct TableMath {
+	static const bool kExact = false;
+	static const UINT kTableSize = 256;
+	
+	/**
+	 Interpolates the square root of the mantissa in the table of the parity of the exponent and halves the exponent
+	 */
+	static inline Float Sqrt(Float x){
+		uint32_t bits;
+		memcpy(&bits, &x, sizeof(bits));
+		int exponent = (int) ((bits >> 23) & 0xff) - 127;
+		uint32_t oddExponent = exponent & 1;
+		uint32_t tableIdx = oddExponent * (kTableSize + 1) + ((bits >> 15) & 0xff);
+		Float fraction = (bits & 0x7fff) * (1.0f / 0x8000);
+		Float root = sqrtTable[tableIdx] + fraction * (sqrtTable[tableIdx + 1] - sqrtTable[tableIdx]);
+		
+		//2^((exponent - oddExponent) / 2), built from its bits
+		uint32_t scaleBits = (uint32_t) ((exponent - (int) oddExponent) / 2 + 127) << 23;
+		Float scale;
+		memcpy(&scale, &scaleBits, sizeof(scale));
+		return (x == 0.0f) ? 0.0f : root * scale;
+	}
+	
+	/**
+	 Interpolates the logarithm of the mantissa in the table and adds the exponent
+	 */
+	static inline Float Log2(Float x){
+		uint32_t bits;
+		memcpy(&bits, &x, sizeof(bits));
+		int exponent = (int) ((bits >> 23) & 0xff) - 127;
+		uint32_t tableIdx = (bits >> 15) & 0xff;
+		Float fraction = (bits & 0x7fff) * (1.0f / 0x8000);
+		return exponent + log2Table[tableIdx] + fraction * (log2Table[tableIdx + 1] - log2Table[tableIdx]);
+	}
+	
+	/**
+	 Interpolates the arc tangent of the ratio of the smallest to the largest coordinate in the table, and applies the symmetries of the octants
+	 */
+	static inline Float Atan2(Float y, Float x){
+		Float absX = fabsf(x);
+		Float absY = fabsf(y);
+		Float maximum = (absX > absY) ? absX : absY;
+		if(maximum == 0.0f){
+			return 0.0f;
+		}
+		Float position = ((absX < absY) ? absX : absY) / maximum * kTableSize;
+		UINT tableIdx = (UINT) position;
+		if(tableIdx == kTableSize){
+			tableIdx--;
+		}
+		Float fraction = position - tableIdx;
+		Float angle = atanTable[tableIdx] + fraction * (atanTable[tableIdx + 1] - atanTable[tableIdx]);
+		if(absY > absX){
+			angle = 1.57079633f - angle;
+		}
+		if(x < 0.0f){
+			angle = 3.14159265f - angle;
+		}
+		return (y < 0.0f) ? -angle : angle;
+	}
+	
+private:
+	static Float sqrtTable[2 * (kTableSize + 1)]; ///< The square roots of [1 2] and of [2 4]
+	static Float log2Table[kTableSize + 1]; ///< The logarithms of [1 2]
+	static Float atanTable[kTableSize + 1]; ///< The arc tangents of [0 1]
+	
+	friend struct TableMathInitializer;
+};
+
+}
+
+#endif //ARF_MATH_POLICIES_H
@@ -0,0 +1,108 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "MirroredMemory.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ARF {
+
+#ifdef __linux__
+
+size_t MirroredMemory::GetPageSize(){
+	return (size_t) sysconf(_SC_PAGESIZE);
+}
+
+bool MirroredMemory::IsSupported(){
+	return true;
+}
+
+void * MirroredMemory::Map(size_t regionSize, UINT numRegions){
+	
+	if(regionSize == 0 || numRegions == 0 || regionSize % GetPageSize() != 0){
+		return nullptr;
+	}
+	
+	//the file is only used to share the physical pages between the two mappings of every region
+	int fd = (int) syscall(SYS_memfd_create, "ARFMirroredMemory", 0);
+	if(fd < 0){
+		return nullptr;
+	}
+	
+	size_t fileSize = regionSize * numRegions;
+	if(ftruncate(fd, (off_t) fileSize) != 0){
+		close(fd);
+		return nullptr;
+	}
+	
+	//reserve the address space of the regions and their mirrors
+	char * memory = (char*) mmap(nullptr, 2 * fileSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(memory == MAP_FAILED){
+		close(fd);
+		return nullptr;
+	}
+	
+	bool mapped = true;
+	for(UINT i = 0 ; i < 2 * numRegions && mapped ; i++){
+		off_t offset = (off_t) ((i / 2) * regionSize);
+		void * region = mmap(memory + i * regionSize, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, offset);
+		mapped = (region != MAP_FAILED);
+	}
+	
+	//the mappings keep the file alive
+	close(fd);
+	
+	if(!mapped){
+		munmap(memory, 2 * fileSize);
+		return nullptr;
+	}
+	return memory;
+}
+
+void MirroredMemory::Unmap(void * memory, size_t regionSize, UINT numRegions){
+	if(memory != nullptr){
+		munmap(memory, 2 * regionSize * numRegions);
+	}
+}
+
+#else
+
+size_t MirroredMemory::GetPageSize(){
+	return 4096;
+}
+
+bool MirroredMemory::IsSupported(){
+	return false;
+}
+
+void * MirroredMemory::Map(size_t regionSize, UINT numRegions){
+	return nullptr;
+}
+
+void MirroredMemory::Unmap(void * memory, size_t regionSize, UINT numRegions){
+}
+
+#endif
+
+}
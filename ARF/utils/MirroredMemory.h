@@ -0,0 +1,73 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The MirroredMemory maps regions of memory whose pages are mapped twice, back-to-back, in the virtual address space. Writing the byte at offset i of a region also modifies the byte at offset i + regionSize, so a ring buffer stored in a region can read any window of up to regionSize bytes as a single contiguous range, even when the window wraps around the end of the buffer. The mapping uses memfd_create() and mmap() on Linux and is not available on other platforms, where Map() returns a NULL pointer and the caller should fall back to a regular allocation.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_MIRRORED_MEMORY_H
+#define ARF_MIRRORED_MEMORY_H
+
+#include <cstddef>
+#include "ARFTypedefs.h"
+
+namespace ARF {
+
+class MirroredMemory {
+	
+public:
+	
+	/**
+	 Retrieves the granularity of the mapping, the size of the regions should be a multiple of it
+	 
+	 @return the size of a page in bytes
+	 */
+	static size_t GetPageSize();
+	
+	/**
+	 Retrieves whether mirrored regions can be mapped on this platform
+	 
+	 @return true if Map() is implemented
+	 */
+	static bool IsSupported();
+	
+	/**
+	 Maps consecutive regions of memory, each of them immediately followed by its mirror. Region r starts at offset 2 * r * regionSize of the returned pointer. The memory is initialized to zero
+	 
+	 @param regionSize the size of every region in bytes, a multiple of GetPageSize()
+	 @param numRegions the number of regions
+	 @return a pointer to the first region, aligned to a page, or NULL if the regions could not be mapped
+	 */
+	static void * Map(size_t regionSize, UINT numRegions);
+	
+	/**
+	 Unmaps regions mapped by Map()
+	 
+	 @param memory the pointer returned by Map()
+	 @param regionSize the size of every region in bytes
+	 @param numRegions the number of regions
+	 */
+	static void Unmap(void * memory, size_t regionSize, UINT numRegions);
+};
+
+}
+
+#endif //ARF_MIRRORED_MEMORY_H
@@ -0,0 +1,155 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ThreadPool.h"
+
+namespace ARF {
+
+//number of times an idle worker checks for a new run before blocking
+static const UINT kNumSpinIterations = 20000;
+
+ThreadPool::ThreadPool(UINT numThreads) : generation(0), numActiveThreads(0),
+stopping(false), task(nullptr), argument(nullptr), numTasks(0) {
+	
+	shards = new Shard[numThreads + 1];
+	for(UINT i = 0 ; i <= numThreads ; i++){
+		shards[i].nextTaskIdx.store(0);
+		shards[i].endTaskIdx = 0;
+	}
+	
+	for(UINT i = 0 ; i < numThreads ; i++){
+		threads.push_back(new std::thread(&ThreadPool::workerLoop, this, i + 1));
+	}
+}
+
+ThreadPool::~ThreadPool(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping.store(true);
+	}
+	startCondition.notify_all();
+	
+	for(UINT i = 0 ; i < threads.getSize() ; i++){
+		threads[i]->join();
+		delete threads[i];
+	}
+	delete[] shards;
+}
+
+UINT ThreadPool::DefaultNumThreads(){
+	UINT numHardwareThreads = std::thread::hardware_concurrency();
+	return (numHardwareThreads > 1) ? numHardwareThreads - 1 : 0;
+}
+
+UINT ThreadPool::getNumWorkers() const{
+	return threads.getSize() + 1;
+}
+
+void ThreadPool::run(Task task, void * argument, UINT numTasks){
+	
+	if(numTasks == 0){
+		return;
+	}
+	
+	//small runs and pools without threads execute on the calling thread
+	if(numTasks == 1 || threads.empty()){
+		for(UINT i = 0 ; i < numTasks ; i++){
+			task(argument, i, 0);
+		}
+		return;
+	}
+	
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = task;
+		this->argument = argument;
+		this->numTasks = numTasks;
+		
+		//split the tasks in contiguous shards of similar size
+		UINT numWorkers = getNumWorkers();
+		for(UINT i = 0 ; i < numWorkers ; i++){
+			shards[i].nextTaskIdx.store((UINT) ((unsigned long long) numTasks * i / numWorkers));
+			shards[i].endTaskIdx = (UINT) ((unsigned long long) numTasks * (i + 1) / numWorkers);
+		}
+		numActiveThreads.store(threads.getSize());
+		generation.fetch_add(1, std::memory_order_release);
+	}
+	startCondition.notify_all();
+	
+	executeTasks(0);
+	
+	//wait for the tasks executed by the other workers
+	for(UINT i = 0 ; i < kNumSpinIterations && numActiveThreads.load(std::memory_order_acquire) > 0 ; i++){
+		std::this_thread::yield();
+	}
+	if(numActiveThreads.load(std::memory_order_acquire) > 0){
+		std::unique_lock<std::mutex> lock(mutex);
+		finishCondition.wait(lock, [this](){ return numActiveThreads.load() == 0; });
+	}
+}
+
+void ThreadPool::executeTasks(UINT workerIdx){
+	UINT numWorkers = getNumWorkers();
+	
+	//visit the shard of the worker first and then the shards of the next workers
+	for(UINT i = 0 ; i < numWorkers ; i++){
+		executeShard(shards[(workerIdx + i) % numWorkers], workerIdx);
+	}
+}
+
+void ThreadPool::executeShard(Shard & shard, UINT workerIdx){
+	while(shard.nextTaskIdx.load(std::memory_order_relaxed) < shard.endTaskIdx){
+		UINT taskIdx = shard.nextTaskIdx.fetch_add(1, std::memory_order_relaxed);
+		if(taskIdx >= shard.endTaskIdx){
+			break;
+		}
+		task(argument, taskIdx, workerIdx);
+	}
+}
+
+void ThreadPool::workerLoop(UINT workerIdx){
+	UINT lastGeneration = 0;
+	
+	while(true){
+		
+		//spin for a while in case a new run starts soon
+		for(UINT i = 0 ; i < kNumSpinIterations && generation.load(std::memory_order_acquire) == lastGeneration && !stopping.load() ; i++){
+			std::this_thread::yield();
+		}
+		
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock, [&](){ return stopping.load() || generation.load() != lastGeneration; });
+			if(stopping.load()){
+				return;
+			}
+			lastGeneration = generation.load();
+		}
+		
+		executeTasks(workerIdx);
+		
+		if(numActiveThreads.fetch_sub(1, std::memory_order_acq_rel) == 1){
+			std::lock_guard<std::mutex> lock(mutex);
+			finishCondition.notify_one();
+		}
+	}
+}
+
+}
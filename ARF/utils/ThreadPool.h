@@ -0,0 +1,138 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The ThreadPool executes the tasks of a parallel loop on a fixed set of worker threads. The thread that calls run() takes part in the execution of the tasks and returns once every task has finished, which makes the pool suitable for fork-join parallelism with very short tasks. The tasks are split into one contiguous shard per worker, so that each worker processes neighbouring tasks, and a worker that finishes its shard steals the remaining tasks of the other shards. Idle workers spin for a short time before blocking so that consecutive calls to run() do not pay the cost of waking the threads up.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_THREAD_POOL_H
+#define ARF_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "../dataStructures/Data.h"
+#include "../dataStructures/Vector.h"
+#include "ARFTypedefs.h"
+
+namespace ARF {
+
+class ThreadPool {
+	
+public:
+	
+	/**
+	 The function executed for every task
+	 
+	 @param argument the argument passed to run()
+	 @param taskIdx the index of the task, in the range [0, numTasks)
+	 @param workerIdx the index of the worker executing the task, in the range [0, getNumWorkers()). The thread that calls run() is the worker 0
+	 */
+	typedef void (*Task)(void * argument, UINT taskIdx, UINT workerIdx);
+	
+	/**
+	 Main constructor of the thread pool. Starts the worker threads
+	 
+	 @param numThreads the number of threads created in addition to the thread that calls run()
+	 */
+	ThreadPool(UINT numThreads = DefaultNumThreads());
+	
+	/**
+	 Stops and joins the worker threads
+	 */
+	~ThreadPool();
+	
+	/**
+	 Executes numTasks tasks on the calling thread and on the worker threads, and waits until all of them have finished. Should not be called concurrently nor from within a task
+	 
+	 @param task the function executed for every task
+	 @param argument the argument passed to the function
+	 @param numTasks the number of tasks
+	 */
+	void run(Task task, void * argument, UINT numTasks);
+	
+	/**
+	 Retrieves the number of threads that execute tasks, including the thread that calls run()
+	 
+	 @return the number of workers
+	 */
+	UINT getNumWorkers() const;
+	
+	/**
+	 Retrieves the number of threads a pool should create to use all the cores of the machine
+	 
+	 @return the number of hardware threads minus one, for the thread that calls run()
+	 */
+	static UINT DefaultNumThreads();
+	
+private:
+	
+	/**
+	 The range of tasks assigned to a worker, padded to a cache line so that workers do not invalidate each other's counters
+	 */
+	struct Shard {
+		std::atomic<UINT> nextTaskIdx; ///< The next task of the shard that has not been claimed
+		UINT endTaskIdx; ///< The end of the range of tasks of the shard
+		char padding[64 - sizeof(std::atomic<UINT>) - sizeof(UINT)];
+	};
+	
+	Vector<std::thread*> threads; ///< The worker threads
+	Shard * shards; ///< The shard of every worker
+	std::mutex mutex; ///< Protects the condition variables
+	std::condition_variable startCondition; ///< Notified when a new run starts or the pool stops
+	std::condition_variable finishCondition; ///< Notified when the last worker finishes a run
+	std::atomic<UINT> generation; ///< Incremented every time a run starts
+	std::atomic<UINT> numActiveThreads; ///< The number of worker threads that have not finished the current run
+	std::atomic<bool> stopping; ///< Whether the pool is being destroyed
+	Task task; ///< The function of the current run
+	void * argument; ///< The argument of the current run
+	UINT numTasks; ///< The number of tasks in the current run
+	
+	/**
+	 The main loop of a worker thread
+	 
+	 @param workerIdx the index of the worker
+	 */
+	void workerLoop(UINT workerIdx);
+	
+	/**
+	 Executes the tasks of the shard of the worker, then steals tasks from the other shards until there are no tasks left
+	 
+	 @param workerIdx the index of the worker executing the tasks
+	 */
+	void executeTasks(UINT workerIdx);
+	
+	/**
+	 Executes tasks of a shard until it has no tasks left
+	 
+	 @param shard the shard the tasks are claimed from
+	 @param workerIdx the index of the worker executing the tasks
+	 */
+	void executeShard(Shard & shard, UINT workerIdx);
+	
+	ThreadPool(const ThreadPool &rhs);
+	ThreadPool& operator=(const ThreadPool &rhs);
+};
+
+}
+
+#endif //ARF_THREAD_POOL_H
@@ -0,0 +1,92 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+/**
+ Prints the number of allocations per sample made by a pipeline execution method
+ 
+ @param name the name of the execution method
+ @param numAllocations the number of allocations counted
+ @param numSamples the number of samples processed
+ */
+static void printAllocations(const std::string &name, size_t numAllocations, UINT numSamples){
+	std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+	<< std::setw(12) << std::setprecision(3) << (numAllocations / (double) numSamples) << " allocations/sample"
+	<< std::endl;
+}
+
+void runAllocationBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numSamples = dataset.getNumSamples();
+	
+	//the first half of the samples fills the ring buffer and warms up the arena
+	UINT numWarmupSamples = numSamples / 2;
+	UINT numMeasuredSamples = numSamples - numWarmupSamples;
+	
+	Benchmark::printHeader("Memory allocations in the steady state, all feature branches (test.arf)");
+	
+	{
+		ExamplePipeline pipeline(true);
+		Vector<Data*> output(4);
+		size_t numAllocations = 0;
+		
+		for(UINT i = 0 ; i < numSamples ; i++){
+			if(i == numWarmupSamples){
+				numAllocations = AllocationCounter::getNumAllocations();
+			}
+			UINT outputCount = Algorithm::ExecutePipeline(pipeline.getRoot(), (Data*) &dataset[i], output);
+			for(UINT j = 0 ; j < outputCount ; j++){
+				delete output[j];
+			}
+		}
+		numAllocations = AllocationCounter::getNumAllocations() - numAllocations;
+		printAllocations("Algorithm::ExecutePipeline", numAllocations, numMeasuredSamples);
+	}
+	
+	{
+		ExamplePipeline pipeline(true);
+		PipelinePlan plan(pipeline.getRoot());
+		Vector<Data*> output(plan.getNumLeaves());
+		DataArena &arena = plan.getContext().getArena();
+		size_t numAllocations = 0;
+		UINT numArenaAllocations = 0;
+		
+		for(UINT i = 0 ; i < numSamples ; i++){
+			if(i == numWarmupSamples){
+				numAllocations = AllocationCounter::getNumAllocations();
+				numArenaAllocations = arena.getNumAllocations();
+			}
+			plan.execute((Data*) &dataset[i], output);
+		}
+		numAllocations = AllocationCounter::getNumAllocations() - numAllocations;
+		numArenaAllocations = arena.getNumAllocations() - numArenaAllocations;
+		printAllocations("PipelinePlan::execute", numAllocations, numMeasuredSamples);
+		printAllocations("PipelinePlan::execute, arena chunks", numArenaAllocations, numMeasuredSamples);
+		std::cout << "arena capacity: " << arena.getCapacity() << " bytes" << std::endl;
+	}
+}
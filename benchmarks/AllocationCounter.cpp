@@ -0,0 +1,54 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include "AllocationCounter.h"
+
+static std::atomic<size_t> numAllocations(0);
+static std::atomic<size_t> numAllocatedBytes(0);
+
+size_t AllocationCounter::getNumAllocations(){
+	return numAllocations.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::getNumAllocatedBytes(){
+	return numAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+//replace the global allocation functions, the array versions and the nothrow versions call these ones
+void * operator new(std::size_t size){
+	numAllocations.fetch_add(1, std::memory_order_relaxed);
+	numAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	void * memory = std::malloc(size == 0 ? 1 : size);
+	if(memory == nullptr){
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void * memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void * memory, std::size_t size) noexcept {
+	std::free(memory);
+}
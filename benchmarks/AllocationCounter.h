@@ -0,0 +1,49 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The AllocationCounter counts the calls to the global operator new made by the benchmarks executable. It is used to verify that code executed repeatedly does not allocate memory in its steady state.
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_ALLOCATION_COUNTER_H
+#define ARF_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+namespace AllocationCounter {
+
+/**
+ Retrieves the number of times the global operator new was invoked since the program started
+ 
+ @return the number of allocations
+ */
+size_t getNumAllocations();
+
+/**
+ Retrieves the number of bytes requested to the global operator new since the program started, without the overhead of the allocator
+ 
+ @return the number of bytes allocated
+ */
+size_t getNumAllocatedBytes();
+
+}
+
+#endif //ARF_ALLOCATION_COUNTER_H
@@ -0,0 +1,113 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The Benchmark class contains the utilities shared by the ARF benchmarks to measure execution times and print the results in a common format
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_BENCHMARK_H
+#define ARF_BENCHMARK_H
+
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include "ARF.h"
+
+class Benchmark {
+public:
+	
+	/**
+	 Executes a function several times and measures the fastest execution
+	 
+	 @param function the function to measure, invoked without parameters
+	 @param numRepetitions the number of times the function is executed
+	 @return the duration of the fastest execution in seconds
+	 */
+	template <typename Function>
+	static double measure(Function function, ARF::UINT numRepetitions = 5){
+		double bestSeconds = 0.0;
+		for(ARF::UINT i = 0 ; i < numRepetitions ; i++){
+			auto start = std::chrono::steady_clock::now();
+			function();
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			if(i == 0 || elapsed.count() < bestSeconds){
+				bestSeconds = elapsed.count();
+			}
+		}
+		return bestSeconds;
+	}
+	
+	/**
+	 Prevents the compiler from optimizing away the computation of a value
+	 
+	 @param value the value that should be computed
+	 */
+	template <typename T>
+	static void doNotOptimize(const T &value){
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(value) : "memory");
+#else
+		static volatile T sink;
+		sink = value;
+		(void) sink;
+#endif
+	}
+	
+	/**
+	 Prints the title of a benchmark
+	 
+	 @param title the title of the benchmark
+	 */
+	static void printHeader(const std::string &title){
+		std::cout << std::endl << title << std::endl;
+		std::cout << std::string(title.length(), '-') << std::endl;
+	}
+	
+	/**
+	 Prints the time per item and the throughput of a measurement
+	 
+	 @param name the name of the measurement
+	 @param seconds the duration of the measurement in seconds
+	 @param numItems the number of items processed during the measurement
+	 @param itemName the name of the items processed (e.g. samples)
+	 */
+	static void printResult(const std::string &name, double seconds, double numItems, const std::string &itemName){
+		std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+		<< std::setw(12) << std::setprecision(2) << (seconds * 1e9 / numItems) << " ns/" << itemName
+		<< std::setw(14) << std::setprecision(2) << (numItems / seconds / 1e6) << " M" << itemName << "/s"
+		<< std::endl;
+	}
+	
+	/**
+	 Prints the ratio between the durations of two measurements
+	 
+	 @param name the name of the comparison
+	 @param baselineSeconds the duration of the reference measurement
+	 @param seconds the duration of the compared measurement
+	 */
+	static void printSpeedup(const std::string &name, double baselineSeconds, double seconds){
+		std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+		<< std::setw(12) << std::setprecision(2) << (baselineSeconds / seconds) << "x" << std::endl;
+	}
+};
+
+#endif //ARF_BENCHMARK_H
@@ -0,0 +1,192 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief This file declares the benchmarks that can be run by the benchmarks executable
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_BENCHMARKS_H
+#define ARF_BENCHMARKS_H
+
+#include <string>
+
+/**
+ Compares Algorithm::ExecutePipeline() with a PipelinePlan on the example pipeline
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runPipelineBenchmark(const std::string &dataDirectory);
+
+/**
+ Counts the memory allocations per sample made by Algorithm::ExecutePipeline() and by a PipelinePlan once the pipeline reaches its steady state
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runAllocationBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the execution of the example pipeline sample by sample with its execution in blocks of samples
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runBlockBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the sequential and the parallel execution of pipelines with many feature extraction branches
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runParallelBenchmark(const std::string &dataDirectory);
+
+/**
+ Executes a small pipeline on thousands of independent streams with a StreamRuntime and reports the memory used per stream
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runStreamBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares adding samples and computing a feature over a window stored in a RingBuffer of SensorSamples, in a ColumnRingBuffer and in a mirrored ColumnRingBuffer
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runColumnBenchmark(const std::string &dataDirectory);
+
+/**
+ Measures the throughput and the latency of a SampleQueue between a producer and a consumer thread running on separate cores, and compares it with a RingBufferAlgorithm protected by a mutex
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runQueueBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the memory used by a RingBuffer of SensorSamples and by a RingBuffer of FixedSensorSamples, and the speed of adding samples and reading them through a DataIterator
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runSampleBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the SIMD feature kernels with their scalar versions and with the loops over a DataIterator, for windows of 64 to 4096 samples
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runKernelBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares computing the mean, standard deviation, minimum and zero crossing rate of a window with one algorithm each and with a single Statistics algorithm
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runStatisticsBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares recomputing the mean, standard deviation and minimum over a sliding window at every notification with reading them from SlidingFeatures
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runSlidingBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares computing features over the windows of the example pipeline by reading every sample and from the index of block aggregates of the ring buffer, and the cost of keeping the index up to date
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runIndexBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the power spectrum computed with an FFTPlan and with the naive DFT, and computing several spectral features with one FFT and with an FFT each, for windows of 128 to 4096 samples
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runSpectralBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares tracking the power of a few frequencies on every sample with a SlidingDFT and with an FFT of the window on every sample, and reports the error accumulated by the SlidingDFT over a long stream
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runSlidingDFTBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares filtering 16 channels with a BiquadFilter on every instruction set, offline and with a filter per channel
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runFilterBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the execution of the example pipeline on every sample with its execution after a Resampler at several decimation factors
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runResamplerBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares computing the magnitude of every row of a long recording with a Value per row and with Magnitude::ComputeBlock() on every instruction set and square root, and detecting peaks in the magnitudes one Value at a time and with PeakDetector::detectPeaks()
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runMagnitudeBenchmark(const std::string &dataDirectory);
+
+/**
+ Measures the speed and the largest error of the square roots, logarithms and arc tangents of every math policy, and of Magnitude, STD and the spectral entropy computed with them
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runMathBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares loading a long recording in the .arf format with a DataSet and mapping it with a MappedDataSet, and replaying its rows
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runMappedBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares loading test.txt with the FileParser and with a CSVParser, and measures the throughput of a CSVParser on a long recording on one thread and on every core
+ 
+ @param dataDirectory the directory containing the test.txt file
+ */
+void runCSVBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares executing the example pipeline on a long recording loaded into a DataSet and read in blocks by a DataSetReader, from .arf and CSV files, and the memory each of them allocates
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runReaderBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares the size of a long recording in the uncompressed and the compressed .arf formats for several block sizes, and the speed of loading and reading it in both formats with a DataSet and a DataSetReader
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runCompressionBenchmark(const std::string &dataDirectory);
+
+/**
+ Compares executing the example pipeline on every column of a long recording and on the columns collected by a ColumnProjection, loaded into a DataSet and read by a DataSetReader from uncompressed and compressed .arf files, and the memory each of them allocates
+ 
+ @param dataDirectory the directory containing the test.arf file
+ */
+void runProjectionBenchmark(const std::string &dataDirectory);
+
+#endif //ARF_BENCHMARKS_H
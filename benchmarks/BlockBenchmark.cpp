@@ -0,0 +1,99 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+/**
+ Executes the example pipeline on the dataset in blocks of samples
+ 
+ @return the sum of the values output by the pipeline
+ */
+static double executeInBlocks(const DataSet &dataset, UINT blockSize){
+	ExamplePipeline pipeline(true);
+	PipelinePlan plan(pipeline.getRoot());
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	double sum = 0.0;
+	
+	for(UINT start = 0 ; start < dataset.getNumSamples() ; start += blockSize){
+		UINT numSamples = std::min(blockSize, dataset.getNumSamples() - start);
+		UINT outputCount = plan.executeBlock(&dataset[start], numSamples, output, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+void runBlockBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numSamples = dataset.getNumSamples();
+	
+	Benchmark::printHeader("Block execution, all feature branches (test.arf)");
+	
+	//the loop of examples/main.cpp
+	double pipelineSum = 0.0;
+	double pipelineSeconds = Benchmark::measure([&](){
+		ExamplePipeline pipeline(true);
+		Vector<Data*> output(4);
+		pipelineSum = 0.0;
+		for(UINT i = 0 ; i < numSamples ; i++){
+			SensorSample sample = dataset[i];
+			UINT outputCount = Algorithm::ExecutePipeline(pipeline.getRoot(), &sample, output);
+			for(UINT j = 0 ; j < outputCount ; j++){
+				pipelineSum += ((Value*) output[j])->getValue();
+				delete output[j];
+			}
+		}
+	});
+	Benchmark::printResult("Algorithm::ExecutePipeline, copied samples", pipelineSeconds, numSamples, "sample");
+	
+	double sampleSum = 0.0;
+	double sampleSeconds = Benchmark::measure([&](){
+		ExamplePipeline pipeline(true);
+		PipelinePlan plan(pipeline.getRoot());
+		Vector<Data*> output(plan.getNumLeaves());
+		sampleSum = 0.0;
+		for(UINT i = 0 ; i < numSamples ; i++){
+			UINT outputCount = plan.execute((Data*) &dataset[i], output);
+			for(UINT j = 0 ; j < outputCount ; j++){
+				sampleSum += ((Value*) output[j])->getValue();
+			}
+		}
+	});
+	Benchmark::printResult("PipelinePlan::execute", sampleSeconds, numSamples, "sample");
+	
+	const UINT blockSizes[] = {16, 256, 4096};
+	for(UINT blockSize : blockSizes){
+		double blockSum = 0.0;
+		double blockSeconds = Benchmark::measure([&](){
+			blockSum = executeInBlocks(dataset, blockSize);
+		});
+		Benchmark::printResult("PipelinePlan::executeBlock, " + std::to_string(blockSize) + " samples", blockSeconds, numSamples, "sample");
+		Benchmark::printSpeedup("speedup over Algorithm::ExecutePipeline", pipelineSeconds, blockSeconds);
+		std::cout << "outputs " << ((blockSum == pipelineSum && blockSum == sampleSum) ? "match" : "DO NOT match") << std::endl;
+	}
+}
@@ -0,0 +1,136 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+#include "FileParser.h"
+#include "Util.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace ARF;
+
+//the number of times the rows of test.txt are repeated in the recording
+static const UINT kNumRepetitions = 20;
+
+/**
+ Parses every row of a text with a CSVParser
+ */
+static void parseRows(const std::string &text, Vector<Float> &values, std::vector<Float*> &rows, ThreadPool * threadPool){
+	CSVParser parser(text.data(), text.size(), true);
+	values.resize(parser.getNumRows() * parser.getNumColumns());
+	rows.resize(parser.getNumRows());
+	for(UINT i = 0 ; i < parser.getNumRows() ; i++){
+		rows[i] = &values[i * parser.getNumColumns()];
+	}
+	parser.readRows(rows.data(), threadPool);
+}
+
+void runCSVBenchmark(const std::string &dataDirectory){
+	
+	//a long recording made of the rows of test.txt
+	std::ifstream testFile((dataDirectory + "/test.txt").c_str(), std::ifstream::in | std::ifstream::binary);
+	std::stringstream testStream;
+	testStream << testFile.rdbuf();
+	std::string testText = testStream.str();
+	size_t headerLength = testText.find('\n') + 1;
+	std::string text = testText;
+	for(UINT r = 1 ; r < kNumRepetitions ; r++){
+		text.append(testText, headerLength, std::string::npos);
+	}
+	const std::string fileName = "CSVBenchmark.csv";
+	{
+		std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		file << text;
+	}
+	
+	Benchmark::printHeader("Loading test.txt (" + std::to_string(testText.size() / 1000) + " kB)");
+	
+	//the values of the first row, parsed by every loader
+	Float firstValues[3] = {0, 0, 0};
+	double fileParserSeconds = Benchmark::measure([&](){
+		FileParser parser;
+		parser.parseCSVFile(dataDirectory + "/test.txt", true);
+		for(UINT i = 1 ; i < parser.getRowSize() ; i++){
+			for(UINT j = 0 ; j < parser.getColumnSize() ; j++){
+				Float value = Util::fromString<Float>(parser[i][j]);
+				if(i == 1 && j < 3){
+					firstValues[j] = value;
+				}
+			}
+		}
+	}, 3);
+	Benchmark::printResult("FileParser and Util::fromString", fileParserSeconds, testText.size(), "B");
+	
+	DataSet testDataSet(dataDirectory + "/test.txt", true);
+	double dataSetSeconds = Benchmark::measure([&](){
+		DataSet dataSet(dataDirectory + "/test.txt", true);
+		Benchmark::doNotOptimize(dataSet[0][0]);
+	});
+	Benchmark::printResult("DataSet with a CSVParser", dataSetSeconds, testText.size(), "B");
+	Benchmark::printSpeedup("speedup CSVParser / FileParser", fileParserSeconds, dataSetSeconds);
+	bool match = (testDataSet[0][0] == firstValues[0] && testDataSet[0][1] == firstValues[1] && testDataSet[0][2] == firstValues[2]);
+	
+	Benchmark::printHeader("Loading a recording of " + std::to_string(testDataSet.getNumSamples() * kNumRepetitions) + " rows (" + std::to_string(text.size() / 1000000) + " MB)");
+	
+	Vector<Float> values;
+	std::vector<Float*> rows;
+	double singleThreadSeconds = Benchmark::measure([&](){
+		parseRows(text, values, rows, nullptr);
+	});
+	Benchmark::printResult("CSVParser from memory, 1 thread", singleThreadSeconds, text.size(), "B");
+	
+	size_t numNewLines = 0;
+	double countSeconds = Benchmark::measure([&](){
+		numNewLines = CSVParser::CountNewLines(text.data(), text.size());
+	});
+	Benchmark::printResult("CSVParser::CountNewLines()", countSeconds, text.size(), "B");
+	
+	ThreadPool threadPool;
+	Vector<Float> parallelValues;
+	double parallelSeconds = Benchmark::measure([&](){
+		parseRows(text, parallelValues, rows, &threadPool);
+	});
+	Benchmark::printResult("CSVParser from memory, " + std::to_string(threadPool.getNumWorkers()) + " workers", parallelSeconds, text.size(), "B");
+	Benchmark::printSpeedup("speedup parallel / 1 thread", singleThreadSeconds, parallelSeconds);
+	
+	double recordingSeconds = Benchmark::measure([&](){
+		DataSet dataSet(fileName, true);
+		Benchmark::doNotOptimize(dataSet[0][0]);
+	}, 3);
+	Benchmark::printResult("DataSet from the file", recordingSeconds, text.size(), "B");
+	
+	for(UINT i = 0 ; i < values.getSize() && match ; i++){
+		match = (values[i] == parallelValues[i]);
+	}
+	match = match && numNewLines == (size_t) std::count(text.begin(), text.end(), '\n') && values[0] == firstValues[0];
+	std::cout << "outputs " << (match ? "match" : "DO NOT match") << std::endl;
+	
+	remove(fileName.c_str());
+}
@@ -0,0 +1,133 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the number of samples in the window the features are computed on
+static const UINT kWindowSize = 300;
+
+/**
+ Computes the mean of a column of the window through a DataSelector and a DataIterator
+ 
+ @return the sum of the means, to prevent the compiler from removing the computation
+ */
+static double computeMeans(const Iterable<SensorSample> * iterable, UINT numColumns, UINT numRepetitions){
+	double sum = 0.0;
+	for(UINT i = 0 ; i < numRepetitions ; i++){
+		DataIterator iterator(iterable, 0, kWindowSize - 1, Vector<uint8_t>(1, i % numColumns));
+		sum += Mean::Compute(iterator);
+	}
+	return sum;
+}
+
+void runColumnBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numColumns = dataset[0].getSize();
+	const UINT numAdds = 100000;
+	const UINT numMeans = 20000;
+	
+	RingBuffer<SensorSample> ringBuffer(kWindowSize);
+	ColumnRingBuffer columnRingBuffer(kWindowSize, numColumns);
+	
+	Benchmark::printHeader("Column ring buffer, " + std::to_string(kWindowSize) + " samples with " + std::to_string(numColumns) + " channels (test.arf)");
+	
+	double rowAddSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			ringBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+	});
+	double columnAddSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			columnRingBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+	});
+	Benchmark::printResult("add, RingBuffer<SensorSample>", rowAddSeconds, numAdds, "sample");
+	Benchmark::printResult("add, ColumnRingBuffer", columnAddSeconds, numAdds, "sample");
+	
+	double rowSum = 0.0;
+	double columnSum = 0.0;
+	double spanSum = 0.0;
+	double rowMeanSeconds = Benchmark::measure([&](){
+		rowSum = computeMeans(&ringBuffer, numColumns, numMeans);
+	});
+	double columnMeanSeconds = Benchmark::measure([&](){
+		columnSum = computeMeans(&columnRingBuffer, numColumns, numMeans);
+	});
+	double spanMeanSeconds = Benchmark::measure([&](){
+		spanSum = 0.0;
+		for(UINT i = 0 ; i < numMeans ; i++){
+			ColumnSpan span = columnRingBuffer.getColumnSpan(i % numColumns, 0, kWindowSize - 1);
+			Float sum = 0.0;
+			for(UINT j = 0 ; j < span.firstSize ; j++){
+				sum += span.first[j];
+			}
+			for(UINT j = 0 ; j < span.secondSize ; j++){
+				sum += span.second[j];
+			}
+			spanSum += sum / kWindowSize;
+		}
+	});
+	
+	//mirrored buffers, with columns copied and with columns mapped twice (1024 samples fill a page)
+	ColumnRingBuffer copiedRingBuffer(kWindowSize, numColumns, true);
+	ColumnRingBuffer mappedRingBuffer(1024, numColumns, true);
+	double copiedAddSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			copiedRingBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+	});
+	double mappedAddSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			mappedRingBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+	});
+	Benchmark::printResult("add, mirrored ColumnRingBuffer (copied)", copiedAddSeconds, numAdds, "sample");
+	Benchmark::printResult(std::string("add, mirrored ColumnRingBuffer (") + (mappedRingBuffer.isMapped() ? "mapped" : "copied") + ")", mappedAddSeconds, numAdds, "sample");
+	
+	double windowSum = 0.0;
+	double windowMeanSeconds = Benchmark::measure([&](){
+		windowSum = 0.0;
+		for(UINT i = 0 ; i < numMeans ; i++){
+			const Float * window = copiedRingBuffer.getColumnWindow(i % numColumns, 0);
+			Float sum = 0.0;
+			for(UINT j = 0 ; j < kWindowSize ; j++){
+				sum += window[j];
+			}
+			windowSum += sum / kWindowSize;
+		}
+	});
+	
+	Benchmark::printResult("mean through DataIterator, RingBuffer", rowMeanSeconds, numMeans, "window");
+	Benchmark::printResult("mean through DataIterator, ColumnRingBuffer", columnMeanSeconds, numMeans, "window");
+	Benchmark::printResult("mean over ColumnSpan", spanMeanSeconds, numMeans, "window");
+	Benchmark::printResult("mean over mirrored window", windowMeanSeconds, numMeans, "window");
+	Benchmark::printSpeedup("speedup ColumnSpan / RingBuffer", rowMeanSeconds, spanMeanSeconds);
+	Benchmark::printSpeedup("speedup mirrored window / RingBuffer", rowMeanSeconds, windowMeanSeconds);
+	std::cout << "outputs " << ((std::abs(rowSum - columnSum) < 1e-3 && std::abs(rowSum - spanSum) < 1e-3 * std::abs(rowSum) + 1e-3 && std::abs(spanSum - windowSum) < 1e-3 * std::abs(rowSum) + 1e-3) ? "match" : "DO NOT match") << std::endl;
+}
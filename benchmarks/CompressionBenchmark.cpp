@@ -0,0 +1,125 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace ARF;
+
+//the number of times the samples of test.arf are repeated in the recording
+static const UINT kNumRepetitions = 20;
+
+//the number of samples of every block returned by the DataSetReaders
+static const UINT kReaderBlockSize = 4096;
+
+static size_t getFileSize(const std::string &fileName){
+	std::ifstream file(fileName.c_str(), std::ifstream::binary | std::ifstream::ate);
+	return (size_t) file.tellg();
+}
+
+/**
+ Reads every block of a file with a DataSetReader
+ 
+ @return the sum of the values of the file
+ */
+static double readFile(const std::string &fileName){
+	DataSetReader reader(fileName, kReaderBlockSize);
+	double sum = 0.0;
+	for(UINT numSamples = reader.readBlock() ; numSamples > 0 ; numSamples = reader.readBlock()){
+		const Float * block = reader.getBlock();
+		for(UINT i = 0 ; i < numSamples * reader.getNumColumns() ; i++){
+			sum += block[i];
+		}
+	}
+	return sum;
+}
+
+void runCompressionBenchmark(const std::string &dataDirectory){
+	
+	//a long recording made of the samples of test.arf
+	MappedDataSet testDataSet(dataDirectory + "/test.arf");
+	UINT numColumns = testDataSet.getNumColumns();
+	UINT numSamples = testDataSet.getNumSamples() * kNumRepetitions;
+	UINT numValues = numSamples * numColumns;
+	const std::string fileName = "CompressionBenchmark.arf";
+	const std::string compressedFileName = "CompressionBenchmark.v2.arf";
+	{
+		std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		file << "DatasetName: recording" << std::endl << "InfoText: " << std::endl;
+		file << "NumDimensions: " << numColumns << std::endl << "TotalNumSamples: " << numSamples << std::endl << "ColumnHeaders:\n";
+		for(UINT j = 0 ; j < numColumns ; j++){
+			file << "\t" << testDataSet.getColumnNames()[j];
+		}
+		file << std::endl;
+		for(UINT r = 0 ; r < kNumRepetitions ; r++){
+			file.write(reinterpret_cast<const char*>(testDataSet.getRow(0)), (size_t) testDataSet.getNumSamples() * numColumns * sizeof(Float));
+		}
+	}
+	DataSet recording(fileName);
+	size_t fileSize = getFileSize(fileName);
+	
+	Benchmark::printHeader("Size of a recording of " + std::to_string(numSamples) + " samples of " + std::to_string(numColumns) + " columns");
+	std::cout << "uncompressed: " << (fileSize / 1000) << " kB" << std::endl;
+	for(UINT blockSize : {1024u, 4096u, 16384u, 65536u}){
+		double seconds = Benchmark::measure([&](){
+			recording.saveCompressedDatasetToFile(compressedFileName, blockSize);
+		}, 3);
+		size_t compressedFileSize = getFileSize(compressedFileName);
+		std::cout << "blocks of " << blockSize << " samples: " << (compressedFileSize / 1000) << " kB, ratio " << (double) fileSize / compressedFileSize;
+		std::cout << ", compressed in " << (seconds * 1e9 / numValues) << " ns/value" << std::endl;
+	}
+	recording.saveCompressedDatasetToFile(compressedFileName);
+	
+	Benchmark::printHeader("Loading and reading the recording, uncompressed and in blocks of " + std::to_string(DataSetWriter::kDefaultBlockSize) + " samples");
+	double loadSeconds = Benchmark::measure([&](){
+		DataSet dataSet(fileName);
+		Benchmark::doNotOptimize(dataSet.getNumSamples());
+	}, 3);
+	Benchmark::printResult("DataSet, uncompressed", loadSeconds, numValues, "value");
+	double compressedLoadSeconds = Benchmark::measure([&](){
+		DataSet dataSet(compressedFileName);
+		Benchmark::doNotOptimize(dataSet.getNumSamples());
+	}, 3);
+	Benchmark::printResult("DataSet, compressed", compressedLoadSeconds, numValues, "value");
+	Benchmark::printSpeedup("speedup compressed / uncompressed", loadSeconds, compressedLoadSeconds);
+	
+	double sum = 0.0;
+	double readSeconds = Benchmark::measure([&](){
+		sum = readFile(fileName);
+	}, 3);
+	Benchmark::printResult("DataSetReader, uncompressed", readSeconds, numValues, "value");
+	double compressedSum = 0.0;
+	double compressedReadSeconds = Benchmark::measure([&](){
+		compressedSum = readFile(compressedFileName);
+	}, 3);
+	Benchmark::printResult("DataSetReader, compressed", compressedReadSeconds, numValues, "value");
+	Benchmark::printSpeedup("speedup compressed / uncompressed", readSeconds, compressedReadSeconds);
+	std::cout << "values " << ((sum == compressedSum) ? "match" : "DO NOT match") << std::endl;
+	
+	remove(fileName.c_str());
+	remove(compressedFileName.c_str());
+}
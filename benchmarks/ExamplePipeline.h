@@ -0,0 +1,74 @@
+/**
+ @file
+ @author  Juan Haladjian <juan.haladjian@gmail.com>
+ @brief The ExamplePipeline builds the pipeline of the examples/main.cpp file, so that the benchmarks can measure the same algorithms on a fresh graph
+ 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ */
+
+#ifndef ARF_EXAMPLE_PIPELINE_H
+#define ARF_EXAMPLE_PIPELINE_H
+
+#include "ARF.h"
+
+struct ExamplePipeline {
+	
+	ARF::RingBuffer<ARF::SensorSample> ringBuffer;
+	ARF::RingBufferAlgorithm ringBufferAlgorithm;
+	ARF::DataSelector accelSelector;
+	ARF::Magnitude magnitude;
+	ARF::PeakDetector peakDetector;
+	ARF::DataSelector midAxSelector;
+	ARF::DataSelector midAzSelector;
+	ARF::DataSelector rightAySelector;
+	ARF::Mean mean;
+	ARF::STD stdev;
+	ARF::ZCR zcr;
+	
+	/**
+	 Builds the pipeline of the examples/main.cpp file. The DataSelectors are created from the RingBufferAlgorithm, so that the pipeline can also be executed by a StreamRuntime
+	 
+	 @param allBranches whether the feature extraction branches that are commented out in the example should be added to the pipeline
+	 */
+	ExamplePipeline(bool allBranches = false) : ringBuffer(301), ringBufferAlgorithm(&ringBuffer),
+	accelSelector(ringBufferAlgorithm,300,300,{0,1,2}), peakDetector(0.8, 100),
+	midAxSelector(ringBufferAlgorithm,60,150,{0}), midAzSelector(ringBufferAlgorithm,60,150,{2}),
+	rightAySelector(ringBufferAlgorithm,180,230,{1}) {
+		
+		ringBufferAlgorithm << accelSelector << magnitude << peakDetector;
+		peakDetector << midAzSelector << stdev;
+		
+		if(allBranches){
+			peakDetector << midAxSelector << mean;
+			peakDetector << rightAySelector << zcr;
+		}
+	}
+	
+	/**
+	 Retrieves the root of the pipeline
+	 
+	 @return the first algorithm of the pipeline
+	 */
+	ARF::Algorithm * getRoot(){
+		return &ringBufferAlgorithm;
+	}
+};
+
+#endif //ARF_EXAMPLE_PIPELINE_H
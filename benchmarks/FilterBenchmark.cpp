@@ -0,0 +1,133 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+#include <vector>
+
+using namespace ARF;
+
+//the number of channels of the samples, like 16 IMU channels
+static const UINT kNumChannels = 16;
+
+//the number of samples of each measurement
+static const UINT kNumSamples = 200000;
+
+//the sampling rate of test.arf
+static const Float kSampleRate = 100.0f;
+
+/**
+ Filters every channel separately with its own delays, as a filter per channel would
+ */
+static void filterPerChannel(const std::vector<BiquadFilter::Section> & sections, std::vector<Float> & delays, SensorSample & sample){
+	for(UINT channel = 0 ; channel < kNumChannels ; channel++){
+		Float value = sample[channel];
+		Float * channelDelays = delays.data() + 2 * sections.size() * channel;
+		for(UINT s = 0 ; s < sections.size() ; s++){
+			const BiquadFilter::Section & section = sections[s];
+			Float y = section.b0 * value + channelDelays[2 * s];
+			channelDelays[2 * s] = section.b1 * value - section.a1 * y + channelDelays[2 * s + 1];
+			channelDelays[2 * s + 1] = section.b2 * value - section.a2 * y;
+			value = y;
+		}
+		sample[channel] = value;
+	}
+}
+
+void runFilterBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numColumns = dataset[0].getSize();
+	
+	//samples of 16 channels made of the columns of test.arf
+	std::vector<SensorSample> samples(kNumSamples, SensorSample(kNumChannels));
+	for(UINT i = 0 ; i < kNumSamples ; i++){
+		const SensorSample & sample = dataset[i % dataset.getNumSamples()];
+		for(UINT j = 0 ; j < kNumChannels ; j++){
+			samples[i][j] = sample[j % numColumns];
+		}
+	}
+	
+	Vector<uint8_t> columns;
+	for(UINT i = 0 ; i < kNumChannels ; i++){
+		columns.push_back(i);
+	}
+	BiquadFilter filter(BiquadFilter::kBandPass, 4, kSampleRate, 0.5f, columns, 15.0f);
+	const std::vector<BiquadFilter::Section> & sections = filter.getSections();
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	
+	Benchmark::printHeader("BiquadFilter, band-pass of order 4 on " + std::to_string(kNumChannels) + " channels (test.arf)");
+	
+	std::vector<SensorSample> perChannelOutput = samples;
+	double perChannelSeconds = Benchmark::measure([&](){
+		std::vector<Float> delays(2 * sections.size() * kNumChannels, 0.0f);
+		for(UINT i = 0 ; i < kNumSamples ; i++){
+			perChannelOutput[i] = samples[i];
+			filterPerChannel(sections, delays, perChannelOutput[i]);
+		}
+	});
+	Benchmark::printResult("filter per channel", perChannelSeconds, kNumSamples, "sample");
+	
+	//sample by sample through the execution context, with every instruction set
+	ExecutionContext context;
+	bool match = true;
+	double fastestSeconds = 0.0;
+	for(UINT instructionSet = FeatureKernels::kScalar ; instructionSet <= supportedInstructionSet ; instructionSet++){
+		FeatureKernels::SetInstructionSet(instructionSet);
+		double sum = 0.0;
+		fastestSeconds = Benchmark::measure([&](){
+			filter.reset();
+			sum = 0.0;
+			for(UINT i = 0 ; i < kNumSamples ; i++){
+				sum += (*(SensorSample*) filter.execute(&samples[i], context))[0];
+			}
+		});
+		
+		double expectedSum = 0.0;
+		for(UINT i = 0 ; i < kNumSamples ; i++){
+			expectedSum += perChannelOutput[i][0];
+		}
+		match = match && std::abs(sum - expectedSum) < 1e-3 * std::abs(expectedSum) + 1e-2;
+		Benchmark::printResult(std::string("BiquadFilter ") + FeatureKernels::GetInstructionSetName(instructionSet), fastestSeconds, kNumSamples, "sample");
+	}
+	
+	//offline, in place
+	std::vector<SensorSample> offlineSamples = samples;
+	double offlineSeconds = Benchmark::measure([&](){
+		filter.reset();
+		for(UINT i = 0 ; i < kNumSamples ; i++){
+			offlineSamples[i] = samples[i];
+		}
+		filter.filter(offlineSamples.data(), kNumSamples);
+	});
+	for(UINT i = 0 ; i < kNumSamples ; i += 1000){
+		for(UINT j = 0 ; j < kNumChannels ; j++){
+			match = match && std::abs(offlineSamples[i][j] - perChannelOutput[i][j]) < 1e-3;
+		}
+	}
+	Benchmark::printResult(std::string("BiquadFilter::filter() ") + FeatureKernels::GetInstructionSetName(supportedInstructionSet), offlineSeconds, kNumSamples, "sample");
+	Benchmark::printSpeedup("speedup BiquadFilter / filter per channel", perChannelSeconds, fastestSeconds);
+	std::cout << "outputs " << (match ? "match" : "DO NOT match") << std::endl;
+}
@@ -0,0 +1,96 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the ring buffer and the windows of the examples/main.cpp pipeline
+static const UINT kCapacity = 301;
+
+struct IndexWindow {
+	UINT startRow;
+	UINT endRow;
+	uint8_t column;
+};
+
+static const IndexWindow kWindows[] = {{60, 150, 0}, {60, 150, 2}, {180, 230, 1}};
+
+/**
+ Computes the mean, STD and minimum of the windows of the example pipeline
+ 
+ @return the sum of the features, to prevent the compiler from removing the computation
+ */
+static double computeFeatures(const RingBuffer<SensorSample> & ringBuffer, UINT numRepetitions){
+	double sum = 0.0;
+	for(UINT i = 0 ; i < numRepetitions ; i++){
+		for(const IndexWindow &window : kWindows){
+			DataIterator signal(&ringBuffer, window.startRow, window.endRow, Vector<uint8_t>(1, window.column));
+			sum += Mean::Compute(signal) + STD::Compute(signal) + Minimum::Compute(signal);
+		}
+	}
+	return sum;
+}
+
+void runIndexBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	const UINT numAdds = 200000;
+	const UINT numRepetitions = 20000;
+	
+	RingBuffer<SensorSample> ringBuffer(kCapacity);
+	RingBuffer<SensorSample> indexedRingBuffer(kCapacity);
+	indexedRingBuffer.createIndex(3);
+	
+	Benchmark::printHeader("Block aggregate index, windows 60-150 (ax, az) and 180-230 (ay) of " + std::to_string(kCapacity) + " samples, mean, STD and minimum (test.arf)");
+	
+	double addSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			ringBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+	});
+	double indexedAddSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			indexedRingBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+	});
+	
+	double sum = 0.0;
+	double indexedSum = 0.0;
+	double featureSeconds = Benchmark::measure([&](){
+		sum = computeFeatures(ringBuffer, numRepetitions);
+	});
+	double indexedFeatureSeconds = Benchmark::measure([&](){
+		indexedSum = computeFeatures(indexedRingBuffer, numRepetitions);
+	});
+	
+	Benchmark::printResult("add, RingBuffer", addSeconds, numAdds, "sample");
+	Benchmark::printResult("add, indexed RingBuffer (3 columns, blocks of 32)", indexedAddSeconds, numAdds, "sample");
+	Benchmark::printResult("3 windows, RingBuffer", featureSeconds, numRepetitions, "notification");
+	Benchmark::printResult("3 windows, indexed RingBuffer", indexedFeatureSeconds, numRepetitions, "notification");
+	Benchmark::printSpeedup("speedup features indexed / scanned", featureSeconds, indexedFeatureSeconds);
+	std::cout << "outputs " << (std::abs(sum - indexedSum) < 1e-4 * std::abs(sum) + 1e-3 ? "match" : "DO NOT match") << std::endl;
+}
@@ -0,0 +1,112 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the sizes of the windows the features are computed on
+static const UINT kWindowSizes[] = {64, 256, 1024, 4096};
+
+//the number of samples processed by each measurement
+static const UINT kNumSamples = 4000000;
+
+struct KernelFeature {
+	const char * name;
+	Feature (*compute)(const Signal & signal);
+};
+
+static const KernelFeature kernelFeatures[] = {
+	{"Mean", Mean::Compute},
+	{"STD", STD::Compute},
+	{"Minimum", Minimum::Compute},
+	{"ZCR", ZCR::Compute},
+};
+
+/**
+ Computes a feature over the same window several times
+ 
+ @return the sum of the features, to prevent the compiler from removing the computation
+ */
+static double computeFeatures(const KernelFeature &feature, const Signal &signal, UINT numWindows){
+	double sum = 0.0;
+	for(UINT i = 0 ; i < numWindows ; i++){
+		sum += feature.compute(signal);
+	}
+	return sum;
+}
+
+void runKernelBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	const char * instructionSetName = FeatureKernels::GetInstructionSetName(supportedInstructionSet);
+	bool match = true;
+	
+	Benchmark::printHeader(std::string("Feature kernels, ") + instructionSetName + " vs scalar vs DataIterator loop over RingBuffer<SensorSample> (test.arf)");
+	
+	for(UINT windowSize : kWindowSizes){
+		
+		//the same values of the first channel, stored row-wise and in a contiguous column
+		RingBuffer<SensorSample> ringBuffer(windowSize);
+		ColumnRingBuffer columnRingBuffer(windowSize, 1);
+		for(UINT i = 0 ; i < windowSize ; i++){
+			const SensorSample &sample = dataset[i % dataset.getNumSamples()];
+			ringBuffer.add(sample);
+			columnRingBuffer.add(&sample[0]);
+		}
+		Signal rowSignal(&ringBuffer, 0, windowSize - 1, Vector<uint8_t>(1, 0));
+		Signal columnSignal(&columnRingBuffer, 0, windowSize - 1, Vector<uint8_t>(1, 0));
+		UINT numWindows = kNumSamples / windowSize;
+		
+		for(const KernelFeature &feature : kernelFeatures){
+			std::string name = std::string(feature.name) + "/" + std::to_string(windowSize);
+			double loopSum = 0.0, scalarSum = 0.0, vectorSum = 0.0;
+			
+			double loopSeconds = Benchmark::measure([&](){
+				loopSum = computeFeatures(feature, rowSignal, numWindows);
+			});
+			FeatureKernels::SetInstructionSet(FeatureKernels::kScalar);
+			double scalarSeconds = Benchmark::measure([&](){
+				scalarSum = computeFeatures(feature, columnSignal, numWindows);
+			});
+			FeatureKernels::SetInstructionSet(supportedInstructionSet);
+			double vectorSeconds = Benchmark::measure([&](){
+				vectorSum = computeFeatures(feature, columnSignal, numWindows);
+			});
+			
+			Benchmark::printResult(name + " loop", loopSeconds, (double) numWindows * windowSize, "sample");
+			Benchmark::printResult(name + " scalar kernel", scalarSeconds, (double) numWindows * windowSize, "sample");
+			Benchmark::printResult(name + " " + instructionSetName + " kernel", vectorSeconds, (double) numWindows * windowSize, "sample");
+			Benchmark::printSpeedup(name + " speedup " + instructionSetName + " / loop", loopSeconds, vectorSeconds);
+			Benchmark::printSpeedup(name + " speedup " + instructionSetName + " / scalar", scalarSeconds, vectorSeconds);
+			
+			double tolerance = 1e-3 * std::abs(loopSum) + 1e-3;
+			match = match && std::abs(loopSum - scalarSum) < tolerance && std::abs(loopSum - vectorSum) < tolerance;
+		}
+	}
+	std::cout << "outputs " << (match ? "match" : "DO NOT match") << std::endl;
+}
@@ -0,0 +1,130 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+#include <cmath>
+#include <vector>
+
+using namespace ARF;
+
+//the number of rows of the recording
+static const UINT kNumSamples = 1000000;
+
+void runMagnitudeBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	
+	//a long recording of the 3 accelerometer axes made of the samples of test.arf
+	RingBuffer<SensorSample> ringBuffer(kNumSamples);
+	ColumnRingBuffer columnRingBuffer(kNumSamples, 3);
+	for(UINT i = 0 ; i < kNumSamples ; i++){
+		const SensorSample & sample = dataset[i % dataset.getNumSamples()];
+		SensorSample axes(3);
+		for(UINT j = 0 ; j < 3 ; j++){
+			axes[j] = sample[j];
+		}
+		ringBuffer.add(axes);
+		columnRingBuffer.add(axes);
+	}
+	Vector<uint8_t> columns(std::vector<uint8_t>{0, 1, 2});
+	
+	Benchmark::printHeader("Magnitude of " + std::to_string(kNumSamples) + " rows of 3 axes (test.arf)");
+	
+	//a Value per row, as Magnitude::execute() computes it
+	double sum = 0.0;
+	double perRowSeconds = Benchmark::measure([&](){
+		sum = 0.0;
+		Magnitude magnitude;
+		for(UINT i = 0 ; i < kNumSamples ; i++){
+			DataIterator row(&columnRingBuffer, i, i, columns);
+			Value * value = (Value*) magnitude.execute(&row);
+			sum += value->getValue();
+			delete value;
+		}
+	}, 3);
+	Benchmark::doNotOptimize(sum);
+	Benchmark::printResult("Magnitude::execute() per row", perRowSeconds, kNumSamples, "row");
+	
+	std::vector<Float> exact(kNumSamples);
+	double samplesSeconds = Benchmark::measure([&](){
+		Magnitude::ComputeBlock(Signal(&ringBuffer, 0, kNumSamples - 1, columns), exact.data());
+	});
+	Benchmark::printResult("ComputeBlock() RingBuffer of SensorSamples", samplesSeconds, kNumSamples, "row");
+	
+	//the columns of a ColumnRingBuffer are contiguous, so the SIMD kernels apply
+	const char * squareRootNames[] = {"exact", "refined rsqrt", "rsqrt"};
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	double fastestSeconds = perRowSeconds;
+	std::vector<Float> magnitudes(kNumSamples);
+	Signal columnSignal(&columnRingBuffer, 0, kNumSamples - 1, columns);
+	for(UINT instructionSet = FeatureKernels::kScalar ; instructionSet <= supportedInstructionSet ; instructionSet++){
+		FeatureKernels::SetInstructionSet(instructionSet);
+		for(UINT squareRoot = FeatureKernels::kExactSquareRoot ; squareRoot <= FeatureKernels::kApproximateSquareRoot ; squareRoot++){
+			if(instructionSet == FeatureKernels::kScalar && squareRoot != FeatureKernels::kExactSquareRoot){
+				continue;
+			}
+			double seconds = Benchmark::measure([&](){
+				Magnitude::ComputeBlock(columnSignal, magnitudes.data(), squareRoot);
+			});
+			fastestSeconds = std::min(fastestSeconds, seconds);
+			
+			double maxError = 0.0;
+			for(UINT i = 0 ; i < kNumSamples ; i++){
+				if(exact[i] > 0){
+					maxError = std::max(maxError, (double) std::abs(magnitudes[i] - exact[i]) / exact[i]);
+				}
+			}
+			Benchmark::printResult(std::string("ComputeBlock() ") + FeatureKernels::GetInstructionSetName(instructionSet) + " " + squareRootNames[squareRoot], seconds, kNumSamples, "row");
+			std::cout << "  max relative error " << std::scientific << std::setprecision(2) << maxError << std::fixed << std::endl;
+		}
+	}
+	FeatureKernels::SetInstructionSet(supportedInstructionSet);
+	Benchmark::printSpeedup("speedup fastest ComputeBlock() / per row", perRowSeconds, fastestSeconds);
+	
+	//peak detection on the magnitudes, a Value per row or the whole array at once
+	Benchmark::printHeader("PeakDetector on " + std::to_string(kNumSamples) + " magnitudes (test.arf)");
+	UINT numPeaks = 0;
+	double valueSeconds = Benchmark::measure([&](){
+		PeakDetector peakDetector(1.5f, 50);
+		numPeaks = 0;
+		for(UINT i = 0 ; i < kNumSamples ; i++){
+			Value value(exact[i]);
+			numPeaks += (peakDetector.execute(&value) != nullptr);
+		}
+	});
+	Benchmark::printResult("PeakDetector::execute() per Value", valueSeconds, kNumSamples, "row");
+	
+	UINT numBlockPeaks = 0;
+	Vector<UINT> peakIndices;
+	peakIndices.reserve(kNumSamples);
+	double blockSeconds = Benchmark::measure([&](){
+		PeakDetector peakDetector(1.5f, 50);
+		peakIndices.clear();
+		numBlockPeaks = peakDetector.detectPeaks(exact.data(), kNumSamples, peakIndices);
+	});
+	Benchmark::printResult("PeakDetector::detectPeaks()", blockSeconds, kNumSamples, "row");
+	std::cout << "peaks: " << numPeaks << (numPeaks == numBlockPeaks ? " (match)" : " (DO NOT match)") << std::endl;
+}
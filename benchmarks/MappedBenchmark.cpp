@@ -0,0 +1,112 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "DataSet.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace ARF;
+
+//the number of times the samples of test.arf are repeated in the recording
+static const UINT kNumRepetitions = 40;
+
+/**
+ Sums the first 3 columns of every row of a recording
+ */
+template <typename GetRow>
+static double sumRows(UINT numSamples, GetRow getRow){
+	double sum = 0.0;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		const Float * row = getRow(i);
+		sum += row[0] + row[1] + row[2];
+	}
+	return sum;
+}
+
+void runMappedBenchmark(const std::string &dataDirectory){
+	
+	//a long recording made of the samples of test.arf, written in the format of DataSet::saveDatasetToFile()
+	const std::string fileName = "MappedBenchmark.arf";
+	MappedDataSet testDataSet(dataDirectory + "/test.arf");
+	UINT numColumns = testDataSet.getNumColumns();
+	UINT numSamples = testDataSet.getNumSamples() * kNumRepetitions;
+	{
+		std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		file << "DatasetName: recording" << std::endl << "InfoText: " << std::endl;
+		file << "NumDimensions: " << numColumns << std::endl << "TotalNumSamples: " << numSamples << std::endl << "ColumnHeaders:\n";
+		for(UINT j = 0 ; j < numColumns ; j++){
+			file << "\t" << testDataSet.getColumnNames()[j];
+		}
+		file << std::endl;
+		for(UINT r = 0 ; r < kNumRepetitions ; r++){
+			file.write(reinterpret_cast<const char*>(testDataSet.getRow(0)), (size_t) testDataSet.getNumSamples() * numColumns * sizeof(Float));
+		}
+	}
+	double fileSize = (double) numSamples * numColumns * sizeof(Float);
+	
+	Benchmark::printHeader("Opening a recording of " + std::to_string(numSamples) + " rows of " + std::to_string(numColumns) + " columns (" + std::to_string((int) (fileSize / 1e6)) + " MB)");
+	
+	double loadedSum = 0.0;
+	size_t numAllocations = 0, numAllocatedBytes = 0;
+	double loadSeconds = Benchmark::measure([&](){
+		size_t allocations = AllocationCounter::getNumAllocations();
+		size_t allocatedBytes = AllocationCounter::getNumAllocatedBytes();
+		DataSet dataSet(fileName);
+		numAllocations = AllocationCounter::getNumAllocations() - allocations;
+		numAllocatedBytes = AllocationCounter::getNumAllocatedBytes() - allocatedBytes;
+		loadedSum = sumRows(numSamples, [&](UINT i){ return &dataSet[i][0]; });
+	}, 3);
+	Benchmark::printResult("DataSet load and replay", loadSeconds, numSamples, "row");
+	std::cout << "  " << numAllocations << " allocations, " << (numAllocatedBytes / 1000000) << " MB allocated" << std::endl;
+	
+	double mappedSum = 0.0;
+	double mapSeconds = Benchmark::measure([&](){
+		size_t allocations = AllocationCounter::getNumAllocations();
+		size_t allocatedBytes = AllocationCounter::getNumAllocatedBytes();
+		MappedDataSet dataSet(fileName);
+		numAllocations = AllocationCounter::getNumAllocations() - allocations;
+		numAllocatedBytes = AllocationCounter::getNumAllocatedBytes() - allocatedBytes;
+		mappedSum = sumRows(numSamples, [&](UINT i){ return dataSet.getRow(i); });
+	}, 3);
+	Benchmark::printResult("MappedDataSet map and replay", mapSeconds, numSamples, "row");
+	std::cout << "  " << numAllocations << " allocations, " << numAllocatedBytes << " bytes allocated" << std::endl;
+	Benchmark::printSpeedup("speedup MappedDataSet / DataSet", loadSeconds, mapSeconds);
+	
+	//replaying a window of the recording through a DataSelector, as a pipeline reads it
+	MappedDataSet dataSet(fileName);
+	DataSelector selector(&dataSet, 0, numSamples - 1, {0});
+	Signal * signal = (Signal*) selector.execute(nullptr);
+	double mean = 0.0;
+	double selectorSeconds = Benchmark::measure([&](){
+		mean = Mean::Compute(*signal);
+	});
+	delete signal;
+	Benchmark::printResult("Mean of column 0 through a DataSelector", selectorSeconds, numSamples, "row");
+	std::cout << "outputs " << ((std::abs(loadedSum - mappedSum) < 1e-6 * std::abs(loadedSum) + 1e-3 && mean == mean) ? "match" : "DO NOT match") << std::endl;
+	
+	remove(fileName.c_str());
+}
@@ -0,0 +1,192 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+#include <cmath>
+#include <vector>
+
+using namespace ARF;
+
+//the number of inputs of every function
+static const UINT kNumValues = 1000000;
+
+//the size of the windows of the feature extractors
+static const UINT kWindowSize = 256;
+
+//the sampling rate of test.arf
+static const Float kSampleRate = 100.0f;
+
+/**
+ Measures the functions of a math policy and their largest error to the functions of the standard library computed in double precision
+ */
+template <typename Math>
+static void measureFunctions(const std::string & name, const std::vector<Float> & positives, const std::vector<Float> & xs, const std::vector<Float> & ys){
+	
+	Float sum = 0.0;
+	double sqrtSeconds = Benchmark::measure([&](){
+		sum = 0.0;
+		for(UINT i = 0 ; i < kNumValues ; i++){
+			sum += Math::Sqrt(positives[i]);
+		}
+	});
+	Benchmark::doNotOptimize(sum);
+	
+	double log2Seconds = Benchmark::measure([&](){
+		sum = 0.0;
+		for(UINT i = 0 ; i < kNumValues ; i++){
+			sum += Math::Log2(positives[i]);
+		}
+	});
+	Benchmark::doNotOptimize(sum);
+	
+	double atan2Seconds = Benchmark::measure([&](){
+		sum = 0.0;
+		for(UINT i = 0 ; i < kNumValues ; i++){
+			sum += Math::Atan2(ys[i], xs[i]);
+		}
+	});
+	Benchmark::doNotOptimize(sum);
+	
+	double sqrtError = 0.0, log2Error = 0.0, atan2Error = 0.0;
+	for(UINT i = 0 ; i < kNumValues ; i++){
+		double x = positives[i];
+		sqrtError = std::max(sqrtError, std::abs(Math::Sqrt(positives[i]) - std::sqrt(x)) / std::sqrt(x));
+		log2Error = std::max(log2Error, std::abs(Math::Log2(positives[i]) - std::log2(x)));
+		atan2Error = std::max(atan2Error, std::abs(Math::Atan2(ys[i], xs[i]) - std::atan2((double) ys[i], (double) xs[i])));
+	}
+	
+	Benchmark::printResult(name + " Sqrt", sqrtSeconds, kNumValues, "call");
+	std::cout << "  max relative error " << std::scientific << std::setprecision(2) << sqrtError << std::fixed << std::endl;
+	Benchmark::printResult(name + " Log2", log2Seconds, kNumValues, "call");
+	std::cout << "  max absolute error " << std::scientific << std::setprecision(2) << log2Error << std::fixed << std::endl;
+	Benchmark::printResult(name + " Atan2", atan2Seconds, kNumValues, "call");
+	std::cout << "  max absolute error " << std::scientific << std::setprecision(2) << atan2Error << " rad" << std::fixed << std::endl;
+}
+
+/**
+ Measures the algorithms computed with a math policy on the rows and windows of a recording, and their largest relative error to the algorithms computed with ExactMath
+ */
+template <typename Math>
+static void measureAlgorithms(const std::string & name, const ColumnRingBuffer & ringBuffer, const std::vector<Float> & exact){
+	
+	Vector<uint8_t> axes(std::vector<uint8_t>{0, 1, 2});
+	UINT numRows = ringBuffer.getSize();
+	UINT numWindows = numRows / kWindowSize;
+	std::vector<Float> results(numRows + 2 * numWindows);
+	
+	//the iterator is moved over the rows so that its range is not allocated for every row
+	double magnitudeSeconds = Benchmark::measure([&](){
+		DataIterator row(&ringBuffer, 0, 0, axes);
+		for(UINT i = 0 ; i < numRows ; i++){
+			row.setRowRange(i, i);
+			results[i] = BasicMagnitude<Math>::Compute(row);
+		}
+	});
+	
+	double stdSeconds = Benchmark::measure([&](){
+		for(UINT w = 0 ; w < numWindows ; w++){
+			results[numRows + w] = BasicSTD<Math>::Compute(Signal(&ringBuffer, w * kWindowSize, (w + 1) * kWindowSize - 1, Vector<uint8_t>(1, 0)));
+		}
+	});
+	
+	const FFTPlan & plan = FFTPlan::GetPlan(kWindowSize);
+	std::vector<Float> scratch(SpectralFeatures::GetScratchSize(plan));
+	FeatureVector entropy;
+	double entropySeconds = Benchmark::measure([&](){
+		for(UINT w = 0 ; w < numWindows ; w++){
+			Signal window(&ringBuffer, w * kWindowSize, (w + 1) * kWindowSize - 1, Vector<uint8_t>(1, 0));
+			BasicSpectralFeatures<Math>::Compute(window, plan, kSampleRate, SpectralFeatures::kSpectralEntropy, Vector<Float>(), entropy, scratch.data());
+			results[numRows + numWindows + w] = entropy[0];
+		}
+	});
+	
+	double magnitudeError = 0.0, stdError = 0.0, entropyError = 0.0;
+	for(UINT i = 0 ; i < numRows ; i++){
+		magnitudeError = std::max(magnitudeError, (double) std::abs(results[i] - exact[i]) / exact[i]);
+	}
+	for(UINT w = 0 ; w < numWindows ; w++){
+		stdError = std::max(stdError, (double) std::abs(results[numRows + w] - exact[numRows + w]) / exact[numRows + w]);
+		entropyError = std::max(entropyError, (double) std::abs(results[numRows + numWindows + w] - exact[numRows + numWindows + w]));
+	}
+	
+	Benchmark::printResult(name + " Magnitude", magnitudeSeconds, numRows, "row");
+	std::cout << "  max relative error " << std::scientific << std::setprecision(2) << magnitudeError << std::fixed << std::endl;
+	Benchmark::printResult(name + " STD", stdSeconds, numWindows, "window");
+	std::cout << "  max relative error " << std::scientific << std::setprecision(2) << stdError << std::fixed << std::endl;
+	Benchmark::printResult(name + " spectral entropy", entropySeconds, numWindows, "window");
+	std::cout << "  max absolute error " << std::scientific << std::setprecision(2) << entropyError << std::fixed << std::endl;
+}
+
+void runMathBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	
+	//the squared magnitudes of the accelerometer of test.arf and angles between its axes
+	std::vector<Float> positives(kNumValues), xs(kNumValues), ys(kNumValues);
+	for(UINT i = 0 ; i < kNumValues ; i++){
+		const SensorSample & sample = dataset[i % dataset.getNumSamples()];
+		positives[i] = sample[0] * sample[0] + sample[1] * sample[1] + sample[2] * sample[2] + 1e-6f;
+		xs[i] = sample[0];
+		ys[i] = sample[1];
+	}
+	
+	Benchmark::printHeader("Math policies on " + std::to_string(kNumValues) + " values (test.arf)");
+	measureFunctions<ExactMath>("ExactMath", positives, xs, ys);
+	measureFunctions<FastMath>("FastMath", positives, xs, ys);
+	measureFunctions<TableMath>("TableMath", positives, xs, ys);
+	
+	ColumnRingBuffer ringBuffer(kWindowSize * 1000, 3);
+	for(UINT i = 0 ; i < ringBuffer.getCapacity() ; i++){
+		const SensorSample & sample = dataset[i % dataset.getNumSamples()];
+		SensorSample axes(3);
+		for(UINT j = 0 ; j < 3 ; j++){
+			axes[j] = sample[j];
+		}
+		ringBuffer.add(axes);
+	}
+	
+	//the results of ExactMath, which the other policies are compared to
+	UINT numRows = ringBuffer.getSize();
+	UINT numWindows = numRows / kWindowSize;
+	std::vector<Float> exact(numRows + 2 * numWindows);
+	Vector<uint8_t> axes(std::vector<uint8_t>{0, 1, 2});
+	std::vector<Float> scratch(SpectralFeatures::GetScratchSize(FFTPlan::GetPlan(kWindowSize)));
+	FeatureVector entropy;
+	for(UINT i = 0 ; i < numRows ; i++){
+		exact[i] = Magnitude::Compute(DataIterator(&ringBuffer, i, i, axes));
+	}
+	for(UINT w = 0 ; w < numWindows ; w++){
+		Signal window(&ringBuffer, w * kWindowSize, (w + 1) * kWindowSize - 1, Vector<uint8_t>(1, 0));
+		exact[numRows + w] = STD::Compute(window);
+		SpectralFeatures::Compute(window, FFTPlan::GetPlan(kWindowSize), kSampleRate, SpectralFeatures::kSpectralEntropy, Vector<Float>(), entropy, scratch.data());
+		exact[numRows + numWindows + w] = entropy[0];
+	}
+	
+	Benchmark::printHeader("Algorithms with every math policy on " + std::to_string(numRows) + " rows and windows of " + std::to_string(kWindowSize) + " (test.arf)");
+	measureAlgorithms<ExactMath>("ExactMath", ringBuffer, exact);
+	measureAlgorithms<FastMath>("FastMath", ringBuffer, exact);
+	measureAlgorithms<TableMath>("TableMath", ringBuffer, exact);
+}
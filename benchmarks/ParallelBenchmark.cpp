@@ -0,0 +1,103 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//a ring buffer followed by many feature extraction branches, executed for every sample
+struct BranchPipeline {
+	RingBuffer<SensorSample> ringBuffer;
+	RingBufferAlgorithm ringBufferAlgorithm;
+	Vector<Algorithm*> algorithms;
+	
+	BranchPipeline(UINT numBranches) : ringBuffer(301), ringBufferAlgorithm(&ringBuffer) {
+		for(UINT i = 0 ; i < numBranches ; i++){
+			UINT startRow = (i * 37) % 100;
+			Algorithm * selector = new DataSelector(&ringBuffer, startRow, 300, {(uint8_t) (i % 6)});
+			Algorithm * feature;
+			switch(i % 4){
+				case 0: feature = new Mean(); break;
+				case 1: feature = new STD(); break;
+				case 2: feature = new ZCR(); break;
+				default: feature = new Minimum(); break;
+			}
+			ringBufferAlgorithm << *selector << *feature;
+			algorithms.push_back(selector);
+			algorithms.push_back(feature);
+		}
+	}
+	
+	~BranchPipeline(){
+		for(UINT i = 0 ; i < algorithms.getSize() ; i++){
+			delete algorithms[i];
+		}
+	}
+};
+
+/**
+ Executes the branch pipeline on the samples of the dataset
+ 
+ @return the sum of the values output by the pipeline
+ */
+static double executeBranches(const DataSet &dataset, UINT numBranches, ThreadPool * threadPool){
+	BranchPipeline pipeline(numBranches);
+	PipelinePlan plan(&pipeline.ringBufferAlgorithm);
+	plan.setThreadPool(threadPool);
+	Vector<Data*> output(plan.getNumLeaves());
+	double sum = 0.0;
+	
+	for(UINT i = 0 ; i < dataset.getNumSamples() ; i++){
+		UINT outputCount = plan.execute((Data*) &dataset[i], output);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+void runParallelBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numSamples = dataset.getNumSamples();
+	UINT numThreads = ThreadPool::DefaultNumThreads();
+	ThreadPool threadPool(numThreads);
+	
+	const UINT numBranchesList[] = {3, 60};
+	for(UINT numBranches : numBranchesList){
+		Benchmark::printHeader("Parallel branches, " + std::to_string(numBranches) + " feature branches over 300 samples (test.arf), " + std::to_string(threadPool.getNumWorkers()) + " workers");
+		
+		double sequentialSum = 0.0;
+		double parallelSum = 0.0;
+		double sequentialSeconds = Benchmark::measure([&](){
+			sequentialSum = executeBranches(dataset, numBranches, nullptr);
+		}, 3);
+		double parallelSeconds = Benchmark::measure([&](){
+			parallelSum = executeBranches(dataset, numBranches, &threadPool);
+		}, 3);
+		
+		Benchmark::printResult("sequential", sequentialSeconds, numSamples, "event");
+		Benchmark::printResult("parallel", parallelSeconds, numSamples, "event");
+		Benchmark::printSpeedup("speedup", sequentialSeconds, parallelSeconds);
+		std::cout << "outputs " << ((sequentialSum == parallelSum) ? "match" : "DO NOT match") << std::endl;
+	}
+}
@@ -0,0 +1,96 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+/**
+ Executes the example pipeline on every sample of the dataset with Algorithm::ExecutePipeline()
+ 
+ @return the sum of the values output by the pipeline
+ */
+static double executeWithExecutePipeline(const DataSet &dataset, bool allBranches){
+	ExamplePipeline pipeline(allBranches);
+	Vector<Data*> output(4);
+	double sum = 0.0;
+	
+	for(UINT i = 0 ; i < dataset.getNumSamples() ; i++){
+		SensorSample sample = dataset[i];
+		UINT outputCount = Algorithm::ExecutePipeline(pipeline.getRoot(), &sample, output);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+			delete output[j];
+		}
+	}
+	return sum;
+}
+
+/**
+ Executes the example pipeline on every sample of the dataset with a PipelinePlan
+ 
+ @return the sum of the values output by the pipeline
+ */
+static double executeWithPipelinePlan(const DataSet &dataset, bool allBranches){
+	ExamplePipeline pipeline(allBranches);
+	PipelinePlan plan(pipeline.getRoot());
+	Vector<Data*> output(plan.getNumLeaves());
+	double sum = 0.0;
+	
+	for(UINT i = 0 ; i < dataset.getNumSamples() ; i++){
+		SensorSample sample = dataset[i];
+		UINT outputCount = plan.execute(&sample, output);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+void runPipelineBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numSamples = dataset.getNumSamples();
+	
+	for(int allBranches = 0 ; allBranches < 2 ; allBranches++){
+		Benchmark::printHeader(allBranches ? "Pipeline execution, all feature branches (test.arf)" : "Pipeline execution, examples/main.cpp pipeline (test.arf)");
+		
+		double pipelineSum = 0.0;
+		double planSum = 0.0;
+		
+		double pipelineSeconds = Benchmark::measure([&](){
+			pipelineSum = executeWithExecutePipeline(dataset, allBranches);
+		});
+		double planSeconds = Benchmark::measure([&](){
+			planSum = executeWithPipelinePlan(dataset, allBranches);
+		});
+		
+		Benchmark::printResult("Algorithm::ExecutePipeline", pipelineSeconds, numSamples, "sample");
+		Benchmark::printResult("PipelinePlan::execute", planSeconds, numSamples, "sample");
+		Benchmark::printSpeedup("speedup", pipelineSeconds, planSeconds);
+		std::cout << "outputs " << ((pipelineSum == planSum) ? "match" : "DO NOT match") << std::endl;
+	}
+}
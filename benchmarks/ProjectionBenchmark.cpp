@@ -0,0 +1,170 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace ARF;
+
+//the number of times the samples of test.arf are repeated in the recording
+static const UINT kNumRepetitions = 20;
+
+//the number of samples executed by every call to PipelinePlan::executeBlock()
+static const UINT kBlockSize = 4096;
+
+/**
+ Executes the example pipeline on a loaded dataset in blocks of samples
+ 
+ @param project whether the pipeline reads the projected samples of the dataset
+ @return the sum of the values output by the pipeline
+ */
+static double executeDataSet(const DataSet &dataSet, bool project){
+	ExamplePipeline pipeline(true);
+	ColumnProjection projection(pipeline.getRoot(), 16);
+	if(project){
+		projection.apply();
+	}
+	PipelinePlan plan(pipeline.getRoot());
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	double sum = 0.0;
+	for(UINT start = 0 ; start < dataSet.getNumSamples() ; start += kBlockSize){
+		UINT numSamples = std::min(kBlockSize, dataSet.getNumSamples() - start);
+		UINT outputCount = plan.executeBlock(&dataSet[start], numSamples, output, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+/**
+ Executes the example pipeline on the blocks of a DataSetReader
+ 
+ @param project whether the reader keeps only the columns read by the pipeline
+ @return the sum of the values output by the pipeline
+ */
+static double executeReader(const std::string &fileName, bool project){
+	ExamplePipeline pipeline(true);
+	DataSetReader reader(fileName, kBlockSize);
+	ColumnProjection projection(pipeline.getRoot(), reader.getNumColumns());
+	if(project){
+		projection.apply();
+		reader.selectColumns(projection.getColumns());
+	}
+	PipelinePlan plan(pipeline.getRoot());
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	double sum = 0.0;
+	for(UINT numSamples = reader.readBlock() ; numSamples > 0 ; numSamples = reader.readBlock()){
+		UINT outputCount = plan.executeBlock(reader.getBlock(), numSamples, reader.getNumColumns(), reader.getNumColumns(), output, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+/**
+ Measures a function and prints its duration and the memory it allocated
+ */
+template <typename Function>
+static double measureLoad(const std::string &name, UINT numSamples, Function function){
+	size_t numAllocatedBytes = 0;
+	double seconds = Benchmark::measure([&](){
+		size_t allocatedBytes = AllocationCounter::getNumAllocatedBytes();
+		function();
+		numAllocatedBytes = AllocationCounter::getNumAllocatedBytes() - allocatedBytes;
+	}, 3);
+	Benchmark::printResult(name, seconds, numSamples, "sample");
+	std::cout << "  " << (numAllocatedBytes / 1000) << " kB allocated" << std::endl;
+	return seconds;
+}
+
+void runProjectionBenchmark(const std::string &dataDirectory){
+	
+	//a long recording made of the samples of test.arf, uncompressed and compressed
+	MappedDataSet testDataSet(dataDirectory + "/test.arf");
+	UINT numColumns = testDataSet.getNumColumns();
+	UINT numSamples = testDataSet.getNumSamples() * kNumRepetitions;
+	const std::string fileName = "ProjectionBenchmark.arf";
+	const std::string compressedFileName = "ProjectionBenchmark.v2.arf";
+	{
+		std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		file << "DatasetName: recording" << std::endl << "InfoText: " << std::endl;
+		file << "NumDimensions: " << numColumns << std::endl << "TotalNumSamples: " << numSamples << std::endl << "ColumnHeaders:\n";
+		for(UINT j = 0 ; j < numColumns ; j++){
+			file << "\t" << testDataSet.getColumnNames()[j];
+		}
+		file << std::endl;
+		for(UINT r = 0 ; r < kNumRepetitions ; r++){
+			file.write(reinterpret_cast<const char*>(testDataSet.getRow(0)), (size_t) testDataSet.getNumSamples() * numColumns * sizeof(Float));
+		}
+	}
+	DataSet(fileName).saveCompressedDatasetToFile(compressedFileName);
+	
+	ExamplePipeline pipeline(true);
+	ColumnProjection projection(pipeline.getRoot(), numColumns);
+	Benchmark::printHeader("Executing the example pipeline on " + std::to_string(projection.getNumColumns()) + " of the " + std::to_string(numColumns) + " columns of a recording of " + std::to_string(numSamples) + " samples");
+	
+	double sum = 0.0;
+	double projectedSum = 0.0;
+	double seconds = measureLoad("DataSet, every column", numSamples, [&](){
+		DataSet dataSet(fileName);
+		sum = executeDataSet(dataSet, false);
+	});
+	double projectedSeconds = measureLoad("DataSet, projected", numSamples, [&](){
+		DataSet dataSet(fileName, projection.getColumns());
+		projectedSum = executeDataSet(dataSet, true);
+	});
+	Benchmark::printSpeedup("speedup projected / every column", seconds, projectedSeconds);
+	bool match = (sum == projectedSum);
+	
+	seconds = measureLoad("DataSetReader, .arf, every column", numSamples, [&](){
+		sum = executeReader(fileName, false);
+	});
+	projectedSeconds = measureLoad("DataSetReader, .arf, projected", numSamples, [&](){
+		projectedSum = executeReader(fileName, true);
+	});
+	Benchmark::printSpeedup("speedup projected / every column", seconds, projectedSeconds);
+	match = match && (sum == projectedSum);
+	
+	seconds = measureLoad("DataSetReader, compressed, every column", numSamples, [&](){
+		sum = executeReader(compressedFileName, false);
+	});
+	projectedSeconds = measureLoad("DataSetReader, compressed, projected", numSamples, [&](){
+		projectedSum = executeReader(compressedFileName, true);
+	});
+	Benchmark::printSpeedup("speedup projected / every column", seconds, projectedSeconds);
+	match = match && (sum == projectedSum);
+	std::cout << "outputs " << (match ? "match" : "DO NOT match") << std::endl;
+	
+	remove(fileName.c_str());
+	remove(compressedFileName.c_str());
+}
@@ -0,0 +1,197 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+#include <mutex>
+#include <thread>
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+using namespace ARF;
+
+//the number of samples in the ring buffer fed by the queue
+static const UINT kRingBufferSize = 300;
+
+/**
+ Pins a thread to a core so that the producer and the consumer run on separate cores. Does nothing on machines with fewer cores or on platforms other than Linux
+ 
+ @param thread the thread to pin
+ @param coreIdx the index of the core
+ */
+static void pinThread(std::thread &thread, UINT coreIdx){
+#ifdef __linux__
+	if(coreIdx < std::thread::hardware_concurrency()){
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(coreIdx, &cpuSet);
+		pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+	}
+#endif
+}
+
+/**
+ Transfers samples from a producer thread to a RingBufferAlgorithm filled by a consumer thread through a SampleQueue
+ 
+ @param values the values of the samples, numChannels consecutive values per sample
+ @param numSamples the number of samples to transfer
+ @param batchSize the number of samples pushed at once by the producer
+ @return the sum of the first value of the last sample added to the ring buffer after every batch, to check the outputs
+ */
+static double transferThroughQueue(const Float * values, UINT numSamples, UINT numChannels, UINT batchSize, bool blocking){
+	SampleQueue queue(1024, numChannels, blocking);
+	RingBufferAlgorithm ringBufferAlgorithm(kRingBufferSize);
+	
+	std::thread producer([&](){
+		UINT numPushed = 0;
+		while(numPushed < numSamples){
+			UINT numBatchSamples = std::min(batchSize, numSamples - numPushed);
+			UINT numBatchPushed = queue.push(values + (size_t) numPushed * numChannels, numBatchSamples);
+			if(numBatchPushed == 0){
+				std::this_thread::yield();
+			}
+			numPushed += numBatchPushed;
+		}
+		queue.close();
+	});
+	pinThread(producer, 1);
+	
+	double sum = 0.0;
+	while(queue.wait()){
+		ringBufferAlgorithm.addSamples(queue);
+		sum += ringBufferAlgorithm.getElementAtIdx(ringBufferAlgorithm.getSize() - 1)[0];
+	}
+	producer.join();
+	return sum;
+}
+
+/**
+ Transfers samples from a producer thread to a RingBufferAlgorithm protected by a mutex, read by a consumer thread
+ 
+ @return the sum of the first value of the last sample in the ring buffer every time the consumer sees new samples
+ */
+static double transferThroughMutex(const Float * values, UINT numSamples, UINT numChannels){
+	std::mutex mutex;
+	RingBufferAlgorithm ringBufferAlgorithm(kRingBufferSize);
+	UINT numAdded = 0;
+	
+	std::thread producer([&](){
+		SensorSample sample(numChannels);
+		for(UINT i = 0 ; i < numSamples ; i++){
+			std::copy(values + (size_t) i * numChannels, values + (size_t) (i + 1) * numChannels, sample.begin());
+			std::lock_guard<std::mutex> lock(mutex);
+			ringBufferAlgorithm.addSample(&sample);
+			numAdded++;
+		}
+	});
+	pinThread(producer, 1);
+	
+	double sum = 0.0;
+	UINT numSeen = 0;
+	while(numSeen < numSamples){
+		std::lock_guard<std::mutex> lock(mutex);
+		if(numAdded > numSeen){
+			numSeen = numAdded;
+			sum += ringBufferAlgorithm.getElementAtIdx(ringBufferAlgorithm.getSize() - 1)[0];
+		}
+	}
+	producer.join();
+	return sum;
+}
+
+/**
+ Sends a sample back and forth between two threads through two SampleQueues
+ 
+ @param numRoundTrips the number of times the sample is sent and received back
+ */
+static void pingPong(UINT numRoundTrips, bool blocking){
+	SampleQueue requests(16, 1, blocking);
+	SampleQueue responses(16, 1, blocking);
+	
+	std::thread echo([&](){
+		const Float * values;
+		while(requests.wait()){
+			requests.acquire(values, 1);
+			while(!responses.push(values)){
+				std::this_thread::yield();
+			}
+			requests.release(1);
+		}
+	});
+	pinThread(echo, 1);
+	
+	for(UINT i = 0 ; i < numRoundTrips ; i++){
+		Float value = (Float) i;
+		requests.push(&value);
+		responses.wait();
+		SensorSample response;
+		responses.pop(response);
+	}
+	requests.close();
+	echo.join();
+}
+
+void runQueueBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numChannels = dataset[0].getSize();
+	const UINT numSamples = 1000000;
+	
+	//the samples of the dataset repeated, as decoded by a producer
+	Vector<Float> values(numSamples * numChannels);
+	for(UINT i = 0 ; i < numSamples ; i++){
+		const SensorSample &sample = dataset[i % dataset.getNumSamples()];
+		std::copy(sample.begin(), sample.end(), values.begin() + (size_t) i * numChannels);
+	}
+	const Float * valuesData = &values[0];
+	
+	Benchmark::printHeader("Sample queue, " + std::to_string(numSamples) + " samples with " + std::to_string(numChannels) + " channels (test.arf), " + std::to_string(std::thread::hardware_concurrency()) + " cores");
+	
+	double mutexSeconds = Benchmark::measure([&](){
+		Benchmark::doNotOptimize(transferThroughMutex(valuesData, numSamples, numChannels));
+	}, 3);
+	Benchmark::printResult("mutex around RingBufferAlgorithm", mutexSeconds, numSamples, "sample");
+	
+	const UINT batchSizes[] = {1, 32};
+	for(UINT batchSize : batchSizes){
+		for(bool blocking : {false, true}){
+			double queueSeconds = Benchmark::measure([&](){
+				Benchmark::doNotOptimize(transferThroughQueue(valuesData, numSamples, numChannels, batchSize, blocking));
+			}, 3);
+			Benchmark::printResult("queue, batches of " + std::to_string(batchSize) + (blocking ? ", futex" : ", polling"), queueSeconds, numSamples, "sample");
+		}
+	}
+	
+	//one-way latency, half of a round trip
+	const UINT numRoundTrips = 20000;
+	for(bool blocking : {false, true}){
+		double pingPongSeconds = Benchmark::measure([&](){
+			pingPong(numRoundTrips, blocking);
+		}, 3);
+		Benchmark::printResult(std::string("latency, ") + (blocking ? "futex" : "polling"), pingPongSeconds / 2, numRoundTrips, "sample");
+	}
+}
@@ -0,0 +1,166 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace ARF;
+
+//the number of times the samples of test.arf are repeated in the recording
+static const UINT kNumRepetitions = 20;
+
+//the number of samples executed by every call to PipelinePlan::executeBlock()
+static const UINT kBlockSize = 4096;
+
+/**
+ Executes the example pipeline on a loaded dataset in blocks of samples
+ 
+ @return the sum of the values output by the pipeline
+ */
+static double executeDataSet(const DataSet &dataSet){
+	ExamplePipeline pipeline(true);
+	PipelinePlan plan(pipeline.getRoot());
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	double sum = 0.0;
+	for(UINT start = 0 ; start < dataSet.getNumSamples() ; start += kBlockSize){
+		UINT numSamples = std::min(kBlockSize, dataSet.getNumSamples() - start);
+		UINT outputCount = plan.executeBlock(&dataSet[start], numSamples, output, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+/**
+ Executes the example pipeline on the blocks of a DataSetReader
+ 
+ @return the sum of the values output by the pipeline
+ */
+static double executeReader(DataSetReader &reader){
+	ExamplePipeline pipeline(true);
+	PipelinePlan plan(pipeline.getRoot());
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	double sum = 0.0;
+	for(UINT numSamples = reader.readBlock() ; numSamples > 0 ; numSamples = reader.readBlock()){
+		UINT outputCount = plan.executeBlock(reader.getBlock(), numSamples, reader.getNumColumns(), reader.getNumColumns(), output, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			sum += ((Value*) output[j])->getValue();
+		}
+	}
+	return sum;
+}
+
+/**
+ Measures a function and prints its duration and the memory it allocated
+ */
+template <typename Function>
+static double measureLoad(const std::string &name, UINT numSamples, Function function){
+	size_t numAllocatedBytes = 0;
+	double seconds = Benchmark::measure([&](){
+		size_t allocatedBytes = AllocationCounter::getNumAllocatedBytes();
+		function();
+		numAllocatedBytes = AllocationCounter::getNumAllocatedBytes() - allocatedBytes;
+	}, 3);
+	Benchmark::printResult(name, seconds, numSamples, "sample");
+	std::cout << "  " << (numAllocatedBytes / 1000) << " kB allocated" << std::endl;
+	return seconds;
+}
+
+void runReaderBenchmark(const std::string &dataDirectory){
+	
+	//a long recording made of the samples of test.arf, in the .arf and CSV formats
+	MappedDataSet testDataSet(dataDirectory + "/test.arf");
+	UINT numColumns = testDataSet.getNumColumns();
+	UINT numSamples = testDataSet.getNumSamples() * kNumRepetitions;
+	const std::string arfFileName = "ReaderBenchmark.arf";
+	const std::string csvFileName = "ReaderBenchmark.csv";
+	{
+		std::ofstream arfFile(arfFileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		arfFile << "DatasetName: recording" << std::endl << "InfoText: " << std::endl;
+		arfFile << "NumDimensions: " << numColumns << std::endl << "TotalNumSamples: " << numSamples << std::endl << "ColumnHeaders:\n";
+		for(UINT j = 0 ; j < numColumns ; j++){
+			arfFile << "\t" << testDataSet.getColumnNames()[j];
+		}
+		arfFile << std::endl;
+		
+		std::ofstream csvFile(csvFileName.c_str(), std::ofstream::out);
+		csvFile.precision(9);
+		for(UINT r = 0 ; r < kNumRepetitions ; r++){
+			arfFile.write(reinterpret_cast<const char*>(testDataSet.getRow(0)), (size_t) testDataSet.getNumSamples() * numColumns * sizeof(Float));
+			for(UINT i = 0 ; i < testDataSet.getNumSamples() ; i++){
+				for(UINT j = 0 ; j < numColumns ; j++){
+					csvFile << testDataSet.getValue(i, j) << ((j + 1 < numColumns) ? "," : "\n");
+				}
+			}
+		}
+	}
+	
+	Benchmark::printHeader("Executing the example pipeline on a recording of " + std::to_string(numSamples) + " samples, in blocks of " + std::to_string(kBlockSize));
+	
+	double dataSetSum = 0.0;
+	double arfDataSetSeconds = measureLoad("DataSet, .arf", numSamples, [&](){
+		DataSet dataSet(arfFileName);
+		dataSetSum = executeDataSet(dataSet);
+	});
+	double readerSum = 0.0;
+	double arfReaderSeconds = measureLoad("DataSetReader, .arf", numSamples, [&](){
+		DataSetReader reader(arfFileName, kBlockSize);
+		readerSum = executeReader(reader);
+	});
+	Benchmark::printSpeedup("speedup DataSetReader / DataSet", arfDataSetSeconds, arfReaderSeconds);
+	bool match = (dataSetSum == readerSum);
+	
+	double csvDataSetSeconds = measureLoad("DataSet, CSV", numSamples, [&](){
+		DataSet dataSet(csvFileName);
+		dataSetSum = executeDataSet(dataSet);
+	});
+	double csvReaderSum = 0.0;
+	double csvReaderSeconds = measureLoad("DataSetReader, CSV", numSamples, [&](){
+		DataSetReader reader(csvFileName, kBlockSize);
+		csvReaderSum = executeReader(reader);
+	});
+	Benchmark::printSpeedup("speedup DataSetReader / DataSet", csvDataSetSeconds, csvReaderSeconds);
+	match = match && (dataSetSum == csvReaderSum);
+	
+	//replaying the second half of the recording
+	DataSetReader reader(arfFileName, kBlockSize);
+	double seekSeconds = Benchmark::measure([&](){
+		reader.seek(numSamples / 2);
+		Benchmark::doNotOptimize(executeReader(reader));
+	}, 3);
+	Benchmark::printResult("DataSetReader, .arf from the middle", seekSeconds, numSamples - numSamples / 2, "sample");
+	std::cout << "outputs " << (match ? "match" : "DO NOT match") << std::endl;
+	
+	remove(arfFileName.c_str());
+	remove(csvFileName.c_str());
+}
@@ -0,0 +1,109 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+struct ResamplingFactor {
+	UINT interpolation;
+	UINT decimation;
+};
+
+static const ResamplingFactor kFactors[] = {{1, 2}, {1, 4}, {1, 8}, {3, 8}};
+
+//the number of times the dataset is processed by each measurement
+static const UINT kNumRepetitions = 20;
+
+/**
+ Executes the example pipeline with all its branches on the samples of the dataset, after a Resampler of the columns unless factor is NULL
+ 
+ @return the number of outputs of the pipeline
+ */
+static UINT executePipeline(const DataSet &dataset, const ResamplingFactor * factor, const Vector<uint8_t> &columns){
+	ExamplePipeline pipeline(true);
+	Algorithm * root = pipeline.getRoot();
+	Resampler resampler((factor == nullptr) ? 1 : factor->interpolation, (factor == nullptr) ? 1 : factor->decimation, columns);
+	if(factor != nullptr){
+		resampler << pipeline.ringBufferAlgorithm;
+		root = &resampler;
+	}
+	PipelinePlan plan(root);
+	Vector<Data*> output(plan.getNumLeaves());
+	UINT numOutputs = 0;
+	
+	for(UINT repetition = 0 ; repetition < kNumRepetitions ; repetition++){
+		for(UINT i = 0 ; i < dataset.getNumSamples() ; i++){
+			numOutputs += plan.execute((Data*) &dataset[i], output);
+		}
+	}
+	return numOutputs;
+}
+
+void runResamplerBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numSamples = dataset.getNumSamples() * kNumRepetitions;
+	Vector<uint8_t> columns;
+	for(uint8_t column : {0, 1, 2}){
+		columns.push_back(column);
+	}
+	
+	Benchmark::printHeader("Pipeline with all feature branches after a Resampler of the 3 accelerometer axes (test.arf)");
+	
+	UINT numOutputs = 0;
+	double baselineSeconds = Benchmark::measure([&](){
+		numOutputs = executePipeline(dataset, nullptr, columns);
+	});
+	Benchmark::printResult("no resampling", baselineSeconds, numSamples, "input");
+	std::cout << "no resampling outputs: " << numOutputs << std::endl;
+	
+	for(const ResamplingFactor & factor : kFactors){
+		std::string name = std::to_string(factor.interpolation) + "/" + std::to_string(factor.decimation);
+		Resampler resampler(factor.interpolation, factor.decimation, columns);
+		
+		double seconds = Benchmark::measure([&](){
+			numOutputs = executePipeline(dataset, &factor, columns);
+		});
+		
+		//the cost of the resampler alone
+		ExecutionContext context;
+		double resamplerSeconds = Benchmark::measure([&](){
+			resampler.reset();
+			for(UINT repetition = 0 ; repetition < kNumRepetitions ; repetition++){
+				for(UINT i = 0 ; i < dataset.getNumSamples() ; i++){
+					Benchmark::doNotOptimize(resampler.execute((Data*) &dataset[i], context));
+				}
+			}
+		});
+		
+		Benchmark::printResult("resampling " + name + " (" + std::to_string(resampler.getNumTapsPerPhase()) + " taps)", seconds, numSamples, "input");
+		Benchmark::printResult("resampling " + name + " Resampler alone", resamplerSeconds, numSamples, "input");
+		Benchmark::printSpeedup("resampling " + name + " speedup", baselineSeconds, seconds);
+		std::cout << "resampling " << name << " outputs: " << numOutputs << std::endl;
+	}
+}
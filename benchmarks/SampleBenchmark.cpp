@@ -0,0 +1,136 @@
+/** 
+ ARF MIT License
+ Copyright (c) <2019> <Juan Haladjian>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the number of samples in the ring buffers
+static const UINT kBufferSize = 3000;
+
+//the number of channels of the samples in test.arf
+static const UINT kNumChannels = 16;
+
+typedef FixedSensorSample<kNumChannels> FixedSample;
+
+/**
+ Fills a ring buffer with samples
+ 
+ @param samples the samples added to the ring buffer, repeated until it is full
+ @param ringBuffer the ring buffer
+ */
+template <typename T>
+static void fillRingBuffer(const Vector<T> &samples, RingBuffer<T> &ringBuffer){
+	for(UINT i = 0 ; i < kBufferSize ; i++){
+		ringBuffer.add(samples[i % samples.getSize()]);
+	}
+}
+
+/**
+ Computes the mean of every channel of a ring buffer through a DataIterator
+ 
+ @return the sum of the means
+ */
+static double computeMeans(const IterableValues * iterable){
+	double sum = 0.0;
+	for(UINT i = 0 ; i < kNumChannels ; i++){
+		DataIterator iterator(iterable, 0, kBufferSize - 1, Vector<uint8_t>(1, (uint8_t) i));
+		sum += Mean::Compute(iterator);
+	}
+	return sum;
+}
+
+void runSampleBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	Vector<SensorSample> samples(dataset.getNumSamples());
+	for(UINT i = 0 ; i < dataset.getNumSamples() ; i++){
+		samples[i] = dataset[i];
+	}
+	Vector<FixedSample> fixedSamples;
+	if(!dataset.getFixedSamples(fixedSamples)){
+		std::cout << "test.arf does not have " << kNumChannels << " channels" << std::endl;
+		return;
+	}
+	
+	Benchmark::printHeader("Fixed sensor samples, " + std::to_string(kBufferSize) + " samples with " + std::to_string(kNumChannels) + " channels (test.arf)");
+	
+	//the memory allocated by the creation of every ring buffer and by filling it
+	size_t startBytes = AllocationCounter::getNumAllocatedBytes();
+	size_t startAllocations = AllocationCounter::getNumAllocations();
+	RingBuffer<SensorSample> ringBuffer(kBufferSize);
+	fillRingBuffer(samples, ringBuffer);
+	size_t numBytes = AllocationCounter::getNumAllocatedBytes() - startBytes;
+	size_t numAllocations = AllocationCounter::getNumAllocations() - startAllocations;
+	
+	startBytes = AllocationCounter::getNumAllocatedBytes();
+	startAllocations = AllocationCounter::getNumAllocations();
+	RingBuffer<FixedSample> fixedRingBuffer(kBufferSize);
+	fillRingBuffer(fixedSamples, fixedRingBuffer);
+	size_t numFixedBytes = AllocationCounter::getNumAllocatedBytes() - startBytes;
+	size_t numFixedAllocations = AllocationCounter::getNumAllocations() - startAllocations;
+	
+	std::cout << "RingBuffer<SensorSample>: " << numBytes << " bytes in " << numAllocations << " allocations ("
+	<< sizeof(SensorSample) << " bytes per sample + " << kNumChannels * sizeof(Float) << " bytes of values)" << std::endl;
+	std::cout << "RingBuffer<FixedSensorSample<" << kNumChannels << "> >: " << numFixedBytes << " bytes in " << numFixedAllocations << " allocations ("
+	<< sizeof(FixedSample) << " bytes per sample)" << std::endl;
+	
+	const UINT numAdds = 1000000;
+	double addSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			ringBuffer.add(samples[i % samples.getSize()]);
+		}
+	});
+	double fixedAddSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numAdds ; i++){
+			fixedRingBuffer.add(fixedSamples[i % fixedSamples.getSize()]);
+		}
+	});
+	
+	double sum = 0.0;
+	double fixedSum = 0.0;
+	const UINT numRepetitions = 100;
+	double meanSeconds = Benchmark::measure([&](){
+		sum = 0.0;
+		for(UINT i = 0 ; i < numRepetitions ; i++){
+			sum += computeMeans(&ringBuffer);
+		}
+	});
+	double fixedMeanSeconds = Benchmark::measure([&](){
+		fixedSum = 0.0;
+		for(UINT i = 0 ; i < numRepetitions ; i++){
+			fixedSum += computeMeans(&fixedRingBuffer);
+		}
+	});
+	
+	Benchmark::printResult("add, RingBuffer<SensorSample>", addSeconds, numAdds, "sample");
+	Benchmark::printResult("add, RingBuffer<FixedSensorSample>", fixedAddSeconds, numAdds, "sample");
+	Benchmark::printResult("means through DataIterator, SensorSample", meanSeconds, numRepetitions * kNumChannels, "window");
+	Benchmark::printResult("means through DataIterator, FixedSensorSample", fixedMeanSeconds, numRepetitions * kNumChannels, "window");
+	Benchmark::printSpeedup("speedup FixedSensorSample / SensorSample", meanSeconds, fixedMeanSeconds);
+	std::cout << "outputs " << ((sum == fixedSum) ? "match" : "DO NOT match") << std::endl;
+}
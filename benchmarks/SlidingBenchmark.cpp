@@ -0,0 +1,96 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//a sliding window of 512 samples notified every 32 samples
+static const UINT kWindowSize = 512;
+static const UINT kHopSize = 32;
+
+void runSlidingBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	const UINT numSamples = 200000;
+	const UINT numNotifications = (numSamples - kWindowSize + 1) / kHopSize;
+	
+	//the mean, STD and minimum of the first channel recomputed over the window at every notification
+	RingBufferAlgorithm windowRingBuffer(kWindowSize, kHopSize);
+	DataSelector selector(windowRingBuffer, 0, kWindowSize - 1, {0});
+	Mean mean;
+	STD std;
+	Minimum minimum;
+	windowRingBuffer << selector;
+	selector << mean;
+	selector << std;
+	selector << minimum;
+	PipelinePlan windowPlan(&windowRingBuffer);
+	
+	//the same features read from the statistics updated as samples are added
+	RingBufferAlgorithm slidingRingBuffer(kWindowSize, kHopSize);
+	SlidingFeature slidingMean(slidingRingBuffer, 0, Statistics::kMean);
+	SlidingFeature slidingSTD(slidingRingBuffer, 0, Statistics::kSTD);
+	SlidingFeature slidingMinimum(slidingRingBuffer, 0, Statistics::kMinimum);
+	slidingRingBuffer << slidingMean;
+	slidingRingBuffer << slidingSTD;
+	slidingRingBuffer << slidingMinimum;
+	PipelinePlan slidingPlan(&slidingRingBuffer);
+	
+	Benchmark::printHeader("Sliding window of " + std::to_string(kWindowSize) + " samples notified every " + std::to_string(kHopSize) + " samples, mean, STD and minimum (test.arf)");
+	
+	Vector<Data*> output(3);
+	double windowSum = 0.0;
+	double windowSeconds = Benchmark::measure([&](){
+		windowSum = 0.0;
+		for(UINT i = 0 ; i < numSamples ; i++){
+			if(windowPlan.execute(&dataset[i % dataset.getNumSamples()], output) > 0){
+				for(UINT j = 0 ; j < 3 ; j++){
+					windowSum += ((Value*) output[j])->getValue();
+				}
+			}
+		}
+	}, 1);
+	
+	double slidingSum = 0.0;
+	double slidingSeconds = Benchmark::measure([&](){
+		slidingSum = 0.0;
+		for(UINT i = 0 ; i < numSamples ; i++){
+			if(slidingPlan.execute(&dataset[i % dataset.getNumSamples()], output) > 0){
+				for(UINT j = 0 ; j < 3 ; j++){
+					slidingSum += ((Value*) output[j])->getValue();
+				}
+			}
+		}
+	}, 1);
+	
+	Benchmark::printResult("features recomputed over the window", windowSeconds, numNotifications, "notification");
+	Benchmark::printResult("sliding features", slidingSeconds, numNotifications, "notification");
+	Benchmark::printResult("features recomputed over the window", windowSeconds, numSamples, "sample");
+	Benchmark::printResult("sliding features", slidingSeconds, numSamples, "sample");
+	Benchmark::printSpeedup("speedup sliding / recomputed", windowSeconds, slidingSeconds);
+	std::cout << "outputs " << (std::abs(windowSum - slidingSum) < 1e-4 * std::abs(windowSum) + 1e-3 ? "match" : "DO NOT match") << std::endl;
+}
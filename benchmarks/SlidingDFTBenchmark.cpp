@@ -0,0 +1,116 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the sizes of the windows the power of the frequencies is computed over
+static const UINT kWindowSizes[] = {128, 256, 512, 1024};
+
+//the number of samples of each measurement
+static const UINT kNumSamples = 20000;
+
+//the sampling rate of test.arf
+static const Float kSampleRate = 100.0f;
+
+void runSlidingDFTBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	
+	//4 frequencies, each one in its own band of the SpectralFeatures
+	Vector<Float> frequencies, bandEdges;
+	for(Float frequency : {2.0f, 5.0f, 12.5f, 25.0f}){
+		frequencies.push_back(frequency);
+	}
+	for(Float edge : {1.5f, 2.5f, 4.5f, 5.5f, 12.0f, 13.0f, 24.5f, 25.5f}){
+		bandEdges.push_back(edge);
+	}
+	
+	Benchmark::printHeader("Power of 4 frequencies on every sample, SlidingDFT vs an FFT of the window on every sample (test.arf)");
+	
+	for(UINT windowSize : kWindowSizes){
+		
+		std::string prefix = std::to_string(windowSize) + " ";
+		RingBuffer<SensorSample> ringBuffer(windowSize);
+		for(UINT i = 0 ; i < windowSize ; i++){
+			ringBuffer.add(dataset[i % dataset.getNumSamples()]);
+		}
+		
+		SlidingDFT slidingDFT(windowSize, kSampleRate, frequencies, SlidingDFT::kPowers);
+		SpectralFeatures spectralFeatures(windowSize, kSampleRate, SpectralFeatures::kBandPowers, bandEdges);
+		ExecutionContext context;
+		
+		double slidingSeconds = Benchmark::measure([&](){
+			for(UINT i = 0 ; i < kNumSamples ; i++){
+				Value value(dataset[i % dataset.getNumSamples()][0]);
+				Benchmark::doNotOptimize((*(FeatureVector*) slidingDFT.execute(&value, context))[0]);
+				context.reset();
+			}
+		});
+		
+		double fftSeconds = Benchmark::measure([&](){
+			for(UINT i = 0 ; i < kNumSamples ; i++){
+				ringBuffer.add(dataset[i % dataset.getNumSamples()]);
+				DataIterator signal(&ringBuffer, 0, windowSize - 1, Vector<uint8_t>(1, 0));
+				Benchmark::doNotOptimize((*(FeatureVector*) spectralFeatures.execute(&signal, context))[0]);
+				context.reset();
+			}
+		});
+		
+		Benchmark::printResult(prefix + "FFT on every sample", fftSeconds, kNumSamples, "sample");
+		Benchmark::printResult(prefix + "SlidingDFT", slidingSeconds, kNumSamples, "sample");
+		Benchmark::printSpeedup(prefix + "speedup SlidingDFT / FFT", fftSeconds, slidingSeconds);
+	}
+	
+	//the error of the sliding DFT after a long stream, with and without damping
+	const UINT windowSize = 256;
+	const UINT numSamples = 2000000;
+	RingBuffer<SensorSample> ringBuffer(windowSize);
+	SlidingDFT damped(windowSize, kSampleRate, frequencies, SlidingDFT::kPowers);
+	SlidingDFT undamped(windowSize, kSampleRate, frequencies, SlidingDFT::kPowers, 1.0);
+	FeatureVector * dampedPowers = nullptr;
+	FeatureVector * undampedPowers = nullptr;
+	ExecutionContext context;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		const SensorSample & sample = dataset[i % dataset.getNumSamples()];
+		ringBuffer.add(sample);
+		Value value(sample[0]);
+		context.reset();
+		dampedPowers = (FeatureVector*) damped.execute(&value, context);
+		undampedPowers = (FeatureVector*) undamped.execute(&value, context);
+	}
+	
+	DataIterator signal(&ringBuffer, 0, windowSize - 1, Vector<uint8_t>(1, 0));
+	double dampedError = 0.0, undampedError = 0.0;
+	for(UINT i = 0 ; i < frequencies.getSize() ; i++){
+		Float dampedExpected = SlidingDFT::Compute(signal, windowSize, kSampleRate, frequencies[i]);
+		Float undampedExpected = SlidingDFT::Compute(signal, windowSize, kSampleRate, frequencies[i], 1.0);
+		dampedError = std::max(dampedError, std::abs((double) (*dampedPowers)[i] - dampedExpected) / (dampedExpected + 1e-6));
+		undampedError = std::max(undampedError, std::abs((double) (*undampedPowers)[i] - undampedExpected) / (undampedExpected + 1e-6));
+	}
+	std::cout << std::scientific << "relative error after " << numSamples << " samples, damped: " << dampedError << ", undamped: " << undampedError << std::fixed << std::endl;
+}
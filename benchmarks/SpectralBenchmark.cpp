@@ -0,0 +1,149 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "DataSet.h"
+#include <math.h>
+#include <vector>
+
+using namespace ARF;
+
+//the sizes of the windows the spectra are computed on
+static const UINT kWindowSizes[] = {128, 256, 512, 1024, 2048, 4096};
+
+//the number of samples processed by each measurement of the FFT
+static const UINT kNumSamples = 2000000;
+
+//the number of multiplications done by each measurement of the naive DFT
+static const double kNumNaiveOperations = 2e8;
+
+//the sampling rate of test.arf
+static const Float kSampleRate = 100.0f;
+
+/**
+ Computes the power spectrum of a window with the definition of the DFT, which takes O(n^2) operations
+ */
+static void computeNaivePowerSpectrum(const Float * values, UINT size, Float * power){
+	for(UINT k = 0 ; k <= size / 2 ; k++){
+		Float re = 0, im = 0;
+		for(UINT i = 0 ; i < size ; i++){
+			Float angle = (Float) (-2.0 * M_PI * (((size_t) k * i) % size) / size);
+			re += values[i] * cosf(angle);
+			im += values[i] * sinf(angle);
+		}
+		power[k] = re * re + im * im;
+	}
+}
+
+void runSpectralBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	bool match = true;
+	
+	Benchmark::printHeader("Spectral features, FFT vs naive DFT and one FFT for several features (test.arf)");
+	
+	for(UINT windowSize : kWindowSizes){
+		
+		RingBuffer<SensorSample> ringBuffer(windowSize);
+		std::vector<Float> window(windowSize);
+		for(UINT i = 0 ; i < windowSize ; i++){
+			const SensorSample &sample = dataset[i % dataset.getNumSamples()];
+			ringBuffer.add(sample);
+			window[i] = sample[0];
+		}
+		Signal signal(&ringBuffer, 0, windowSize - 1, Vector<uint8_t>(1, 0));
+		std::string prefix = std::to_string(windowSize) + " ";
+		
+		//the power spectrum with the plan and with the naive DFT
+		const FFTPlan & plan = FFTPlan::GetPlan(windowSize);
+		std::vector<Float> values(windowSize), power(plan.getNumBins()), naivePower(plan.getNumBins());
+		UINT numWindows = kNumSamples / windowSize;
+		UINT numNaiveWindows = std::max(1u, (UINT) (kNumNaiveOperations / ((double) windowSize * windowSize)));
+		
+		double fftSeconds = Benchmark::measure([&](){
+			for(UINT i = 0 ; i < numWindows ; i++){
+				std::copy(window.begin(), window.end(), values.begin());
+				plan.computePowerSpectrum(values.data(), power.data());
+				Benchmark::doNotOptimize(power[1]);
+			}
+		});
+		double naiveSeconds = Benchmark::measure([&](){
+			for(UINT i = 0 ; i < numNaiveWindows ; i++){
+				computeNaivePowerSpectrum(window.data(), windowSize, naivePower.data());
+				Benchmark::doNotOptimize(naivePower[1]);
+			}
+		}, 1);
+		for(UINT k = 0 ; k < plan.getNumBins() ; k++){
+			match = match && std::abs(power[k] - naivePower[k]) < 1e-2 * (std::abs(naivePower[k]) + 1.0f);
+		}
+		
+		Benchmark::printResult(prefix + "naive DFT", naiveSeconds, numNaiveWindows, "window");
+		Benchmark::printResult(prefix + "FFTPlan", fftSeconds, numWindows, "window");
+		Benchmark::printSpeedup(prefix + "speedup FFT / naive DFT", naiveSeconds / numNaiveWindows, fftSeconds / numWindows);
+		
+		//three features computed with an FFT each and with a single FFT
+		SpectralFeatures dominantFrequency(windowSize, kSampleRate, SpectralFeatures::kDominantFrequency);
+		SpectralFeatures spectralEnergy(windowSize, kSampleRate, SpectralFeatures::kSpectralEnergy);
+		SpectralFeatures spectralEntropy(windowSize, kSampleRate, SpectralFeatures::kSpectralEntropy);
+		SpectralFeatures * separateAlgorithms[] = {&dominantFrequency, &spectralEnergy, &spectralEntropy};
+		SpectralFeatures combined(windowSize, kSampleRate);
+		ExecutionContext context;
+		double separateSum = 0.0, combinedSum = 0.0;
+		
+		double separateSeconds = Benchmark::measure([&](){
+			separateSum = 0.0;
+			for(UINT i = 0 ; i < numWindows ; i++){
+				for(SpectralFeatures * algorithm : separateAlgorithms){
+					separateSum += (*(FeatureVector*) algorithm->execute(&signal, context))[0];
+				}
+				context.reset();
+			}
+		});
+		double combinedSeconds = Benchmark::measure([&](){
+			combinedSum = 0.0;
+			for(UINT i = 0 ; i < numWindows ; i++){
+				FeatureVector * features = (FeatureVector*) combined.execute(&signal, context);
+				combinedSum += (*features)[0] + (*features)[1] + (*features)[2];
+				context.reset();
+			}
+		});
+		match = match && std::abs(separateSum - combinedSum) < 1e-3 * std::abs(separateSum) + 1e-3;
+		
+		//the allocations in the steady state
+		size_t allocationsBefore = AllocationCounter::getNumAllocations();
+		for(UINT i = 0 ; i < numWindows ; i++){
+			Benchmark::doNotOptimize((*(FeatureVector*) combined.execute(&signal, context))[0]);
+			context.reset();
+		}
+		size_t numAllocations = AllocationCounter::getNumAllocations() - allocationsBefore;
+		
+		Benchmark::printResult(prefix + "3 SpectralFeatures of 1 feature", separateSeconds, numWindows, "window");
+		Benchmark::printResult(prefix + "1 SpectralFeatures of 3 features", combinedSeconds, numWindows, "window");
+		Benchmark::printSpeedup(prefix + "speedup shared FFT / FFT per feature", separateSeconds, combinedSeconds);
+		std::cout << prefix << "allocations per window: " << (double) numAllocations / numWindows << std::endl;
+	}
+	std::cout << "outputs " << (match ? "match" : "DO NOT match") << std::endl;
+}
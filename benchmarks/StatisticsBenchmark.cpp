@@ -0,0 +1,95 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the number of samples in the window the features are computed on
+static const UINT kWindowSize = 300;
+
+void runStatisticsBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numColumns = dataset[0].getSize();
+	const UINT numWindows = 20000;
+	
+	RingBuffer<SensorSample> ringBuffer(kWindowSize);
+	for(UINT i = 0 ; i < kWindowSize ; i++){
+		ringBuffer.add(dataset[i % dataset.getNumSamples()]);
+	}
+	
+	Benchmark::printHeader("Statistics, " + std::to_string(kWindowSize) + " samples of RingBuffer<SensorSample> (test.arf)");
+	
+	Mean mean;
+	STD std;
+	Minimum minimum;
+	ZCR zcr;
+	Algorithm * separateAlgorithms[] = {&mean, &std, &minimum, &zcr};
+	UINT selection = Statistics::kMean | Statistics::kSTD | Statistics::kMinimum | Statistics::kZeroCrossingRate;
+	Statistics fusedStatistics(selection);
+	Statistics allStatistics(Statistics::kAll);
+	ExecutionContext context;
+	
+	double separateSum = 0.0;
+	double separateSeconds = Benchmark::measure([&](){
+		separateSum = 0.0;
+		for(UINT i = 0 ; i < numWindows ; i++){
+			DataIterator signal(&ringBuffer, 0, kWindowSize - 1, Vector<uint8_t>(1, i % numColumns));
+			for(Algorithm * algorithm : separateAlgorithms){
+				separateSum += ((Value*) algorithm->execute(&signal, context))->getValue();
+			}
+			context.reset();
+		}
+	});
+	
+	double fusedSum = 0.0;
+	double fusedSeconds = Benchmark::measure([&](){
+		fusedSum = 0.0;
+		for(UINT i = 0 ; i < numWindows ; i++){
+			DataIterator signal(&ringBuffer, 0, kWindowSize - 1, Vector<uint8_t>(1, i % numColumns));
+			FeatureVector * features = (FeatureVector*) fusedStatistics.execute(&signal, context);
+			for(UINT j = 0 ; j < features->getSize() ; j++){
+				fusedSum += (*features)[j];
+			}
+			context.reset();
+		}
+	});
+	
+	double allSeconds = Benchmark::measure([&](){
+		for(UINT i = 0 ; i < numWindows ; i++){
+			DataIterator signal(&ringBuffer, 0, kWindowSize - 1, Vector<uint8_t>(1, i % numColumns));
+			Benchmark::doNotOptimize((*(FeatureVector*) allStatistics.execute(&signal, context))[0]);
+			context.reset();
+		}
+	});
+	
+	Benchmark::printResult("Mean, STD, Minimum and ZCR algorithms", separateSeconds, numWindows, "window");
+	Benchmark::printResult("Statistics (mean, std, minimum, zcr)", fusedSeconds, numWindows, "window");
+	Benchmark::printResult("Statistics (all 10 statistics)", allSeconds, numWindows, "window");
+	Benchmark::printSpeedup("speedup Statistics / separate algorithms", separateSeconds, fusedSeconds);
+	std::cout << "outputs " << (std::abs(separateSum - fusedSum) < 1e-3 * std::abs(separateSum) + 1e-3 ? "match" : "DO NOT match") << std::endl;
+}
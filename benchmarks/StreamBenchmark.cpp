@@ -0,0 +1,109 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Benchmarks.h"
+#include "Benchmark.h"
+#include "ExamplePipeline.h"
+#include "DataSet.h"
+
+using namespace ARF;
+
+//the number of samples stored per stream
+static const UINT kStreamWindowSize = 64;
+
+//the number of samples of every stream executed in a block
+static const UINT kStreamBlockSize = 16;
+
+//a small pipeline computing a feature over the ring buffer of every stream and detecting peaks in its last sample
+struct StreamPipeline {
+	RingBufferAlgorithm ringBufferAlgorithm;
+	DataSelector windowSelector;
+	DataSelector sampleSelector;
+	Mean mean;
+	Magnitude magnitude;
+	PeakDetector peakDetector;
+	
+	StreamPipeline() : ringBufferAlgorithm(kStreamWindowSize), windowSelector(ringBufferAlgorithm,0,kStreamWindowSize-1,{0}),
+	sampleSelector(ringBufferAlgorithm,kStreamWindowSize-1,kStreamWindowSize-1,{0,1,2}), peakDetector(0.8, 100) {
+		ringBufferAlgorithm << windowSelector << mean;
+		ringBufferAlgorithm << sampleSelector << magnitude << peakDetector;
+	}
+};
+
+static void sumOutputs(void * argument, UINT streamIdx, UINT sampleIdx, Data ** output, UINT numOutputs){
+	Benchmark::doNotOptimize(((Value*) output[0])->getValue());
+}
+
+void runStreamBenchmark(const std::string &dataDirectory){
+	
+	DataSet dataset(dataDirectory + "/test.arf", true);
+	UINT numColumns = dataset[0].getSize();
+	ThreadPool threadPool(ThreadPool::DefaultNumThreads());
+	UINT numWorkers = threadPool.getNumWorkers();
+	
+	//every stream receives the same samples, which are not copied by the blocks
+	Vector<SensorSample> samples(kStreamBlockSize);
+	for(UINT i = 0 ; i < kStreamBlockSize ; i++){
+		samples[i] = dataset[i % dataset.getNumSamples()];
+	}
+	
+	//the values of the samples in a ring buffer are allocated on the heap
+	size_t sampleValuesSize = kStreamWindowSize * numColumns * sizeof(Float);
+	
+	ExamplePipeline examplePipeline;
+	StreamRuntime exampleRuntime(examplePipeline.getRoot(), 1);
+	
+	Benchmark::printHeader("Streams, " + std::to_string(kStreamWindowSize) + " samples per stream in blocks of " + std::to_string(kStreamBlockSize) + ", " + std::to_string(numWorkers) + " workers");
+	std::cout << "state block of the example pipeline (301 samples): " << exampleRuntime.getStateSize() << " bytes + "
+	<< 301 * numColumns * sizeof(Float) << " bytes of sample values" << std::endl;
+	
+	const UINT numStreamsList[] = {1000, 10000, 100000};
+	for(UINT numStreams : numStreamsList){
+		StreamPipeline pipeline;
+		StreamRuntime runtime(&pipeline.ringBufferAlgorithm, numStreams, &threadPool);
+		
+		Vector<StreamRuntime::StreamBlock> blocks(numStreams);
+		for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+			blocks[streamIdx].streamIdx = streamIdx;
+			blocks[streamIdx].samples = samples.getData();
+			blocks[streamIdx].numSamples = kStreamBlockSize;
+		}
+		
+		//fill the ring buffers so that the measurement reflects the steady state
+		for(UINT i = 0 ; i < kStreamWindowSize / kStreamBlockSize ; i++){
+			runtime.execute(blocks.getData(), numStreams, sumOutputs, nullptr);
+		}
+		
+		double seconds = Benchmark::measure([&](){
+			runtime.execute(blocks.getData(), numStreams, sumOutputs, nullptr);
+		}, 3);
+		
+		double numSamples = (double) numStreams * kStreamBlockSize;
+		std::string name = std::to_string(numStreams) + " streams";
+		Benchmark::printResult(name, seconds, numSamples, "sample");
+		std::cout << std::left << std::setw(48) << (name + " memory") << std::right << std::fixed
+		<< std::setw(12) << std::setprecision(0) << (double) (runtime.getStateSize() + sampleValuesSize) << " bytes/stream"
+		<< std::setw(14) << std::setprecision(2) << (numSamples / seconds / numWorkers / 1e6) << " Msample/s/core" << std::endl;
+	}
+}
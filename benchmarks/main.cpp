@@ -0,0 +1,83 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include "Benchmarks.h"
+
+struct BenchmarkEntry {
+	const char * name;
+	void (*run)(const std::string &dataDirectory);
+};
+
+static const BenchmarkEntry benchmarks[] = {
+	{"pipeline", runPipelineBenchmark},
+	{"allocations", runAllocationBenchmark},
+	{"block", runBlockBenchmark},
+	{"parallel", runParallelBenchmark},
+	{"streams", runStreamBenchmark},
+	{"columns", runColumnBenchmark},
+	{"queue", runQueueBenchmark},
+	{"samples", runSampleBenchmark},
+	{"kernels", runKernelBenchmark},
+	{"statistics", runStatisticsBenchmark},
+	{"sliding", runSlidingBenchmark},
+	{"index", runIndexBenchmark},
+	{"spectral", runSpectralBenchmark},
+	{"slidingdft", runSlidingDFTBenchmark},
+	{"filter", runFilterBenchmark},
+	{"resampler", runResamplerBenchmark},
+	{"magnitude", runMagnitudeBenchmark},
+	{"math", runMathBenchmark},
+	{"mapped", runMappedBenchmark},
+	{"csv", runCSVBenchmark},
+	{"reader", runReaderBenchmark},
+	{"compression", runCompressionBenchmark},
+	{"projection", runProjectionBenchmark},
+};
+
+//usage: Benchmarks [benchmarkName] [dataDirectory]
+int main(int argc, const char * argv[]) {
+	
+	std::string filter = (argc > 1) ? argv[1] : "all";
+	std::string dataDirectory = (argc > 2) ? argv[2] : ".";
+	
+	bool found = false;
+	for(const BenchmarkEntry &benchmark : benchmarks){
+		if(filter == "all" || filter == benchmark.name){
+			benchmark.run(dataDirectory);
+			found = true;
+		}
+	}
+	
+	if(!found){
+		std::cout << "Unknown benchmark: " << filter << ". Available benchmarks:" << std::endl;
+		for(const BenchmarkEntry &benchmark : benchmarks){
+			std::cout << "\t" << benchmark.name << std::endl;
+		}
+		return 1;
+	}
+	
+	return 0;
+}
@@ -19,11 +19,13 @@
  */
 
 #include <fstream>
+#include <sstream>
 
 #include "ARF.h"
 #include "DataSet.h"
 #include "Util.h"
-#include "FileParser.h"
+#include "utils/CSVParser.h"
+#include "utils/ThreadPool.h"
 
 
 DataSet::DataSet(const std::string &fileName, const bool loadHeader) : datasetName(fileName), infoText("")
@@ -31,6 +33,11 @@ DataSet::DataSet(const std::string &fileName, const bool loadHeader) : datasetNa
 	load(fileName,loadHeader);
 }
 
+DataSet::DataSet(const std::string &fileName, const ARF::Vector<ARF::UINT> &columns, const bool loadHeader) : datasetName(fileName), infoText(""), selectedColumns(columns)
+{
+	load(fileName,loadHeader);
+}
+
 DataSet::DataSet(const ARF::UINT numDimensions, const std::string & datasetName, const std::string & infoText) : datasetName(datasetName), numDimensions(numDimensions), infoText(infoText), totalNumSamples(0){
 	
 	if(numDimensions > 0) {
@@ -53,6 +60,7 @@ DataSet& DataSet::operator=(const DataSet &rhs){
 		totalNumSamples = rhs.totalNumSamples;
 		columnNames = rhs.columnNames;
 		data = rhs.data;
+		selectedColumns = rhs.selectedColumns;
 	}
 	return *this;
 }
@@ -96,6 +104,33 @@ bool DataSet::setInfoText(const std::string &rhs){
 	return true;
 }
 
+void DataSet::selectColumns(const ARF::Vector<ARF::UINT> &columns){
+	selectedColumns = columns;
+}
+
+ARF::UINT DataSet::checkSelectedColumns(ARF::UINT numFileColumns) const{
+	if(selectedColumns.getSize() == 0){
+		return numFileColumns;
+	}
+	for(ARF::UINT k = 0; k < selectedColumns.getSize(); k++){
+		if(selectedColumns[k] >= numFileColumns || (k > 0 && selectedColumns[k] <= selectedColumns[k-1])){
+			throw ARF::ARFException("DataSet::load() - the selected columns should be columns of the file in increasing order!");
+		}
+	}
+	return selectedColumns.getSize();
+}
+
+void DataSet::selectColumnNames(){
+	if(selectedColumns.getSize() == 0 || columnNames.getSize() == 0){
+		return;
+	}
+	ARF::Vector<std::string> selectedColumnNames(selectedColumns.getSize());
+	for(ARF::UINT k = 0; k < selectedColumns.getSize(); k++){
+		selectedColumnNames[k] = columnNames[selectedColumns[k]];
+	}
+	columnNames = selectedColumnNames;
+}
+
 bool DataSet::save(const std::string &filename) const{
 	
 	//Check if the file should be saved as a csv file
@@ -127,21 +162,27 @@ bool DataSet::saveDatasetToFile(const std::string &filename) const{
 		return false;
 	}
 	
-	file << "DatasetName: " << datasetName << std::endl;
-	file << "InfoText: " << infoText << std::endl;
-	file << "NumDimensions: " << numDimensions << std::endl;
-	file << "TotalNumSamples: " << totalNumSamples << std::endl;
+	std::ostringstream infoHeader, header;
+	infoHeader << "DatasetName: " << datasetName << std::endl;
+	infoHeader << "InfoText: " << infoText;
+	header << std::endl;
+	header << "NumDimensions: " << numDimensions << std::endl;
+	header << "TotalNumSamples: " << totalNumSamples << std::endl;
 
 	//print the headers
-	file << "ColumnHeaders:\n";
+	header << "ColumnHeaders:\n";
 	for(ARF::UINT j=0; j < numDimensions; j++){
 		if(columnNames.getSize() < numDimensions){
-			file << "\t" << "col_" << j + 1;
+			header << "\t" << "col_" << j + 1;
 		} else {
-			file << "\t" << columnNames[j];
+			header << "\t" << columnNames[j];
 		}
 	}
-	file << std::endl;
+	header << std::endl;
+	
+	//the info text is padded with spaces, which the loaders skip, so that the rows start at a multiple of 16 bytes and can be read in place from a MappedDataSet
+	size_t headerSize = infoHeader.str().size() + header.str().size();
+	file << infoHeader.str() << std::string((16 - headerSize % 16) % 16, ' ') << header.str();
 	
 	//write the data
 	for(ARF::UINT i = 0; i < totalNumSamples; i++){
@@ -160,6 +201,20 @@ bool DataSet::saveDatasetToFile(const std::string &filename) const{
 	return true;
 }
 
+bool DataSet::saveCompressedDatasetToFile(const std::string &filename, const ARF::UINT blockSize) const{
+	
+	try{
+		ARF::DataSetWriter writer(filename, numDimensions, datasetName, infoText, columnNames, blockSize);
+		for(ARF::UINT i = 0; i < totalNumSamples; i++){
+			writer.writeSample(&data[i][0]);
+		}
+		writer.close();
+	} catch(ARF::ARFException &exception){
+		return false;
+	}
+	return true;
+}
+
 bool DataSet::loadDatasetFromFile(const std::string &filename){
 	
 	std::ifstream file;
@@ -173,8 +228,31 @@ bool DataSet::loadDatasetFromFile(const std::string &filename){
 	
 	std::string word;
 	
-	//Get the name of the dataset
+	//compressed files are decoded by a DataSetReader
 	file >> word;
+	if(word == "ARFVersion:"){
+		file.close();
+		ARF::DataSetReader reader(filename);
+		if(selectedColumns.getSize() > 0){
+			checkSelectedColumns(reader.getNumColumns());
+			reader.selectColumns(selectedColumns);
+		}
+		datasetName = reader.getDatasetName();
+		infoText = reader.getInfoText();
+		numDimensions = reader.getNumColumns();
+		totalNumSamples = reader.getNumSamples();
+		columnNames = reader.getColumnNames();
+		data.resize(totalNumSamples, ARF::SensorSample(numDimensions));
+		for(ARF::UINT numSamples = reader.readBlock(); numSamples > 0; numSamples = reader.readBlock()){
+			for(ARF::UINT i = 0; i < numSamples; i++){
+				const ARF::Float * row = reader.getRow(i);
+				std::copy(row, row + numDimensions, data[reader.getBlockStart() + i].getData());
+			}
+		}
+		return true;
+	}
+	
+	//Get the name of the dataset
 	if(word != "DatasetName:"){
 		file.close();
 		throw ARF::ARFException("loadDatasetFromFile(const std::string &filename) - failed to find DatasetName header!");
@@ -229,6 +307,12 @@ bool DataSet::loadDatasetFromFile(const std::string &filename){
 	
 	//skip the \n character
 	file.get();
+	
+	//only the selected columns of the rows are kept
+	ARF::UINT numFileColumns = numDimensions;
+	numDimensions = checkSelectedColumns(numFileColumns);
+	selectColumnNames();
+	std::vector<ARF::Float> row(numFileColumns);
 		
 	//Load the data
 	ARF::SensorSample tempSample(numDimensions);
@@ -240,7 +324,14 @@ bool DataSet::loadDatasetFromFile(const std::string &filename){
 		
 		//read the row
 		ARF::Float * dataPointer = sample.getData();
-		file.read(reinterpret_cast<char*>(dataPointer), numDimensions * sizeof(ARF::Float));
+		if(selectedColumns.getSize() == 0){
+			file.read(reinterpret_cast<char*>(dataPointer), numDimensions * sizeof(ARF::Float));
+		} else {
+			file.read(reinterpret_cast<char*>(row.data()), numFileColumns * sizeof(ARF::Float));
+			for(ARF::UINT k = 0; k < numDimensions; k++){
+				dataPointer[k] = row[selectedColumns[k]];
+			}
+		}
 		
 		//save it
 		data[i] = sample;
@@ -297,58 +388,49 @@ bool DataSet::loadDatasetFromCSVFile(const std::string &filename, bool parseColu
 	//Clear any previous data
 	clear();
 	
-	//Parse the CSV file
-	FileParser parser;
-	
-	if(!parser.parseCSVFile(filename,true)){
-		throw ARF::ARFException("loadDatasetFromCSVFile(const std::string &filename) - Failed to parse CSV file!");
-		return false;
-	}
-	
-	if(!parser.getConsistentColumnSize()){
-		throw ARF::ARFException("loadDatasetFromCSVFile(const std::string &filename) - The CSV file does not have a consistent number of columns!");
-		return false;
-	}
+	//Read the CSV file and count its rows
+	ARF::CSVParser parser(filename, parseColumnHeader);
 	
-	if(parser.getColumnSize() <= 1){
+	if(parser.getNumColumns() <= 1){
 		throw ARF::ARFException("loadDatasetFromCSVFile(const std::string &filename) - The CSV file does not have enough columns! It should contain at least two columns!");
 		return false;
 	}
 	
 	//Set the number of dimensions
-	numDimensions = parser.getColumnSize();
-	
-	//Reserve the memory for the data
-	totalNumSamples = parser.getRowSize();
-	ARF::UINT parserOffset = 0;
+	numDimensions = parser.getNumColumns();
+	totalNumSamples = parser.getNumRows();
 	
 	//parse the header names
 	if(parseColumnHeader) {
-		
-		columnNames.resize(numDimensions);
-		for(int i = 0 ; i < numDimensions ; i++) {
-			columnNames[i] = parser[0][i];
-		}
-		totalNumSamples--;
-		parserOffset = 1;
+		columnNames = parser.getColumnNames();
 	}
 
 	data.resize(totalNumSamples, ARF::SensorSample(numDimensions));
 	
-	//Loop over the samples and add them to the data set
-	ARF::UINT j = 0;
-	ARF::UINT n = 0;
+	//Parse the values straight into the samples, in parallel if the file is large
+	std::vector<ARF::Float*> rows(totalNumSamples);
 	for(ARF::UINT i = 0; i < totalNumSamples; i++){
-		
-		//Get the sample data
-		j=0;
-		n=0;
-		while(j != numDimensions){
-			std::string s = parser[i+parserOffset][n];
-			ARF::Float sampleValue = Util::fromString<ARF::Float>(s);
-			data[i][j++] = sampleValue;
-			n++;
+		rows[i] = &data[i][0];
+	}
+	if(parser.getNumChunks() > 1){
+		ARF::ThreadPool threadPool;
+		parser.readRows(rows.data(), &threadPool);
+	} else {
+		parser.readRows(rows.data());
+	}
+	
+	//the rows are parsed whole, the columns that are not selected are dropped afterwards
+	ARF::UINT numSelectedColumns = checkSelectedColumns(numDimensions);
+	if(numSelectedColumns < numDimensions){
+		for(ARF::UINT i = 0; i < totalNumSamples; i++){
+			ARF::SensorSample sample(numSelectedColumns);
+			for(ARF::UINT k = 0; k < numSelectedColumns; k++){
+				sample[k] = data[i][selectedColumns[k]];
+			}
+			data[i] = sample;
 		}
+		numDimensions = numSelectedColumns;
+		selectColumnNames();
 	}
 	
 	return true;
@@ -40,6 +40,15 @@ public:
 	 */
 	DataSet(const std::string &fileName, const bool parseColumnHeader = false);
 	
+	/**
+	 Constructor, creates a data set with only some of the columns of a file loaded, see selectColumns(). Uses the fileName as datasetName
+	 
+	 @param fileName the name of the file to load
+	 @param columns the indices of the columns of the file that are kept, in increasing order
+	 @param parseColumnHeader whether the first row of the data file is a header containing the names of the columns
+	 */
+	DataSet(const std::string &fileName, const ARF::Vector<ARF::UINT> &columns, const bool parseColumnHeader = false);
+	
 	/**
 	 Constructor, sets the name of the dataset and the number of dimensions of the training data.
 	 The name of the dataset should not contain any spaces.
@@ -97,7 +106,16 @@ public:
 	bool saveDatasetToFile(const std::string &filename) const;
 	
 	/**
-	 Loads the labelled classification data from a custom file format.
+	 Saves the labelled classification data to a compressed .arf file written by a DataSetWriter, which can be loaded with loadDatasetFromFile() and read by a DataSetReader
+	 
+	 @param filename the name of the file the data will be saved to
+	 @param blockSize the number of samples compressed together, larger blocks compress better
+	 @return true if the data was saved successfully, false otherwise
+	 */
+	bool saveCompressedDatasetToFile(const std::string &filename, const ARF::UINT blockSize = ARF::DataSetWriter::kDefaultBlockSize) const;
+	
+	/**
+	 Loads the labelled classification data from a custom file format, either uncompressed or compressed by saveCompressedDatasetToFile().
 	 
 	 @param filename the name of the file the data will be loaded from
 	 @return true if the data was loaded successfully, false otherwise
@@ -199,6 +217,13 @@ public:
 	 @return true if the infoText was correctly updated, false otherwise
 	 */
 	bool setInfoText(const std::string &infoText);
+	
+	/**
+	 Keeps only some of the columns of the files loaded by the next calls to load(), like the columns read by a pipeline collected by an ARF::ColumnProjection. The samples then have one value per selected column, and the columns that are not selected are dropped as the rows are read
+	 
+	 @param columns the indices of the columns of the files that are kept, in increasing order, or an empty vector to keep every column
+	 */
+	void selectColumns(const ARF::Vector<ARF::UINT> &columns);
 
 	
 	/**
@@ -223,6 +248,26 @@ public:
 		 return data[i];
 	}
 	
+	/**
+	 Copies the samples of the dataset to FixedSensorSamples, which store their values without allocating memory
+	 
+	 @param samples the vector the samples are copied to, resized to the number of samples in the dataset
+	 @return true if the samples were copied, false if the samples of the dataset do not have N dimensions
+	 */
+	template <ARF::UINT N>
+	bool getFixedSamples(ARF::Vector<ARF::FixedSensorSample<N> > &samples) const{
+		
+		if(numDimensions != N){
+			return false;
+		}
+		
+		samples.resize(totalNumSamples);
+		for(ARF::UINT i = 0 ; i < totalNumSamples ; i++){
+			samples[i] = data[i];
+		}
+		return true;
+	}
+	
 private:
 	std::string datasetName;   ///< The name of the dataset
 	std::string infoText;        ///< Some infoText about the dataset
@@ -230,6 +275,20 @@ private:
 	ARF::UINT totalNumSamples;     ///< The total number of samples in the dataset
 	ARF::Vector<std::string> columnNames;     ///< The names of each column
 	ARF::Vector<ARF::SensorSample> data;  ///< The actual data
+	ARF::Vector<ARF::UINT> selectedColumns; ///< The columns of the files kept by the loaders, or empty to keep every column
+	
+	/**
+	 Checks that the selected columns are columns of a file being loaded
+	 
+	 @param numFileColumns the number of columns of the file
+	 @return the number of columns kept
+	 */
+	ARF::UINT checkSelectedColumns(ARF::UINT numFileColumns) const;
+	
+	/**
+	 Keeps the names of the selected columns of the file loaded
+	 */
+	void selectColumnNames();
 };
 
 #endif //ARF_DATA_SET_H
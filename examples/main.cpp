@@ -82,17 +82,21 @@ int main(int argc, const char * argv[]) {
 	peakDetector << midAzSelector << std;
 	//peakDetector << rightAySelector << zcr;
 	
-	//load some data
-	DataSet dataset = DataSet("test.arf",true);
+	//load only the columns read by the pipeline, ax, ay and az, and make its selectors read them from the projected samples
+	ColumnProjection projection(&ringBufferAlgorithm, DataSetReader("test.arf").getNumFileColumns());
+	projection.apply();
+	DataSet dataset = DataSet("test.arf",projection.getColumns(),true);
 	//DataSet dataset = DataSet("test.txt",true);
 	//dataset.save("1-niklas.arf");
 	
+	//compile the pipeline once, so that executing it on every sample does not allocate memory once it reaches its steady state
+	PipelinePlan plan(&ringBufferAlgorithm);
+	
 	//execute algorithm for each sample
-	Vector<Data*> output(4);
+	Vector<Data*> output(plan.getNumLeaves());
 	for(int i = 0 ; i < dataset.getNumSamples() ; i++){
 		
-		SensorSample sample = dataset[i];
-		UINT outputCount = Algorithm::ExecutePipeline(&ringBufferAlgorithm,&sample,output);
+		UINT outputCount = plan.execute(&dataset[i],output);
 			//printRingBuffer(ringBuffer);
 			//printDataWithIterator(*output);
 		
@@ -0,0 +1,212 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+#include <vector>
+
+using namespace ARF;
+
+static const Float kSampleRate = 100.0f;
+
+static Vector<uint8_t> createColumns(UINT numColumns){
+	Vector<uint8_t> columns;
+	for(UINT i = 0 ; i < numColumns ; i++){
+		columns.push_back(i);
+	}
+	return columns;
+}
+
+/**
+ Filters a sine with one column and returns the amplitude of the output once the filter settled, computed from its RMS over whole periods
+ */
+static Float measureGain(BiquadFilter & filter, Float frequency){
+	SensorSample sample(1);
+	double sumSquares = 0.0;
+	for(UINT i = 0 ; i < 2000 ; i++){
+		sample[0] = sinf(2 * M_PI * frequency * i / kSampleRate);
+		SensorSample * output = (SensorSample*) filter.execute(&sample);
+		if(i >= 1000){
+			sumSquares += (*output)[0] * (*output)[0];
+		}
+		delete output;
+	}
+	return (Float) sqrt(2.0 * sumSquares / 1000);
+}
+
+TEST(BiquadFilter, FrequencyResponse) {
+	for(UINT order : {1, 2, 3, 4}){
+		BiquadFilter lowPass(BiquadFilter::kLowPass, order, kSampleRate, 5.0f, createColumns(1));
+		EXPECT_EQ(lowPass.getSections().size(), (order + 1) / 2);
+		EXPECT_NEAR(measureGain(lowPass, 0.5f), 1.0f, 0.02f) << "order " << order;
+		lowPass.reset();
+		EXPECT_NEAR(measureGain(lowPass, 5.0f), sqrt(0.5f), 0.02f) << "order " << order;
+		lowPass.reset();
+		EXPECT_LT(measureGain(lowPass, 40.0f), pow(0.3f, order)) << "order " << order;
+		
+		BiquadFilter highPass(BiquadFilter::kHighPass, order, kSampleRate, 5.0f, createColumns(1));
+		EXPECT_NEAR(measureGain(highPass, 40.0f), 1.0f, 0.02f) << "order " << order;
+		highPass.reset();
+		EXPECT_NEAR(measureGain(highPass, 5.0f), sqrt(0.5f), 0.02f) << "order " << order;
+		highPass.reset();
+		EXPECT_LT(measureGain(highPass, 0.5f), pow(0.3f, order)) << "order " << order;
+	}
+	
+	BiquadFilter bandPass(BiquadFilter::kBandPass, 4, kSampleRate, 2.0f, createColumns(1), 20.0f);
+	EXPECT_NEAR(measureGain(bandPass, 6.0f), 1.0f, 0.02f);
+	bandPass.reset();
+	EXPECT_LT(measureGain(bandPass, 0.2f), 0.01f);
+	bandPass.reset();
+	EXPECT_LT(measureGain(bandPass, 45.0f), 0.01f);
+}
+
+TEST(BiquadFilter, MatchesReferenceOnEveryInstructionSet) {
+	
+	//16 filtered channels of 18 columns, and a reference filter per channel in double precision
+	const UINT numColumns = 18;
+	const UINT numSamples = 500;
+	Vector<uint8_t> columns;
+	for(UINT i = 1 ; i <= 16 ; i++){
+		columns.push_back(i);
+	}
+	std::vector<SensorSample> samples(numSamples, SensorSample(numColumns));
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			samples[i][j] = sinf(i * 0.05f * (j + 1)) + 0.1f * j;
+		}
+	}
+	
+	BiquadFilter filter(BiquadFilter::kBandPass, 3, kSampleRate, 1.0f, columns, 10.0f);
+	const std::vector<BiquadFilter::Section> & sections = filter.getSections();
+	std::vector<std::vector<double> > expected(numSamples, std::vector<double>(numColumns));
+	for(UINT j = 0 ; j < numColumns ; j++){
+		std::vector<double> z1(sections.size(), 0.0), z2(sections.size(), 0.0);
+		for(UINT i = 0 ; i < numSamples ; i++){
+			double value = samples[i][j];
+			if(j >= 1 && j <= 16){
+				for(UINT s = 0 ; s < sections.size() ; s++){
+					double y = sections[s].b0 * value + z1[s];
+					z1[s] = sections[s].b1 * value - sections[s].a1 * y + z2[s];
+					z2[s] = sections[s].b2 * value - sections[s].a2 * y;
+					value = y;
+				}
+			}
+			expected[i][j] = value;
+		}
+	}
+	
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	for(UINT instructionSet = FeatureKernels::kScalar ; instructionSet <= supportedInstructionSet ; instructionSet++){
+		FeatureKernels::SetInstructionSet(instructionSet);
+		filter.reset();
+		ExecutionContext context;
+		for(UINT i = 0 ; i < numSamples ; i++){
+			SensorSample * output = (SensorSample*) filter.execute(&samples[i], context);
+			ASSERT_EQ(output->getSize(), numColumns);
+			for(UINT j = 0 ; j < numColumns ; j++){
+				ASSERT_NEAR((*output)[j], expected[i][j], 1e-4) << FeatureKernels::GetInstructionSetName(instructionSet) << " sample " << i << " column " << j;
+			}
+		}
+	}
+	FeatureKernels::SetInstructionSet(supportedInstructionSet);
+}
+
+TEST(BiquadFilter, BlocksAndStreams) {
+	const UINT numSamples = 200;
+	std::vector<SensorSample> samples(numSamples, SensorSample(3));
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < 3 ; j++){
+			samples[i][j] = cosf(i * 0.3f + j) + ((i / 20) % 2);
+		}
+	}
+	
+	//sample by sample
+	BiquadFilter filter(BiquadFilter::kLowPass, 4, kSampleRate, 8.0f, createColumns(3));
+	std::vector<SensorSample> expected;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		SensorSample * output = (SensorSample*) filter.execute(&samples[i]);
+		expected.push_back(*output);
+		delete output;
+	}
+	
+	//in place, offline
+	std::vector<SensorSample> offline = samples;
+	filter.reset();
+	filter.filter(offline.data(), 120);
+	filter.filter(offline.data() + 120, numSamples - 120);
+	
+	//in blocks of a PipelinePlan
+	filter.reset();
+	PipelinePlan plan(&filter);
+	Vector<Data*> outputs;
+	Vector<UINT> sampleIndices;
+	std::vector<SensorSample> blocks;
+	for(UINT blockStart = 0 ; blockStart < numSamples ; blockStart += 50){
+		UINT numOutputs = plan.executeBlock(samples.data() + blockStart, 50, outputs, sampleIndices);
+		ASSERT_EQ(numOutputs, 50);
+		for(UINT i = 0 ; i < numOutputs ; i++){
+			blocks.push_back(*(SensorSample*) outputs[i]);
+		}
+	}
+	
+	//two interleaved streams with their own state blocks
+	AlgorithmState algorithmState = {&filter, 0};
+	std::vector<double> stateBlocks[2];
+	for(std::vector<double> & stateBlock : stateBlocks){
+		stateBlock.resize(filter.getStateSize() / sizeof(double) + 1);
+		filter.initializeState(stateBlock.data());
+	}
+	std::vector<SensorSample> streams[2];
+	ExecutionContext context;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT stream = 0 ; stream < 2 ; stream++){
+			context.setStateBlock((char*) stateBlocks[stream].data(), &algorithmState, 1);
+			streams[stream].push_back(*(SensorSample*) filter.execute(&samples[i], context));
+		}
+	}
+	for(std::vector<double> & stateBlock : stateBlocks){
+		filter.destroyState(stateBlock.data());
+	}
+	
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < 3 ; j++){
+			EXPECT_FLOAT_EQ(offline[i][j], expected[i][j]);
+			EXPECT_FLOAT_EQ(blocks[i][j], expected[i][j]);
+			EXPECT_FLOAT_EQ(streams[0][i][j], expected[i][j]);
+			EXPECT_FLOAT_EQ(streams[1][i][j], expected[i][j]);
+		}
+	}
+}
+
+TEST(BiquadFilter, InvalidParameters) {
+	EXPECT_THROW(BiquadFilter(3, 2, kSampleRate, 5.0f, createColumns(1)), ARFException);
+	EXPECT_THROW(BiquadFilter(BiquadFilter::kLowPass, 0, kSampleRate, 5.0f, createColumns(1)), ARFException);
+	EXPECT_THROW(BiquadFilter(BiquadFilter::kLowPass, 2, kSampleRate, 60.0f, createColumns(1)), ARFException);
+	EXPECT_THROW(BiquadFilter(BiquadFilter::kBandPass, 2, kSampleRate, 5.0f, createColumns(1), 2.0f), ARFException);
+	
+	BiquadFilter filter(BiquadFilter::kLowPass, 2, kSampleRate, 5.0f, createColumns(4));
+	SensorSample sample(3);
+	ExecutionContext context;
+	EXPECT_THROW(filter.execute(&sample, context), ARFException);
+}
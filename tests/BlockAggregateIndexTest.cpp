@@ -0,0 +1,103 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+static SensorSample createSample(UINT sampleIdx){
+	SensorSample sample(2);
+	sample[0] = sinf(sampleIdx * 0.7f) * 3.0f + 50.0f;
+	sample[1] = (Float) ((sampleIdx * 13) % 17);
+	return sample;
+}
+
+static RangeAggregate computeAggregate(const RingBuffer<SensorSample> & ringBuffer, UINT colIdx, UINT startRow, UINT endRow){
+	RangeAggregate aggregate;
+	for(UINT i = startRow ; i <= endRow ; i++){
+		aggregate.add(ringBuffer.getValue(i, colIdx));
+	}
+	return aggregate;
+}
+
+TEST(BlockAggregateIndex, RangesMatchRecomputation) {
+	
+	//a capacity that is not a multiple of the block size, and an index created after the first samples
+	RingBuffer<SensorSample> ringBuffer(50);
+	RangeAggregate aggregate;
+	for(UINT sampleIdx = 0 ; sampleIdx < 130 ; sampleIdx++){
+		if(sampleIdx == 20){
+			EXPECT_FALSE(ringBuffer.getRangeAggregate(0, 0, 10, aggregate));
+			ringBuffer.createIndex(2, 8);
+		}
+		ringBuffer.add(createSample(sampleIdx));
+		if(sampleIdx < 20){
+			continue;
+		}
+		
+		UINT size = ringBuffer.getSize();
+		for(UINT startRow = 0 ; startRow < size ; startRow += 3){
+			for(UINT endRow = startRow ; endRow < size ; endRow += 7){
+				for(UINT colIdx = 0 ; colIdx < 2 ; colIdx++){
+					ASSERT_TRUE(ringBuffer.getRangeAggregate(colIdx, startRow, endRow, aggregate));
+					RangeAggregate expected = computeAggregate(ringBuffer, colIdx, startRow, endRow);
+					ASSERT_EQ(aggregate.count, expected.count);
+					EXPECT_NEAR(aggregate.getMean(), expected.getMean(), 1e-4);
+					EXPECT_NEAR(aggregate.getVariance(), expected.getVariance(), 1e-3);
+					EXPECT_EQ(aggregate.minimum, expected.minimum);
+					EXPECT_EQ(aggregate.maximum, expected.maximum);
+				}
+			}
+		}
+	}
+	
+	EXPECT_FALSE(ringBuffer.getRangeAggregate(2, 0, 10, aggregate));
+	EXPECT_FALSE(ringBuffer.getRangeAggregate(0, 10, 50, aggregate));
+	
+	RingBuffer<SensorSample> copy(ringBuffer);
+	ASSERT_TRUE(copy.getRangeAggregate(1, 5, 45, aggregate));
+	EXPECT_EQ(aggregate.minimum, computeAggregate(ringBuffer, 1, 5, 45).minimum);
+}
+
+TEST(BlockAggregateIndex, FeaturesUseIndex) {
+	RingBufferAlgorithm indexedRingBuffer(40);
+	RingBufferAlgorithm ringBuffer(40);
+	indexedRingBuffer.createIndex(2, 4);
+	
+	for(UINT sampleIdx = 0 ; sampleIdx < 95 ; sampleIdx++){
+		SensorSample sample = createSample(sampleIdx);
+		indexedRingBuffer.addSample(&sample);
+		ringBuffer.addSample(&sample);
+	}
+	
+	Signal indexedSignal(indexedRingBuffer.getIterable(), 7, 33, Vector<uint8_t>(1, 0));
+	Signal signal(ringBuffer.getIterable(), 7, 33, Vector<uint8_t>(1, 0));
+	RangeAggregate aggregate;
+	EXPECT_TRUE(indexedSignal.getAggregate(aggregate));
+	EXPECT_FALSE(signal.getAggregate(aggregate));
+	EXPECT_NEAR(Mean::Compute(indexedSignal), Mean::Compute(signal), 1e-4);
+	EXPECT_NEAR(STD::Compute(indexedSignal), STD::Compute(signal), 1e-4);
+	EXPECT_EQ(Minimum::Compute(indexedSignal), Minimum::Compute(signal));
+}
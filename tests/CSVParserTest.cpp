@@ -0,0 +1,153 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include "utils/ThreadPool.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ARF;
+
+//parses a text and returns its values row after row
+static std::vector<Float> ReadValues(const CSVParser &parser, ThreadPool * threadPool = nullptr){
+	std::vector<Float> values(parser.getNumRows() * parser.getNumColumns());
+	std::vector<Float*> rows(parser.getNumRows());
+	for(UINT i = 0 ; i < parser.getNumRows() ; i++){
+		rows[i] = values.data() + i * parser.getNumColumns();
+	}
+	parser.readRows(rows.data(), threadPool);
+	return values;
+}
+
+TEST(CSVParser, ParsesFloatsLikeStrtof) {
+	std::vector<std::string> numbers = {"0", "-0", "1", "-1.5", "+2.25", "0.05688475", "-0.009176254", "12345678.9",
+		"1e10", "1.5E-7", "3.4028235e38", "1e39", "1e-45", "1.17549435e-38", "123456789012345678901234", "0.1000000000000000055511151231257827",
+		"16777217", "33554431", "9007199254740993", ".5", "5.", "inf", "nan"};
+	
+	//random numbers of up to 20 digits with random exponents
+	std::mt19937 generator(1);
+	char number[64];
+	for(UINT i = 0 ; i < 10000 ; i++){
+		snprintf(number, sizeof(number), "%.*g", (int) (generator() % 12) + 1, std::uniform_real_distribution<double>(-1000, 1000)(generator));
+		numbers.push_back(number);
+		snprintf(number, sizeof(number), "%llue%d", (unsigned long long) generator() * generator(), (int) (generator() % 80) - 40);
+		numbers.push_back(number);
+	}
+	
+	for(const std::string &text : numbers){
+		Float value = 0;
+		const char * end = CSVParser::ParseFloat(text.data(), text.data() + text.size(), value);
+		ASSERT_EQ(end, text.data() + text.size()) << text;
+		Float expected = strtof(text.c_str(), nullptr);
+		if(expected == expected){
+			EXPECT_EQ(value, expected) << text;
+			EXPECT_EQ(signbit(value), signbit(expected)) << text;
+		} else {
+			EXPECT_NE(value, value) << text;
+		}
+	}
+	
+	//the number ends at the first character that is not part of it
+	Float value = 0;
+	std::string text = "-2.5e1,3";
+	EXPECT_EQ(CSVParser::ParseFloat(text.data(), text.data() + text.size(), value), text.data() + 6);
+	EXPECT_EQ(value, -25.0f);
+	text = "4e,";
+	EXPECT_EQ(CSVParser::ParseFloat(text.data(), text.data() + text.size(), value), text.data() + 1);
+	EXPECT_EQ(value, 4.0f);
+	text = ",1";
+	EXPECT_EQ(CSVParser::ParseFloat(text.data(), text.data() + text.size(), value), nullptr);
+	text = "\n1";
+	EXPECT_EQ(CSVParser::ParseFloat(text.data(), text.data() + text.size(), value), nullptr);
+}
+
+TEST(CSVParser, ParsesRowsAndHeader) {
+	std::string text = "ax,ay,az\r\n0.5,-1, 2e-1\r\n3,4.25 ,-5\r\n\r\n";
+	CSVParser parser(text.data(), text.size(), true);
+	ASSERT_EQ(parser.getNumRows(), 2);
+	ASSERT_EQ(parser.getNumColumns(), 3);
+	EXPECT_EQ(parser.getColumnNames()[0], "ax");
+	EXPECT_EQ(parser.getColumnNames()[2], "az");
+	
+	std::vector<Float> values = ReadValues(parser);
+	std::vector<Float> expected = {0.5f, -1.0f, 0.2f, 3.0f, 4.25f, -5.0f};
+	EXPECT_EQ(values, expected);
+	
+	//without a header, and with another delimiter and no new line at the end
+	text = "1\t2\n3\t4";
+	CSVParser tabParser(text.data(), text.size(), false, '\t');
+	ASSERT_EQ(tabParser.getNumRows(), 2);
+	ASSERT_EQ(tabParser.getNumColumns(), 2);
+	expected = {1.0f, 2.0f, 3.0f, 4.0f};
+	EXPECT_EQ(ReadValues(tabParser), expected);
+	
+	CSVParser emptyParser("", 0);
+	EXPECT_EQ(emptyParser.getNumRows(), 0);
+	EXPECT_EQ(ReadValues(emptyParser).size(), 0);
+}
+
+TEST(CSVParser, RejectsInvalidRows) {
+	for(const std::string &text : {std::string("1,2\n3\n"), std::string("1,2\n3,4,5\n"), std::string("1,2\n3,x\n"),
+		std::string("1,2\n\n3,4\n"), std::string("1,2\n3,\n")}){
+		CSVParser parser(text.data(), text.size());
+		EXPECT_THROW(ReadValues(parser), ARFException) << text;
+	}
+	EXPECT_THROW(CSVParser("CSVParserTestMissing.csv"), ARFException);
+}
+
+TEST(CSVParser, ParsesChunksInParallel) {
+	
+	//a text of several chunks
+	std::string text = "a,b,c,d\n";
+	std::mt19937 generator(2);
+	char row[128];
+	UINT numRows = 0;
+	while(text.size() < 3 * CSVParser::kChunkSize + 1000){
+		snprintf(row, sizeof(row), "%.8g,%.8g,%u,%.3e\n", std::uniform_real_distribution<double>(-1, 1)(generator), numRows * 0.25, numRows, std::uniform_real_distribution<double>(-1e6, 1e6)(generator));
+		text += row;
+		numRows++;
+	}
+	
+	CSVParser parser(text.data(), text.size(), true);
+	ASSERT_EQ(parser.getNumRows(), numRows);
+	EXPECT_EQ(parser.getNumChunks(), 4);
+	
+	ThreadPool threadPool(2);
+	std::vector<Float> values = ReadValues(parser, &threadPool);
+	EXPECT_EQ(values, ReadValues(parser));
+	for(UINT i = 0 ; i < numRows ; i++){
+		EXPECT_EQ(values[i * 4 + 2], (Float) i);
+	}
+	
+	//the first invalid row is reported whatever chunk it is in
+	text[text.size() - 3] = 'x';
+	CSVParser invalidParser(text.data(), text.size(), true);
+	EXPECT_THROW(ReadValues(invalidParser, &threadPool), ARFException);
+	
+	std::string newLines = text.substr(0, 1001);
+	EXPECT_EQ(CSVParser::CountNewLines(newLines.data(), newLines.size()), (size_t) std::count(newLines.begin(), newLines.end(), '\n'));
+}
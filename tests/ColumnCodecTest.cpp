@@ -0,0 +1,114 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace ARF;
+
+//encodes the values and checks that they are decoded with the same bits
+static size_t RoundTrip(ColumnCodec &codec, const std::vector<Float> &values){
+	std::vector<uint8_t> encoded;
+	codec.encode(values.data(), (UINT) values.size(), 1, encoded);
+	std::vector<Float> decoded(values.size() + 1, 1.0f);
+	const uint8_t * end = codec.decode(encoded.data(), encoded.data() + encoded.size(), (UINT) values.size(), decoded.data());
+	EXPECT_EQ(end, encoded.data() + encoded.size());
+	EXPECT_TRUE(values.empty() || memcmp(values.data(), decoded.data(), values.size() * sizeof(Float)) == 0);
+	EXPECT_EQ(decoded[values.size()], 1.0f);
+	return encoded.size();
+}
+
+TEST(ColumnCodec, DecodesTheEncodedBits) {
+	ColumnCodec codec;
+	std::mt19937 generator(7);
+	std::normal_distribution<Float> noise(0.0f, 1.0f);
+	
+	//sizes that do not fill the rANS states nor the SIMD loops
+	for(UINT numValues : {0u, 1u, 2u, 15u, 17u, 33u, 1001u, 16384u}){
+		std::vector<Float> values(numValues);
+		for(UINT i = 0 ; i < numValues ; i++){
+			values[i] = std::sin(i * 0.01f) + noise(generator) * 0.01f;
+		}
+		RoundTrip(codec, values);
+	}
+	
+	//special values and random bits, which are stored raw
+	std::vector<Float> special = {0.0f, -0.0f, std::numeric_limits<Float>::infinity(), -std::numeric_limits<Float>::infinity(), std::numeric_limits<Float>::quiet_NaN(), std::numeric_limits<Float>::denorm_min(), std::numeric_limits<Float>::max(), -1.5f};
+	RoundTrip(codec, special);
+	std::vector<Float> randomBits(5000);
+	for(Float &value : randomBits){
+		uint32_t bits = (uint32_t) generator();
+		memcpy(&value, &bits, sizeof(bits));
+	}
+	EXPECT_LE(RoundTrip(codec, randomBits), randomBits.size() * sizeof(Float) + 4);
+	
+	//a constant column is stored in a few hundred bytes, mostly the sizes of the rANS streams
+	std::vector<Float> constant(4096, 9.81f);
+	EXPECT_LT(RoundTrip(codec, constant), 1024);
+	
+	//a strided column
+	std::vector<Float> rows(3 * 100);
+	for(UINT i = 0 ; i < rows.size() ; i++){
+		rows[i] = i * 0.5f;
+	}
+	std::vector<uint8_t> encoded;
+	codec.encode(rows.data() + 1, 100, 3, encoded);
+	std::vector<Float> column(100);
+	ASSERT_NE(codec.decode(encoded.data(), encoded.data() + encoded.size(), 100, column.data()), nullptr);
+	for(UINT i = 0 ; i < 100 ; i++){
+		EXPECT_EQ(column[i], rows[i * 3 + 1]);
+	}
+}
+
+TEST(ColumnCodec, RejectsTruncatedData) {
+	ColumnCodec codec;
+	std::vector<Float> values(2000);
+	for(UINT i = 0 ; i < values.size() ; i++){
+		values[i] = std::cos(i * 0.03f);
+	}
+	std::vector<uint8_t> encoded;
+	codec.encode(values.data(), (UINT) values.size(), 1, encoded);
+	std::vector<Float> decoded(values.size());
+	for(size_t size : {(size_t) 0, (size_t) 1, (size_t) 10, encoded.size() / 2, encoded.size() - 1}){
+		EXPECT_EQ(codec.decode(encoded.data(), encoded.data() + size, (UINT) values.size(), decoded.data()), nullptr);
+	}
+}
+
+TEST(ColumnCodec, ComputesCRC32C) {
+	const char * text = "123456789";
+	EXPECT_EQ(ColumnCodec::Checksum(reinterpret_cast<const uint8_t*>(text), 9), 0xE3069283u);
+	EXPECT_EQ(ColumnCodec::Checksum(nullptr, 0), 0u);
+	
+	//the unaligned start and the end that do not fill 8 bytes
+	std::vector<uint8_t> data(1000);
+	for(UINT i = 0 ; i < data.size() ; i++){
+		data[i] = (uint8_t) (i * 31);
+	}
+	uint32_t checksum = ColumnCodec::Checksum(data.data() + 3, 990);
+	data[500] ^= 1;
+	EXPECT_NE(ColumnCodec::Checksum(data.data() + 3, 990), checksum);
+}
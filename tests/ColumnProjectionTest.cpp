@@ -0,0 +1,271 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ARF;
+
+static Float TestValue(UINT sampleIdx, UINT columnIdx){
+	return sampleIdx * 0.25f + columnIdx * 100;
+}
+
+TEST(ColumnProjection, CollectsTheColumnsOfTheSelectors) {
+	RingBuffer<SensorSample> ringBuffer(301);
+	RingBufferAlgorithm ringBufferAlgorithm(&ringBuffer);
+	DataSelector accelSelector(&ringBuffer, 300, 300, {0, 1, 2});
+	Magnitude magnitude;
+	PeakDetector peakDetector(0.8, 100);
+	DataSelector midAxSelector(&ringBuffer, 60, 150, {0});
+	DataSelector midAzSelector(&ringBuffer, 60, 150, {2});
+	DataSelector rightAySelector(&ringBuffer, 180, 230, {1});
+	Mean mean;
+	STD stdev;
+	ZCR zcr;
+	ringBufferAlgorithm << accelSelector << magnitude << peakDetector;
+	peakDetector << midAzSelector << stdev;
+	peakDetector << midAxSelector << mean;
+	peakDetector << rightAySelector << zcr;
+	
+	ColumnProjection projection(&ringBufferAlgorithm, 16);
+	EXPECT_EQ(projection.getNumSourceColumns(), 16);
+	ASSERT_EQ(projection.getNumColumns(), 3);
+	EXPECT_EQ(projection.getColumns()[2], 2);
+	EXPECT_EQ(projection.getProjectedColumn(1), 1);
+	EXPECT_EQ(projection.getProjectedColumn(3), -1);
+	EXPECT_EQ(projection.getNumAlgorithms(), 4);
+	EXPECT_THROW(projection.getProjectedColumn(16), ARFException);
+	
+	//a pipeline without selectors reads every column
+	RingBufferAlgorithm otherRingBufferAlgorithm(&ringBuffer);
+	ColumnProjection identity(&otherRingBufferAlgorithm, 4);
+	EXPECT_EQ(identity.getNumColumns(), 4);
+	EXPECT_EQ(identity.getNumAlgorithms(), 0);
+	
+	//columns the samples do not have
+	EXPECT_THROW(ColumnProjection(&ringBufferAlgorithm, 2), ARFException);
+}
+
+//two branches, the magnitude of columns 9, 3 and 7 of the last sample and the mean of column 5
+struct TwoBranchPipeline {
+	RingBuffer<SensorSample> ringBuffer;
+	RingBufferAlgorithm ringBufferAlgorithm;
+	DataSelector firstSelector;
+	DataSelector secondSelector;
+	Magnitude magnitude;
+	Mean mean;
+	
+	TwoBranchPipeline() : ringBuffer(10), ringBufferAlgorithm(&ringBuffer, 10),
+	firstSelector(&ringBuffer, 9, 9, {9, 3, 7}), secondSelector(&ringBuffer, 0, 9, {5}){
+		ringBufferAlgorithm << firstSelector << magnitude;
+		ringBufferAlgorithm << secondSelector << mean;
+	}
+};
+
+TEST(ColumnProjection, ExecutesPipelinesOnProjectedSamples) {
+	const UINT numSamples = 200;
+	const UINT numColumns = 12;
+	std::vector<Float> rows(numSamples * numColumns);
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			rows[i * numColumns + j] = TestValue(i, j);
+		}
+	}
+	
+	TwoBranchPipeline pipeline;
+	PipelinePlan plan(&pipeline.ringBufferAlgorithm);
+	Vector<Data*> expectedOutput;
+	Vector<UINT> sampleIndices;
+	UINT expectedCount = plan.executeBlock(rows.data(), numSamples, numColumns, numColumns, expectedOutput, sampleIndices);
+	ASSERT_GT(expectedCount, 0);
+	Vector<Float> expectedMeans;
+	for(UINT k = 0 ; k < expectedCount ; k++){
+		expectedMeans.push_back(((Value*) expectedOutput[k])->getValue());
+	}
+	
+	TwoBranchPipeline projectedPipeline;
+	ColumnProjection projection(&projectedPipeline.ringBufferAlgorithm, numColumns);
+	ASSERT_EQ(projection.getNumColumns(), 4);
+	EXPECT_EQ(projection.getColumns()[0], 3);
+	EXPECT_EQ(projection.getColumns()[1], 5);
+	EXPECT_EQ(projection.getColumns()[3], 9);
+	projection.apply();
+	projection.apply();
+	EXPECT_TRUE(projection.isApplied());
+	EXPECT_EQ(projectedPipeline.firstSelector.getIterableRange().columnIndices[0], 3);
+	EXPECT_EQ(projectedPipeline.firstSelector.getIterableRange().columnIndices[1], 0);
+	EXPECT_EQ(projectedPipeline.firstSelector.getIterableRange().columnIndices[2], 2);
+	EXPECT_EQ(projectedPipeline.secondSelector.getIterableRange().columnIndices[0], 1);
+	
+	//the ring buffer stores the projected samples
+	std::vector<Float> projectedRows(numSamples * projection.getNumColumns());
+	projection.projectRows(rows.data(), numSamples, numColumns, projectedRows.data());
+	PipelinePlan projectedPlan(&projectedPipeline.ringBufferAlgorithm);
+	Vector<Data*> output;
+	UINT outputCount = projectedPlan.executeBlock(projectedRows.data(), numSamples, projection.getNumColumns(), projection.getNumColumns(), output, sampleIndices);
+	ASSERT_EQ(outputCount, expectedCount);
+	for(UINT k = 0 ; k < outputCount ; k++){
+		EXPECT_EQ(((Value*) output[k])->getValue(), expectedMeans[k]);
+	}
+	EXPECT_EQ(projectedPipeline.ringBuffer[0].getSize(), 4);
+	
+	projection.restore();
+	EXPECT_FALSE(projection.isApplied());
+	EXPECT_EQ(projectedPipeline.firstSelector.getIterableRange().columnIndices[0], 9);
+	EXPECT_EQ(projectedPipeline.secondSelector.getIterableRange().columnIndices[0], 5);
+}
+
+//the two branches, with a sliding mean of column 11, which no DataSelector selects, and a DataSelector over an iterable that does not contain the samples
+struct SlidingPipeline : public TwoBranchPipeline {
+	SlidingFeature slidingMean;
+	RingBuffer<SensorSample> otherRingBuffer;
+	DataSelector otherSelector;
+	Mean otherMean;
+	
+	SlidingPipeline() : slidingMean(ringBufferAlgorithm, 11, Statistics::kMean), otherRingBuffer(1), otherSelector(&otherRingBuffer, 0, 0, {20}) {
+		otherRingBuffer.add(SensorSample(21));
+		ringBufferAlgorithm << slidingMean;
+		magnitude << otherSelector << otherMean;
+	}
+};
+
+TEST(ColumnProjection, ProjectsSlidingFeatures) {
+	const UINT numSamples = 200;
+	const UINT numColumns = 12;
+	std::vector<Float> rows(numSamples * numColumns);
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			rows[i * numColumns + j] = TestValue(i, j);
+		}
+	}
+	
+	SlidingPipeline pipeline;
+	PipelinePlan plan(&pipeline.ringBufferAlgorithm);
+	Vector<Data*> expectedOutput;
+	Vector<UINT> sampleIndices;
+	UINT expectedCount = plan.executeBlock(rows.data(), numSamples, numColumns, numColumns, expectedOutput, sampleIndices);
+	ASSERT_GT(expectedCount, 0);
+	Vector<Float> expectedValues;
+	for(UINT k = 0 ; k < expectedCount ; k++){
+		expectedValues.push_back(((Value*) expectedOutput[k])->getValue());
+	}
+	
+	//the selectors, the sliding mean and the ring buffer tracking its column are collected, but not the selector over the other iterable
+	SlidingPipeline projectedPipeline;
+	ColumnProjection projection(&projectedPipeline.ringBufferAlgorithm, numColumns);
+	ASSERT_EQ(projection.getNumColumns(), 5);
+	EXPECT_EQ(projection.getColumns()[4], 11);
+	EXPECT_EQ(projection.getNumAlgorithms(), 4);
+	projection.apply();
+	Vector<uint8_t> columnIndices;
+	ASSERT_TRUE(projectedPipeline.slidingMean.getColumnIndices(columnIndices));
+	EXPECT_EQ(columnIndices[0], 4);
+	ASSERT_TRUE(projectedPipeline.ringBufferAlgorithm.getColumnIndices(columnIndices));
+	EXPECT_EQ(columnIndices[0], 4);
+	EXPECT_EQ(projectedPipeline.otherSelector.getIterableRange().columnIndices[0], 20);
+	
+	std::vector<Float> projectedRows(numSamples * projection.getNumColumns());
+	projection.projectRows(rows.data(), numSamples, numColumns, projectedRows.data());
+	PipelinePlan projectedPlan(&projectedPipeline.ringBufferAlgorithm);
+	Vector<Data*> output;
+	UINT outputCount = projectedPlan.executeBlock(projectedRows.data(), numSamples, projection.getNumColumns(), projection.getNumColumns(), output, sampleIndices);
+	ASSERT_EQ(outputCount, expectedCount);
+	for(UINT k = 0 ; k < outputCount ; k++){
+		EXPECT_EQ(((Value*) output[k])->getValue(), expectedValues[k]);
+	}
+	
+	projection.restore();
+	ASSERT_TRUE(projectedPipeline.slidingMean.getColumnIndices(columnIndices));
+	EXPECT_EQ(columnIndices[0], 11);
+}
+
+TEST(ColumnProjection, ReadsOnlyTheSelectedColumns) {
+	const UINT numColumns = 6;
+	const UINT numSamples = 700;
+	std::vector<Float> rows(numSamples * numColumns);
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			rows[i * numColumns + j] = TestValue(i, j);
+		}
+	}
+	Vector<UINT> columns(2);
+	columns[0] = 1;
+	columns[1] = 4;
+	
+	//an uncompressed and a compressed .arf file and a CSV file of the same rows
+	{
+		std::ofstream file("ColumnProjectionTest.arf", std::ofstream::binary);
+		file << "DatasetName: recording\nInfoText: \nNumDimensions: " << numColumns << "\nTotalNumSamples: " << numSamples << "\nColumnHeaders:\n";
+		for(UINT j = 0 ; j < numColumns ; j++){
+			file << "\tc" << j;
+		}
+		file << "\n";
+		file.write(reinterpret_cast<const char*>(rows.data()), rows.size() * sizeof(Float));
+		
+		std::ofstream csvFile("ColumnProjectionTest.csv");
+		for(UINT i = 0 ; i < numSamples ; i++){
+			for(UINT j = 0 ; j < numColumns ; j++){
+				csvFile << TestValue(i, j) << ((j + 1 < numColumns) ? "," : "\n");
+			}
+		}
+	}
+	{
+		DataSetWriter writer("ColumnProjectionTest.v2.arf", numColumns, "recording", "", Vector<std::string>(), 256);
+		writer.writeSamples(rows.data(), numSamples);
+	}
+	
+	for(const char * fileName : {"ColumnProjectionTest.arf", "ColumnProjectionTest.v2.arf", "ColumnProjectionTest.csv"}){
+		DataSetReader reader(fileName, 100);
+		reader.selectColumns(columns);
+		EXPECT_EQ(reader.getNumColumns(), 2);
+		EXPECT_EQ(reader.getNumFileColumns(), numColumns);
+		if(!reader.isCSV()){
+			EXPECT_EQ(reader.getColumnNames().getSize(), 2);
+			reader.seek(250);
+		}
+		UINT sampleIdx = reader.isCSV() ? 0 : 250;
+		for(UINT n = reader.readBlock() ; n > 0 ; n = reader.readBlock()){
+			for(UINT i = 0 ; i < n ; i++){
+				ASSERT_EQ(reader.getRow(i)[0], TestValue(sampleIdx + i, 1));
+				ASSERT_EQ(reader.getRow(i)[1], TestValue(sampleIdx + i, 4));
+			}
+			sampleIdx += n;
+		}
+		EXPECT_EQ(sampleIdx, numSamples);
+		
+		//invalid selections
+		Vector<UINT> unordered(2);
+		unordered[0] = 4;
+		unordered[1] = 1;
+		EXPECT_THROW(reader.selectColumns(unordered), ARFException);
+		EXPECT_THROW(reader.selectColumns(Vector<UINT>(1, numColumns)), ARFException);
+		EXPECT_THROW(reader.selectColumns(Vector<UINT>()), ARFException);
+	}
+	
+	remove("ColumnProjectionTest.arf");
+	remove("ColumnProjectionTest.v2.arf");
+	remove("ColumnProjectionTest.csv");
+}
@@ -0,0 +1,157 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+
+using namespace ARF;
+
+TEST(ColumnRingBuffer, AddAndWrapAround) {
+	ColumnRingBuffer ringBuffer(4,3);
+	EXPECT_EQ(ringBuffer.getCapacity(),4);
+	EXPECT_EQ(ringBuffer.getNumChannels(),3);
+	
+	//add 6 samples, the first 2 are overwritten
+	for(UINT i = 0 ; i < 6 ; i++){
+		ringBuffer.add(SensorSample(std::vector<float>{(float) i, (float) i * 10, (float) i * 100}));
+	}
+	
+	EXPECT_TRUE(ringBuffer.isFull());
+	EXPECT_EQ(ringBuffer.getSize(),4);
+	for(UINT i = 0 ; i < 4 ; i++){
+		EXPECT_EQ(ringBuffer.getValue(i,0),i + 2);
+		EXPECT_EQ(ringBuffer.getValue(i,2),(i + 2) * 100);
+	}
+	
+	SensorSample sample;
+	ringBuffer.getSample(3,sample);
+	EXPECT_EQ(sample.getSize(),3);
+	EXPECT_EQ(sample[1],50);
+	
+	EXPECT_THROW(ringBuffer.getValue(4,0),ARFException);
+	EXPECT_THROW(ringBuffer.getValue(0,3),ARFException);
+	EXPECT_THROW(ringBuffer.add(SensorSample(2)),ARFException);
+}
+
+TEST(ColumnRingBuffer, ColumnSpan) {
+	ColumnRingBuffer ringBuffer(5,2);
+	for(UINT i = 0 ; i < 3 ; i++){
+		Float values[2] = {(Float) i, -(Float) i};
+		ringBuffer.add(values);
+	}
+	
+	//a range that does not wrap around is a single contiguous part
+	ColumnSpan span = ringBuffer.getColumnSpan(1,0,2);
+	EXPECT_EQ(span.firstSize,3);
+	EXPECT_EQ(span.secondSize,0);
+	EXPECT_EQ(span.first[2],-2);
+	EXPECT_EQ(((size_t) ringBuffer.getColumnData(1)) % 64,0);
+	
+	for(UINT i = 3 ; i < 8 ; i++){
+		Float values[2] = {(Float) i, -(Float) i};
+		ringBuffer.add(values);
+	}
+	
+	//the buffer holds samples 3..7 and its oldest sample is stored at position 3
+	span = ringBuffer.getColumnSpan(0,1,4);
+	EXPECT_EQ(span.getSize(),4);
+	EXPECT_EQ(span.firstSize,1);
+	EXPECT_EQ(span.secondSize,3);
+	for(UINT i = 0 ; i < span.getSize() ; i++){
+		EXPECT_EQ(span[i],i + 4);
+	}
+	
+	EXPECT_THROW(ringBuffer.getColumnSpan(0,2,5),ARFException);
+	EXPECT_THROW(ringBuffer.getColumnSpan(2,0,1),ARFException);
+}
+
+TEST(ColumnRingBuffer, MatchesRingBufferInPipeline) {
+	RingBuffer<SensorSample> ringBuffer(6);
+	ColumnRingBuffer columnRingBuffer(6,3);
+	
+	DataSelector selector(&ringBuffer,1,5,{2});
+	DataSelector columnSelector(&columnRingBuffer,1,5,{2});
+	DataSelector sampleSelector(&ringBuffer,5,5,{0,1,2});
+	DataSelector columnSampleSelector(&columnRingBuffer,5,5,{0,1,2});
+	
+	for(UINT i = 0 ; i < 15 ; i++){
+		SensorSample sample(std::vector<float>{(float) (i % 4), (float) (i % 3) - 1.0f, (float) (i * i % 7) - 3.0f});
+		ringBuffer.add(sample);
+		columnRingBuffer.add(sample);
+		
+		if(ringBuffer.isFull()){
+			DataIterator * iterator = (DataIterator*) selector.execute(nullptr);
+			DataIterator * columnIterator = (DataIterator*) columnSelector.execute(nullptr);
+			EXPECT_FLOAT_EQ(Mean::Compute(*iterator),Mean::Compute(*columnIterator));
+			EXPECT_FLOAT_EQ(STD::Compute(*iterator),STD::Compute(*columnIterator));
+			EXPECT_FLOAT_EQ(ZCR::Compute(*iterator),ZCR::Compute(*columnIterator));
+			delete iterator;
+			delete columnIterator;
+			
+			iterator = (DataIterator*) sampleSelector.execute(nullptr);
+			columnIterator = (DataIterator*) columnSampleSelector.execute(nullptr);
+			EXPECT_FLOAT_EQ(Magnitude::Compute(*iterator),Magnitude::Compute(*columnIterator));
+			delete iterator;
+			delete columnIterator;
+		}
+	}
+}
+
+static void testMirroredWindows(UINT capacity){
+	ColumnRingBuffer ringBuffer(capacity,2,true);
+	EXPECT_TRUE(ringBuffer.isMirrored());
+	
+	for(UINT i = 0 ; i < capacity + capacity / 3 ; i++){
+		Float values[2] = {(Float) i, -(Float) i};
+		ringBuffer.add(values);
+		
+		//every window starting at any sample is contiguous
+		for(UINT startRow = 0 ; startRow < ringBuffer.getSize() ; startRow += 7){
+			ColumnSpan span = ringBuffer.getColumnSpan(1,startRow,ringBuffer.getSize() - 1);
+			EXPECT_EQ(span.secondSize,0);
+			
+			const Float * window = ringBuffer.getColumnWindow(1,startRow);
+			EXPECT_EQ(window,span.first);
+			EXPECT_EQ(window[0],ringBuffer.getValue(startRow,1));
+			EXPECT_EQ(window[ringBuffer.getSize() - startRow - 1],-(Float) i);
+		}
+	}
+	
+	ColumnRingBuffer copy(ringBuffer);
+	EXPECT_EQ(copy.getColumnWindow(0,1)[capacity - 2],ringBuffer.getColumnWindow(0,1)[capacity - 2]);
+}
+
+TEST(ColumnRingBuffer, MirroredWindows) {
+	
+	//columns that are not a multiple of the page size are copied
+	testMirroredWindows(37);
+	EXPECT_FALSE(ColumnRingBuffer(37,2,true).isMapped());
+	
+	//columns that are a multiple of the page size are mapped twice when the platform supports it
+	UINT pageCapacity = (UINT) (MirroredMemory::GetPageSize() / sizeof(Float));
+	testMirroredWindows(pageCapacity);
+	EXPECT_EQ(ColumnRingBuffer(pageCapacity,2,true).isMapped(),MirroredMemory::IsSupported());
+	
+	EXPECT_THROW(ColumnRingBuffer(10,2).getColumnWindow(0,0),ARFException);
+}
@@ -0,0 +1,98 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+
+using namespace ARF;
+
+//counts the number of instances alive
+class Counted : public Data {
+public:
+	static int numInstances;
+	
+	Counted(){ numInstances++; }
+	~Counted(){ numInstances--; }
+	
+	Data * clone() override {
+		return new Counted();
+	}
+};
+
+int Counted::numInstances = 0;
+
+TEST(DataArena, CreateAndReset) {
+	DataArena arena;
+	
+	Value * value = arena.create<Value>(2.5);
+	EXPECT_EQ(value->getValue(),2.5);
+	
+	for(int i = 0 ; i < 10 ; i++){
+		arena.create<Counted>();
+	}
+	EXPECT_EQ(Counted::numInstances,10);
+	
+	arena.reset();
+	EXPECT_EQ(Counted::numInstances,0);
+}
+
+TEST(DataArena, Adopt) {
+	DataArena arena;
+	
+	arena.adopt(new Counted());
+	EXPECT_EQ(Counted::numInstances,1);
+	
+	arena.reset();
+	EXPECT_EQ(Counted::numInstances,0);
+}
+
+TEST(DataArena, ReusesMemoryAfterReset) {
+	DataArena arena(256);
+	
+	for(int i = 0 ; i < 100 ; i++){
+		arena.create<Value>((Float) i);
+	}
+	UINT numAllocations = arena.getNumAllocations();
+	EXPECT_GT(numAllocations,1);
+	
+	for(int j = 0 ; j < 10 ; j++){
+		arena.reset();
+		for(int i = 0 ; i < 100 ; i++){
+			arena.create<Value>((Float) i);
+		}
+	}
+	EXPECT_EQ(arena.getNumAllocations(),numAllocations);
+}
+
+TEST(DataArena, LargeObjects) {
+	DataArena arena(64);
+	
+	char * memory = (char*) arena.allocate(1000);
+	memory[999] = 1;
+	EXPECT_GE(arena.getCapacity(),1000);
+	
+	arena.reset();
+	Value * value = arena.create<Value>(1.0);
+	EXPECT_EQ(value->getValue(),1.0);
+}
@@ -0,0 +1,95 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+
+using namespace ARF;
+
+TEST(DataIterator, SpansOfFixedSamples) {
+	RingBuffer<FixedSensorSample<2> > ringBuffer(5);
+	DataIterator iterator(&ringBuffer,1,3,Vector<uint8_t>(1,1));
+	
+	StridedSpan span;
+	EXPECT_FALSE(iterator.getSpan(span));
+	
+	for(UINT i = 0 ; i < 7 ; i++){
+		FixedSensorSample<2> sample;
+		sample[0] = (Float) i;
+		sample[1] = -(Float) i;
+		ringBuffer.add(sample);
+	}
+	
+	//the buffer holds samples 2..6 and the range of the iterator wraps around its end
+	ASSERT_TRUE(iterator.getSpan(span));
+	EXPECT_EQ(span.getSize(),3);
+	EXPECT_EQ(span.stride,2);
+	EXPECT_EQ(span.firstSize,2);
+	EXPECT_EQ(span.secondSize,1);
+	for(UINT i = 0 ; i < 3 ; i++){
+		EXPECT_EQ(span[i],iterator[i]);
+		EXPECT_EQ(span[i],-(Float) (i + 3));
+	}
+	
+	//several columns, a column out of bounds and samples that do not store their values have no span
+	EXPECT_FALSE(DataIterator(&ringBuffer,1,3,Vector<uint8_t>(2,0)).getSpan(span));
+	EXPECT_FALSE(DataIterator(&ringBuffer,1,3,Vector<uint8_t>(1,2)).getSpan(span));
+	RingBuffer<SensorSample> sensorRingBuffer(5);
+	sensorRingBuffer.add(SensorSample(2));
+	EXPECT_FALSE(DataIterator(&sensorRingBuffer,0,0,Vector<uint8_t>(1,0)).getSpan(span));
+}
+
+TEST(DataIterator, FeaturesMatchCheckedAccess) {
+	RingBuffer<SensorSample> ringBuffer(7);
+	RingBuffer<FixedSensorSample<3> > fixedRingBuffer(7);
+	ColumnRingBuffer columnRingBuffer(7,3);
+	
+	for(UINT i = 0 ; i < 17 ; i++){
+		SensorSample sample(std::vector<float>{(float) (i % 4), (float) (i % 3) - 1.0f, (float) (i * i % 7) - 3.0f});
+		ringBuffer.add(sample);
+		fixedRingBuffer.add(FixedSensorSample<3>(sample));
+		columnRingBuffer.add(sample);
+		
+		for(UINT startRow = 0 ; startRow + 1 < ringBuffer.getSize() ; startRow += 2){
+			for(uint8_t colIdx = 0 ; colIdx < 3 ; colIdx++){
+				DataIterator iterator(&ringBuffer,startRow,ringBuffer.getSize() - 1,Vector<uint8_t>(1,colIdx));
+				DataIterator fixedIterator(&fixedRingBuffer,startRow,ringBuffer.getSize() - 1,Vector<uint8_t>(1,colIdx));
+				DataIterator columnIterator(&columnRingBuffer,startRow,ringBuffer.getSize() - 1,Vector<uint8_t>(1,colIdx));
+				
+				StridedSpan span;
+				EXPECT_TRUE(fixedIterator.getSpan(span));
+				EXPECT_TRUE(columnIterator.getSpan(span));
+				
+				EXPECT_FLOAT_EQ(Mean::Compute(iterator),Mean::Compute(fixedIterator));
+				EXPECT_FLOAT_EQ(Mean::Compute(iterator),Mean::Compute(columnIterator));
+				EXPECT_FLOAT_EQ(STD::Compute(iterator),STD::Compute(fixedIterator));
+				EXPECT_FLOAT_EQ(STD::Compute(iterator),STD::Compute(columnIterator));
+				EXPECT_FLOAT_EQ(Minimum::Compute(iterator),Minimum::Compute(fixedIterator));
+				EXPECT_FLOAT_EQ(Minimum::Compute(iterator),Minimum::Compute(columnIterator));
+				EXPECT_FLOAT_EQ(ZCR::Compute(iterator),ZCR::Compute(fixedIterator));
+				EXPECT_FLOAT_EQ(ZCR::Compute(iterator),ZCR::Compute(columnIterator));
+			}
+		}
+	}
+}
@@ -0,0 +1,192 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ARF;
+
+//writes a file in the .arf format of DataSet::saveDatasetToFile()
+static void WriteARFFile(const std::string &fileName, UINT numColumns, UINT numSamples){
+	std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+	file << "DatasetName: recording" << std::endl << "InfoText: a test" << std::endl;
+	file << "NumDimensions: " << numColumns << std::endl << "TotalNumSamples: " << numSamples << std::endl << "ColumnHeaders:\n";
+	for(UINT j = 0 ; j < numColumns ; j++){
+		file << "\tcol_" << j + 1;
+	}
+	file << std::endl;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			Float value = i * 0.5f + j;
+			file.write(reinterpret_cast<char*>(&value), sizeof(Float));
+		}
+	}
+}
+
+TEST(DataSetReader, ReadsARFFilesInBlocks) {
+	const std::string fileName = "DataSetReaderTest.arf";
+	WriteARFFile(fileName, 3, 1000);
+	
+	DataSetReader reader(fileName, 64);
+	EXPECT_FALSE(reader.isCSV());
+	EXPECT_EQ(reader.getDatasetName(), "recording");
+	EXPECT_EQ(reader.getInfoText(), "a test ");
+	ASSERT_EQ(reader.getNumColumns(), 3);
+	ASSERT_EQ(reader.getNumSamples(), 1000);
+	EXPECT_EQ(reader.getColumnNames()[2], "col_3");
+	
+	UINT numSamples = 0;
+	UINT numBlocks = 0;
+	for(UINT n = reader.readBlock() ; n > 0 ; n = reader.readBlock()){
+		EXPECT_EQ(reader.getBlockStart(), numSamples);
+		EXPECT_EQ(n, std::min(64u, 1000 - numSamples));
+		for(UINT i = 0 ; i < n ; i++){
+			EXPECT_EQ(reader.getRow(i)[0], (numSamples + i) * 0.5f);
+			EXPECT_EQ(reader.getBlock()[i * 3 + 2], (numSamples + i) * 0.5f + 2);
+		}
+		numSamples += n;
+		numBlocks++;
+	}
+	EXPECT_EQ(numSamples, 1000);
+	EXPECT_EQ(numBlocks, 16);
+	EXPECT_EQ(reader.readBlock(), 0);
+	
+	//seeking after the end of the file was reached
+	reader.seek(990);
+	ASSERT_EQ(reader.readBlock(), 10);
+	EXPECT_EQ(reader.getBlockStart(), 990);
+	EXPECT_EQ(reader.getRow(0)[1], 990 * 0.5f + 1);
+	reader.seek(0);
+	ASSERT_EQ(reader.readBlock(), 64);
+	EXPECT_EQ(reader.getRow(63)[0], 63 * 0.5f);
+	EXPECT_THROW(reader.seek(1001), ARFException);
+	EXPECT_THROW(reader.getRow(64), ARFException);
+	
+	//a file shorter than its header states
+	WriteARFFile(fileName, 3, 10);
+	std::ifstream original(fileName.c_str(), std::ifstream::binary);
+	std::string contents((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+	original.close();
+	std::ofstream truncated(fileName.c_str(), std::ofstream::binary);
+	truncated << contents.substr(0, contents.size() - 4);
+	truncated.close();
+	DataSetReader truncatedReader(fileName, 64);
+	EXPECT_THROW(truncatedReader.readBlock(), ARFException);
+	
+	remove(fileName.c_str());
+}
+
+TEST(DataSetReader, ReadsCSVFilesInBlocks) {
+	const std::string fileName = "DataSetReaderTest.csv";
+	
+	//more rows than fit in the text buffer, so that rows are split between reads
+	const UINT numRows = 20000;
+	{
+		std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		file << "ax,ay\r\n";
+		for(UINT i = 0 ; i < numRows ; i++){
+			file << i << "," << i * 0.25f << "\r\n";
+		}
+		file << "\r\n\n";
+	}
+	
+	DataSetReader reader(fileName, 300, true);
+	EXPECT_TRUE(reader.isCSV());
+	ASSERT_EQ(reader.getNumColumns(), 2);
+	EXPECT_EQ(reader.getColumnNames()[1], "ay");
+	EXPECT_THROW(reader.seek(0), ARFException);
+	
+	UINT numSamples = 0;
+	for(UINT n = reader.readBlock() ; n > 0 ; n = reader.readBlock()){
+		EXPECT_EQ(reader.getBlockStart(), numSamples);
+		for(UINT i = 0 ; i < n ; i++){
+			ASSERT_EQ(reader.getRow(i)[0], (Float) (numSamples + i));
+			ASSERT_EQ(reader.getRow(i)[1], (numSamples + i) * 0.25f);
+		}
+		numSamples += n;
+	}
+	EXPECT_EQ(numSamples, numRows);
+	
+	//the values of every row are checked as they are read
+	{
+		std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+		file << "1,2\n3,4\n\n5,6";
+	}
+	DataSetReader invalidReader(fileName, 1);
+	EXPECT_EQ(invalidReader.readBlock(), 1);
+	EXPECT_EQ(invalidReader.readBlock(), 1);
+	EXPECT_THROW(invalidReader.readBlock(), ARFException);
+	
+	remove(fileName.c_str());
+}
+
+TEST(DataSetReader, FeedsPipelinePlans) {
+	const std::string fileName = "DataSetReaderTest.arf";
+	WriteARFFile(fileName, 2, 500);
+	
+	//the mean of a window of 10 samples of the first column, every 10 samples
+	RingBuffer<SensorSample> ringBuffer(10);
+	RingBufferAlgorithm ringBufferAlgorithm(&ringBuffer, 10);
+	DataSelector selector(&ringBuffer, 0, 9, {0});
+	Mean mean;
+	ringBufferAlgorithm << selector << mean;
+	PipelinePlan plan(&ringBufferAlgorithm);
+	
+	//the same pipeline executed sample by sample
+	RingBuffer<SensorSample> sampleRingBuffer(10);
+	RingBufferAlgorithm sampleRingBufferAlgorithm(&sampleRingBuffer, 10);
+	DataSelector sampleSelector(&sampleRingBuffer, 0, 9, {0});
+	Mean sampleMean;
+	sampleRingBufferAlgorithm << sampleSelector << sampleMean;
+	PipelinePlan samplePlan(&sampleRingBufferAlgorithm);
+	Vector<Float> expectedMeans;
+	Vector<Data*> sampleOutput(1);
+	SensorSample sample(2);
+	for(UINT i = 0 ; i < 500 ; i++){
+		sample[0] = i * 0.5f;
+		sample[1] = i * 0.5f + 1;
+		if(samplePlan.execute(&sample, sampleOutput) > 0){
+			expectedMeans.push_back(((Value*) sampleOutput[0])->getValue());
+		}
+	}
+	
+	DataSetReader reader(fileName, 64);
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	UINT numMeans = 0;
+	for(UINT n = reader.readBlock() ; n > 0 ; n = reader.readBlock()){
+		UINT outputCount = plan.executeBlock(reader.getBlock(), n, reader.getNumColumns(), reader.getNumColumns(), output, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			ASSERT_LT(numMeans, expectedMeans.getSize());
+			EXPECT_EQ(((Value*) output[j])->getValue(), expectedMeans[numMeans]);
+			numMeans++;
+		}
+	}
+	EXPECT_GT(numMeans, 0);
+	EXPECT_EQ(numMeans, expectedMeans.getSize());
+	
+	remove(fileName.c_str());
+}
@@ -0,0 +1,174 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ARF;
+
+static Float TestValue(UINT sampleIdx, UINT columnIdx){
+	return std::sin(sampleIdx * 0.01f * (columnIdx + 1)) + (sampleIdx % 7) * 0.001f;
+}
+
+static void WriteCompressedFile(const std::string &fileName, UINT numColumns, UINT numSamples, UINT blockSize){
+	Vector<std::string> columnNames(3);
+	columnNames[0] = "ax";
+	columnNames[1] = "ay";
+	columnNames[2] = "az";
+	DataSetWriter writer(fileName, numColumns, "recording", "a test", columnNames, blockSize);
+	std::vector<Float> rows((size_t) numSamples * numColumns);
+	for(UINT i = 0 ; i < numSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			rows[(size_t) i * numColumns + j] = TestValue(i, j);
+		}
+	}
+	
+	//single samples and runs of samples that cross blocks
+	UINT numWritten = 0;
+	for( ; numWritten < numSamples && numWritten < 5 ; numWritten++){
+		writer.writeSample(rows.data() + (size_t) numWritten * numColumns);
+	}
+	if(numWritten < numSamples){
+		writer.writeSamples(rows.data() + (size_t) numWritten * numColumns, numSamples - numWritten);
+	}
+	EXPECT_EQ(writer.getNumSamples(), numSamples);
+	writer.close();
+	EXPECT_FALSE(writer.isOpen());
+}
+
+static std::string ReadFile(const std::string &fileName){
+	std::ifstream file(fileName.c_str(), std::ifstream::binary);
+	return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::string &fileName, const std::string &contents){
+	std::ofstream file(fileName.c_str(), std::ofstream::binary);
+	file << contents;
+}
+
+TEST(DataSetWriter, WritesFilesReadByDataSetReader) {
+	const std::string fileName = "DataSetWriterTest.arf";
+	WriteCompressedFile(fileName, 3, 1000, 300);
+	
+	DataSetReader reader(fileName, 64);
+	EXPECT_EQ(reader.getVersion(), 2);
+	EXPECT_FALSE(reader.isCSV());
+	EXPECT_EQ(reader.getDatasetName(), "recording");
+	EXPECT_EQ(reader.getInfoText(), "a test ");
+	ASSERT_EQ(reader.getNumColumns(), 3);
+	ASSERT_EQ(reader.getNumSamples(), 1000);
+	EXPECT_EQ(reader.getColumnNames()[2], "az");
+	
+	//the blocks of the reader do not match the blocks of the file
+	UINT numSamples = 0;
+	for(UINT n = reader.readBlock() ; n > 0 ; n = reader.readBlock()){
+		EXPECT_EQ(reader.getBlockStart(), numSamples);
+		EXPECT_EQ(n, std::min(64u, 1000 - numSamples));
+		for(UINT i = 0 ; i < n ; i++){
+			for(UINT j = 0 ; j < 3 ; j++){
+				ASSERT_EQ(reader.getRow(i)[j], TestValue(numSamples + i, j));
+			}
+		}
+		numSamples += n;
+	}
+	EXPECT_EQ(numSamples, 1000);
+	
+	//seeking into the blocks of the file
+	for(UINT sampleIdx : {990u, 0u, 299u, 600u, 1000u}){
+		reader.seek(sampleIdx);
+		ASSERT_EQ(reader.readBlock(), std::min(64u, 1000 - sampleIdx));
+		if(sampleIdx < 1000){
+			EXPECT_EQ(reader.getRow(0)[1], TestValue(sampleIdx, 1));
+		}
+	}
+	EXPECT_THROW(reader.seek(1001), ARFException);
+	
+	//uncompressed files are still read as version 1
+	{
+		std::ofstream file("DataSetWriterTest.v1.arf", std::ofstream::binary);
+		file << "DatasetName: recording\nInfoText: \nNumDimensions: 1\nTotalNumSamples: 2\nColumnHeaders:\n\tcol_1\n";
+		Float values[2] = {1.0f, 2.0f};
+		file.write(reinterpret_cast<char*>(values), sizeof(values));
+	}
+	DataSetReader uncompressedReader("DataSetWriterTest.v1.arf");
+	EXPECT_EQ(uncompressedReader.getVersion(), 1);
+	EXPECT_EQ(uncompressedReader.readBlock(), 2);
+	remove("DataSetWriterTest.v1.arf");
+	
+	//compressed files cannot be mapped
+	EXPECT_THROW(MappedDataSet mapped(fileName), ARFException);
+	
+	remove(fileName.c_str());
+}
+
+TEST(DataSetWriter, WritesEmptyAndSingleBlockFiles) {
+	const std::string fileName = "DataSetWriterTest.arf";
+	
+	WriteCompressedFile(fileName, 2, 0, 100);
+	DataSetReader emptyReader(fileName);
+	EXPECT_EQ(emptyReader.getNumSamples(), 0);
+	EXPECT_EQ(emptyReader.readBlock(), 0);
+	
+	WriteCompressedFile(fileName, 2, 100, 100);
+	DataSetReader reader(fileName, 1000);
+	ASSERT_EQ(reader.readBlock(), 100);
+	EXPECT_EQ(reader.getRow(99)[1], TestValue(99, 1));
+	EXPECT_EQ(reader.readBlock(), 0);
+	
+	EXPECT_THROW(DataSetWriter(fileName, 2, "recording", "", Vector<std::string>(), 0), ARFException);
+	
+	remove(fileName.c_str());
+}
+
+TEST(DataSetWriter, DetectsCorruptedFiles) {
+	const std::string fileName = "DataSetWriterTest.arf";
+	WriteCompressedFile(fileName, 3, 1000, 300);
+	const std::string contents = ReadFile(fileName);
+	
+	//a flipped bit in the first block is detected by its checksum when the block is read
+	std::string corrupted = contents;
+	size_t dataOffset = contents.find("az\n") + 3;
+	corrupted[dataOffset + 100] ^= 4;
+	WriteFile(fileName, corrupted);
+	DataSetReader corruptedReader(fileName, 64);
+	EXPECT_THROW(corruptedReader.readBlock(), ARFException);
+	corruptedReader.seek(300);
+	EXPECT_EQ(corruptedReader.readBlock(), 64);
+	EXPECT_EQ(corruptedReader.getRow(0)[0], TestValue(300, 0));
+	
+	//a flipped bit in the index is detected when the file is opened
+	corrupted = contents;
+	corrupted[contents.size() - 30] ^= 1;
+	WriteFile(fileName, corrupted);
+	EXPECT_THROW(DataSetReader reader(fileName), ARFException);
+	
+	//a truncated file has no index
+	WriteFile(fileName, contents.substr(0, contents.size() - 10));
+	EXPECT_THROW(DataSetReader reader(fileName), ARFException);
+	
+	remove(fileName.c_str());
+}
@@ -0,0 +1,99 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+//values with a fractional part and both signs, so that every kernel processes sign changes and unaligned tails
+static std::vector<Float> CreateValues(UINT numValues){
+	std::vector<Float> values(numValues);
+	for(UINT i = 0 ; i < numValues ; i++){
+		values[i] = sinf(i * 0.37f) * 10.0f + (i % 7) * 0.25f - 0.5f;
+	}
+	return values;
+}
+
+TEST(FeatureKernels, InstructionSetsMatchScalar) {
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	
+	for(UINT numValues = 1 ; numValues <= 130 ; numValues++){
+		std::vector<Float> values = CreateValues(numValues);
+		
+		//every instruction set is compared on a misaligned pointer as well
+		for(UINT offset = 0 ; offset < 2 && offset < numValues ; offset++){
+			const Float * data = values.data() + offset;
+			UINT n = numValues - offset;
+			
+			ASSERT_TRUE(FeatureKernels::SetInstructionSet(FeatureKernels::kScalar));
+			Float sum = FeatureKernels::Sum(data, n);
+			Float sumSquaredDifferences = FeatureKernels::SumSquaredDifferences(data, n, 1.5f);
+			Float minimum = FeatureKernels::Minimum(data, n);
+			UINT signChanges = FeatureKernels::CountSignChanges(data, n);
+			Float dotProduct = FeatureKernels::DotProduct(data, values.data(), n);
+			
+			for(UINT instructionSet = FeatureKernels::kSSE2 ; instructionSet <= supportedInstructionSet ; instructionSet++){
+				ASSERT_TRUE(FeatureKernels::SetInstructionSet(instructionSet));
+				EXPECT_NEAR(FeatureKernels::Sum(data, n), sum, 1e-3);
+				EXPECT_NEAR(FeatureKernels::SumSquaredDifferences(data, n, 1.5f), sumSquaredDifferences, 1e-4 * sumSquaredDifferences + 1e-4);
+				EXPECT_EQ(FeatureKernels::Minimum(data, n), minimum);
+				EXPECT_EQ(FeatureKernels::CountSignChanges(data, n), signChanges);
+				EXPECT_NEAR(FeatureKernels::DotProduct(data, values.data(), n), dotProduct, 1e-4 * fabs(dotProduct) + 1e-3);
+			}
+		}
+	}
+	
+	EXPECT_FALSE(FeatureKernels::SetInstructionSet(FeatureKernels::kAVX2 + 1));
+	ASSERT_TRUE(FeatureKernels::SetInstructionSet(supportedInstructionSet));
+	EXPECT_EQ(FeatureKernels::GetInstructionSet(), supportedInstructionSet);
+}
+
+TEST(FeatureKernels, FeaturesOfWrappedColumn) {
+	ColumnRingBuffer ringBuffer(64, 2);
+	RingBuffer<SensorSample> sampleRingBuffer(64);
+	
+	//wrap the rows of both buffers around the end of their storage
+	std::vector<Float> values = CreateValues(100);
+	for(UINT i = 0 ; i < values.size() ; i++){
+		SensorSample sample(2);
+		sample[0] = values[i];
+		sample[1] = -values[i];
+		ringBuffer.add(sample);
+		sampleRingBuffer.add(sample);
+	}
+	
+	Signal columnSignal(&ringBuffer, 3, 60, Vector<uint8_t>(1, 1));
+	Signal sampleSignal(&sampleRingBuffer, 3, 60, Vector<uint8_t>(1, 1));
+	StridedSpan span;
+	ASSERT_TRUE(columnSignal.getSpan(span));
+	ASSERT_EQ(span.stride, 1);
+	ASSERT_GT(span.secondSize, 0);
+	ASSERT_FALSE(sampleSignal.getSpan(span));
+	
+	EXPECT_NEAR(Mean::Compute(columnSignal), Mean::Compute(sampleSignal), 1e-4);
+	EXPECT_NEAR(STD::Compute(columnSignal), STD::Compute(sampleSignal), 1e-4);
+	EXPECT_EQ(Minimum::Compute(columnSignal), Minimum::Compute(sampleSignal));
+	EXPECT_EQ(ZCR::Compute(columnSignal), ZCR::Compute(sampleSignal));
+}
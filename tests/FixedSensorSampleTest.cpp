@@ -0,0 +1,104 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+
+using namespace ARF;
+
+TEST(FixedSensorSample, StoresValuesInline) {
+	EXPECT_EQ(sizeof(FixedSensorSample<16>),16 * sizeof(Float));
+	
+	FixedSensorSample<3> sample(SensorSample(std::vector<float>{1.0f, 2.0f, 3.0f}));
+	EXPECT_EQ(sample.getSize(),3);
+	EXPECT_EQ(sample[2],3.0f);
+	EXPECT_TRUE(sample.resize(3));
+	EXPECT_FALSE(sample.resize(4));
+	
+	SensorSample copy;
+	sample.copyTo(copy);
+	EXPECT_EQ(copy.getSize(),3);
+	EXPECT_EQ(copy[1],2.0f);
+	
+	EXPECT_THROW(sample = SensorSample(2),ARFException);
+}
+
+TEST(FixedSensorSample, MatchesSensorSampleInPipeline) {
+	RingBufferAlgorithm ringBufferAlgorithm(6);
+	BasicRingBufferAlgorithm<FixedSensorSample<3> > fixedRingBufferAlgorithm(6);
+	BasicRingBufferAlgorithm<FixedSensorSample<3> > unplannedRingBufferAlgorithm(2);
+	
+	DataSelector selector(ringBufferAlgorithm,1,5,{2});
+	DataSelector fixedSelector(fixedRingBufferAlgorithm,1,5,{2});
+	Mean mean;
+	Mean fixedMean;
+	ringBufferAlgorithm << selector << mean;
+	fixedRingBufferAlgorithm << fixedSelector << fixedMean;
+	
+	PipelinePlan plan(&ringBufferAlgorithm);
+	PipelinePlan fixedPlan(&fixedRingBufferAlgorithm);
+	Vector<Data*> output(1);
+	Vector<Data*> fixedOutput(1);
+	
+	for(UINT i = 0 ; i < 15 ; i++){
+		SensorSample sample(std::vector<float>{(float) (i % 4), (float) (i % 3) - 1.0f, (float) (i * i % 7) - 3.0f});
+		FixedSensorSample<3> fixedSample(sample);
+		
+		UINT outputCount = plan.execute(&sample, output);
+		UINT fixedOutputCount = fixedPlan.execute((Data*) &fixedSample, fixedOutput);
+		EXPECT_EQ(outputCount,fixedOutputCount);
+		if(outputCount == 1){
+			EXPECT_FLOAT_EQ(((Value*) output[0])->getValue(),((Value*) fixedOutput[0])->getValue());
+		}
+		
+		//the notification sample is output as a SensorSample
+		Data * notification = unplannedRingBufferAlgorithm.execute((Data*) &fixedSample);
+		if(notification != nullptr){
+			EXPECT_EQ(((SensorSample*) notification)->getSize(),3);
+			EXPECT_EQ((*(SensorSample*) notification)[0],sample[0]);
+			delete notification;
+		}
+	}
+	
+	//a DataIterator reads the fixed samples like SensorSamples
+	DataIterator iterator(fixedRingBufferAlgorithm.getRingBuffer(),0,5,Vector<uint8_t>(std::vector<uint8_t>{0,1,2}));
+	EXPECT_EQ(iterator(5,1),fixedRingBufferAlgorithm.getElementAtIdx(5)[1]);
+}
+
+TEST(FixedSensorSample, FedBySampleQueue) {
+	SampleQueue queue(8,2);
+	BasicRingBufferAlgorithm<FixedSensorSample<2> > ringBufferAlgorithm(4);
+	
+	for(UINT i = 0 ; i < 6 ; i++){
+		Float values[2] = {(Float) i, (Float) (2 * i)};
+		queue.push(values);
+	}
+	EXPECT_EQ(ringBufferAlgorithm.addSamples(queue),6);
+	EXPECT_EQ(ringBufferAlgorithm.getElementAtIdx(0)[1],4.0f);
+	
+	SampleQueue wideQueue(8,3);
+	Float values[3] = {1.0f, 2.0f, 3.0f};
+	wideQueue.push(values);
+	EXPECT_THROW(ringBufferAlgorithm.addSamples(wideQueue),ARFException);
+}
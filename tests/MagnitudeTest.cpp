@@ -0,0 +1,172 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+
+using namespace ARF;
+
+TEST(Magnitude, Execute) {
+	RingBuffer<SensorSample> ringBuffer(1);
+	ringBuffer.add(SensorSample(std::vector<float>{3.0, 4.0, 12.0}));
+	DataIterator signal(&ringBuffer,0,0,Vector<uint8_t>(std::vector<uint8_t>{0,1,2}));
+	
+	Magnitude magnitude;
+	Value * value = (Value*) magnitude.execute(&signal);
+	EXPECT_FLOAT_EQ(value->getValue(),13.0);
+	delete value;
+}
+
+TEST(Magnitude, ComputeBlock) {
+	ColumnRingBuffer columnRingBuffer(64, 4);
+	RingBuffer<SensorSample> ringBuffer(64);
+	
+	//wrap the rows around the end of the column storage, and include a row of zeros
+	for(UINT i = 0 ; i < 100 ; i++){
+		SensorSample sample(4);
+		for(UINT c = 0 ; c < 4 ; c++){
+			sample[c] = (i == 70) ? 0.0f : sinf(i * 0.3f + c) * (c + 1.0f) * 100.0f;
+		}
+		columnRingBuffer.add(sample);
+		ringBuffer.add(sample);
+	}
+	
+	Vector<uint8_t> columns(std::vector<uint8_t>{0, 1, 3});
+	Signal columnSignal(&columnRingBuffer, 3, 60, columns);
+	Signal signal(&ringBuffer, 3, 60, columns);
+	UINT numRows = signal.getNumRows();
+	
+	//the rows of a RingBuffer of SensorSamples are not contiguous, so they are copied into blocks before the kernels compute them
+	Vector<Float> expected(numRows);
+	Magnitude::ComputeBlock(signal, expected.getData());
+	for(UINT i = 0 ; i < numRows ; i++){
+		Float sum = 0.0;
+		for(UINT c = 0 ; c < 3 ; c++){
+			sum += signal(i, c) * signal(i, c);
+		}
+		EXPECT_FLOAT_EQ(expected[i], sqrtf(sum));
+	}
+	
+	const Float tolerances[] = {1e-6, 1e-6, 4e-4};
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	for(UINT instructionSet = FeatureKernels::kScalar ; instructionSet <= supportedInstructionSet ; instructionSet++){
+		ASSERT_TRUE(FeatureKernels::SetInstructionSet(instructionSet));
+		for(UINT squareRoot = FeatureKernels::kExactSquareRoot ; squareRoot <= FeatureKernels::kApproximateSquareRoot ; squareRoot++){
+			Vector<Float> magnitudes(numRows);
+			Magnitude::ComputeBlock(columnSignal, magnitudes.getData(), squareRoot);
+			for(UINT i = 0 ; i < numRows ; i++){
+				EXPECT_NEAR(magnitudes[i], expected[i], tolerances[squareRoot] * expected[i]);
+			}
+			
+			//the last rows, which do not fill a SIMD register, have the same magnitudes as the other rows
+			for(UINT i = 0 ; i < numRows ; i++){
+				Signal row(&columnRingBuffer, 3 + i, 3 + i, columns);
+				Float magnitude;
+				Magnitude::ComputeBlock(row, &magnitude, squareRoot);
+				EXPECT_EQ(magnitude, magnitudes[i]);
+			}
+		}
+	}
+	ASSERT_TRUE(FeatureKernels::SetInstructionSet(supportedInstructionSet));
+}
+
+TEST(Magnitude, ComputeBlockOfStridedColumns) {
+	ColumnRingBuffer columnRingBuffer(800, 4);
+	RingBuffer<SensorSample> ringBuffer(800);
+	for(UINT i = 0 ; i < 1000 ; i++){
+		SensorSample sample(4);
+		for(UINT c = 0 ; c < 4 ; c++){
+			sample[c] = sinf(i * 0.7f + c) * (c + 1.0f) * 10.0f;
+		}
+		columnRingBuffer.add(sample);
+		ringBuffer.add(sample);
+	}
+	
+	//the rows span several blocks of copied values and wrap around the end of the ring buffers
+	Vector<uint8_t> columns(std::vector<uint8_t>{0, 2, 3});
+	Signal columnSignal(&columnRingBuffer, 0, 799, columns);
+	Signal signal(&ringBuffer, 0, 799, columns);
+	UINT numRows = signal.getNumRows();
+	
+	UINT supportedInstructionSet = FeatureKernels::GetSupportedInstructionSet();
+	for(UINT instructionSet = FeatureKernels::kScalar ; instructionSet <= supportedInstructionSet ; instructionSet++){
+		ASSERT_TRUE(FeatureKernels::SetInstructionSet(instructionSet));
+		for(UINT squareRoot = FeatureKernels::kExactSquareRoot ; squareRoot <= FeatureKernels::kApproximateSquareRoot ; squareRoot++){
+			Vector<Float> expected(numRows);
+			Vector<Float> magnitudes(numRows);
+			Magnitude::ComputeBlock(columnSignal, expected.getData(), squareRoot);
+			Magnitude::ComputeBlock(signal, magnitudes.getData(), squareRoot);
+			for(UINT i = 0 ; i < numRows ; i++){
+				EXPECT_EQ(magnitudes[i], expected[i]);
+			}
+		}
+	}
+	ASSERT_TRUE(FeatureKernels::SetInstructionSet(supportedInstructionSet));
+}
+
+TEST(Magnitude, BlockFeedsFeaturesAndPeakDetector) {
+	ColumnRingBuffer columnRingBuffer(600, 3);
+	for(UINT i = 0 ; i < 600 ; i++){
+		SensorSample sample(3, 0.1f);
+		if(i % 100 == 50){
+			sample[2] = 5.0f;
+		}
+		columnRingBuffer.add(sample);
+	}
+	Signal signal(&columnRingBuffer, 0, 599, Vector<uint8_t>(std::vector<uint8_t>{0, 1, 2}));
+	
+	Vector<Float> magnitudes(600);
+	Magnitude::ComputeBlock(signal, magnitudes.getData());
+	
+	//a Vector of Floats is a column the feature extractors read without copying
+	Signal magnitudeSignal(&magnitudes, 0, 599, Vector<uint8_t>(1, 0));
+	StridedSpan span;
+	ASSERT_TRUE(magnitudeSignal.getSpan(span));
+	Float mean = 0.0;
+	for(UINT i = 0 ; i < 600 ; i++){
+		mean += magnitudes[i] / 600;
+	}
+	EXPECT_NEAR(Mean::Compute(magnitudeSignal), mean, 1e-5);
+	EXPECT_FLOAT_EQ(Minimum::Compute(magnitudeSignal), sqrtf(0.03f));
+	
+	//the block detection reports the peaks at the same samples as the detection sample by sample
+	PeakDetector blockDetector(1.0f, 20);
+	Vector<UINT> peakIndices;
+	EXPECT_EQ(blockDetector.detectPeaks(magnitudes.getData(), 300, peakIndices), 3);
+	EXPECT_EQ(blockDetector.detectPeaks(magnitudes.getData() + 300, 300, peakIndices), 3);
+	
+	PeakDetector peakDetector(1.0f, 20);
+	Vector<UINT> expectedIndices;
+	for(UINT i = 0 ; i < 600 ; i++){
+		Value value(magnitudes[i]);
+		if(peakDetector.execute(&value) != nullptr){
+			expectedIndices.push_back(i % 300);
+		}
+	}
+	ASSERT_EQ(peakIndices.getSize(), expectedIndices.getSize());
+	for(UINT i = 0 ; i < peakIndices.getSize() ; i++){
+		EXPECT_EQ(peakIndices[i], expectedIndices[i]);
+		EXPECT_EQ(peakIndices[i] % 100, 70);
+	}
+}
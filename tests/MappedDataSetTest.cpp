@@ -0,0 +1,111 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ARF;
+
+//writes a file in the .arf format of DataSet::saveDatasetToFile(), with an info text of any length so that the rows can be unaligned
+static void WriteFile(const std::string &fileName, const std::string &infoText, UINT numColumns, UINT numSamples, UINT numWrittenSamples){
+	std::ofstream file(fileName.c_str(), std::ofstream::out | std::ofstream::binary);
+	file << "DatasetName: mapped" << std::endl;
+	file << "InfoText: " << infoText << std::endl;
+	file << "NumDimensions: " << numColumns << std::endl;
+	file << "TotalNumSamples: " << numSamples << std::endl;
+	file << "ColumnHeaders:\n";
+	for(UINT j = 0 ; j < numColumns ; j++){
+		file << "\tcol_" << j + 1;
+	}
+	file << std::endl;
+	for(UINT i = 0 ; i < numWrittenSamples ; i++){
+		for(UINT j = 0 ; j < numColumns ; j++){
+			Float value = i * 0.5f + j;
+			file.write(reinterpret_cast<char*>(&value), sizeof(Float));
+		}
+	}
+}
+
+TEST(MappedDataSet, ReadsRowsInPlace) {
+	const std::string fileName = "MappedDataSetTest.arf";
+	
+	//both an aligned and an unaligned header
+	for(const std::string &infoText : {std::string("a test"), std::string("a test ")}){
+		WriteFile(fileName, infoText, 4, 1000, 1000);
+		MappedDataSet dataSet(fileName);
+		
+		EXPECT_EQ(dataSet.getDatasetName(), "mapped");
+		EXPECT_EQ(dataSet.getInfoText(), "a test ");
+		ASSERT_EQ(dataSet.getNumColumns(), 4);
+		ASSERT_EQ(dataSet.getNumSamples(), 1000);
+		EXPECT_EQ(dataSet.getColumnNames()[3], "col_4");
+		
+		for(UINT i = 0 ; i < 1000 ; i++){
+			EXPECT_EQ(dataSet.getRow(i)[2], i * 0.5f + 2);
+			EXPECT_EQ(dataSet.getValue(i, 1), i * 0.5f + 1);
+		}
+		SensorSample sample;
+		dataSet.getSample(999, sample);
+		EXPECT_EQ(sample.getSize(), 4);
+		EXPECT_EQ(sample[3], 999 * 0.5f + 3);
+		EXPECT_THROW(dataSet.getRow(1000), ARFException);
+		
+		//the rows of the unaligned file are copied, and a pipeline reads both files through DataSelectors with spans
+		if(!dataSet.isAligned()){
+			EXPECT_FALSE(dataSet.isMapped());
+		}
+		DataSelector selector(&dataSet, 10, 109, {2});
+		Signal * signal = (Signal*) selector.execute(nullptr);
+		StridedSpan span;
+		EXPECT_TRUE(signal->getSpan(span));
+		EXPECT_EQ(span.stride, 4);
+		EXPECT_FLOAT_EQ(Mean::Compute(*signal), 59.5f * 0.5f + 2);
+		delete signal;
+		
+		EXPECT_TRUE(dataSet.advise(MappedDataSet::kWillNeed, 100, 200));
+		EXPECT_TRUE(dataSet.advise(MappedDataSet::kDontNeed));
+		EXPECT_EQ(dataSet.getValue(500, 0), 250.0f);
+		EXPECT_FALSE(dataSet.advise(MappedDataSet::kSequential, 0, 1000));
+	}
+	
+	remove(fileName.c_str());
+}
+
+TEST(MappedDataSet, InvalidFiles) {
+	const std::string fileName = "MappedDataSetTest.arf";
+	EXPECT_THROW(MappedDataSet("MappedDataSetTestMissing.arf"), ARFException);
+	
+	WriteFile(fileName, "truncated", 3, 100, 99);
+	EXPECT_THROW(MappedDataSet dataSet(fileName), ARFException);
+	
+	{
+		std::ofstream file(fileName.c_str());
+		file << "NotADataSet: 1" << std::endl;
+	}
+	EXPECT_THROW(MappedDataSet dataSet(fileName), ARFException);
+	
+	remove(fileName.c_str());
+}
@@ -0,0 +1,86 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+//checks the error bounds documented by a policy on values from 1e-12 to 1e12 and on angles all around the circle
+template <typename Math>
+static void ExpectErrorBounds(double sqrtError, double log2Error, double atan2Error){
+	for(UINT i = 0 ; i < 100000 ; i++){
+		double x = exp((i / 100000.0 - 0.5) * 55.0);
+		EXPECT_NEAR(Math::Sqrt((Float) x), sqrt(x), sqrtError * sqrt(x));
+		EXPECT_NEAR(Math::Log2((Float) x), log2(x), log2Error);
+		
+		double angle = i * (2 * M_PI / 100000) - M_PI;
+		Float y = (Float) (sin(angle) * x);
+		Float z = (Float) (cos(angle) * x);
+		EXPECT_NEAR(Math::Atan2(y, z), atan2((double) y, (double) z), atan2Error);
+	}
+	EXPECT_EQ(Math::Sqrt(0.0f), 0.0f);
+	EXPECT_EQ(Math::Atan2(0.0f, 0.0f), 0.0f);
+}
+
+TEST(MathPolicies, ErrorBounds) {
+	ExpectErrorBounds<ExactMath>(1e-7, 2e-6, 1e-6);
+	ExpectErrorBounds<FastMath>(1e-5, 3e-6, 3e-6);
+	ExpectErrorBounds<TableMath>(1e-6, 1e-5, 2e-6);
+}
+
+TEST(MathPolicies, Algorithms) {
+	ColumnRingBuffer ringBuffer(256, 3);
+	for(UINT i = 0 ; i < 256 ; i++){
+		SensorSample sample(3);
+		sample[0] = sinf(i * 0.2f) * 3.0f;
+		sample[1] = cosf(i * 0.05f) + sinf(i * 1.3f) * 0.5f;
+		sample[2] = 9.81f;
+		ringBuffer.add(sample);
+	}
+	Signal column(&ringBuffer, 0, 255, Vector<uint8_t>(1, 1));
+	Signal row(&ringBuffer, 10, 10, Vector<uint8_t>(std::vector<uint8_t>{0, 1, 2}));
+	
+	Float magnitude = Magnitude::Compute(row);
+	EXPECT_NEAR(BasicMagnitude<FastMath>::Compute(row), magnitude, 1e-5 * magnitude);
+	EXPECT_NEAR(BasicMagnitude<TableMath>::Compute(row), magnitude, 1e-6 * magnitude);
+	
+	Float std = STD::Compute(column);
+	EXPECT_NEAR(BasicSTD<FastMath>::Compute(column), std, 1e-5 * std);
+	EXPECT_NEAR(BasicSTD<TableMath>::Compute(column), std, 1e-6 * std);
+	
+	//the entropy is a sum of p * log2(p) over 128 bins divided by log2(128), so its error stays close to the error of Log2()
+	std::vector<Float> scratch(SpectralFeatures::GetScratchSize(FFTPlan::GetPlan(256)));
+	FeatureVector entropy, fastEntropy, tableEntropy;
+	SpectralFeatures::Compute(column, FFTPlan::GetPlan(256), 100.0f, SpectralFeatures::kSpectralEntropy, Vector<Float>(), entropy, scratch.data());
+	BasicSpectralFeatures<FastMath>::Compute(column, FFTPlan::GetPlan(256), 100.0f, SpectralFeatures::kSpectralEntropy, Vector<Float>(), fastEntropy, scratch.data());
+	BasicSpectralFeatures<TableMath>::Compute(column, FFTPlan::GetPlan(256), 100.0f, SpectralFeatures::kSpectralEntropy, Vector<Float>(), tableEntropy, scratch.data());
+	EXPECT_NEAR(fastEntropy[0], entropy[0], 1e-5);
+	EXPECT_NEAR(tableEntropy[0], entropy[0], 1e-5);
+	
+	BasicMagnitude<FastMath> fastMagnitude;
+	Value * value = (Value*) fastMagnitude.execute(&row);
+	EXPECT_NEAR(value->getValue(), magnitude, 1e-5 * magnitude);
+	delete value;
+}
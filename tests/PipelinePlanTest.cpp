@@ -0,0 +1,404 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace ARF;
+
+//outputs a new Value containing the number of times it was executed
+class Counter : public Algorithm {
+public:
+	UINT numExecutions = 0;
+	
+	Data* execute(Data* data) override {
+		numExecutions++;
+		return new Value(numExecutions);
+	}
+};
+
+//never produces an output
+class Blocker : public Algorithm {
+public:
+	Data* execute(Data* data) override {
+		return nullptr;
+	}
+};
+
+//stateless algorithm that outputs the first value of a SensorSample and counts the calls to executeBatch()
+class FirstValue : public Algorithm {
+public:
+	UINT numBatches = 0;
+	
+	Data* execute(Data* data) override {
+		return new Value((*(SensorSample*) data)[0]);
+	}
+	
+	bool supportsBatch() const override {
+		return true;
+	}
+	
+	void executeBatch(Data** input, Data** output, UINT numInputs, ExecutionContext & context) override {
+		numBatches++;
+		Algorithm::executeBatch(input, output, numInputs, context);
+	}
+};
+
+TEST(PipelinePlan, Compile) {
+	RingBufferAlgorithm ringBufferAlgorithm(10);
+	DataSelector selector1(nullptr,0,0,{0});
+	DataSelector selector2(nullptr,0,0,{0});
+	Mean mean;
+	Minimum minimum;
+	
+	ringBufferAlgorithm << selector1 << mean;
+	ringBufferAlgorithm << selector2 << minimum;
+	
+	PipelinePlan plan(&ringBufferAlgorithm);
+	EXPECT_EQ(plan.getNumNodes(),5);
+	EXPECT_EQ(plan.getNumLeaves(),2);
+}
+
+TEST(PipelinePlan, ExecuteProducesSameOutputAsExecutePipeline) {
+	RingBuffer<SensorSample> ringBuffer(3);
+	RingBufferAlgorithm ringBufferAlgorithm(&ringBuffer);
+	DataSelector firstColumnSelector(&ringBuffer,0,2,{0});
+	DataSelector secondColumnSelector(&ringBuffer,0,2,{1});
+	Mean mean;
+	Minimum minimum;
+	
+	ringBufferAlgorithm << firstColumnSelector << mean;
+	ringBufferAlgorithm << secondColumnSelector << minimum;
+	
+	PipelinePlan plan(&ringBufferAlgorithm);
+	Vector<Data*> planOutput(plan.getNumLeaves());
+	Vector<Data*> pipelineOutput(plan.getNumLeaves());
+	
+	for(int i = 0 ; i < 3 ; i++){
+		SensorSample sample(std::vector<float>{(float) i, (float) -i});
+		UINT outputCount = plan.execute(&sample, planOutput);
+		
+		//the buffer notifies only after it is full
+		EXPECT_EQ(outputCount, (i < 2) ? 0 : 2);
+	}
+	
+	EXPECT_EQ(((Value*) planOutput[0])->getValue(), 1.0);
+	EXPECT_EQ(((Value*) planOutput[1])->getValue(), -2.0);
+	
+	//execute the same graph without the plan, the ring buffer is already full
+	SensorSample sample(std::vector<float>{3.0, -3.0});
+	UINT pipelineOutputCount = Algorithm::ExecutePipeline(&ringBufferAlgorithm, &sample, pipelineOutput);
+	EXPECT_EQ(pipelineOutputCount,2);
+	
+	sample = SensorSample(std::vector<float>{4.0, -4.0});
+	UINT planOutputCount = plan.execute(&sample, planOutput);
+	EXPECT_EQ(planOutputCount,2);
+	
+	EXPECT_EQ(((Value*) pipelineOutput[0])->getValue(), 2.0);
+	EXPECT_EQ(((Value*) planOutput[0])->getValue(), 3.0);
+	EXPECT_EQ(((Value*) pipelineOutput[1])->getValue(), -3.0);
+	EXPECT_EQ(((Value*) planOutput[1])->getValue(), -4.0);
+	
+	delete pipelineOutput[0];
+	delete pipelineOutput[1];
+}
+
+TEST(PipelinePlan, SkipsAlgorithmsAfterMissingOutput) {
+	Counter root;
+	Blocker blocker;
+	Counter blockedCounter;
+	Counter counter;
+	
+	root << blocker << blockedCounter;
+	root << counter;
+	
+	PipelinePlan plan(&root);
+	Vector<Data*> output(plan.getNumLeaves());
+	
+	SensorSample sample(1,0);
+	UINT outputCount = plan.execute(&sample, output);
+	
+	EXPECT_EQ(outputCount,1);
+	EXPECT_EQ(blockedCounter.numExecutions,0);
+	EXPECT_EQ(counter.numExecutions,1);
+	EXPECT_EQ(((Value*) output[0])->getValue(), 1.0);
+}
+
+TEST(PipelinePlan, DetectsCycles) {
+	Counter counter1;
+	Counter counter2;
+	
+	counter1 << counter2;
+	counter2 << counter1;
+	
+	EXPECT_THROW(PipelinePlan plan(&counter1),ARFException);
+}
+
+TEST(PipelinePlan, SteadyStateDoesNotAllocate) {
+	RingBuffer<SensorSample> ringBuffer(5);
+	RingBufferAlgorithm ringBufferAlgorithm(&ringBuffer);
+	DataSelector selector(&ringBuffer,0,4,{0});
+	Mean mean;
+	STD stdev;
+	
+	ringBufferAlgorithm << selector << mean;
+	selector << stdev;
+	
+	PipelinePlan plan(&ringBufferAlgorithm);
+	Vector<Data*> output(plan.getNumLeaves());
+	SensorSample sample(1,0);
+	
+	for(int i = 0 ; i < 5 ; i++){
+		sample[0] = (Float) i;
+		plan.execute(&sample, output);
+	}
+	
+	UINT numAllocations = plan.getContext().getArena().getNumAllocations();
+	for(int i = 0 ; i < 100 ; i++){
+		plan.execute(&sample, output);
+	}
+	EXPECT_EQ(plan.getContext().getArena().getNumAllocations(),numAllocations);
+	EXPECT_EQ(((Value*) output[0])->getValue(), 4.0);
+	EXPECT_EQ(((Value*) output[1])->getValue(), 0.0);
+}
+
+TEST(PipelinePlan, ExecuteBlockProducesSameOutputAsExecute) {
+	RingBuffer<SensorSample> ringBuffer1(4);
+	RingBufferAlgorithm ringBufferAlgorithm1(&ringBuffer1);
+	DataSelector selector1(&ringBuffer1,0,3,{0});
+	Minimum minimum1;
+	Counter counter1;
+	ringBufferAlgorithm1 << selector1 << minimum1;
+	ringBufferAlgorithm1 << counter1;
+	
+	RingBuffer<SensorSample> ringBuffer2(4);
+	RingBufferAlgorithm ringBufferAlgorithm2(&ringBuffer2);
+	DataSelector selector2(&ringBuffer2,0,3,{0});
+	Minimum minimum2;
+	Counter counter2;
+	ringBufferAlgorithm2 << selector2 << minimum2;
+	ringBufferAlgorithm2 << counter2;
+	
+	PipelinePlan plan1(&ringBufferAlgorithm1);
+	PipelinePlan plan2(&ringBufferAlgorithm2);
+	
+	Vector<SensorSample> samples;
+	for(int i = 0 ; i < 10 ; i++){
+		samples.push_back(SensorSample(std::vector<float>{(float) ((i * 7) % 5), 0}));
+	}
+	
+	//execute the samples one by one
+	Vector<Float> expectedValues;
+	Vector<UINT> expectedIndices;
+	Vector<Data*> output(plan1.getNumLeaves());
+	for(UINT i = 0 ; i < samples.getSize() ; i++){
+		UINT outputCount = plan1.execute(&samples[i], output);
+		for(UINT j = 0 ; j < outputCount ; j++){
+			expectedValues.push_back(((Value*) output[j])->getValue());
+			expectedIndices.push_back(i);
+		}
+	}
+	
+	//execute the samples in two blocks
+	Vector<Data*> blockOutput;
+	Vector<UINT> sampleIndices;
+	UINT numOutputs = 0;
+	for(UINT start = 0 ; start < samples.getSize() ; start += 5){
+		UINT outputCount = plan2.executeBlock(&samples[start], 5, blockOutput, sampleIndices);
+		for(UINT j = 0 ; j < outputCount ; j++, numOutputs++){
+			EXPECT_EQ(((Value*) blockOutput[j])->getValue(), expectedValues[numOutputs]);
+			EXPECT_EQ(sampleIndices[j] + start, expectedIndices[numOutputs]);
+		}
+	}
+	EXPECT_EQ(numOutputs, expectedValues.getSize());
+}
+
+TEST(PipelinePlan, ExecuteBlockBatchesStatelessPrefix) {
+	FirstValue firstValue;
+	PeakDetector peakDetector(0.5,2);
+	
+	firstValue << peakDetector;
+	
+	PipelinePlan plan(&firstValue);
+	
+	//samples stored in a raw array with an extra unused column
+	Float data[] = {0.0, 9.0, 1.0, 9.0, 0.0, 9.0, 0.0, 9.0, 0.0, 9.0, 0.0, 9.0};
+	Vector<Data*> output;
+	Vector<UINT> sampleIndices;
+	UINT outputCount = plan.executeBlock(data, 6, 1, 2, output, sampleIndices);
+	
+	EXPECT_EQ(firstValue.numBatches,1);
+	EXPECT_EQ(outputCount,1);
+	EXPECT_EQ(((Value*) output[0])->getValue(), 0.0);
+	EXPECT_EQ(sampleIndices[0],3);
+	
+	EXPECT_THROW(plan.executeBlock(data, 6, 2, 1, output, sampleIndices),ARFException);
+}
+
+//ring buffer followed by many feature extraction branches
+struct FeatureGraph {
+	RingBuffer<SensorSample> ringBuffer;
+	RingBufferAlgorithm ringBufferAlgorithm;
+	Vector<Algorithm*> algorithms;
+	
+	FeatureGraph(UINT numBranches) : ringBuffer(8), ringBufferAlgorithm(&ringBuffer) {
+		for(UINT i = 0 ; i < numBranches ; i++){
+			Algorithm * selector = new DataSelector(&ringBuffer,i % 4,7,{(uint8_t) (i % 2)});
+			Algorithm * feature = (i % 3 == 0) ? (Algorithm*) new Mean() : (i % 3 == 1) ? (Algorithm*) new STD() : (Algorithm*) new ZCR();
+			ringBufferAlgorithm << *selector << *feature;
+			algorithms.push_back(selector);
+			algorithms.push_back(feature);
+		}
+	}
+	
+	~FeatureGraph(){
+		for(UINT i = 0 ; i < algorithms.getSize() ; i++){
+			delete algorithms[i];
+		}
+	}
+};
+
+TEST(PipelinePlan, ParallelExecutionProducesSameOutput) {
+	FeatureGraph sequentialGraph(20);
+	FeatureGraph parallelGraph(20);
+	
+	PipelinePlan sequentialPlan(&sequentialGraph.ringBufferAlgorithm);
+	PipelinePlan parallelPlan(&parallelGraph.ringBufferAlgorithm);
+	ThreadPool threadPool(3);
+	parallelPlan.setThreadPool(&threadPool, 8);
+	EXPECT_EQ(parallelPlan.getNumParallelNodes(),1);
+	
+	Vector<Data*> sequentialOutput(sequentialPlan.getNumLeaves());
+	Vector<Data*> parallelOutput(parallelPlan.getNumLeaves());
+	
+	for(int i = 0 ; i < 50 ; i++){
+		SensorSample sample(std::vector<float>{(float) ((i * 7) % 5) - 2, (float) ((i * 3) % 4) - 1});
+		
+		UINT sequentialCount = sequentialPlan.execute(&sample, sequentialOutput);
+		UINT parallelCount = parallelPlan.execute(&sample, parallelOutput);
+		
+		ASSERT_EQ(sequentialCount,parallelCount);
+		for(UINT j = 0 ; j < sequentialCount ; j++){
+			EXPECT_EQ(((Value*) sequentialOutput[j])->getValue(), ((Value*) parallelOutput[j])->getValue());
+		}
+	}
+}
+
+//stateful algorithm that counts its executions in the state of the stream, and the executions without a state block. Every execution sleeps briefly, so that the workers of a thread pool take part even on a single core
+class StreamCounter : public Algorithm {
+public:
+	std::atomic<UINT> numExecutionsWithoutState;
+	
+	StreamCounter() : numExecutionsWithoutState(0) { }
+	
+	Data* execute(Data* data) override {
+		return new Value(0.0);
+	}
+	
+	Data* execute(Data* data, ExecutionContext & context) override {
+		std::this_thread::sleep_for(std::chrono::microseconds(20));
+		UINT * count = (UINT*) context.getState(this);
+		if(count == nullptr){
+			numExecutionsWithoutState++;
+			return context.create<Value>(0.0);
+		}
+		(*count)++;
+		return context.create<Value>((Float) *count);
+	}
+	
+	UINT getStateSize() const override {
+		return sizeof(UINT);
+	}
+	
+	void initializeState(void * state) const override {
+		*(UINT*) state = 0;
+	}
+};
+
+TEST(PipelinePlan, ParallelBranchesUseTheStateBlock) {
+	const UINT numBranches = 8;
+	StreamCounter root;
+	StreamCounter branches[numBranches];
+	for(UINT i = 0 ; i < numBranches ; i++){
+		root << branches[i];
+	}
+	
+	ThreadPool threadPool(3);
+	PipelinePlan plan(&root);
+	plan.setThreadPool(&threadPool, 1);
+	ASSERT_EQ(plan.getNumParallelNodes(),1);
+	
+	//a state block with the counters of the root and of every branch
+	std::vector<UINT> stateBlock(numBranches + 1);
+	Vector<AlgorithmState> states(numBranches + 1);
+	for(UINT i = 0 ; i <= numBranches ; i++){
+		states[i].algorithm = (i == 0) ? &root : &branches[i - 1];
+		states[i].offset = i * sizeof(UINT);
+		states[i].algorithm->initializeState(&stateBlock[i]);
+	}
+	plan.getContext().setStateBlock((char*) stateBlock.data(), states.getData(), states.getSize());
+	
+	const UINT numSamples = 100;
+	Vector<Data*> output(plan.getNumLeaves());
+	SensorSample sample(1);
+	for(UINT i = 0 ; i < numSamples ; i++){
+		ASSERT_EQ(plan.execute(&sample, output), numBranches);
+		for(UINT j = 0 ; j < numBranches ; j++){
+			EXPECT_EQ(((Value*) output[j])->getValue(), (Float) (i + 1));
+		}
+	}
+	for(UINT i = 0 ; i < numBranches ; i++){
+		EXPECT_EQ(branches[i].numExecutionsWithoutState, 0);
+		EXPECT_EQ(stateBlock[i + 1], numSamples);
+	}
+}
+
+TEST(PipelinePlan, SmallOrDependentGraphsStaySequential) {
+	Counter root;
+	Counter counter1;
+	Counter counter2;
+	Counter shared;
+	
+	root << counter1 << shared;
+	root << counter2 << shared;
+	
+	ThreadPool threadPool(1);
+	PipelinePlan plan(&root);
+	
+	plan.setThreadPool(&threadPool, 10);
+	EXPECT_EQ(plan.getNumParallelNodes(),0);
+	
+	plan.setThreadPool(&threadPool, 1);
+	EXPECT_EQ(plan.getNumParallelNodes(),0);
+	
+	Counter counter3;
+	Counter counter4;
+	counter1 << counter3;
+	counter2 << counter4;
+	PipelinePlan independentPlan(&counter1);
+	independentPlan.setThreadPool(&threadPool, 1);
+	EXPECT_EQ(independentPlan.getNumParallelNodes(),1);
+}
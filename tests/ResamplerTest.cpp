@@ -0,0 +1,141 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+static Float createValue(double inputIdx, Float frequency){
+	return sinf(2 * M_PI * frequency * inputIdx);
+}
+
+/**
+ Resamples a sine and compares the outputs with the sine at the output times, delayed by the filter
+ 
+ @param frequency the frequency of the sine in cycles per input sample
+ @return the largest difference
+ */
+static Float measureError(UINT interpolation, UINT decimation, Float frequency){
+	
+	Vector<uint8_t> columns;
+	columns.push_back(1);
+	Resampler resampler(interpolation, decimation, columns);
+	UINT numTaps = resampler.getNumTapsPerPhase() * interpolation;
+	double delay = (numTaps - 1) / 2.0;
+	
+	SensorSample sample(2);
+	ExecutionContext context;
+	UINT numOutputs = 0;
+	Float maxError = 0.0f;
+	const UINT numInputs = 4000;
+	for(UINT i = 0 ; i < numInputs ; i++){
+		sample[0] = (Float) i;
+		sample[1] = createValue(i, frequency);
+		SensorSample * output = (SensorSample*) resampler.execute(&sample, context);
+		if(output != nullptr){
+			
+			//the columns that are not resampled are copied from the last input
+			EXPECT_EQ((*output)[0], (Float) i);
+			
+			double inputIdx = (numOutputs * (double) decimation - delay) / interpolation;
+			if(inputIdx > numTaps){
+				maxError = std::max(maxError, std::abs((*output)[1] - createValue(inputIdx, frequency)));
+			}
+			numOutputs++;
+		}
+	}
+	EXPECT_EQ(numOutputs, numInputs * interpolation / decimation);
+	return maxError;
+}
+
+TEST(Resampler, PassesLowFrequencies) {
+	EXPECT_LT(measureError(1, 1, 0.05f), 1e-3);
+	EXPECT_LT(measureError(1, 4, 0.02f), 1e-2);
+	EXPECT_LT(measureError(1, 8, 0.01f), 1e-2);
+	EXPECT_LT(measureError(3, 4, 0.05f), 1e-2);
+	EXPECT_LT(measureError(2, 5, 0.05f), 1e-2);
+}
+
+TEST(Resampler, RemovesAliases) {
+	
+	//a sine above the Nyquist frequency of the output would alias to a low frequency
+	Vector<uint8_t> columns;
+	columns.push_back(0);
+	Resampler resampler(1, 4, columns);
+	SensorSample sample(1);
+	Float amplitude = 0.0f;
+	for(UINT i = 0 ; i < 2000 ; i++){
+		sample[0] = createValue(i, 0.3f) + 2.0f;
+		SensorSample * output = (SensorSample*) resampler.execute(&sample);
+		if(output != nullptr){
+			if(i > 200){
+				amplitude = std::max(amplitude, std::abs((*output)[0] - 2.0f));
+			}
+			delete output;
+		}
+	}
+	EXPECT_LT(amplitude, 1e-3);
+}
+
+TEST(Resampler, DownstreamRunsAtOutputRate) {
+	Vector<uint8_t> columns;
+	for(uint8_t column : {0, 1, 2}){
+		columns.push_back(column);
+	}
+	Resampler resampler(1, 8, columns);
+	RingBufferAlgorithm ringBufferAlgorithm(10);
+	resampler << ringBufferAlgorithm;
+	PipelinePlan plan(&resampler);
+	
+	Vector<Data*> outputs(plan.getNumLeaves());
+	SensorSample sample(3);
+	for(UINT j = 0 ; j < 3 ; j++){
+		sample[j] = (Float) j;
+	}
+	
+	//the ring buffer receives 100 samples and notifies once it is full
+	UINT numOutputs = 0;
+	for(UINT i = 0 ; i < 800 ; i++){
+		if(plan.execute(&sample, outputs) > 0){
+			numOutputs++;
+			
+			//a constant stream remains constant once the history of the filter is full. The ring buffer outputs the last resampled sample
+			SensorSample * resampled = (SensorSample*) outputs[0];
+			ASSERT_EQ(resampled->getSize(), 3);
+			for(UINT j = 0 ; j < 3 && i > 8 * resampler.getNumTapsPerPhase() ; j++){
+				EXPECT_NEAR((*resampled)[j], (Float) j, 1e-5);
+			}
+		}
+	}
+	EXPECT_EQ(numOutputs, 91);
+}
+
+TEST(Resampler, InvalidParameters) {
+	Vector<uint8_t> columns;
+	columns.push_back(0);
+	EXPECT_THROW(Resampler(0, 4, columns), ARFException);
+	EXPECT_THROW(Resampler(3, 2, columns), ARFException);
+	EXPECT_THROW(Resampler(1, 2, Vector<uint8_t>()), ARFException);
+}
@@ -0,0 +1,141 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "ARF.h"
+
+using namespace ARF;
+
+TEST(SampleQueue, PushAndPop) {
+	SampleQueue queue(5,2);
+	EXPECT_EQ(queue.getCapacity(),8);
+	
+	SensorSample sample;
+	EXPECT_FALSE(queue.pop(sample));
+	
+	//fill the queue several times so that the batches wrap around its end
+	Float values[20];
+	for(UINT i = 0 ; i < 20 ; i++){
+		values[i] = (Float) i;
+	}
+	UINT nextValue = 0;
+	for(UINT round = 0 ; round < 5 ; round++){
+		EXPECT_EQ(queue.push(values + 2 * (round % 3), 10),8);
+		EXPECT_FALSE(queue.push(values));
+		EXPECT_EQ(queue.getSize(),8);
+		
+		for(UINT i = 0 ; i < 8 ; i++){
+			EXPECT_TRUE(queue.pop(sample));
+			EXPECT_EQ(sample.getSize(),2);
+			EXPECT_EQ(sample[0],(Float) (2 * (round % 3 + i)));
+			EXPECT_EQ(sample[1],(Float) (2 * (round % 3 + i) + 1));
+		}
+		EXPECT_FALSE(queue.pop(sample));
+		
+		//shift the position of the next batch
+		EXPECT_TRUE(queue.push(SensorSample(2, (Float) nextValue)));
+		EXPECT_TRUE(queue.pop(sample));
+		EXPECT_EQ(sample[0],(Float) nextValue);
+		nextValue++;
+	}
+	
+	EXPECT_THROW(queue.push(SensorSample(3)),ARFException);
+	EXPECT_THROW(SampleQueue(0,2),ARFException);
+}
+
+TEST(SampleQueue, FeedsRingBufferAlgorithm) {
+	SampleQueue queue(4,3);
+	RingBufferAlgorithm ringBufferAlgorithm(6);
+	
+	for(UINT i = 0 ; i < 10 ; i++){
+		Float values[3] = {(Float) i, (Float) (10 * i), (Float) (100 * i)};
+		EXPECT_TRUE(queue.push(values));
+		if(queue.getSize() == 3){
+			EXPECT_EQ(ringBufferAlgorithm.addSamples(queue,2),2);
+			EXPECT_EQ(ringBufferAlgorithm.addSamples(queue),1);
+		}
+	}
+	EXPECT_EQ(ringBufferAlgorithm.addSamples(queue),1);
+	
+	EXPECT_EQ(ringBufferAlgorithm.getSize(),6);
+	for(UINT i = 0 ; i < 6 ; i++){
+		SensorSample sample = ringBufferAlgorithm.getElementAtIdx(i);
+		EXPECT_EQ(sample.getSize(),3);
+		EXPECT_EQ(sample[0],(Float) (i + 4));
+		EXPECT_EQ(sample[2],(Float) (100 * (i + 4)));
+	}
+}
+
+static void testProducerConsumer(bool blocking){
+	const UINT numSamples = 100000;
+	SampleQueue queue(64,2,blocking);
+	
+	std::thread producer([&](){
+		Float values[2 * 16];
+		UINT numPushed = 0;
+		while(numPushed < numSamples){
+			UINT batchSize = std::min(1 + numPushed % 16, numSamples - numPushed);
+			for(UINT i = 0 ; i < batchSize ; i++){
+				values[2 * i] = (Float) (numPushed + i);
+				values[2 * i + 1] = -(Float) (numPushed + i);
+			}
+			UINT numBatchPushed = 0;
+			while(numBatchPushed < batchSize){
+				numBatchPushed += queue.push(values + 2 * numBatchPushed, batchSize - numBatchPushed);
+				if(numBatchPushed < batchSize){
+					std::this_thread::yield();
+				}
+			}
+			numPushed += batchSize;
+		}
+		queue.close();
+	});
+	
+	//the consumer checks that the samples arrive once and in order
+	UINT numConsumed = 0;
+	bool inOrder = true;
+	while(queue.wait()){
+		const Float * values;
+		UINT numAcquired = queue.acquire(values, 10);
+		for(UINT i = 0 ; i < numAcquired ; i++){
+			inOrder = inOrder && values[2 * i] == (Float) numConsumed && values[2 * i + 1] == -(Float) numConsumed;
+			numConsumed++;
+		}
+		queue.release(numAcquired);
+	}
+	producer.join();
+	
+	EXPECT_TRUE(inOrder);
+	EXPECT_EQ(numConsumed,numSamples);
+	EXPECT_TRUE(queue.isClosed());
+}
+
+TEST(SampleQueue, ProducerConsumerPolling) {
+	testProducerConsumer(false);
+}
+
+TEST(SampleQueue, ProducerConsumerBlocking) {
+	testProducerConsumer(true);
+}
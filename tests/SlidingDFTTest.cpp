@@ -0,0 +1,108 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+static Float createValue(UINT sampleIdx, Float frequency, Float sampleRate){
+	return 2.0f * sinf(2 * M_PI * frequency * sampleIdx / sampleRate) + 0.3f * sinf(sampleIdx * 2.3f) + 1.0f;
+}
+
+TEST(SlidingDFT, MatchesDirectComputation) {
+	const UINT windowSize = 64;
+	const Float sampleRate = 100.0f;
+	Vector<Float> frequencies;
+	for(Float frequency : {0.0f, 7.5f, 12.5f, 50.0f}){
+		frequencies.push_back(frequency);
+	}
+	SlidingDFT slidingDFT(windowSize, sampleRate, frequencies, SlidingDFT::kPowers);
+	
+	//a long stream, so that rounding errors would accumulate if they were not damped
+	const UINT numSamples = 200000;
+	RingBuffer<SensorSample> ringBuffer(windowSize);
+	ExecutionContext context;
+	FeatureVector * powers = nullptr;
+	for(UINT i = 0 ; i < numSamples ; i++){
+		Float value = createValue(i, 12.5f, sampleRate);
+		SensorSample sample(1);
+		sample[0] = value;
+		ringBuffer.add(sample);
+		
+		Value input(value);
+		context.reset();
+		powers = (FeatureVector*) slidingDFT.execute(&input, context);
+		
+		//the first samples, when the window is not full yet
+		if(i == 10){
+			Signal signal(&ringBuffer, 0, 10, Vector<uint8_t>(1, 0));
+			EXPECT_NEAR((*powers)[1], SlidingDFT::Compute(signal, windowSize, sampleRate, 7.5f), 1e-3);
+		}
+	}
+	
+	Signal signal(&ringBuffer, 0, windowSize - 1, Vector<uint8_t>(1, 0));
+	ASSERT_EQ(powers->getSize(), 4);
+	for(UINT i = 0 ; i < frequencies.getSize() ; i++){
+		Float expected = SlidingDFT::Compute(signal, windowSize, sampleRate, frequencies[i]);
+		EXPECT_NEAR((*powers)[i], expected, 1e-4 * (1 + expected)) << "frequency " << frequencies[i];
+	}
+	
+	//the sine of amplitude 2 has a power of about 2^2 * windowSize / 2 at its frequency
+	EXPECT_NEAR((*powers)[2], 2.0f * windowSize, 0.1f * windowSize);
+	EXPECT_LT((*powers)[3], 0.1f * (*powers)[2]);
+}
+
+TEST(SlidingDFT, FeedsPeakDetector) {
+	const Float sampleRate = 100.0f;
+	Vector<Float> frequencies;
+	frequencies.push_back(10.0f);
+	
+	//the power of the frequency peaks at the end of a burst of 10 Hz in a stream of 30 Hz
+	SlidingDFT slidingDFT(50, sampleRate, frequencies);
+	PeakDetector peakDetector(20.0f, 30);
+	slidingDFT << peakDetector;
+	PipelinePlan plan(&slidingDFT);
+	
+	Vector<Data*> outputs(plan.getNumLeaves());
+	UINT firstPeak = 0;
+	for(UINT i = 0 ; i < 400 && firstPeak == 0 ; i++){
+		Value input(sinf(2 * M_PI * ((i >= 200 && i < 250) ? 10.0f : 30.0f) * i / sampleRate));
+		if(plan.execute(&input, outputs) > 0){
+			firstPeak = i;
+		}
+	}
+	EXPECT_GE(firstPeak, 250);
+	EXPECT_LT(firstPeak, 300);
+}
+
+TEST(SlidingDFT, InvalidParameters) {
+	Vector<Float> frequencies;
+	EXPECT_THROW(SlidingDFT(64, 100.0f, frequencies), ARFException);
+	frequencies.push_back(60.0f);
+	EXPECT_THROW(SlidingDFT(64, 100.0f, frequencies), ARFException);
+	frequencies[0] = 10.0f;
+	EXPECT_THROW(SlidingDFT(0, 100.0f, frequencies), ARFException);
+	EXPECT_THROW(SlidingDFT(64, 100.0f, frequencies, SlidingDFT::kTotalPower, 1.5), ARFException);
+}
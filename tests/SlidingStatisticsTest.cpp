@@ -0,0 +1,160 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+static Float createValue(UINT streamIdx, UINT sampleIdx){
+	//repeated values exercise the ties in the monotonic queues
+	return (Float) ((sampleIdx * 7 + streamIdx * 3) % 11) - 5.0f + 100.0f * streamIdx;
+}
+
+TEST(SlidingStatistics, MatchWindowRecomputation) {
+	const UINT capacity = 7;
+	SlidingStatistics statistics(capacity);
+	RingBuffer<SensorSample> ringBuffer(capacity);
+	
+	for(UINT sampleIdx = 0 ; sampleIdx < 100 ; sampleIdx++){
+		Float value = createValue(1, sampleIdx);
+		statistics.push(ringBuffer.isFull() ? ringBuffer.getValue(0, 0) : 0.0f, value);
+		ringBuffer.add(SensorSample(1, value));
+		
+		Signal signal(&ringBuffer, 0, ringBuffer.getSize() - 1, Vector<uint8_t>(1, 0));
+		Float maximum = signal[0];
+		for(UINT i = 0 ; i < signal.getSize() ; i++){
+			maximum = std::max(maximum, signal[i]);
+		}
+		ASSERT_EQ(statistics.getSize(), ringBuffer.getSize());
+		EXPECT_NEAR(statistics.getMean(), Mean::Compute(signal), 1e-4);
+		if(signal.getSize() > 1){
+			EXPECT_NEAR(statistics.getSTD(), STD::Compute(signal), 1e-3);
+		}
+		EXPECT_EQ(statistics.getMinimum(), Minimum::Compute(signal));
+		EXPECT_EQ(statistics.getMaximum(), maximum);
+	}
+	
+	EXPECT_THROW(statistics.add(1.0f), ARFException);
+	statistics.reset();
+	EXPECT_EQ(statistics.getSize(), 0);
+}
+
+//a ring buffer notifying every 4 samples, with the mean, STD and minimum of a column computed over the window and read from the sliding statistics
+struct SlidingGraph {
+	RingBufferAlgorithm ringBufferAlgorithm;
+	DataSelector selector;
+	Mean mean;
+	STD std;
+	Minimum minimum;
+	SlidingFeature slidingMean;
+	SlidingFeature slidingSTD;
+	SlidingFeature slidingMinimum;
+	
+	SlidingGraph() : ringBufferAlgorithm(16, 4), selector(ringBufferAlgorithm, 0, 15, {1}),
+	slidingMean(ringBufferAlgorithm, 1, Statistics::kMean), slidingSTD(ringBufferAlgorithm, 1, Statistics::kSTD),
+	slidingMinimum(ringBufferAlgorithm, 1, Statistics::kMinimum) {
+		ringBufferAlgorithm << selector;
+		selector << mean;
+		selector << std;
+		selector << minimum;
+		ringBufferAlgorithm << slidingMean;
+		ringBufferAlgorithm << slidingSTD;
+		ringBufferAlgorithm << slidingMinimum;
+	}
+};
+
+static SensorSample createSample(UINT streamIdx, UINT sampleIdx){
+	SensorSample sample(2);
+	sample[0] = 0.0f;
+	sample[1] = createValue(streamIdx, sampleIdx);
+	return sample;
+}
+
+static void expectSlidingOutputMatches(const Vector<Data*> & output){
+	EXPECT_NEAR(((Value*) output[3])->getValue(), ((Value*) output[0])->getValue(), 1e-3);
+	EXPECT_NEAR(((Value*) output[4])->getValue(), ((Value*) output[1])->getValue(), 1e-3);
+	EXPECT_EQ(((Value*) output[5])->getValue(), ((Value*) output[2])->getValue());
+}
+
+TEST(SlidingStatistics, SlidingFeaturesInPipeline) {
+	SlidingGraph graph;
+	PipelinePlan plan(&graph.ringBufferAlgorithm);
+	Vector<Data*> output(6);
+	UINT numNotifications = 0;
+	
+	for(UINT sampleIdx = 0 ; sampleIdx < 60 ; sampleIdx++){
+		SensorSample sample = createSample(0, sampleIdx);
+		if(plan.execute(&sample, output) > 0){
+			expectSlidingOutputMatches(output);
+			numNotifications++;
+		}
+	}
+	EXPECT_EQ(numNotifications, (60 - 15) / 4);
+	EXPECT_THROW(SlidingFeature(graph.ringBufferAlgorithm, 1, Statistics::kZeroCrossingRate), ARFException);
+	EXPECT_THROW(SlidingFeature(graph.ringBufferAlgorithm, 1, Statistics::kMean | Statistics::kSTD), ARFException);
+}
+
+TEST(SlidingStatistics, SlidingFeaturesPerStream) {
+	const UINT numStreams = 3;
+	SlidingGraph graph;
+	StreamRuntime runtime(&graph.ringBufferAlgorithm, numStreams);
+	Vector<Data*> output(6);
+	UINT numNotifications = 0;
+	
+	for(UINT sampleIdx = 0 ; sampleIdx < 40 ; sampleIdx++){
+		for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+			SensorSample sample = createSample(streamIdx, sampleIdx);
+			if(runtime.execute(streamIdx, &sample, output) > 0){
+				expectSlidingOutputMatches(output);
+				numNotifications++;
+			}
+		}
+	}
+	EXPECT_EQ(numNotifications, numStreams * ((40 - 15) / 4));
+}
+
+TEST(SlidingStatistics, ColumnTrackedAfterStateInitialized) {
+	RingBufferAlgorithm ringBufferAlgorithm(16);
+	SlidingFeature slidingMean(ringBufferAlgorithm, 1, Statistics::kMean);
+	
+	//the state of a stream, initialized while only column 1 is tracked
+	std::vector<std::max_align_t> stateBlock(ringBufferAlgorithm.getStateSize() / sizeof(std::max_align_t) + 1);
+	ringBufferAlgorithm.initializeState(stateBlock.data());
+	AlgorithmState state = {&ringBufferAlgorithm, 0};
+	ExecutionContext context;
+	context.setStateBlock((char*) stateBlock.data(), &state, 1);
+	
+	SlidingFeature lateMean(ringBufferAlgorithm, 0, Statistics::kMean);
+	EXPECT_NE(ringBufferAlgorithm.getSlidingStatistics(1, context), nullptr);
+	EXPECT_EQ(ringBufferAlgorithm.getSlidingStatistics(0, context), nullptr);
+	EXPECT_NE(ringBufferAlgorithm.getSlidingStatistics(0), nullptr);
+	
+	SensorSample sample = createSample(0, 0);
+	ringBufferAlgorithm.execute(&sample, context);
+	EXPECT_NE(slidingMean.execute(&sample, context), nullptr);
+	EXPECT_THROW(lateMean.execute(&sample, context), ARFException);
+	
+	ringBufferAlgorithm.destroyState(stateBlock.data());
+}
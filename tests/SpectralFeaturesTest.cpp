@@ -0,0 +1,140 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+#include <vector>
+
+using namespace ARF;
+
+static void AddValues(RingBuffer<SensorSample> & ringBuffer, UINT numValues, Float frequency, Float sampleRate){
+	for(UINT i = 0 ; i < numValues ; i++){
+		SensorSample sample(1);
+		sample[0] = 3.0f * sinf(2 * M_PI * frequency * i / sampleRate) + 0.5f * sinf(i * 1.3f) + 2.0f;
+		ringBuffer.add(sample);
+	}
+}
+
+TEST(FFTPlan, MatchesNaiveDFT) {
+	for(UINT size : {4, 8, 64, 512}){
+		const FFTPlan & plan = FFTPlan::GetPlan(size);
+		std::vector<Float> values(size);
+		for(UINT i = 0 ; i < size ; i++){
+			values[i] = sinf(i * 0.7f) + 0.3f * cosf(i * 2.1f) + (i % 3);
+		}
+		
+		std::vector<double> expected(plan.getNumBins());
+		for(UINT k = 0 ; k < plan.getNumBins() ; k++){
+			double re = 0, im = 0;
+			for(UINT i = 0 ; i < size ; i++){
+				re += values[i] * cos(2 * M_PI * k * i / size);
+				im -= values[i] * sin(2 * M_PI * k * i / size);
+			}
+			expected[k] = re * re + im * im;
+		}
+		
+		std::vector<Float> power(plan.getNumBins());
+		plan.computePowerSpectrum(values.data(), power.data());
+		for(UINT k = 0 ; k < plan.getNumBins() ; k++){
+			EXPECT_NEAR(power[k], expected[k], 1e-3 * (1 + expected[k])) << "size " << size << " bin " << k;
+		}
+	}
+}
+
+TEST(FFTPlan, SharedPerSize) {
+	EXPECT_EQ(&FFTPlan::GetPlan(256), &FFTPlan::GetPlan(256));
+	EXPECT_NE(&FFTPlan::GetPlan(256), &FFTPlan::GetPlan(128));
+	EXPECT_EQ(FFTPlan::GetPlanSize(100), 128);
+	EXPECT_EQ(FFTPlan::GetPlanSize(128), 128);
+	EXPECT_THROW(FFTPlan::GetPlan(100), ARFException);
+	
+	SpectralFeatures first(200, 50.0f);
+	SpectralFeatures second(256, 100.0f);
+	EXPECT_EQ(&first.getPlan(), &second.getPlan());
+}
+
+TEST(SpectralFeatures, ComputeFeatures) {
+	Float sampleRate = 100.0f;
+	RingBuffer<SensorSample> ringBuffer(256);
+	AddValues(ringBuffer, 300, 12.5f, sampleRate);
+	Signal signal(&ringBuffer, 0, 255, Vector<uint8_t>(1, 0));
+	
+	//the energy of the values without their mean
+	Float mean = Mean::Compute(signal);
+	Float energy = 0;
+	for(UINT i = 0 ; i < signal.getSize() ; i++){
+		energy += (signal[i] - mean) * (signal[i] - mean);
+	}
+	
+	Vector<Float> bandEdges;
+	for(Float edge : {0.0f, 10.0f, 20.0f, 51.0f}){
+		bandEdges.push_back(edge);
+	}
+	SpectralFeatures spectralFeatures(256, sampleRate, SpectralFeatures::kAll, bandEdges);
+	ASSERT_EQ(spectralFeatures.getNumFeatures(), 6);
+	
+	FeatureVector * features = (FeatureVector*) spectralFeatures.execute(&signal);
+	EXPECT_NEAR((*features)[0], 12.5f, sampleRate / 256);
+	EXPECT_NEAR((*features)[1], energy, 1e-3 * energy);
+	EXPECT_GT((*features)[2], 0.0f);
+	EXPECT_LT((*features)[2], 0.5f);
+	
+	//the bands cover the whole spectrum and the sine is in the second band
+	EXPECT_NEAR((*features)[3] + (*features)[4] + (*features)[5], energy, 1e-3 * energy);
+	EXPECT_GT((*features)[4], (*features)[3] + (*features)[5]);
+	
+	//the same features when executed with a context, written to the same FeatureVector every time
+	ExecutionContext context;
+	FeatureVector * contextFeatures = (FeatureVector*) spectralFeatures.execute(&signal, context);
+	EXPECT_EQ(spectralFeatures.execute(&signal, context), contextFeatures);
+	for(UINT i = 0 ; i < features->getSize() ; i++){
+		EXPECT_NEAR((*contextFeatures)[i], (*features)[i], 1e-4 * (1 + fabs((*features)[i])));
+	}
+	delete features;
+	
+	//a white spectrum has the maximum entropy
+	SensorSample impulse(1);
+	RingBuffer<SensorSample> impulseBuffer(64);
+	for(UINT i = 0 ; i < 64 ; i++){
+		impulse[0] = (i == 10) ? 1.0f : 0.0f;
+		impulseBuffer.add(impulse);
+	}
+	Signal impulseSignal(&impulseBuffer, 0, 63, Vector<uint8_t>(1, 0));
+	FeatureVector entropy;
+	std::vector<Float> scratch(SpectralFeatures::GetScratchSize(FFTPlan::GetPlan(64)));
+	SpectralFeatures::Compute(impulseSignal, FFTPlan::GetPlan(64), sampleRate, SpectralFeatures::kSpectralEntropy, Vector<Float>(), entropy, scratch.data());
+	EXPECT_GT(entropy[0], 0.95f);
+}
+
+TEST(SpectralFeatures, InvalidParameters) {
+	EXPECT_THROW(SpectralFeatures(64, 100.0f, 0), ARFException);
+	EXPECT_THROW(SpectralFeatures(64, 100.0f, SpectralFeatures::kBandPowers), ARFException);
+	
+	SpectralFeatures spectralFeatures(64, 100.0f);
+	RingBuffer<SensorSample> ringBuffer(100);
+	AddValues(ringBuffer, 100, 10.0f, 100.0f);
+	Signal signal(&ringBuffer, 0, 99, Vector<uint8_t>(1, 0));
+	ExecutionContext context;
+	EXPECT_THROW(spectralFeatures.execute(&signal, context), ARFException);
+}
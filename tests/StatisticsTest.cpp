@@ -0,0 +1,109 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include "ARF.h"
+#include <math.h>
+
+using namespace ARF;
+
+static void AddValues(RingBuffer<SensorSample> & ringBuffer, ColumnRingBuffer & columnRingBuffer, UINT numValues){
+	for(UINT i = 0 ; i < numValues ; i++){
+		SensorSample sample(2);
+		sample[0] = sinf(i * 0.3f) * 4.0f + 1.0f;
+		sample[1] = (Float) i;
+		ringBuffer.add(sample);
+		columnRingBuffer.add(sample);
+	}
+}
+
+TEST(Statistics, MatchSeparateFeatures) {
+	RingBuffer<SensorSample> ringBuffer(50);
+	ColumnRingBuffer columnRingBuffer(50, 2);
+	AddValues(ringBuffer, columnRingBuffer, 70);
+	
+	Signal signal(&ringBuffer, 0, 49, Vector<uint8_t>(1, 0));
+	Signal columnSignal(&columnRingBuffer, 0, 49, Vector<uint8_t>(1, 0));
+	
+	//reference values computed with a loop per statistic
+	Float mean = Mean::Compute(signal);
+	Float std = STD::Compute(signal);
+	Float minimum = Minimum::Compute(signal);
+	Float maximum = signal[0], energy = 0.0;
+	UINT meanCrossings = 0;
+	for(UINT i = 0 ; i < signal.getSize() ; i++){
+		maximum = std::max(maximum, signal[i]);
+		energy += signal[i] * signal[i];
+		if(i > 0 && signbit(signal[i] - mean) != signbit(signal[i - 1] - mean)){
+			meanCrossings++;
+		}
+	}
+	ASSERT_GT(meanCrossings, 0);
+	
+	//the same statistics through the DataIterator, through the span of the column and from the execution context
+	Statistics statistics;
+	FeatureVector features;
+	Statistics::Compute(signal, Statistics::kAll, features);
+	FeatureVector columnFeatures;
+	Statistics::Compute(columnSignal, Statistics::kAll, columnFeatures);
+	ExecutionContext context;
+	FeatureVector * contextFeatures = (FeatureVector*) statistics.execute(&signal, context);
+	
+	for(const FeatureVector * result : {&features, &columnFeatures, contextFeatures}){
+		ASSERT_EQ(result->getSize(), 10);
+		EXPECT_NEAR((*result)[0], mean, 1e-4);
+		EXPECT_NEAR((*result)[1], std * std, 1e-3);
+		EXPECT_NEAR((*result)[2], std, 1e-4);
+		EXPECT_EQ((*result)[3], minimum);
+		EXPECT_EQ((*result)[4], maximum);
+		EXPECT_EQ((*result)[5], maximum - minimum);
+		EXPECT_NEAR((*result)[6], sqrt(energy / 50), 1e-4);
+		EXPECT_NEAR((*result)[7], energy, 1e-2);
+		EXPECT_FLOAT_EQ((*result)[8], ZCR::Compute(signal));
+		EXPECT_FLOAT_EQ((*result)[9], meanCrossings / 50.0f);
+	}
+}
+
+TEST(Statistics, SelectedStatistics) {
+	RingBuffer<SensorSample> ringBuffer(20);
+	ColumnRingBuffer columnRingBuffer(20, 2);
+	AddValues(ringBuffer, columnRingBuffer, 20);
+	Signal signal(&ringBuffer, 5, 14, Vector<uint8_t>(1, 1));
+	
+	UINT selection = Statistics::kMaximum | Statistics::kMean | Statistics::kRange;
+	Statistics statistics(selection);
+	EXPECT_EQ(statistics.getNumFeatures(), 3);
+	EXPECT_EQ(Statistics::GetFeatureIdx(selection, Statistics::kMean), 0);
+	EXPECT_EQ(Statistics::GetFeatureIdx(selection, Statistics::kMaximum), 1);
+	EXPECT_EQ(Statistics::GetFeatureIdx(selection, Statistics::kRange), 2);
+	
+	FeatureVector * features = (FeatureVector*) statistics.execute(&signal);
+	ASSERT_EQ(features->getSize(), 3);
+	EXPECT_FLOAT_EQ((*features)[0], 9.5);
+	EXPECT_FLOAT_EQ((*features)[1], 14.0);
+	EXPECT_FLOAT_EQ((*features)[2], 9.0);
+	delete features;
+	
+	EXPECT_THROW(Statistics(0), ARFException);
+	EXPECT_THROW(Statistics(Statistics::kAll + 1), ARFException);
+}
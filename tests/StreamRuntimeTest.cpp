@@ -0,0 +1,183 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include "ARF.h"
+
+using namespace ARF;
+
+//a graph with a ring buffer, a mean over the ring buffer and a peak detector on the magnitude of the last sample
+struct StreamGraph {
+	RingBufferAlgorithm ringBufferAlgorithm;
+	DataSelector windowSelector;
+	DataSelector sampleSelector;
+	Mean mean;
+	Magnitude magnitude;
+	PeakDetector peakDetector;
+	
+	StreamGraph() : ringBufferAlgorithm(5), windowSelector(ringBufferAlgorithm,0,4,{0}),
+	sampleSelector(ringBufferAlgorithm,4,4,{0,1,2}), peakDetector(1.0, 3) {
+		ringBufferAlgorithm << windowSelector << mean;
+		ringBufferAlgorithm << sampleSelector << magnitude << peakDetector;
+	}
+};
+
+static SensorSample createSample(UINT streamIdx, UINT sampleIdx){
+	SensorSample sample(3);
+	for(UINT i = 0 ; i < 3 ; i++){
+		sample[i] = (Float) (((streamIdx + 1) * (sampleIdx + 3 * i)) % 7) * 0.5f;
+	}
+	return sample;
+}
+
+TEST(StreamRuntime, StreamsMatchSeparateGraphs) {
+	const UINT numStreams = 3;
+	const UINT numSamples = 40;
+	
+	StreamGraph sharedGraph;
+	StreamRuntime runtime(&sharedGraph.ringBufferAlgorithm, numStreams);
+	EXPECT_EQ(runtime.getNumStreams(),numStreams);
+	EXPECT_EQ(runtime.getNumLeaves(),2);
+	EXPECT_EQ(runtime.getStateSize() % 64,0);
+	EXPECT_GT(runtime.getStateSize(),sharedGraph.ringBufferAlgorithm.getStateSize() + sharedGraph.peakDetector.getStateSize());
+	
+	StreamGraph graphs[numStreams];
+	PipelinePlan * plans[numStreams];
+	for(UINT i = 0 ; i < numStreams ; i++){
+		plans[i] = new PipelinePlan(&graphs[i].ringBufferAlgorithm);
+	}
+	
+	Vector<Data*> output(2);
+	Vector<Data*> expectedOutput(2);
+	UINT numPeaks = 0;
+	
+	//interleave the samples of the streams
+	for(UINT sampleIdx = 0 ; sampleIdx < numSamples ; sampleIdx++){
+		for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+			SensorSample sample = createSample(streamIdx, sampleIdx);
+			UINT outputCount = runtime.execute(streamIdx, &sample, output);
+			UINT expectedOutputCount = plans[streamIdx]->execute(&sample, expectedOutput);
+			
+			ASSERT_EQ(outputCount,expectedOutputCount);
+			for(UINT i = 0 ; i < outputCount ; i++){
+				EXPECT_FLOAT_EQ(((Value*) output[i])->getValue(),((Value*) expectedOutput[i])->getValue());
+			}
+			if(outputCount == 2){
+				numPeaks++;
+			}
+		}
+	}
+	EXPECT_GT(numPeaks,0);
+	
+	//the graph used by the runtime keeps its own state untouched
+	EXPECT_EQ(sharedGraph.ringBufferAlgorithm.getSize(),0);
+	
+	for(UINT i = 0 ; i < numStreams ; i++){
+		delete plans[i];
+	}
+}
+
+TEST(StreamRuntime, ResetStream) {
+	StreamGraph graph;
+	StreamRuntime runtime(&graph.ringBufferAlgorithm, 2);
+	Vector<Data*> output(2);
+	
+	SensorSample sample(3,1.0f);
+	for(UINT i = 0 ; i < 5 ; i++){
+		runtime.execute(0, &sample, output);
+		runtime.execute(1, &sample, output);
+	}
+	
+	//a full ring buffer produces an output for every sample, an empty one does not
+	runtime.resetStream(0);
+	EXPECT_EQ(runtime.execute(0, &sample, output),0);
+	EXPECT_GT(runtime.execute(1, &sample, output),0);
+	
+	EXPECT_THROW(runtime.execute(2, &sample, output),ARFException);
+}
+
+TEST(StreamRuntime, RejectsSelectorsOfTheSharedRingBuffer) {
+	RingBuffer<SensorSample> ringBuffer(5);
+	RingBufferAlgorithm ringBufferAlgorithm(&ringBuffer);
+	DataSelector selector(&ringBuffer,0,4,{0});
+	Mean mean;
+	ringBufferAlgorithm << selector << mean;
+	EXPECT_THROW(StreamRuntime(&ringBufferAlgorithm, 2), ARFException);
+	
+	//a selector over an iterable that is not kept per stream is accepted
+	RingBuffer<SensorSample> otherRingBuffer(5);
+	RingBufferAlgorithm otherRingBufferAlgorithm(&otherRingBuffer);
+	DataSelector otherSelector(&ringBuffer,0,4,{0});
+	otherRingBufferAlgorithm << otherSelector;
+	StreamRuntime runtime(&otherRingBufferAlgorithm, 2);
+	EXPECT_EQ(runtime.getNumStreams(), 2);
+}
+
+struct BlockResults {
+	std::atomic<UINT> numOutputs;
+	std::atomic<UINT> numWrongStreams;
+};
+
+static void countOutputs(void * argument, UINT streamIdx, UINT sampleIdx, Data ** output, UINT numOutputs){
+	BlockResults * results = (BlockResults*) argument;
+	results->numOutputs += numOutputs;
+	
+	//every sample of a stream has the value of the stream, so is the mean of its ring buffer
+	if(((Value*) output[0])->getValue() != (Float) streamIdx){
+		results->numWrongStreams++;
+	}
+}
+
+TEST(StreamRuntime, ExecuteBlocks) {
+	const UINT numStreams = 20;
+	const UINT numSamples = 8;
+	
+	ThreadPool threadPool(3);
+	StreamGraph graph;
+	StreamRuntime runtime(&graph.ringBufferAlgorithm, numStreams, &threadPool);
+	
+	Vector<SensorSample> samples;
+	for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+		for(UINT i = 0 ; i < numSamples ; i++){
+			samples.push_back(SensorSample(3,(Float) streamIdx));
+		}
+	}
+	
+	Vector<StreamRuntime::StreamBlock> blocks(numStreams);
+	for(UINT streamIdx = 0 ; streamIdx < numStreams ; streamIdx++){
+		blocks[streamIdx].streamIdx = streamIdx;
+		blocks[streamIdx].samples = samples.getData() + streamIdx * numSamples;
+		blocks[streamIdx].numSamples = numSamples;
+	}
+	
+	BlockResults results;
+	results.numOutputs = 0;
+	results.numWrongStreams = 0;
+	runtime.execute(blocks.getData(), numStreams, countOutputs, &results);
+	
+	//the ring buffer notifies once it is full, after the 5th sample
+	EXPECT_GE(results.numOutputs.load(),numStreams * (numSamples - 4));
+	EXPECT_EQ(results.numWrongStreams.load(),0);
+}
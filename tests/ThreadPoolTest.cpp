@@ -0,0 +1,80 @@
+/**
+@file
+@author  Juan Haladjian <juan.haladjian@gmail.com>
+ 
+ARF MIT License
+Copyright (c) <2019> <Juan Haladjian>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include "ARF.h"
+#include "ThreadPool.h"
+
+using namespace ARF;
+
+struct TaskCounter {
+	std::atomic<UINT> numTasks;
+	std::atomic<UINT> taskSum;
+	UINT numWorkers;
+	bool validWorkers;
+};
+
+static void countTask(void * argument, UINT taskIdx, UINT workerIdx){
+	TaskCounter * counter = (TaskCounter*) argument;
+	counter->numTasks++;
+	counter->taskSum += taskIdx;
+	if(workerIdx >= counter->numWorkers){
+		counter->validWorkers = false;
+	}
+}
+
+TEST(ThreadPool, ExecutesEveryTaskOnce) {
+	ThreadPool threadPool(3);
+	EXPECT_EQ(threadPool.getNumWorkers(),4);
+	
+	for(UINT numTasks = 0 ; numTasks < 100 ; numTasks++){
+		TaskCounter counter;
+		counter.numTasks = 0;
+		counter.taskSum = 0;
+		counter.numWorkers = threadPool.getNumWorkers();
+		counter.validWorkers = true;
+		
+		threadPool.run(countTask, &counter, numTasks);
+		
+		EXPECT_EQ(counter.numTasks.load(),numTasks);
+		EXPECT_EQ(counter.taskSum.load(),numTasks * (numTasks - 1) / 2);
+		EXPECT_TRUE(counter.validWorkers);
+	}
+}
+
+TEST(ThreadPool, WithoutThreads) {
+	ThreadPool threadPool(0);
+	EXPECT_EQ(threadPool.getNumWorkers(),1);
+	
+	TaskCounter counter;
+	counter.numTasks = 0;
+	counter.taskSum = 0;
+	counter.numWorkers = 1;
+	counter.validWorkers = true;
+	
+	threadPool.run(countTask, &counter, 10);
+	EXPECT_EQ(counter.numTasks.load(),10);
+	EXPECT_TRUE(counter.validWorkers);
+}